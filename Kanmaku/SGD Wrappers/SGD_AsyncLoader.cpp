@@ -0,0 +1,272 @@
+/***********************************************************************\
+|																		|
+|	File:			SGD_AsyncLoader.cpp									|
+|																		|
+|	Purpose:		To read & decode files on worker threads and hand	|
+|					the results back to the main thread, so loading		|
+|					does not stall the frame							|
+|																		|
+\***********************************************************************/
+
+#include "SGD_AsyncLoader.h"
+
+
+// Uses std::find
+#include <algorithm>
+
+// Uses SGD_ASSERT for debug breaks
+#include "SGD_Utilities.h"
+
+
+namespace SGD
+{
+	namespace SGD_IMPLEMENTATION
+	{
+		//*************************************************************//
+		// DESTRUCTOR
+		AsyncLoader::~AsyncLoader( void )
+		{
+			Terminate();
+		}
+		//*************************************************************//
+
+
+
+		//*************************************************************//
+		// INITIALIZE
+		void AsyncLoader::Initialize( unsigned int numWorkers )
+		{
+			SGD_ASSERT( m_vWorkers.empty() == true, "AsyncLoader::Initialize - loader is already initialized" );
+			if( m_vWorkers.empty() == false )
+				return;
+
+			m_bShutdown = false;
+			for( unsigned int i = 0; i < numWorkers; i++ )
+				m_vWorkers.push_back( std::thread( &AsyncLoader::WorkerProc, this ) );
+		}
+		//*************************************************************//
+
+
+
+		//*************************************************************//
+		// TERMINATE
+		//	- a job already on a worker is decoded, then discarded
+		void AsyncLoader::Terminate( void )
+		{
+			{
+				std::lock_guard< std::mutex > lock( m_Mutex );
+				m_bShutdown = true;
+				m_Queued.clear();
+			}
+			m_cvQueued.notify_all();
+
+			for( unsigned int i = 0; i < m_vWorkers.size(); i++ )
+				m_vWorkers[ i ].join();
+			m_vWorkers.clear();
+
+
+			std::lock_guard< std::mutex > lock( m_Mutex );
+			m_Decoded.clear();
+			m_bShutdown = false;
+		}
+		//*************************************************************//
+
+
+
+		//*************************************************************//
+		// SUBMIT
+		unsigned int AsyncLoader::Submit( Step decode, Step finish )
+		{
+			Job job;
+			job.decode	= std::move( decode );
+			job.finish	= std::move( finish );
+
+			unsigned int ticket;
+			{
+				std::lock_guard< std::mutex > lock( m_Mutex );
+
+				ticket = m_unNextTicket++;
+				if( m_unNextTicket == 0 )
+					m_unNextTicket = 1;
+
+				job.unTicket = ticket;
+				m_Queued.push_back( std::move( job ) );
+			}
+			m_cvQueued.notify_one();
+
+			return ticket;
+		}
+		//*************************************************************//
+
+
+
+		//*************************************************************//
+		// UPDATE
+		//	- the steps run outside the lock so the workers keep going
+		unsigned int AsyncLoader::Update( unsigned int maxJobs )
+		{
+			unsigned int count = 0;
+			while( count < maxJobs )
+			{
+				Job job;
+				bool decoded = true;
+
+				{
+					std::lock_guard< std::mutex > lock( m_Mutex );
+
+					if( m_Decoded.empty() == false )
+					{
+						job = std::move( m_Decoded.front() );
+						m_Decoded.pop_front();
+					}
+					else if( m_vWorkers.empty() == true && m_Queued.empty() == false )
+					{
+						job = std::move( m_Queued.front() );
+						m_Queued.pop_front();
+						decoded = false;
+					}
+					else
+						break;
+				}
+
+				if( decoded == false )
+					job.decode();
+				job.finish();
+				count++;
+			}
+
+			return count;
+		}
+		//*************************************************************//
+
+
+
+		//*************************************************************//
+		// COMPLETE
+		//	- a job no worker has started is decoded right here instead
+		//	  of waiting behind the rest of the queue
+		void AsyncLoader::Complete( unsigned int ticket )
+		{
+			Job job;
+			bool decoded;
+
+			{
+				std::unique_lock< std::mutex > lock( m_Mutex );
+
+				for( ;; )
+				{
+					if( TakeJob( m_Decoded, ticket, job ) == true )
+					{
+						decoded = true;
+						break;
+					}
+
+					if( TakeJob( m_Queued, ticket, job ) == true )
+					{
+						decoded = false;
+						break;
+					}
+
+					// Already finished?
+					if( std::find( m_vDecoding.begin(), m_vDecoding.end(), ticket ) == m_vDecoding.end() )
+						return;
+
+					m_cvDecoded.wait( lock );
+				}
+			}
+
+			if( decoded == false )
+				job.decode();
+			job.finish();
+		}
+		//*************************************************************//
+
+
+
+		//*************************************************************//
+		// COMPLETE ALL
+		void AsyncLoader::CompleteAll( void )
+		{
+			for( ;; )
+			{
+				if( Update( 0xFFFFFFFF ) > 0 )
+					continue;
+
+				// Wait for a worker to decode something
+				std::unique_lock< std::mutex > lock( m_Mutex );
+				if( m_Decoded.empty() == true && m_Queued.empty() == true && m_vDecoding.empty() == true )
+					return;
+
+				m_cvDecoded.wait( lock, [this]{ return m_Decoded.empty() == false || (m_Queued.empty() == true && m_vDecoding.empty() == true); } );
+			}
+		}
+		//*************************************************************//
+
+
+
+		//*************************************************************//
+		// GET PENDING COUNT
+		unsigned int AsyncLoader::GetPendingCount( void ) const
+		{
+			std::lock_guard< std::mutex > lock( m_Mutex );
+			return (unsigned int)(m_Queued.size() + m_vDecoding.size() + m_Decoded.size());
+		}
+		//*************************************************************//
+
+
+
+		//*************************************************************//
+		// WORKER PROC
+		void AsyncLoader::WorkerProc( void )
+		{
+			for( ;; )
+			{
+				Job job;
+
+				{
+					std::unique_lock< std::mutex > lock( m_Mutex );
+					m_cvQueued.wait( lock, [this]{ return m_bShutdown == true || m_Queued.empty() == false; } );
+
+					if( m_bShutdown == true )
+						return;
+
+					job = std::move( m_Queued.front() );
+					m_Queued.pop_front();
+					m_vDecoding.push_back( job.unTicket );
+				}
+
+				job.decode();
+
+				{
+					std::lock_guard< std::mutex > lock( m_Mutex );
+					m_vDecoding.erase( std::find( m_vDecoding.begin(), m_vDecoding.end(), job.unTicket ) );
+					m_Decoded.push_back( std::move( job ) );
+				}
+				m_cvDecoded.notify_all();
+			}
+		}
+		//*************************************************************//
+
+
+
+		//*************************************************************//
+		// TAKE JOB
+		/*static*/ bool AsyncLoader::TakeJob( std::deque< Job >& queue, unsigned int ticket, Job& job )
+		{
+			for( std::deque< Job >::iterator iter = queue.begin(); iter != queue.end(); ++iter )
+			{
+				if( iter->unTicket == ticket )
+				{
+					job = std::move( *iter );
+					queue.erase( iter );
+					return true;
+				}
+			}
+
+			return false;
+		}
+		//*************************************************************//
+
+	}	// namespace SGD_IMPLEMENTATION
+
+}	// namespace SGD
@@ -0,0 +1,97 @@
+/***********************************************************************\
+|																		|
+|	File:			SGD_AsyncLoader.h									|
+|																		|
+|	Purpose:		To read & decode files on worker threads and hand	|
+|					the results back to the main thread, so loading		|
+|					does not stall the frame							|
+|																		|
+\***********************************************************************/
+
+#ifndef SGD_ASYNCLOADER_H
+#define SGD_ASYNCLOADER_H
+
+
+#include <condition_variable>	// Wakes the workers with a std::condition_variable
+#include <deque>				// Queues the jobs in std::deques
+#include <functional>			// Stores the job steps in std::functions
+#include <mutex>				// Guards the queues with a std::mutex
+#include <thread>				// Runs the workers on std::threads
+#include <vector>				// Stores the workers in a std::vector
+
+
+namespace SGD
+{
+	namespace SGD_IMPLEMENTATION
+	{
+		//*************************************************************//
+		// AsyncLoader
+		//	- each job has two steps: Decode runs on a worker thread
+		//	  (file reading & parsing only, no manager or device state),
+		//	  then Finish runs on the main thread (upload & store)
+		//	- Submit returns a ticket (never 0) that identifies the job
+		//	  until its Finish has run
+		//	- Finish never runs inside Submit, so the caller can record
+		//	  the ticket before the job can complete
+		//	- with no workers, Update decodes the queued jobs itself
+		//	- only the main thread (the manager's) may call the methods
+		class AsyncLoader
+		{
+		public:
+			typedef std::function< void( void ) >	Step;
+
+
+			AsyncLoader		( void )					= default;	// Default constructor
+			~AsyncLoader	( void );								// Destructor (terminates)
+
+
+			void			Initialize		( unsigned int numWorkers = 2 );
+			void			Terminate		( void );				// discards the unfinished jobs
+
+			unsigned int	Submit			( Step decode, Step finish );
+
+			unsigned int	Update			( unsigned int maxJobs );	// finishes decoded jobs without blocking, returns how many
+			void			Complete		( unsigned int ticket );	// blocks until the job is decoded, then finishes it
+			void			CompleteAll		( void );
+
+			unsigned int	GetPendingCount	( void ) const;			// jobs submitted but not finished
+
+		private:
+			AsyncLoader					( const AsyncLoader& )	= delete;	// Copy constructor
+			AsyncLoader&	operator=	( const AsyncLoader& )	= delete;	// Assignment operator
+
+
+			// Submitted job
+			struct Job
+			{
+				unsigned int	unTicket;
+				Step			decode;
+				Step			finish;
+			};
+
+			// Worker thread procedure
+			void			WorkerProc		( void );
+
+			// Removes the job with the ticket from the queue (false if it is not there)
+			static	bool	TakeJob			( std::deque< Job >& queue, unsigned int ticket, Job& job );
+
+
+			// Data Storage:
+			std::vector< std::thread >	m_vWorkers;
+			std::deque< Job >			m_Queued;					// waiting for a worker
+			std::deque< Job >			m_Decoded;					// waiting for Finish
+			std::vector< unsigned int >	m_vDecoding;				// tickets on a worker right now
+
+			mutable std::mutex			m_Mutex;					// guards everything above but the workers
+			std::condition_variable		m_cvQueued;					// a job was queued (or shutdown)
+			std::condition_variable		m_cvDecoded;				// a job was decoded
+			bool						m_bShutdown		= false;
+
+			unsigned int				m_unNextTicket	= 1;
+		};
+
+	}	// namespace SGD_IMPLEMENTATION
+
+}	// namespace SGD
+
+#endif //SGD_ASYNCLOADER_H
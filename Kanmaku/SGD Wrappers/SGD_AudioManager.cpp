@@ -27,6 +27,10 @@
 // Uses std::multimap for storing voices
 #include <map>
 
+// Uses std::shared_ptr & std::wstring for the pending loads
+#include <memory>
+#include <string>
+
 // Uses DirectInput to solve random memory-leak detection bug?!?
 #define DIRECTINPUT_VERSION 0x0800
 #include <dinput.h>
@@ -36,28 +40,62 @@
 #include <XAudio2.h>
 #pragma comment (lib, "dxguid.lib")
 
-// Uses HandleManager for storing data
+// Uses HandleManager & ResourceCache for storing data
 #include "SGD_HandleManager.h"
+#include "SGD_ResourceCache.h"
+
+// Uses AsyncLoader for asynchronous loads
+#include "SGD_AsyncLoader.h"
 
 // Uses Alert & SGD_ASSERT for debugging
 #include "SGD_Utilities.h"
 
 
+// Asynchronous loads stored by each Update
+#define SGD_AUDIO_PER_UPDATE		4
+
+
 namespace SGD
 {
 	namespace SGD_IMPLEMENTATION
 	{
 		//*************************************************************//
 		// AudioInfo
-		//	- stores info for the audio file: name, buffer, reference count
+		//	- stores info for the audio file: buffer & volume
+		//	  (the cache stores the name & reference count)
 		struct AudioInfo
 		{
-			wchar_t*				wszFilename;		// file name
-			unsigned int			unRefCount;			// reference count
 			WAVEFORMATEXTENSIBLE	format;				// wave format (sample rate, etc)
 			XAUDIO2_BUFFER			buffer;				// buffer
 			XAUDIO2_BUFFER_WMA		bufferwma;			// additional buffer packets for xwm
 			float					fVolume;			// audio volume
+
+			unsigned int			unTicket;			// asynchronous load in progress (0 if none)
+		};
+		//*************************************************************//
+
+
+
+		//*************************************************************//
+		// PendingAudio
+		//	- an asynchronous load, shared by its two loader steps
+		//	- owns the parsed buffers until they move into the entry,
+		//	  so a discarded load frees them
+		struct PendingAudio
+		{
+			std::wstring			wsFilename;
+			unsigned int			unTicket;			// set once submitted
+
+			HRESULT					hResult;
+			WAVEFORMATEXTENSIBLE	format;
+			XAUDIO2_BUFFER			buffer;
+			XAUDIO2_BUFFER_WMA		bufferwma;
+
+			~PendingAudio( void )
+			{
+				delete[] buffer.pAudioData;
+				delete[] bufferwma.pDecodedPacketCumulativeBytes;
+			}
 		};
 		//*************************************************************//
 
@@ -83,7 +121,7 @@ namespace SGD
 		//	- only supports .wav and .xwm files
 		//	- .wav files are categorized as 'Sound Effects'
 		//	- .xwm files are categorized as 'Music'
-		//	- uses IHandleManager to store audio data
+		//	- uses ResourceCache to store audio data
 		class AudioManager : public SGD::AudioManager
 		{
 		public:
@@ -112,6 +150,11 @@ namespace SGD
 			virtual bool		IsAudioPlaying		( HAudio handle )					override;
 			virtual	bool		StopAudio			( HAudio handle )					override;
 			virtual	bool		UnloadAudio			( HAudio& handle )					override;
+
+			virtual	HAudio		LoadAudioAsync		( const wchar_t* filename )			override;
+			virtual	HAudio		LoadAudioAsync		( const char* filename )			override;
+			virtual	LoadStatus	GetAudioStatus		( HAudio handle )					override;
+			virtual	unsigned int	FinishLoads		( bool wait )						override;
 			
 			virtual bool		IsVoiceValid		( HVoice handle )					override;
 			virtual bool		IsVoicePlaying		( HVoice handle )					override;
@@ -124,6 +167,9 @@ namespace SGD
 			virtual bool		SetAudioVolume		( HAudio handle, int value )		override;
 
 
+			virtual	const CacheStats&	GetCacheStats	( void ) const		override	{	return m_Audio.GetStats();	}
+
+
 		private:
 			// SINGLETON
 			static	AudioManager*		s_Instance;		// the ONE instance
@@ -156,8 +202,9 @@ namespace SGD
 			typedef std::multimap< HAudio, HVoice >	VoiceMap;
 			VoiceMap					m_mVoices;								// source voice map
 
-			HandleManager< AudioInfo >	m_HandleManager;						// data storage
+			ResourceCache< AudioInfo >	m_Audio;								// data storage
 			HandleManager< VoiceInfo >	m_VoiceManager;							// voice storage
+			AsyncLoader					m_Loader;								// asynchronous audio loads
 
 
 			// AUDIO LOADING HELPER METHODS
@@ -165,15 +212,9 @@ namespace SGD
 			static	HRESULT		ReadChunkData	( HANDLE hFile, void* buffer, DWORD buffersize, DWORD bufferoffset );
 			static	HRESULT		LoadAudio		( const wchar_t* filename, WAVEFORMATEXTENSIBLE& wfx, XAUDIO2_BUFFER& buffer, XAUDIO2_BUFFER_WMA& bufferWMA );
 
-
-			// AUDIO REFERENCE HELPER METHOD
-			struct SearchInfo
-			{
-				const wchar_t*	filename;	// input
-				AudioInfo*		audio;		// output
-				HAudio			handle;		// output
-			};
-			static	bool	FindAudioByName( Handle handle, AudioInfo& data, SearchInfo* extra );
+			// ASYNCHRONOUS LOADING HELPER METHODS
+			void				FinishAudio		( HAudio handle, PendingAudio& pending );
+			void				WaitForAudio	( HAudio handle );
 		};
 		//*************************************************************//
 
@@ -341,6 +382,10 @@ namespace SGD
 			}
 
 
+			// Start the asynchronous loader (parsing is mostly file reads: one worker)
+			m_Loader.Initialize( 1 );
+
+
 			// Success!
 			m_eStatus = E_INITIALIZED;
 
@@ -359,6 +404,9 @@ namespace SGD
 			if( m_eStatus != E_INITIALIZED )
 				return false;
 
+			// Store a few of the files parsed asynchronously
+			m_Loader.Update( SGD_AUDIO_PER_UPDATE );
+
 			// Update the current voices
 			VoiceMap::iterator iter = m_mVoices.begin();
 			while( iter != m_mVoices.end() )
@@ -382,7 +430,7 @@ namespace SGD
 					if( info->loop == true )
 					{
 						// Get the data from the Handle Manager
-						AudioInfo* data = m_HandleManager.GetData( iter->first );
+						AudioInfo* data = m_Audio.GetData( iter->first );
 						SGD_ASSERT( data != nullptr, "AudioManager::Update - voice refers to removed audio" );
 						if( data == nullptr )
 						{
@@ -457,9 +505,13 @@ namespace SGD
 			m_mVoices.clear();
 
 
+			// Discard the unfinished loads
+			m_Loader.Terminate();
+
+
 			// Clear handles
 			m_VoiceManager.Clear();
-			m_HandleManager.Clear();
+			m_Audio.Clear();
 
 			
 			// Release submix & master voices
@@ -561,19 +613,25 @@ namespace SGD
 				return SGD::INVALID_HANDLE;
 
 
-			// Attempt to find the audio in the Handle Manager
-			SearchInfo search = { filename, nullptr, SGD::INVALID_HANDLE };
-			m_HandleManager.ForEach( &AudioManager::FindAudioByName, &search );
-
-			// If it was found, increase the reference & return the existing handle
-			if( search.audio != NULL )
+			// Attempt to find the audio in the cache
+			// (if it was found, it holds another reference)
+			HAudio existing = m_Audio.Acquire( filename );
+			if( existing != SGD::INVALID_HANDLE )
 			{
-				search.audio->unRefCount++;
-				return search.handle;
+				// Finish an asynchronous load of the file now
+				WaitForAudio( existing );
+
+				if( GetAudioStatus( existing ) == LoadStatus::Failed )
+				{
+					UnloadAudio( existing );
+					return SGD::INVALID_HANDLE;
+				}
+
+				return existing;
 			}
 
 
-			// Could not find audio in the Handle Manager
+			// Could not find audio in the cache
 			AudioInfo data = { };
 			ZeroMemory( &data.format, sizeof( data.format ) );
 			ZeroMemory( &data.buffer, sizeof( data.buffer ) );
@@ -597,13 +655,13 @@ namespace SGD
 
 
 			// Audio loaded successfully
-			data.wszFilename	= _wcsdup( filename );
-			data.unRefCount		= 1;
 			data.fVolume		= 1.0f;
 
+			m_Audio.AddBytesLoaded( data.buffer.AudioBytes + data.bufferwma.PacketCount * sizeof( UINT32 ) );
 
-			// Store audio into the Handle Manager
-			return m_HandleManager.StoreData( data );
+
+			// Store audio into the cache
+			return m_Audio.Store( filename, data );
 		}
 		//*************************************************************//
 
@@ -668,11 +726,18 @@ namespace SGD
 
 
 			// Get the audio info from the handle manager
-			AudioInfo* data = m_HandleManager.GetData( handle );
+			AudioInfo* data = m_Audio.GetData( handle );
 			SGD_ASSERT( data != nullptr, "AudioManager::PlayAudio - handle has expired" );
 			if( data == nullptr )
 				return SGD::INVALID_HANDLE;
 
+			// Finish an asynchronous load first (quietly fail if it failed)
+			if( data->unTicket != 0 )
+				WaitForAudio( handle );
+
+			if( data->buffer.pAudioData == nullptr )
+				return SGD::INVALID_HANDLE;
+
 
 			HRESULT hResult = S_OK;
 
@@ -833,40 +898,26 @@ namespace SGD
 				return false;
 
 			// Quietly ignore bad handles
-			if( m_HandleManager.IsHandleValid( handle ) == false )
+			if( m_Audio.IsHandleValid( handle ) == false )
 			{
 				handle = SGD::INVALID_HANDLE;
 				return false;
 			}
 
 
-			// Get the audio info from the handle manager
-			AudioInfo* data = m_HandleManager.GetData( handle );
-			if( data == nullptr )
-				return false;
-
-
-			// Release a reference
-			data->unRefCount--;
-
 			// Is this the last reference?
-			if( data->unRefCount == 0 )
-			{
-				// Stop the audio
+			// (stop the audio while the handle is still valid)
+			if( m_Audio.GetRefCount( handle ) == 1 )
 				StopAudio( handle );
 
 
+			// Release a reference: was it the last one?
+			AudioInfo data = { };
+			if( m_Audio.Release( handle, &data ) == true )
+			{
 				// Deallocate the audio buffers
-				delete[] data->buffer.pAudioData;
-				delete[] data->bufferwma.pDecodedPacketCumulativeBytes;
-
-				// Deallocate the name
-				delete[] data->wszFilename;
-
-
-				// Remove the audio info from the handle manager
-				m_HandleManager.RemoveData( handle, nullptr );
-				data = nullptr;
+				delete[] data.buffer.pAudioData;
+				delete[] data.bufferwma.pDecodedPacketCumulativeBytes;
 			}
 
 
@@ -878,6 +929,200 @@ namespace SGD
 
 
 		
+		//*************************************************************//
+		// LOAD AUDIO ASYNC
+		HAudio AudioManager::LoadAudioAsync( const wchar_t* filename )
+		{
+			// Sanity-check the wrapper's status
+			SGD_ASSERT( m_eStatus == E_INITIALIZED, "AudioManager::LoadAudioAsync - wrapper has not been initialized" );
+			if( m_eStatus != E_INITIALIZED )
+				return SGD::INVALID_HANDLE;
+
+			SGD_ASSERT( filename != nullptr && filename[0] != L'\0', "AudioManager::LoadAudioAsync - invalid filename" );
+			if( filename == nullptr || filename[0] == L'\0' )
+				return SGD::INVALID_HANDLE;
+
+
+			// Attempt to find the audio in the cache (loaded or still loading)
+			HAudio existing = m_Audio.Acquire( filename );
+			if( existing != SGD::INVALID_HANDLE )
+				return existing;
+
+
+			// Store the entry now: it has no buffers until the load finishes
+			AudioInfo data = { };
+			ZeroMemory( &data.format, sizeof( data.format ) );
+			ZeroMemory( &data.buffer, sizeof( data.buffer ) );
+			ZeroMemory( &data.bufferwma, sizeof( data.bufferwma ) );
+			data.fVolume		= 1.0f;
+
+			HAudio handle = m_Audio.Store( filename, data );
+
+
+			// Parse the file on a worker, store the buffers in Update
+			std::shared_ptr< PendingAudio > pending = std::make_shared< PendingAudio >();
+			pending->wsFilename	= filename;
+			ZeroMemory( &pending->format, sizeof( pending->format ) );
+			ZeroMemory( &pending->buffer, sizeof( pending->buffer ) );
+			ZeroMemory( &pending->bufferwma, sizeof( pending->bufferwma ) );
+
+			pending->unTicket = m_Loader.Submit(
+				[ pending ]()
+				{
+					pending->hResult = LoadAudio( pending->wsFilename.c_str(), pending->format, pending->buffer, pending->bufferwma );
+				},
+				[ this, handle, pending ]()		{	FinishAudio( handle, *pending );	} );
+
+			m_Audio.GetData( handle )->unTicket = pending->unTicket;
+			return handle;
+		}
+		//*************************************************************//
+
+
+
+		//*************************************************************//
+		// LOAD AUDIO ASYNC
+		HAudio AudioManager::LoadAudioAsync( const char* filename )
+		{
+			// Sanity-check the wrapper's status
+			SGD_ASSERT( m_eStatus == E_INITIALIZED, "AudioManager::LoadAudioAsync - wrapper has not been initialized" );
+			if( m_eStatus != E_INITIALIZED )
+				return SGD::INVALID_HANDLE;
+
+			SGD_ASSERT( filename != nullptr && filename[0] != '\0', "AudioManager::LoadAudioAsync - invalid filename" );
+			if( filename == nullptr || filename[0] == '\0' )
+				return SGD::INVALID_HANDLE;
+
+
+			// Convert the filename to UTF16
+			wchar_t widename[ MAX_PATH * 4 ];
+			int ret = MultiByteToWideChar( CP_UTF8, 0, filename, -1, widename, MAX_PATH * 4 );
+
+			if( ret == 0 )
+			{
+				// MESSAGE
+				char szBuffer[ 256 ];
+				_snprintf_s( szBuffer, 256, _TRUNCATE, "!!! AudioManager::LoadAudioAsync - invalid filename \"%hs\" (0x%X) !!!", filename, GetLastError() );
+				Alert( szBuffer );
+				//OutputDebugStringA( szBuffer );
+				//OutputDebugStringA( "\n" );
+
+				return SGD::INVALID_HANDLE;
+			}
+
+
+			// Use the UTF16 load
+			return LoadAudioAsync( widename );
+		}
+		//*************************************************************//
+
+
+
+		//*************************************************************//
+		// GET AUDIO STATUS
+		LoadStatus AudioManager::GetAudioStatus( HAudio handle )
+		{
+			// Sanity-check the wrapper's status
+			SGD_ASSERT( m_eStatus == E_INITIALIZED, "AudioManager::GetAudioStatus - wrapper has not been initialized" );
+			if( m_eStatus != E_INITIALIZED )
+				return LoadStatus::Failed;
+
+			// Quietly report bad handles
+			if( handle == SGD::INVALID_HANDLE || m_Audio.IsHandleValid( handle ) == false )
+				return LoadStatus::Failed;
+
+
+			const AudioInfo* data = m_Audio.GetData( handle );
+			if( data->unTicket != 0 )
+				return LoadStatus::Pending;
+
+			return (data->buffer.pAudioData != nullptr) ? LoadStatus::Loaded : LoadStatus::Failed;
+		}
+		//*************************************************************//
+
+
+
+		//*************************************************************//
+		// FINISH LOADS
+		unsigned int AudioManager::FinishLoads( bool wait )
+		{
+			// Sanity-check the wrapper's status
+			SGD_ASSERT( m_eStatus == E_INITIALIZED, "AudioManager::FinishLoads - wrapper has not been initialized" );
+			if( m_eStatus != E_INITIALIZED )
+				return 0;
+
+
+			if( wait == true )
+				m_Loader.CompleteAll();
+			else
+				m_Loader.Update( 0xFFFFFFFF );
+
+			return m_Loader.GetPendingCount();
+		}
+		//*************************************************************//
+
+
+
+		//*************************************************************//
+		// FINISH AUDIO
+		//	- runs on the main thread: hands the parsed buffers to the
+		//	  entry, unless the handle was unloaded in the meantime
+		//	  (the pending load then frees them)
+		void AudioManager::FinishAudio( HAudio handle, PendingAudio& pending )
+		{
+			// Was the audio unloaded while it was loading?
+			if( m_Audio.IsHandleValid( handle ) == false )
+				return;
+
+			AudioInfo* data = m_Audio.GetData( handle );
+			if( data->unTicket != pending.unTicket )
+				return;
+
+			data->unTicket = 0;
+
+
+			if( FAILED( pending.hResult ) )
+			{
+				// The entry stays without buffers (LoadStatus::Failed)
+
+				// MESSAGE
+				wchar_t wszBuffer[ 256 ];
+				_snwprintf_s( wszBuffer, 256, _TRUNCATE, L"!!! AudioManager::LoadAudioAsync - failed to load audio file \"%ws\" (0x%X) !!!", pending.wsFilename.c_str(), pending.hResult );
+				Alert( wszBuffer );
+				//OutputDebugStringW( wszBuffer );
+				//OutputDebugStringA( "\n" );
+
+				return;
+			}
+
+
+			// Move the buffers into the entry
+			data->format	= pending.format;
+			data->buffer	= pending.buffer;
+			data->bufferwma	= pending.bufferwma;
+
+			pending.buffer.pAudioData						= nullptr;
+			pending.bufferwma.pDecodedPacketCumulativeBytes	= nullptr;
+
+			m_Audio.AddBytesLoaded( data->buffer.AudioBytes + data->bufferwma.PacketCount * sizeof( UINT32 ) );
+		}
+		//*************************************************************//
+
+
+
+		//*************************************************************//
+		// WAIT FOR AUDIO
+		//	- finish the asynchronous load of the audio on this thread
+		void AudioManager::WaitForAudio( HAudio handle )
+		{
+			const AudioInfo* data = m_Audio.GetData( handle );
+			if( data != nullptr && data->unTicket != 0 )
+				m_Loader.Complete( data->unTicket );
+		}
+		//*************************************************************//
+
+
+
 		//*************************************************************//
 		// IS VOICE VALID
 		bool AudioManager::IsVoiceValid( HVoice handle )
@@ -1130,7 +1375,7 @@ namespace SGD
 
 
 			// Get the audio info from the handle manager
-			AudioInfo* data = m_HandleManager.GetData( handle );
+			AudioInfo* data = m_Audio.GetData( handle );
 			SGD_ASSERT( data != nullptr, "AudioManager::GetAudioVolume - handle has expired" );
 			if( data == nullptr )
 				return 0;
@@ -1158,7 +1403,7 @@ namespace SGD
 
 
 			// Get the audio info from the handle manager
-			AudioInfo* data = m_HandleManager.GetData( handle );
+			AudioInfo* data = m_Audio.GetData( handle );
 			SGD_ASSERT( data != nullptr, "AudioManager::SetAudioVolume - handle has expired" );
 			if( data == nullptr )
 				return false;
@@ -1298,7 +1543,11 @@ namespace SGD
 				return HRESULT_FROM_WIN32( GetLastError() );
 
 			if( SetFilePointer( hFile, 0, NULL, FILE_BEGIN ) == INVALID_SET_FILE_POINTER )
-				return HRESULT_FROM_WIN32( GetLastError() );
+			{
+				HRESULT hResult = HRESULT_FROM_WIN32( GetLastError() );
+				CloseHandle( hFile );
+				return hResult;
+			}
 
 
 			// Check the file type, should be 'WAVE' or 'XWMA'
@@ -1342,34 +1591,16 @@ namespace SGD
 					bufferWMA.pDecodedPacketCumulativeBytes = pWmaDataBuffer;	// buffer containing wma data
 				}
 
+				CloseHandle( hFile );
 				return S_OK;
 			}
 			else
 			{
+				CloseHandle( hFile );
 				return E_UNEXPECTED;
 			}
 		}
 		//*************************************************************//
-
-
-
-		//*************************************************************//
-		// FIND AUDIO BY NAME
-		/*static*/ bool AudioManager::FindAudioByName( Handle handle, AudioInfo& data, SearchInfo* extra )
-		{		
-			// Compare the names
-			if( wcscmp( data.wszFilename, extra->filename ) == 0 )
-			{
-				// Audio does exist!
-				extra->audio	= &data;
-				extra->handle	= handle;
-				return false;
-			}
-
-			// Did not find yet
-			return true;
-		}
-		//*************************************************************//
 		
 
 	}	// namespace SGD_IMPLEMENTATION
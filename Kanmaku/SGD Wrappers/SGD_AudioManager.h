@@ -61,6 +61,17 @@ namespace SGD
 		virtual	bool		StopAudio			( HAudio handle )							= 0;
 		virtual	bool		UnloadAudio			( HAudio& handle )							= 0;
 
+		// Asynchronous loading
+		//	- LoadAudioAsync returns a handle at once and parses the file on
+		//	  a worker thread; Update stores the parsed files
+		//	- PlayAudio of a file that is still loading waits for it
+		//	- FinishLoads stores the parsed files now (wait: until every
+		//	  load is done) & returns how many loads are still pending
+		virtual	HAudio		LoadAudioAsync		( const wchar_t* filename )					= 0;
+		virtual	HAudio		LoadAudioAsync		( const char* filename )					= 0;
+		virtual	LoadStatus	GetAudioStatus		( HAudio handle )							= 0;
+		virtual	unsigned int	FinishLoads		( bool wait = false )						= 0;
+
 		virtual bool		IsVoiceValid		( HVoice handle )							= 0;
 		virtual bool		IsVoicePlaying		( HVoice handle )							= 0;
 		virtual bool		PauseVoice			( HVoice handle, bool pause = true )		= 0;
@@ -70,6 +81,9 @@ namespace SGD
 		virtual bool		SetVoiceVolume		( HVoice handle, int value = 100 )			= 0;
 		virtual int			GetAudioVolume		( HAudio handle )							= 0;
 		virtual bool		SetAudioVolume		( HAudio handle, int value = 100 )			= 0;
+
+
+		virtual	const CacheStats&	GetCacheStats	( void ) const		= 0;	// LoadAudio hits & misses by file name
 		
 
 	protected:
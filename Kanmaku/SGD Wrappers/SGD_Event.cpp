@@ -19,6 +19,12 @@
 // Uses strcmp for comparisons
 #include <cstring>
 
+// Uses std::vector for storing the interned IDs
+#include <vector>
+
+// Uses SpinLock for sharing the interned IDs between threads
+#include "SGD_SpinLock.h"
+
 // Uses Event Manager
 #include "SGD_EventManager.h"
 
@@ -29,6 +35,159 @@
 namespace SGD
 {
 
+#pragma region EVENTID_TABLE
+
+	namespace SGD_IMPLEMENTATION
+	{
+		//*************************************************************//
+		// EventIDTable
+		//	- interns the 32 character ID strings: the first string
+		//	  gets key 0 (the empty ID), each new one the next key
+		//	- flat hash table (open addressing, linear probing) of keys,
+		//	  with the strings stored once in key order
+		//	- worker threads may create events too: a spin lock
+		//	  guards Intern
+		class EventIDTable
+		{
+		public:
+			enum { SIZE = 32 };		// characters per ID (as EventID)
+
+			EventIDTable			( void );
+
+			unsigned int	Intern	( const char* id );		// SIZE null-padded characters
+
+		private:
+			EventIDTable			( const EventIDTable& )	= delete;
+			EventIDTable& operator=	( const EventIDTable& )	= delete;
+
+			struct Slot
+			{
+				unsigned int	unHash;
+				unsigned int	unKey;		// EMPTY_SLOT if unused
+			};
+
+			struct Name
+			{
+				char			id[ SIZE ];
+			};
+
+			enum { EMPTY_SLOT = 0xFFFFFFFF };
+
+			static unsigned int	Hash	( const char* id );
+			void				Grow	( void );
+
+			SpinLock				m_Lock;
+			std::vector< Slot >		m_vSlots;		// power-of-2 size, at most half full
+			std::vector< Name >		m_vNames;		// indexed by key
+		};
+
+
+		// Table accessor
+		//	- constructed on first use, which is on the main thread:
+		//	  a static EventID or InitializeEventIDs
+		static EventIDTable& GetEventIDTable( void )
+		{
+			static EventIDTable s_Table;
+			return s_Table;
+		}
+
+		// Table builder
+		void InitializeEventIDs( void )
+		{
+			GetEventIDTable();
+		}
+
+
+		// Constructor
+		//	- the empty ID is key 0 (as the EventID default constructor)
+		EventIDTable::EventIDTable( void )
+		{
+			m_vSlots.resize( 64, Slot{ 0, EMPTY_SLOT } );
+
+			char empty[ SIZE ] = { };
+			Intern( empty );
+		}
+
+		// Intern
+		//	- return the string's key, adding it if it is new
+		unsigned int EventIDTable::Intern( const char* id )
+		{
+			std::lock_guard< SpinLock > lock( m_Lock );
+
+			unsigned int hash = Hash( id );
+			unsigned int mask = (unsigned int)m_vSlots.size() - 1;
+
+			// Probe for the string (or the empty slot ending its run)
+			unsigned int slot = hash & mask;
+			while( m_vSlots[ slot ].unKey != EMPTY_SLOT )
+			{
+				const Slot& probe = m_vSlots[ slot ];
+				if( probe.unHash == hash && memcmp( m_vNames[ probe.unKey ].id, id, SIZE ) == 0 )
+					return probe.unKey;
+
+				slot = (slot + 1) & mask;
+			}
+
+
+			// Add the new string
+			unsigned int key = (unsigned int)m_vNames.size();
+
+			Name name;
+			memcpy( name.id, id, SIZE );
+			m_vNames.push_back( name );
+
+			m_vSlots[ slot ].unHash	= hash;
+			m_vSlots[ slot ].unKey	= key;
+
+			// Keep the table at most half full
+			if( m_vNames.size() * 2 > m_vSlots.size() )
+				Grow();
+
+			return key;
+		}
+
+		// Hash
+		//	- FNV-1a of the characters before the terminator
+		/*static*/ unsigned int EventIDTable::Hash( const char* id )
+		{
+			unsigned int hash = 2166136261u;
+			for( int i = 0; i < SIZE && id[ i ] != '\0'; i++ )
+			{
+				hash ^= (unsigned char)id[ i ];
+				hash *= 16777619u;
+			}
+
+			return hash;
+		}
+
+		// Grow
+		//	- double the slots & reinsert every key
+		void EventIDTable::Grow( void )
+		{
+			std::vector< Slot > slots( m_vSlots.size() * 2, Slot{ 0, EMPTY_SLOT } );
+			unsigned int mask = (unsigned int)slots.size() - 1;
+
+			for( unsigned int i = 0; i < m_vSlots.size(); i++ )
+			{
+				if( m_vSlots[ i ].unKey == EMPTY_SLOT )
+					continue;
+
+				unsigned int slot = m_vSlots[ i ].unHash & mask;
+				while( slots[ slot ].unKey != EMPTY_SLOT )
+					slot = (slot + 1) & mask;
+
+				slots[ slot ] = m_vSlots[ i ];
+			}
+
+			m_vSlots.swap( slots );
+		}
+		//*************************************************************//
+
+	}	// namespace SGD_IMPLEMENTATION
+
+#pragma endregion EVENTID_TABLE
+
+
 #pragma region EVENTID_METHODS
 	
 	//*****************************************************************//
@@ -37,27 +196,32 @@ namespace SGD
 	// Default constructor
 	EventID::EventID( const char* str )
 	{
-		// Copy the parameter
-		memcpy( id, str, SIZE );
-
-		// Pad the remaining string with null terminators (for quick mem compare)
+		// Copy the parameter (without reading past its terminator)
 		int eos = 0;
-		while( eos < SIZE && id[ eos ] != '\0' )
+		while( eos < SIZE && str[ eos ] != '\0' )
+		{
+			id[ eos ] = str[ eos ];
 			eos++;
+		}
+
+		// Pad the remaining string with null terminators (for quick mem compare)
 		while( eos < SIZE )
 			id[ eos++ ] = '\0';
+
+		// Intern the padded string
+		key = SGD_IMPLEMENTATION::GetEventIDTable().Intern( id );
 	}
 
 	// Is-equal-to
 	bool EventID::operator == ( const EventID& other ) const
 	{
-		return memcmp( id, other.id, SIZE ) == 0;
+		return key == other.key;
 	}
 	
 	// Not-equal-to
 	bool EventID::operator != ( const EventID& other ) const
 	{
-		return memcmp( id, other.id, SIZE ) != 0;
+		return key != other.key;
 	}
 
 	// Less-than
@@ -21,19 +21,24 @@ namespace SGD
 {
 	//*****************************************************************//
 	// EventID
-	//	- 32 character string (optimized for comparisons)
+	//	- 32 character string, interned to a small integer key when
+	//	  constructed: equal IDs have equal keys, so comparisons are
+	//	  integer compares
+	//	- keys are dense (0 is the empty ID), so the EventManager
+	//	  indexes its listener arrays with them
 	class EventID
 	{
 	public:
 		EventID( void )										// default constructor
-			{	id[ 0 ] = 0;	}
+			{	id[ 0 ] = 0;	key = 0;	}
 		EventID( const char* str );							// overloaded constructor
 
-		char&		operator [] ( unsigned int i )			// array accessor
-			{	return id[ i ];	}
 		const char& operator [] ( unsigned int i ) const	// const array accessor
 			{	return id[ i ];	}
 
+		unsigned int GetKey( void ) const					// interned key
+			{	return key;		}
+
 		bool operator == ( const EventID& other ) const;	// is-equal-to
 		bool operator != ( const EventID& other ) const;	// not-equal-to
 		bool operator <  ( const EventID& other ) const;	// less-than
@@ -47,6 +52,7 @@ namespace SGD
 	private:
 		enum { SIZE = 32 };	// compile-time constant
 		char id[ SIZE ];	// event ID (limited to 32 characters!)
+		unsigned int key;	// interned key (the same for every equal string)
 	};
 
 
@@ -88,6 +94,19 @@ namespace SGD
 		void*			m_pSender;				// object that sent the event
 	};
 
+
+	namespace SGD_IMPLEMENTATION
+	{
+		//*************************************************************//
+		// InitializeEventIDs
+		//	- builds the table that interns the EventIDs
+		//	- EventManager::Initialize calls it on the main thread, so a
+		//	  worker thread never constructs the table (the VS2013 toolset
+		//	  does not guard the construction of function-local statics)
+		void	InitializeEventIDs	( void );
+
+	}	// namespace SGD_IMPLEMENTATION
+
 }	// namespace SGD
 
 #endif	//SGD_EVENT_H
@@ -16,18 +16,18 @@
 #include "SGD_EventManager.h"
 
 
-// Uses std::string for mapping event IDs
-#include <string>
+// Uses MPSCQueue for storing events from any thread
+#include "SGD_MPSCQueue.h"
 
-// Uses std::queue for storing events
-#include <queue>
+// Uses std::atomic for the status read by any thread
+#include <atomic>
 
-// Uses std::multimap for storing listeners
-#include <map>
-
-// Uses std::vector for storing current event listeners
+// Uses std::vector for storing the listener arrays
 #include <vector>
 
+// Uses std::remove_if for removing unregistered listeners
+#include <algorithm>
+
 // Uses Event & Listener
 #include "SGD_Event.h"
 #include "SGD_IListener.h"
@@ -68,7 +68,7 @@ namespace SGD
 			// SINGLETON
 			static	EventManager*		s_Instance;		// the ONE instance
 
-			EventManager				( void )				= default;		// Default constructor
+			EventManager				( void )				: m_eStatus( E_UNINITIALIZED )	{	}		// Default constructor
 			virtual	~EventManager		( void )				= default;		// Destructor
 
 			EventManager				( const EventManager& )	= delete;		// Copy constructor
@@ -83,20 +83,38 @@ namespace SGD
 				E_DESTROYED
 			};
 
-			EEventManagerStatus			m_eStatus	= E_UNINITIALIZED;		// wrapper initialization status
+			std::atomic< EEventManagerStatus >	m_eStatus;		// wrapper initialization status (read by any thread)
 			
 			typedef	std::pair< const Event*, const void* >	EventDestinationPair;
-			typedef std::queue< EventDestinationPair >		EventQueue;
-			EventQueue					m_qEvents;							// event queue
+			typedef MPSCQueue< EventDestinationPair >		EventQueue;
+			EventQueue					m_qEvents;							// event queue (any thread may queue)
+
+			// Listener registration
+			//	- the object address (dynamic_cast< const void* >) is cached
+			//	  by the first targeted event, once the object is constructed
+			struct Registration
+			{
+				IListener*				pListener;						// nullptr once unregistered (tombstone)
+				const void*				pObject;						// most-derived address, or nullptr
+			};
+
+			// Listeners of one event ID (in registration order)
+			struct ListenerArray
+			{
+				std::vector< Registration >	vListeners;
+				unsigned int				unTombstones	= 0;
+			};
+
+			typedef std::vector< ListenerArray >			ListenerTable;
+			ListenerTable				m_vListeners;						// indexed by the EventID key
+			unsigned int				m_unTombstones	= 0;				// listeners unregistered during dispatch
+			unsigned int				m_unDispatching	= 0;				// depth of nested Dispatch calls
 
-			typedef std::multimap< EventID, IListener* >	ListenerMap;
-			typedef ListenerMap::const_iterator				LMapIter;
-			typedef ListenerMap::value_type					LMapValue;
-			typedef std::pair< LMapIter, LMapIter >			LMapRange;
-			typedef std::vector< IListener* >				ListenerVector;
-			ListenerMap					m_mListeners;						// registered listeners
-			ListenerMap					m_mUnlisteners;						// unregistered listeners
 
+			// Helper Methods
+			void				Dispatch			( const Event* pEvent, const void* destination );
+			void				RemoveListener		( ListenerArray& listeners, IListener* listener );
+			void				RemoveTombstones	( void );
 		};
 		//*************************************************************//
 
@@ -161,6 +179,10 @@ namespace SGD
 			if( m_eStatus == E_INITIALIZED )
 				return false;
 
+
+			// Build the EventID table on this (main) thread
+			InitializeEventIDs();
+
 			
 			// Success!
 			m_eStatus = E_INITIALIZED;
@@ -181,76 +203,16 @@ namespace SGD
 
 
 			// Iterate through the entire queue
-			while( m_qEvents.empty() == false )
+			// (each thread's events arrive in the order it queued them)
+			m_qEvents.Drain( [ this ]( const EventDestinationPair& eventPair )
 			{
-				// Dequeue the first event
-				EventDestinationPair eventPair = m_qEvents.front();
-				m_qEvents.pop();
-
-				
-				// Hold a local ref to the ID (for readability)
-				const EventID& id = eventPair.first->GetEventID();
-
-
-				// Send the event to all registered listeners for processing
-				LMapRange range = m_mListeners.equal_range( id );
-				if( range.first != range.second )
-				{
-					// Copy the intended listeners
-					ListenerVector vec;
-
-					// All listeners?
-					if( eventPair.second == nullptr )
-					{
-						for( LMapIter iter = range.first; iter != range.second; ++iter )
-							vec.push_back( iter->second );
-					}
-					else 
-					{
-						// One intended listener (which may not exist)
-						for( LMapIter iter = range.first; iter != range.second; ++iter )
-						{
-							if( dynamic_cast< const void* >( iter->second ) == eventPair.second )
-							{
-								vec.push_back( iter->second );
-								break;
-							}
-						}
-					}
-
-					// Send the event to the current listeners
-					for( unsigned int i = 0; i < vec.size(); i++ )
-					{
-						// Has a listener been removed from this event?
-						if( m_mUnlisteners.empty() == false )
-						{
-							LMapRange removed = m_mUnlisteners.equal_range( id );
-							if( removed.first != removed.second )
-							{
-								// Is this listener marked for removal from this event?
-								LMapIter iter = std::find( removed.first, removed.second, LMapValue( id, vec[i] ) );
-								if( iter != removed.second )
-								{
-									m_mUnlisteners.erase( iter );
-
-									// Skip over the HandleEvent
-									continue;
-								}
-							}
-						}
-
-						// Send event
-						vec[ i ]->HandleEvent( eventPair.first );
-					}
-				}
+				// Send the event to the registered listeners for processing
+				Dispatch( eventPair.first, eventPair.second );
 				
 				// Deallocate the event
 				delete eventPair.first;
-			}
+			} );
 
-
-			// Unregistered listeners have all been processed
-			m_mUnlisteners.clear();
 			return true;
 		}
 		//*************************************************************//
@@ -268,15 +230,15 @@ namespace SGD
 
 			
 			// Deallocate all events in the queue
-			while( m_qEvents.empty() == false )
+			m_qEvents.Drain( []( const EventDestinationPair& eventPair )
 			{
-				delete m_qEvents.front().first;
-				m_qEvents.pop();
-			}
+				delete eventPair.first;
+			} );
 
 			// Remove the registered listeners
-			m_mListeners.clear();
-			m_mUnlisteners.clear();
+			m_vListeners.clear();
+			m_unTombstones	= 0;
+			m_unDispatching	= 0;
 
 
 			m_eStatus = E_DESTROYED;
@@ -306,18 +268,23 @@ namespace SGD
 
 
 			// Convert the C-style string parameter to an EventID
+			// (interning it: the key indexes the listener arrays)
 			EventID id = eventID;
 
+			if( id.GetKey() >= m_vListeners.size() )
+				m_vListeners.resize( id.GetKey() + 1 );
+
+			std::vector< Registration >& listeners = m_vListeners[ id.GetKey() ].vListeners;
+
 
 			// Check if the listener is NOT already registered
-			LMapRange range = m_mListeners.equal_range( id );
-			for( LMapIter iter = range.first; iter != range.second; ++iter )
-				if( iter->second == listener )
+			for( unsigned int i = 0; i < listeners.size(); i++ )
+				if( listeners[ i ].pListener == listener )
 					return true;		// already registered!
 
 
 			// Register the new listener
-			m_mListeners.insert( LMapValue( id, listener ) );
+			listeners.push_back( Registration{ listener, nullptr } );
 			return true;
 		}
 		//*************************************************************//
@@ -343,38 +310,15 @@ namespace SGD
 			if( eventID == nullptr )
 			{
 				// Unregister from all events
-				LMapIter iter = m_mListeners.begin(); 
-				while( iter != m_mListeners.end() )
-				{
-					if( iter->second == listener )
-					{
-						m_mUnlisteners.insert( *iter );
-						iter = m_mListeners.erase( iter );
-						continue;	// may be listening to another event
-					}
-					
-					++iter;
-				}
+				for( unsigned int i = 0; i < m_vListeners.size(); i++ )
+					RemoveListener( m_vListeners[ i ], listener );
 			}
 			else 
 			{
-				// Find all registered listeners for the event
-				EventID id = eventID;
-				LMapRange range = m_mListeners.equal_range( id );
-				
 				// Unregister from the event
-				LMapIter iter = range.first; 
-				while( iter != range.second )
-				{
-					if( iter->second == listener )
-					{
-						m_mUnlisteners.insert( *iter );
-						iter = m_mListeners.erase( iter );
-						break;		// cannot be listening to the same event again
-					}
-					
-					++iter;
-				}
+				EventID id = eventID;
+				if( id.GetKey() < m_vListeners.size() )
+					RemoveListener( m_vListeners[ id.GetKey() ], listener );
 			}
 
 			return true;
@@ -398,8 +342,8 @@ namespace SGD
 				return false;
 
 			
-			// Queue the event
-			m_qEvents.push( EventDestinationPair{ pEvent, destination } );
+			// Queue the event (from any thread)
+			m_qEvents.Push( EventDestinationPair{ pEvent, destination } );
 			
 			return true;
 		}
@@ -421,86 +365,135 @@ namespace SGD
 			if( pEvent == nullptr )
 				return false;
 
-				
-			// Hold a local ref (for readability)
-			const EventID& id = pEvent->GetEventID();
-
 
-			// Send the event to all registered listeners to process
+			// Send the event to the registered listeners to process
 			// (does not deallocate the event)
-			LMapRange range = m_mListeners.equal_range( id );
-			if( range.first != range.second )
+			Dispatch( pEvent, destination );
+
+			return true;
+		}
+		//*************************************************************//
+
+
+
+		//*************************************************************//
+		// CLEAR EVENTS
+		bool EventManager::ClearEvents( void )
+		{
+			// Sanity-check the wrapper's status
+			SGD_ASSERT( m_eStatus == E_INITIALIZED, "EventManager::ClearEvents - wrapper has not been initialized" );
+			if( m_eStatus != E_INITIALIZED )
+				return false;
+
+			
+			// Deallocate all messages in the queue
+			m_qEvents.Drain( []( const EventDestinationPair& eventPair )
+			{
+				delete eventPair.first;
+			} );
+
+			return true;
+		}
+		//*************************************************************//
+
+
+
+		//*************************************************************//
+		// DISPATCH
+		//	- send the event to its listeners (or only to the destination)
+		//	- listeners registered while dispatching wait for the next
+		//	  event; unregistered ones are skipped (tombstones) until the
+		//	  outermost Dispatch removes them
+		void EventManager::Dispatch( const Event* pEvent, const void* destination )
+		{
+			unsigned int key = pEvent->GetEventID().GetKey();
+			if( key >= m_vListeners.size() )
+				return;		// no listener ever registered
+
+			unsigned int count = (unsigned int)m_vListeners[ key ].vListeners.size();
+			++m_unDispatching;
+
+			for( unsigned int i = 0; i < count; i++ )
 			{
-				// Copy the intended listeners
-				ListenerVector vec;
+				// (HandleEvent may register listeners: re-index every time)
+				Registration& registration = m_vListeners[ key ].vListeners[ i ];
+				if( registration.pListener == nullptr )
+					continue;	// unregistered
 
 				// All listeners?
 				if( destination == nullptr )
 				{
-					for( LMapIter iter = range.first; iter != range.second; ++iter )
-						vec.push_back( iter->second );
-				}
-				else 
-				{
-					// One intended listener (which may not exist)
-					for( LMapIter iter = range.first; iter != range.second; ++iter )
-					{
-						if( dynamic_cast< const void* >( iter->second ) == destination )
-						{
-							vec.push_back( iter->second );
-							break;
-						}
-					}
+					registration.pListener->HandleEvent( pEvent );
+					continue;
 				}
 
+				// One intended listener (which may not exist)
+				if( registration.pObject == nullptr )
+					registration.pObject = dynamic_cast< const void* >( registration.pListener );
 
-				// Send the event to the current listeners
-				for( unsigned int i = 0; i < vec.size(); i++ )
+				if( registration.pObject == destination )
 				{
-					// Has this listener been removed from the event?
-					if( m_mUnlisteners.empty() == false )
-					{
-						LMapRange removed = m_mUnlisteners.equal_range( id );
-						if( removed.first != removed.second )
-						{
-							LMapIter iter = std::find( removed.first, removed.second, LMapValue( id, vec[i] ) );
-							if( iter != removed.second )
-								continue;
-						}
-					}
-
-					// Send event
-					vec[ i ]->HandleEvent( pEvent );
+					registration.pListener->HandleEvent( pEvent );
+					break;
 				}
 			}
 
-			return true;
+			--m_unDispatching;
+			if( m_unDispatching == 0 && m_unTombstones > 0 )
+				RemoveTombstones();
 		}
 		//*************************************************************//
 
 
 
 		//*************************************************************//
-		// CLEAR EVENTS
-		bool EventManager::ClearEvents( void )
+		// REMOVE LISTENER
+		//	- erase the registration, or mark it while dispatching
+		void EventManager::RemoveListener( ListenerArray& listeners, IListener* listener )
 		{
-			// Sanity-check the wrapper's status
-			SGD_ASSERT( m_eStatus == E_INITIALIZED, "EventManager::ClearEvents - wrapper has not been initialized" );
-			if( m_eStatus != E_INITIALIZED )
-				return false;
+			std::vector< Registration >& registrations = listeners.vListeners;
 
-			
-			// Deallocate all messages in the queue
-			while( m_qEvents.empty() == false )
+			for( unsigned int i = 0; i < registrations.size(); i++ )
 			{
-				delete m_qEvents.front().first;
-				m_qEvents.pop();
+				if( registrations[ i ].pListener != listener )
+					continue;
+
+				if( m_unDispatching > 0 )
+				{
+					registrations[ i ].pListener = nullptr;
+					listeners.unTombstones++;
+					m_unTombstones++;
+				}
+				else
+					registrations.erase( registrations.begin() + i );
+
+				break;		// cannot be listening to the same event again
 			}
+		}
+		//*************************************************************//
 
 
-			// Unregistered listeners have been effectively been processed
-			m_mUnlisteners.clear();
-			return true;
+
+		//*************************************************************//
+		// REMOVE TOMBSTONES
+		//	- compact the arrays marked while dispatching
+		void EventManager::RemoveTombstones( void )
+		{
+			for( unsigned int i = 0; i < m_vListeners.size(); i++ )
+			{
+				ListenerArray& listeners = m_vListeners[ i ];
+				if( listeners.unTombstones == 0 )
+					continue;
+
+				listeners.vListeners.erase(
+					std::remove_if( listeners.vListeners.begin(), listeners.vListeners.end(),
+						[]( const Registration& r ) { return r.pListener == nullptr; } ),
+					listeners.vListeners.end() );
+
+				listeners.unTombstones = 0;
+			}
+
+			m_unTombstones = 0;
 		}
 		//*************************************************************//
 		
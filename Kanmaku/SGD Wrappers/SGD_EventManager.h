@@ -27,6 +27,8 @@ namespace SGD
 	//*****************************************************************//
 	// EventManager
 	//	- SINGLETON class for queuing events sent to registered Listeners
+	//	- any thread may queue; every other method belongs to the thread
+	//	  that calls Update (each thread's queue order is kept)
 	class EventManager
 	{
 	public:
@@ -41,7 +43,7 @@ namespace SGD
 		virtual bool		RegisterForEvent	( IListener* listener, const char* eventID )				= 0;
 		virtual bool		UnregisterFromEvent	( IListener* listener, const char* eventID = nullptr )		= 0;
 
-		virtual bool		QueueEvent			( const Event* pEvent, const void* destination = nullptr )	= 0;
+		virtual bool		QueueEvent			( const Event* pEvent, const void* destination = nullptr )	= 0;	// any thread (Initialize first)
 		virtual bool		SendEventNow		( const Event* pEvent, const void* destination = nullptr )	= 0;
 
 		virtual bool		ClearEvents			( void )					= 0;
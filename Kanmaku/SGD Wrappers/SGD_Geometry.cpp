@@ -541,7 +541,11 @@ namespace SGD
 		float dot = ( (this->x * other.x) + (this->y * other.y) );
 
 		float angle = acosf( dot / sqrtf( lenSq ) );
+#if defined( _WIN32 )
 		if( _isnan( angle ) != 0 )
+#else
+		if( std::isnan( angle ) == true )
+#endif
 			return 0.0f;
 
 		return angle;
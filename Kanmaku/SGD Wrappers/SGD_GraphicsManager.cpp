@@ -16,6 +16,10 @@
 #include "SGD_GraphicsManager.h"
 
 
+// The headless backend (SGD_HeadlessGraphicsManager.cpp) replaces this one
+#ifndef SGD_HEADLESS_GRAPHICS
+
+
 // Uses Win32 API for window
 #define WIN32_LEAN_AND_MEAN
 #include <Windows.h>
@@ -27,6 +31,16 @@
 #include <cstring>
 #include <cstdio>
 
+// Uses sinf & cosf for batched quads
+#include <cmath>
+
+// Uses std::vector for the batch vertices & file data
+#include <vector>
+
+// Uses std::shared_ptr & std::wstring for the pending loads
+#include <memory>
+#include <string>
+
 // Uses Direct3D9 for rendering
 #include <d3d9.h>
 #include <d3dx9.h>
@@ -34,8 +48,15 @@
 #pragma comment(lib, "d3dx9.lib")
 #pragma comment (lib, "dxguid.lib")
 
-// Uses HandleManager for storing data
-#include "SGD_HandleManager.h"
+// Uses ResourceCache for storing data
+#include "SGD_ResourceCache.h"
+
+// Uses AtlasIndex & AtlasDirectory for packed sprites
+#include "SGD_TextureAtlas.h"
+
+// Uses AsyncLoader & DecodePng for asynchronous loads
+#include "SGD_AsyncLoader.h"
+#include "SGD_PngDecoder.h"
 
 // Uses SGD_ASSERT for debug breaks
 #include "SGD_Utilities.h"
@@ -43,6 +64,9 @@
 // Window Class Descriptor ID
 #define SGD_WINDOW_CLASS_NAME		L"SGD Graphics Manager Window"
 
+// Asynchronous loads turned into textures by each Update
+#define SGD_TEXTURES_PER_UPDATE		4
+
 
 namespace SGD
 {
@@ -50,25 +74,69 @@ namespace SGD
 	{
 		//*************************************************************//
 		// TextureInfo
-		//	- stores info for the texture file: name, buffer, reference count
+		//	- stores info for the texture file: buffer & size
+		//	  (the cache stores the name & reference count)
+		//	- a packed sprite shares its atlas page's texture & holds
+		//	  a reference to the page
 		struct TextureInfo
 		{
-			wchar_t*				wszFilename;		// file name
-			unsigned int			unRefCount;			// reference count
 			IDirect3DTexture9*		texture;			// texture
 			float					fWidth;				// width
 			float					fHeight;			// height
+
+			HTexture				hPage;				// atlas page (INVALID_HANDLE if not packed)
+			float					fLeft;				// position within the page
+			float					fTop;
+			float					fPageWidth;			// page size (the texture's size if not packed)
+			float					fPageHeight;
+
+			unsigned int			unTicket;			// asynchronous load in progress (0 if none)
 		};
 		//*************************************************************//
 
 
 
+		//*************************************************************//
+		// PendingTexture
+		//	- an asynchronous load, shared by its two loader steps
+		//	- the worker fills the file or pixel data, the main thread
+		//	  creates the texture from it
+		struct PendingTexture
+		{
+			std::wstring					wsFilename;
+			D3DCOLOR						colorKey;
+			unsigned int					unTicket;		// set once submitted
+
+			std::vector< unsigned char >	vFile;			// file contents (unless decoded)
+			std::vector< unsigned char >	vPixels;		// decoded PNG, RGBA
+			unsigned int					unWidth;		// decoded PNG size
+			unsigned int					unHeight;
+		};
+		//*************************************************************//
+
+
+
+		//*************************************************************//
+		// BatchVertex
+		//	- pre-transformed vertex of a DrawTextureBatch quad
+		struct BatchVertex
+		{
+			FLOAT					x, y, z, rhw;		// screen position
+			D3DCOLOR				color;				// modulation
+			FLOAT					u, v;				// texture coordinates
+		};
+
+		#define SGD_BATCH_VERTEX_FVF	( D3DFVF_XYZRHW | D3DFVF_DIFFUSE | D3DFVF_TEX1 )
+		//*************************************************************//
+
+
+
 		//*************************************************************//
 		// GraphicsManager
 		//	- concrete class for rendering simple geometry and image files
 		//	- supports .bmp, .dds, .dib, .hdr, .jpg, .pfm, .png, .ppm, and .tga files
 		//	- texture dimensions will be rounded up to the nearest power of 2 (e.g. 2,4,8,16,32,64, etc.)
-		//	- uses IHandleManager to store texture data
+		//	- uses ResourceCache to store texture data
 		class GraphicsManager : public SGD::GraphicsManager
 		{
 		public:
@@ -101,8 +169,23 @@ namespace SGD
 			virtual	HTexture	LoadTexture				( const char* filename, Color colorKey )		override;
 			virtual	bool		DrawTexture				( HTexture handle, Point position, float rotation, Vector rotationOffset, Color color, Size scale )						override;
 			virtual	bool		DrawTextureSection		( HTexture handle, Point position, Rectangle section, float rotation, Vector rotationOffset, Color color, Size scale )	override;
+			virtual	bool		DrawTextureBatch		( HTexture handle, const SpriteQuad* quads, unsigned int count )		override;
 			virtual	bool		UnloadTexture			( HTexture& handle )							override;
 
+
+			virtual	bool		LoadAtlas				( const wchar_t* filename )						override;
+			virtual	bool		LoadAtlas				( const char* filename )						override;
+
+
+			virtual	HTexture	LoadTextureAsync		( const wchar_t* filename, Color colorKey )		override;
+			virtual	HTexture	LoadTextureAsync		( const char* filename, Color colorKey )		override;
+			virtual	LoadStatus	GetTextureStatus		( HTexture handle )								override;
+			virtual	unsigned int	FinishLoads			( bool wait )									override;
+
+
+			virtual	const GraphicsStats&	GetFrameStats	( void ) const		override	{	return m_FrameStats;	}
+			virtual	const CacheStats&		GetCacheStats	( void ) const		override	{	return m_Textures.GetStats();	}
+
 		private:
 			// SINGLETON
 			static	GraphicsManager*		s_Instance;		// the ONE instance
@@ -124,7 +207,9 @@ namespace SGD
 
 			EGraphicsManagerStatus		m_eStatus			= E_UNINITIALIZED;			// wrapper initialization status
 
-			HandleManager< TextureInfo > m_HandleManager;								// data storage
+			ResourceCache< TextureInfo > m_Textures;									// data storage
+			AtlasDirectory				m_Atlases;										// packed sprites by file name
+			AsyncLoader					m_Loader;										// asynchronous texture loads
 
 			IDirect3D9*					m_pDirect3D			= nullptr;					// Direct3D api
 			IDirect3DDevice9*			m_pDevice			= nullptr;					// device
@@ -145,19 +230,34 @@ namespace SGD
 			wchar_t*					m_pwszBuffer		= nullptr;					// output buffer storage (preallocated to hasten ASCII -> UTF16 conversion)
 			int							m_nBufferSize		= 0;						// size (in wchar_t) of output buffer
 
+			std::vector< BatchVertex >	m_vBatchVertices;								// DrawTextureBatch storage (kept to reuse the allocation)
+
+			GraphicsStats				m_FrameStats		= GraphicsStats{};			// counters of the last completed frame
+			GraphicsStats				m_CurrentStats		= GraphicsStats{};			// counters of the frame being drawn
+			int							m_nLastDraw			= -1;						// kind of the previous draw
+			HTexture					m_hLastTexture		= HTexture{};				// texture of the previous texture draw
+
 
 			// CLEAR SCREEN HELPER METHOD
 			bool			ClearScreen( void );
 
 
-			// TEXTURE REFERENCE HELPER METHOD
-			struct SearchInfo
-			{
-				const wchar_t*	filename;	// input
-				TextureInfo*	texture;	// output
-				HTexture		handle;		// output
-			};
-			static	bool	FindTextureByName( Handle handle, TextureInfo& data, SearchInfo* extra );
+			// DRAW COUNTING HELPER METHOD
+			enum EDrawKind { E_DRAW_TEXTURE, E_DRAW_RECTANGLE, E_DRAW_LINE, E_DRAW_STRING };
+			void			CountDraw( EDrawKind kind, HTexture texture );
+
+
+			// ATLAS HELPER METHOD
+			HTexture		LoadAtlasSprite( const wchar_t* filename, const AtlasDirectory::Entry& sprite, bool async );
+
+
+			// TEXTURE LOADING HELPER METHODS
+			void			StoreTextureSize( const wchar_t* filename, TextureInfo& data, UINT imageWidth, UINT imageHeight );
+			bool			ResolveTexture( TextureInfo& data );
+			void			WaitForTexture( HTexture handle );
+
+			static	void	DecodeTexture( PendingTexture& pending );
+			void			FinishTexture( HTexture handle, PendingTexture& pending );
 
 
 			// WINDOW INITIALIZATION HELPER METHODS
@@ -430,6 +530,10 @@ namespace SGD
 			m_pwszBuffer		= new wchar_t[ m_nBufferSize ];
 
 
+			// Start the asynchronous loader's workers
+			m_Loader.Initialize();
+
+
 			// Success!
 			m_eStatus = E_INITIALIZED;
 			return true;
@@ -478,6 +582,13 @@ namespace SGD
 			if( m_eStatus != E_INITIALIZED )
 				return false;
 
+
+			// Close the frame's counters
+			m_FrameStats	= m_CurrentStats;
+			m_CurrentStats	= GraphicsStats{};
+			m_nLastDraw		= -1;
+			m_hLastTexture	= HTexture{};
+
 			
 			// Centered output onto fullscreen display?
 			float offsetX = (m_WindowSize.width - m_DesiredSize.width) / 2;
@@ -638,6 +749,10 @@ namespace SGD
 			}
 
 
+			// Create a few of the textures decoded asynchronously
+			m_Loader.Update( SGD_TEXTURES_PER_UPDATE );
+
+
 
 			// Run the message loop
 			if( m_bWindowOwned == true )
@@ -685,8 +800,13 @@ namespace SGD
 			m_nBufferSize = 0;
 
 
+			// Discard the unfinished loads
+			m_Loader.Terminate();
+
+
 			// Clear handles
-			m_HandleManager.Clear();
+			m_Textures.Clear();
+			m_Atlases.Clear();
 
 
 			// Release resources
@@ -753,6 +873,10 @@ namespace SGD
 			if( m_eStatus != E_INITIALIZED )
 				return false;
 			
+			// Count the sampler change
+			if( m_bPixelated != pixelated )
+				m_CurrentStats.unStateChanges++;
+
 			// Store the parameter
 			m_bPixelated = pixelated;
 
@@ -1049,6 +1173,8 @@ namespace SGD
 				return false;
 
 
+			CountDraw( E_DRAW_STRING, HTexture{} );
+
 			RECT region = { (LONG)position.x, (LONG)position.y };
 			
 			int result = m_pFont->DrawTextW( m_pSprite, text, -1, &region, DT_NOCLIP, (D3DCOLOR)color );
@@ -1126,6 +1252,8 @@ namespace SGD
 				return false;
 
 
+			CountDraw( E_DRAW_LINE, HTexture{} );
+
 			// Calculate the difference in positions
 			float dX = position2.x - position1.x;
 			float dY = position2.y - position1.y;
@@ -1271,6 +1399,8 @@ namespace SGD
 				return false;
 
 
+			CountDraw( E_DRAW_RECTANGLE, HTexture{} );
+
 			HRESULT result = 0;
 			
 			// Store original transform
@@ -1430,22 +1560,33 @@ namespace SGD
 				return SGD::INVALID_HANDLE;
 
 
-			// Attempt to find the texture in the Handle Manager
-			SearchInfo search = { filename, nullptr, SGD::INVALID_HANDLE };
-			m_HandleManager.ForEach( &GraphicsManager::FindTextureByName, &search );
-
-			// If it was found, increase the reference & return the existing handle
-			if( search.texture != NULL )
+			// Attempt to find the texture in the cache
+			// (if it was found, it holds another reference)
+			HTexture existing = m_Textures.Acquire( filename );
+			if( existing != SGD::INVALID_HANDLE )
 			{
-				search.texture->unRefCount++;
-				return search.handle;
+				// Finish an asynchronous load of the file now
+				WaitForTexture( existing );
+
+				if( GetTextureStatus( existing ) == LoadStatus::Failed )
+				{
+					UnloadTexture( existing );
+					return SGD::INVALID_HANDLE;
+				}
+
+				return existing;
 			}
 
 
-			// Could not find texture in the Handle Manager
+			// Is it a packed sprite?
+			const AtlasDirectory::Entry* sprite = m_Atlases.Find( filename );
+			if( sprite != nullptr )
+				return LoadAtlasSprite( filename, *sprite, false );
+
+
+			// Could not find texture in the cache
 			TextureInfo data = { };
 			D3DXIMAGE_INFO info = { };
-			D3DSURFACE_DESC surface = { };
 
 
 			// Attempt to load from file
@@ -1464,31 +1605,12 @@ namespace SGD
 			}
 
 
-			// Texture loaded successfully
-			data.wszFilename = _wcsdup( filename );
-			data.unRefCount = 1;
-
-
-			// Compare surface description to the original image
-			data.texture->GetLevelDesc( 0, &surface );
-
-			if( surface.Width != info.Width || surface.Height != info.Height )
-			{
-				// MESSAGE
-				wchar_t wszBuffer[ 256 ];
-				_snwprintf_s( wszBuffer, 256, _TRUNCATE, L"!!! GraphicsManager::LoadTexture - Texture file \"%ws\" is stretched from %ux%u to %ux%u !!!\n", filename, info.Width, info.Height, surface.Width, surface.Height );
-				Alert( wszBuffer );
-				//OutputDebugStringW( wszBuffer );
-			}
-
-
 			// Store the buffer size
-			data.fWidth  = (float)surface.Width;
-			data.fHeight = (float)surface.Height;
+			StoreTextureSize( filename, data, info.Width, info.Height );
 
 
-			// Store texture into the Handle Manager
-			return m_HandleManager.StoreData( data );
+			// Store texture into the cache
+			return m_Textures.Store( filename, data );
 		}
 		//*************************************************************//
 
@@ -1547,11 +1669,17 @@ namespace SGD
 
 
 			// Get the texture info from the handle manager
-			TextureInfo* data = m_HandleManager.GetData( handle );
+			TextureInfo* data = m_Textures.GetData( handle );
 			SGD_ASSERT( data != nullptr, "GraphicsManager::DrawTexture - handle has expired" );
 			if( data == nullptr )
 				return false;
 
+			// Quietly skip a texture that is still loading
+			if( ResolveTexture( *data ) == false )
+				return false;
+
+
+			CountDraw( E_DRAW_TEXTURE, (data->hPage != SGD::INVALID_HANDLE) ? data->hPage : handle );
 			
 			// Store original transform
 			D3DXMATRIX original, world;
@@ -1587,8 +1715,9 @@ namespace SGD
 			m_pSprite->SetTransform( &world );
 
 
-			// Draw the texture
-			HRESULT result = m_pSprite->Draw( data->texture, nullptr, nullptr, nullptr, (D3DCOLOR)color );
+			// Draw the texture (only its sub-rectangle if packed)
+			RECT source = { (LONG)data->fLeft, (LONG)data->fTop, (LONG)(data->fLeft + data->fWidth), (LONG)(data->fTop + data->fHeight) };
+			HRESULT result = m_pSprite->Draw( data->texture, (data->hPage != SGD::INVALID_HANDLE) ? &source : nullptr, nullptr, nullptr, (D3DCOLOR)color );
 
 
 			// Restore the transform
@@ -1627,17 +1756,23 @@ namespace SGD
 
 
 			// Get the texture info from the handle manager
-			TextureInfo* data = m_HandleManager.GetData( handle );
+			TextureInfo* data = m_Textures.GetData( handle );
 			SGD_ASSERT( data != nullptr, "GraphicsManager::DrawTextureSection - handle has expired" );
 			if( data == nullptr )
 				return false;
 
+			// Quietly skip a texture that is still loading
+			if( ResolveTexture( *data ) == false )
+				return false;
+
 			
 			// Is the section inverted?
 			SGD_ASSERT( section.IsEmpty() == false, "GraphicsManager::DrawTextureSection - section rectangle is empty" );
 			if( section.IsEmpty() == true )
 				return false;
 
+
+			CountDraw( E_DRAW_TEXTURE, (data->hPage != SGD::INVALID_HANDLE) ? data->hPage : handle );
 		
 			// Store original transform
 			D3DXMATRIX original, world;
@@ -1673,8 +1808,8 @@ namespace SGD
 			m_pSprite->SetTransform( &world );
 
 
-			// Draw the texture
-			RECT source = { (LONG)section.left, (LONG)section.top, (LONG)section.right, (LONG)section.bottom };
+			// Draw the texture (the section is relative to the sub-rectangle if packed)
+			RECT source = { (LONG)(section.left + data->fLeft), (LONG)(section.top + data->fTop), (LONG)(section.right + data->fLeft), (LONG)(section.bottom + data->fTop) };
 			HRESULT result = m_pSprite->Draw( data->texture, &source, nullptr, nullptr, (D3DCOLOR)color );
 
 
@@ -1700,39 +1835,190 @@ namespace SGD
 
 
 		//*************************************************************//
-		// UNLOAD TEXTURE
-		bool GraphicsManager::UnloadTexture( HTexture& handle )	
+		// DRAW TEXTURE BATCH
+		//	- every quad is transformed on the CPU (like DrawTextureSection)
+		//	  and the whole run goes to the device in one DrawPrimitiveUP
+		bool GraphicsManager::DrawTextureBatch( HTexture handle, const SpriteQuad* quads, unsigned int count )
 		{
 			// Sanity-check the wrapper's status
-			SGD_ASSERT( m_eStatus == E_INITIALIZED, "GraphicsManager::UnloadTexture - wrapper has not been initialized" );
+			SGD_ASSERT( m_eStatus == E_INITIALIZED, "GraphicsManager::DrawTextureBatch - wrapper has not been initialized" );
 			if( m_eStatus != E_INITIALIZED )
 				return false;
 
-			// Quietly ignore bad handles
-			if( handle == INVALID_HANDLE )
+			SGD_ASSERT( handle != SGD::INVALID_HANDLE, "GraphicsManager::DrawTextureBatch - invalid handle" );
+			if( handle == SGD::INVALID_HANDLE )
+				return false;
+
+			SGD_ASSERT( quads != nullptr || count == 0, "GraphicsManager::DrawTextureBatch - quads cannot be null" );
+			if( quads == nullptr || count == 0 )
 				return false;
 
 
 			// Get the texture info from the handle manager
-			TextureInfo* data = m_HandleManager.GetData( handle );
+			TextureInfo* data = m_Textures.GetData( handle );
+			SGD_ASSERT( data != nullptr, "GraphicsManager::DrawTextureBatch - handle has expired" );
 			if( data == nullptr )
 				return false;
 
-			// Release a reference
-			data->unRefCount--;
+			// Quietly skip a texture that is still loading
+			if( ResolveTexture( *data ) == false )
+				return false;
+
+
+			CountDraw( E_DRAW_TEXTURE, (data->hPage != SGD::INVALID_HANDLE) ? data->hPage : handle );
+			m_CurrentStats.unSprites += count - 1;
+			m_CurrentStats.unBatches++;
+
+
+			// The sprite's transform still applies to the batch
+			D3DXMATRIX original;
+			m_pSprite->GetTransform( &original );
+
+			float invWidth	= 1.0f / data->fPageWidth;
+			float invHeight	= 1.0f / data->fPageHeight;
+
+
+			// Build two triangles per quad
+			m_vBatchVertices.resize( count * 6 );
+			BatchVertex* vertex = &m_vBatchVertices[ 0 ];
 
-			// Is this the last reference?
-			if( data->unRefCount == 0 )
+			for( unsigned int q = 0; q < count; q++ )
 			{
-				// Release the texture
-				data->texture->Release();
+				const SpriteQuad& quad = quads[ q ];
+
+				Rectangle section = quad.section;
+				if( section.IsEmpty() == true )
+					section = Rectangle{ 0, 0, data->fWidth, data->fHeight };
+
+				float cosine	= cosf( quad.rotation );
+				float sine		= sinf( quad.rotation );
+				float offsetX	= quad.rotationOffset.x * quad.scale.width;
+				float offsetY	= quad.rotationOffset.y * quad.scale.height;
+
+				// Local corners: top-left, top-right, bottom-right, bottom-left
+				float width		= section.right  - section.left;
+				float height	= section.bottom - section.top;
 
-				// Deallocate the name
-				delete[] data->wszFilename;
+				// Texture coordinates within the page
+				section.left	+= data->fLeft;		section.right	+= data->fLeft;
+				section.top		+= data->fTop;		section.bottom	+= data->fTop;
 
-				// Remove the audio info from the handle manager
-				m_HandleManager.RemoveData( handle, nullptr );
-				data = nullptr;
+				float localX[ 4 ] = { 0.0f, width, width,  0.0f   };
+				float localY[ 4 ] = { 0.0f, 0.0f,  height, height };
+				float texU[ 4 ] = { section.left * invWidth,  section.right * invWidth,   section.right * invWidth,   section.left * invWidth   };
+				float texV[ 4 ] = { section.top  * invHeight, section.top   * invHeight,  section.bottom * invHeight, section.bottom * invHeight };
+
+				BatchVertex corners[ 4 ];
+				for( int c = 0; c < 4; c++ )
+				{
+					// Scale, rotate around the local point, translate
+					float x = localX[ c ] * quad.scale.width  - offsetX;
+					float y = localY[ c ] * quad.scale.height - offsetY;
+
+					float worldX = x * cosine - y * sine   + offsetX + quad.position.x;
+					float worldY = x * sine   + y * cosine + offsetY + quad.position.y;
+
+					// Apply the sprite transform & map texels to pixels
+					corners[ c ].x		= worldX * original._11 + worldY * original._21 + original._41 - 0.5f;
+					corners[ c ].y		= worldX * original._12 + worldY * original._22 + original._42 - 0.5f;
+					corners[ c ].z		= 0.0f;
+					corners[ c ].rhw	= 1.0f;
+					corners[ c ].color	= (D3DCOLOR)quad.color;
+					corners[ c ].u		= texU[ c ];
+					corners[ c ].v		= texV[ c ];
+				}
+
+				*vertex++ = corners[ 0 ];
+				*vertex++ = corners[ 1 ];
+				*vertex++ = corners[ 2 ];
+				*vertex++ = corners[ 0 ];
+				*vertex++ = corners[ 2 ];
+				*vertex++ = corners[ 3 ];
+			}
+
+
+			// Draw the sprites queued before the batch first
+			m_pSprite->Flush();
+
+
+			// Store the sprite's device state
+			IDirect3DVertexDeclaration9*	pDeclaration	= nullptr;
+			IDirect3DVertexShader9*			pShader			= nullptr;
+			IDirect3DVertexBuffer9*			pStream			= nullptr;
+			UINT							unStreamOffset	= 0;
+			UINT							unStreamStride	= 0;
+
+			m_pDevice->GetVertexDeclaration( &pDeclaration );
+			m_pDevice->GetVertexShader( &pShader );
+			m_pDevice->GetStreamSource( 0, &pStream, &unStreamOffset, &unStreamStride );
+
+
+			// Draw the batch (the blend & sampler states are the sprite's)
+			m_pDevice->SetVertexShader( nullptr );
+			m_pDevice->SetFVF( SGD_BATCH_VERTEX_FVF );
+			m_pDevice->SetTexture( 0, data->texture );
+
+			HRESULT result = m_pDevice->DrawPrimitiveUP( D3DPT_TRIANGLELIST, count * 2, &m_vBatchVertices[ 0 ], sizeof( BatchVertex ) );
+
+
+			// Restore the sprite's device state
+			m_pDevice->SetVertexDeclaration( pDeclaration );
+			m_pDevice->SetVertexShader( pShader );
+			m_pDevice->SetStreamSource( 0, pStream, unStreamOffset, unStreamStride );
+
+			if( pDeclaration != nullptr )
+				pDeclaration->Release();
+			if( pShader != nullptr )
+				pShader->Release();
+			if( pStream != nullptr )
+				pStream->Release();
+
+
+			if( FAILED( result ) )
+			{
+				// MESSAGE
+				char szBuffer[ 128 ];
+				_snprintf_s( szBuffer, 128, _TRUNCATE, "!!! GraphicsManager::DrawTextureBatch - failed to draw texture batch (0x%X) !!!\n", result );
+				Alert( szBuffer );
+				//OutputDebugStringA( szBuffer );
+
+				return false;
+			}
+
+			return true;
+		}
+		//*************************************************************//
+
+
+
+		//*************************************************************//
+		// UNLOAD TEXTURE
+		bool GraphicsManager::UnloadTexture( HTexture& handle )	
+		{
+			// Sanity-check the wrapper's status
+			SGD_ASSERT( m_eStatus == E_INITIALIZED, "GraphicsManager::UnloadTexture - wrapper has not been initialized" );
+			if( m_eStatus != E_INITIALIZED )
+				return false;
+
+			// Quietly ignore bad handles
+			if( handle == INVALID_HANDLE )
+				return false;
+
+
+			// Validate the handle
+			if( m_Textures.GetData( handle ) == nullptr )
+				return false;
+
+			// Release a reference: was it the last one?
+			TextureInfo data = { };
+			if( m_Textures.Release( handle, &data ) == true )
+			{
+				// Release the texture (a packed sprite releases its page instead)
+				// (a texture that failed or is still loading has none)
+				if( data.hPage != SGD::INVALID_HANDLE )
+					UnloadTexture( data.hPage );
+				else if( data.texture != nullptr )
+					data.texture->Release();
 			}
 
 
@@ -1745,25 +2031,497 @@ namespace SGD
 
 
 		//*************************************************************//
-		// FIND TEXTURE BY NAME
-		/*static*/ bool GraphicsManager::FindTextureByName( Handle handle, TextureInfo& data, SearchInfo* extra )
-		{		
-			// Compare the names
-			if( wcscmp( data.wszFilename, extra->filename ) == 0 )
+		// LOAD ATLAS
+		bool GraphicsManager::LoadAtlas( const wchar_t* filename )
+		{
+			// Sanity-check the wrapper's status
+			SGD_ASSERT( m_eStatus == E_INITIALIZED, "GraphicsManager::LoadAtlas - wrapper has not been initialized" );
+			if( m_eStatus != E_INITIALIZED )
+				return false;
+
+			SGD_ASSERT( filename != nullptr && filename[0] != L'\0', "GraphicsManager::LoadAtlas - invalid filename" );
+			if( filename == nullptr || filename[0] == L'\0' )
+				return false;
+
+
+			// Read the index (the pages load with their first sprite)
+			AtlasIndex index;
+			FILE* file = nullptr;
+			bool success = _wfopen_s( &file, filename, L"rb" ) == 0 && index.Read( file ) == true;
+
+			if( file != nullptr )
+				fclose( file );
+
+			if( success == false )
 			{
-				// Texture does exist!
-				extra->texture	= &data;
-				extra->handle	= handle;
+				// MESSAGE
+				wchar_t wszBuffer[ 256 ];
+				_snwprintf_s( wszBuffer, 256, _TRUNCATE, L"!!! GraphicsManager::LoadAtlas - failed to load atlas index \"%ws\" !!!", filename );
+				Alert( wszBuffer );
+				//OutputDebugStringW( wszBuffer );
+				//OutputDebugStringA( "\n" );
+
 				return false;
 			}
 
-			// Did not find yet
+
+			m_Atlases.Add( index, filename );
 			return true;
 		}
 		//*************************************************************//
 
 
 
+		//*************************************************************//
+		// LOAD ATLAS
+		bool GraphicsManager::LoadAtlas( const char* filename )
+		{
+			// Sanity-check the wrapper's status
+			SGD_ASSERT( m_eStatus == E_INITIALIZED, "GraphicsManager::LoadAtlas - wrapper has not been initialized" );
+			if( m_eStatus != E_INITIALIZED )
+				return false;
+
+			SGD_ASSERT( filename != nullptr && filename[0] != '\0', "GraphicsManager::LoadAtlas - invalid filename" );
+			if( filename == nullptr || filename[0] == '\0' )
+				return false;
+
+
+			// Convert the filename to UTF16
+			wchar_t widename[ MAX_PATH * 4 ];
+			int ret = MultiByteToWideChar( CP_UTF8, 0, filename, -1, widename, MAX_PATH * 4 );
+
+			if( ret == 0 )
+			{
+				// MESSAGE
+				char szBuffer[ 256 ];
+				_snprintf_s( szBuffer, 256, _TRUNCATE, "!!! GraphicsManager::LoadAtlas - invalid filename \"%hs\" (0x%X) !!!", filename, GetLastError() );
+				Alert( szBuffer );
+				//OutputDebugStringA( szBuffer );
+				//OutputDebugStringA( "\n" );
+
+				return false;
+			}
+
+
+			// Use the UTF16 load
+			return LoadAtlas( widename );
+		}
+		//*************************************************************//
+
+
+
+		//*************************************************************//
+		// LOAD ATLAS SPRITE
+		//	- load (or reference) the page, then store the sprite as
+		//	  its own texture sharing the page's Direct3D texture
+		//	- while the page is loading asynchronously, the sprite has no
+		//	  texture yet (ResolveTexture copies it once the page is ready)
+		HTexture GraphicsManager::LoadAtlasSprite( const wchar_t* filename, const AtlasDirectory::Entry& sprite, bool async )
+		{
+			HTexture page = (async == true)
+				? LoadTextureAsync( sprite.wsPage.c_str(), Color{ 0, 0, 0, 0 } )
+				: LoadTexture( sprite.wsPage.c_str(), Color{ 0, 0, 0, 0 } );
+			if( page == SGD::INVALID_HANDLE )
+				return SGD::INVALID_HANDLE;
+
+			TextureInfo* pageData = m_Textures.GetData( page );
+
+
+			TextureInfo data = { };
+			data.texture		= pageData->texture;
+			data.fWidth			= (float)sprite.unWidth;
+			data.fHeight		= (float)sprite.unHeight;
+
+			data.hPage			= page;
+			data.fLeft			= (float)sprite.unX;
+			data.fTop			= (float)sprite.unY;
+			data.fPageWidth		= pageData->fPageWidth;
+			data.fPageHeight	= pageData->fPageHeight;
+
+
+			// Store texture into the cache
+			return m_Textures.Store( filename, data );
+		}
+		//*************************************************************//
+
+
+
+		//*************************************************************//
+		// LOAD TEXTURE ASYNC
+		HTexture GraphicsManager::LoadTextureAsync( const wchar_t* filename, Color colorKey )
+		{
+			// Sanity-check the wrapper's status
+			SGD_ASSERT( m_eStatus == E_INITIALIZED, "GraphicsManager::LoadTextureAsync - wrapper has not been initialized" );
+			if( m_eStatus != E_INITIALIZED )
+				return SGD::INVALID_HANDLE;
+
+			SGD_ASSERT( filename != nullptr && filename[0] != L'\0', "GraphicsManager::LoadTextureAsync - invalid filename" );
+			if( filename == nullptr || filename[0] == L'\0' )
+				return SGD::INVALID_HANDLE;
+
+
+			// Attempt to find the texture in the cache (loaded or still loading)
+			HTexture existing = m_Textures.Acquire( filename );
+			if( existing != SGD::INVALID_HANDLE )
+				return existing;
+
+
+			// Is it a packed sprite? (its page loads asynchronously)
+			const AtlasDirectory::Entry* sprite = m_Atlases.Find( filename );
+			if( sprite != nullptr )
+				return LoadAtlasSprite( filename, *sprite, true );
+
+
+			// Store the entry now: it has no texture until the load finishes
+			TextureInfo data = { };
+			data.hPage = SGD::INVALID_HANDLE;
+
+			HTexture handle = m_Textures.Store( filename, data );
+
+
+			// Read & decode the file on a worker, create the texture in Update
+			std::shared_ptr< PendingTexture > pending = std::make_shared< PendingTexture >();
+			pending->wsFilename	= filename;
+			pending->colorKey	= (D3DCOLOR)colorKey;
+
+			pending->unTicket = m_Loader.Submit(
+				[ pending ]()					{	DecodeTexture( *pending );			},
+				[ this, handle, pending ]()		{	FinishTexture( handle, *pending );	} );
+
+			m_Textures.GetData( handle )->unTicket = pending->unTicket;
+			return handle;
+		}
+		//*************************************************************//
+
+
+
+		//*************************************************************//
+		// LOAD TEXTURE ASYNC
+		HTexture GraphicsManager::LoadTextureAsync( const char* filename, Color colorKey )
+		{
+			// Sanity-check the wrapper's status
+			SGD_ASSERT( m_eStatus == E_INITIALIZED, "GraphicsManager::LoadTextureAsync - wrapper has not been initialized" );
+			if( m_eStatus != E_INITIALIZED )
+				return SGD::INVALID_HANDLE;
+
+			SGD_ASSERT( filename != nullptr && filename[0] != '\0', "GraphicsManager::LoadTextureAsync - invalid filename" );
+			if( filename == nullptr || filename[0] == '\0' )
+				return SGD::INVALID_HANDLE;
+
+
+			// Convert the filename to UTF16
+			wchar_t widename[ MAX_PATH * 4 ];
+			int ret = MultiByteToWideChar( CP_UTF8, 0, filename, -1, widename, MAX_PATH * 4 );
+
+			if( ret == 0 )
+			{
+				// MESSAGE
+				char szBuffer[ 256 ];
+				_snprintf_s( szBuffer, 256, _TRUNCATE, "!!! GraphicsManager::LoadTextureAsync - invalid filename \"%hs\" (0x%X) !!!", filename, GetLastError() );
+				Alert( szBuffer );
+				//OutputDebugStringA( szBuffer );
+				//OutputDebugStringA( "\n" );
+
+				return SGD::INVALID_HANDLE;
+			}
+
+
+			// Use the UTF16 load
+			return LoadTextureAsync( widename, colorKey );
+		}
+		//*************************************************************//
+
+
+
+		//*************************************************************//
+		// GET TEXTURE STATUS
+		//	- a packed sprite is as ready as its page
+		LoadStatus GraphicsManager::GetTextureStatus( HTexture handle )
+		{
+			// Sanity-check the wrapper's status
+			SGD_ASSERT( m_eStatus == E_INITIALIZED, "GraphicsManager::GetTextureStatus - wrapper has not been initialized" );
+			if( m_eStatus != E_INITIALIZED )
+				return LoadStatus::Failed;
+
+			// Quietly report bad handles
+			if( handle == SGD::INVALID_HANDLE || m_Textures.IsHandleValid( handle ) == false )
+				return LoadStatus::Failed;
+
+
+			const TextureInfo* data = m_Textures.GetData( handle );
+			if( data->hPage != SGD::INVALID_HANDLE )
+				data = m_Textures.GetData( data->hPage );
+
+			if( data->unTicket != 0 )
+				return LoadStatus::Pending;
+
+			return (data->texture != nullptr) ? LoadStatus::Loaded : LoadStatus::Failed;
+		}
+		//*************************************************************//
+
+
+
+		//*************************************************************//
+		// FINISH LOADS
+		unsigned int GraphicsManager::FinishLoads( bool wait )
+		{
+			// Sanity-check the wrapper's status
+			SGD_ASSERT( m_eStatus == E_INITIALIZED, "GraphicsManager::FinishLoads - wrapper has not been initialized" );
+			if( m_eStatus != E_INITIALIZED )
+				return 0;
+
+
+			if( wait == true )
+				m_Loader.CompleteAll();
+			else
+				m_Loader.Update( 0xFFFFFFFF );
+
+			return m_Loader.GetPendingCount();
+		}
+		//*************************************************************//
+
+
+
+		//*************************************************************//
+		// STORE TEXTURE SIZE
+		//	- compare the texture to the original image & store its size
+		//	- counts the texture's bytes in the cache stats
+		void GraphicsManager::StoreTextureSize( const wchar_t* filename, TextureInfo& data, UINT imageWidth, UINT imageHeight )
+		{
+			// Compare surface description to the original image
+			D3DSURFACE_DESC surface = { };
+			data.texture->GetLevelDesc( 0, &surface );
+
+			if( surface.Width != imageWidth || surface.Height != imageHeight )
+			{
+				// MESSAGE
+				wchar_t wszBuffer[ 256 ];
+				_snwprintf_s( wszBuffer, 256, _TRUNCATE, L"!!! GraphicsManager::LoadTexture - Texture file \"%ws\" is stretched from %ux%u to %ux%u !!!\n", filename, imageWidth, imageHeight, surface.Width, surface.Height );
+				Alert( wszBuffer );
+				//OutputDebugStringW( wszBuffer );
+			}
+
+
+			// Store the buffer size
+			data.fWidth  = (float)surface.Width;
+			data.fHeight = (float)surface.Height;
+
+			// Not packed
+			data.hPage			= SGD::INVALID_HANDLE;
+			data.fPageWidth		= data.fWidth;
+			data.fPageHeight	= data.fHeight;
+
+			m_Textures.AddBytesLoaded( surface.Width * surface.Height * 4 );
+		}
+		//*************************************************************//
+
+
+
+		//*************************************************************//
+		// RESOLVE TEXTURE
+		//	- false while the texture (or a packed sprite's page) is loading
+		//	- a packed sprite stored before its page finished loading
+		//	  copies the page's texture once it is ready
+		bool GraphicsManager::ResolveTexture( TextureInfo& data )
+		{
+			if( data.texture == nullptr && data.hPage != SGD::INVALID_HANDLE )
+			{
+				const TextureInfo* page = m_Textures.GetData( data.hPage );
+				if( page != nullptr && page->texture != nullptr )
+				{
+					data.texture		= page->texture;
+					data.fPageWidth		= page->fPageWidth;
+					data.fPageHeight	= page->fPageHeight;
+				}
+			}
+
+			return data.texture != nullptr;
+		}
+		//*************************************************************//
+
+
+
+		//*************************************************************//
+		// WAIT FOR TEXTURE
+		//	- finish the asynchronous load of the texture (or a packed
+		//	  sprite's page) on this thread
+		void GraphicsManager::WaitForTexture( HTexture handle )
+		{
+			const TextureInfo* data = m_Textures.GetData( handle );
+			if( data != nullptr && data->hPage != SGD::INVALID_HANDLE )
+				data = m_Textures.GetData( data->hPage );
+
+			if( data != nullptr && data->unTicket != 0 )
+				m_Loader.Complete( data->unTicket );
+		}
+		//*************************************************************//
+
+
+
+		//*************************************************************//
+		// DECODE TEXTURE
+		//	- runs on a loader worker: reads the file & decodes PNG files
+		//	  (D3DX decodes the other formats when the texture is created)
+		//	- touches nothing but the pending load
+		/*static*/ void GraphicsManager::DecodeTexture( PendingTexture& pending )
+		{
+			// Read the whole file
+			FILE* file = nullptr;
+			if( _wfopen_s( &file, pending.wsFilename.c_str(), L"rb" ) != 0 || file == nullptr )
+				return;
+
+			fseek( file, 0, SEEK_END );
+			long size = ftell( file );
+			fseek( file, 0, SEEK_SET );
+
+			if( size > 0 )
+			{
+				pending.vFile.resize( (size_t)size );
+				if( fread( &pending.vFile[ 0 ], 1, (size_t)size, file ) != (size_t)size )
+					pending.vFile.clear();
+			}
+
+			fclose( file );
+
+
+			// Decode PNG files here (an unsupported one is left to D3DX)
+			if( IsPngFile( pending.vFile.empty() ? nullptr : &pending.vFile[ 0 ], (unsigned int)pending.vFile.size() ) == true
+				&& DecodePng( &pending.vFile[ 0 ], (unsigned int)pending.vFile.size(), pending.unWidth, pending.unHeight, pending.vPixels ) == true )
+			{
+				std::vector< unsigned char >().swap( pending.vFile );
+			}
+		}
+		//*************************************************************//
+
+
+
+		//*************************************************************//
+		// FINISH TEXTURE
+		//	- runs on the main thread: creates the texture of a decoded
+		//	  load, unless the handle was unloaded in the meantime
+		//	- a decoded PNG is stretched over the power-of-2 texture and
+		//	  color-keyed just like D3DXCreateTextureFromFileEx would
+		void GraphicsManager::FinishTexture( HTexture handle, PendingTexture& pending )
+		{
+			// Was the texture unloaded while it was loading?
+			if( m_Textures.IsHandleValid( handle ) == false )
+				return;
+
+			TextureInfo* data = m_Textures.GetData( handle );
+			if( data->unTicket != pending.unTicket )
+				return;
+
+			data->unTicket = 0;
+
+
+			HRESULT hResult = E_FAIL;
+			UINT imageWidth = 0, imageHeight = 0;
+
+			if( pending.vPixels.empty() == false )
+			{
+				imageWidth	= pending.unWidth;
+				imageHeight	= pending.unHeight;
+
+				// Round the texture size up to the nearest power of 2
+				UINT width = 1, height = 1;
+				while( width < imageWidth )
+					width <<= 1;
+				while( height < imageHeight )
+					height <<= 1;
+
+				hResult = D3DXCreateTexture( m_pDevice, width, height, D3DX_DEFAULT, 0, D3DFMT_A8R8G8B8, D3DPOOL_MANAGED, &data->texture );
+				if( SUCCEEDED( hResult ) )
+				{
+					// Copy the pixels into the top level
+					IDirect3DSurface9* surface = nullptr;
+					hResult = data->texture->GetSurfaceLevel( 0, &surface );
+
+					if( SUCCEEDED( hResult ) )
+					{
+						RECT source = { 0, 0, (LONG)imageWidth, (LONG)imageHeight };
+						hResult = D3DXLoadSurfaceFromMemory( surface, nullptr, nullptr, &pending.vPixels[ 0 ], D3DFMT_A8B8G8R8, imageWidth * 4, nullptr, &source, D3DX_DEFAULT, pending.colorKey );
+						surface->Release();
+					}
+
+					// Fill the mip levels
+					if( SUCCEEDED( hResult ) )
+						hResult = D3DXFilterTexture( data->texture, nullptr, 0, D3DX_DEFAULT );
+
+					if( FAILED( hResult ) )
+					{
+						data->texture->Release();
+						data->texture = nullptr;
+					}
+				}
+			}
+			else if( pending.vFile.empty() == false )
+			{
+				// Let D3DX decode the other formats
+				D3DXIMAGE_INFO info = { };
+				hResult = D3DXCreateTextureFromFileInMemoryEx( m_pDevice, &pending.vFile[ 0 ], (UINT)pending.vFile.size(), 0, 0, D3DX_DEFAULT, 0, D3DFMT_UNKNOWN, D3DPOOL_MANAGED, D3DX_DEFAULT, D3DX_DEFAULT, pending.colorKey, &info, nullptr, &data->texture );
+
+				imageWidth	= info.Width;
+				imageHeight	= info.Height;
+			}
+
+
+			if( FAILED( hResult ) )
+			{
+				// The entry stays without a texture (LoadStatus::Failed)
+				data->texture = nullptr;
+
+				// MESSAGE
+				wchar_t wszBuffer[ 256 ];
+				_snwprintf_s( wszBuffer, 256, _TRUNCATE, L"!!! GraphicsManager::LoadTextureAsync - failed to load texture file \"%ws\" (0x%X) !!!", pending.wsFilename.c_str(), hResult );
+				Alert( wszBuffer );
+				//OutputDebugStringW( wszBuffer );
+				//OutputDebugStringA( "\n" );
+
+				return;
+			}
+
+
+			// Store the buffer size
+			StoreTextureSize( pending.wsFilename.c_str(), *data, imageWidth, imageHeight );
+		}
+		//*************************************************************//
+
+
+
+		//*************************************************************//
+		// COUNT DRAW
+		void GraphicsManager::CountDraw( EDrawKind kind, HTexture texture )
+		{
+			switch( kind )
+			{
+			case E_DRAW_TEXTURE:	m_CurrentStats.unSprites++;		break;
+			case E_DRAW_RECTANGLE:	m_CurrentStats.unRectangles++;	break;
+			case E_DRAW_LINE:		m_CurrentStats.unLines++;		break;
+			case E_DRAW_STRING:		m_CurrentStats.unStrings++;		break;
+			}
+
+			// Different kind of draw?
+			if( m_nLastDraw != (int)kind )
+			{
+				if( m_nLastDraw != -1 )
+					m_CurrentStats.unStateChanges++;
+
+				m_nLastDraw = (int)kind;
+			}
+
+			// Different texture?
+			if( kind == E_DRAW_TEXTURE && texture != m_hLastTexture )
+			{
+				if( m_hLastTexture != INVALID_HANDLE )
+					m_CurrentStats.unTextureSwitches++;
+
+				m_hLastTexture = texture;
+			}
+		}
+		//*************************************************************//
+
+
+
 		//*************************************************************//
 		// INITIALIZE WINDOW
 		HWND GraphicsManager::InitializeWindow( const wchar_t* title, LONG width, LONG height )
@@ -1920,3 +2678,5 @@ namespace SGD
 	}	// namespace SGD_IMPLEMENTATION
 
 }	// namespace SGD
+
+#endif	//!SGD_HEADLESS_GRAPHICS
\ No newline at end of file
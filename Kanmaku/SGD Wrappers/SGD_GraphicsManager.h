@@ -27,12 +27,50 @@ namespace SGD
 	// Forward declaration of global variable
 	extern const float PI;
 
+
+	//*****************************************************************//
+	// GraphicsStats
+	//	- draw counters for one frame (between two Update calls)
+	//	- a state change is a draw of a different kind than the previous
+	//	  draw (texture / rectangle / line / text) or a sampler change
+	//	- a texture switch is a texture draw using a different texture
+	//	  than the previous texture draw
+	struct GraphicsStats
+	{
+		unsigned int	unSprites			= 0;	// DrawTexture & DrawTextureSection
+		unsigned int	unRectangles		= 0;	// DrawRectangle
+		unsigned int	unLines				= 0;	// DrawLine
+		unsigned int	unStrings			= 0;	// DrawString
+		unsigned int	unBatches			= 0;	// DrawTextureBatch (its quads count as sprites)
+		unsigned int	unStateChanges		= 0;
+		unsigned int	unTextureSwitches	= 0;
+	};
+
+
+	//*****************************************************************//
+	// SpriteQuad
+	//	- one quad of a DrawTextureBatch call, with the parameters
+	//	  of DrawTextureSection
+	//	- an empty section draws the whole texture
+	struct SpriteQuad
+	{
+		Point			position;
+		Rectangle		section;
+		float			rotation;
+		Vector			rotationOffset;
+		Color			color;
+		Size			scale;
+	};
+
 	
 	//*****************************************************************//
 	// GraphicsManager
 	//	- SINGLETON class for rendering text, geometry, and textures
 	//	- supports .bmp, .dds, .dib, .hdr, .jpg, .pfm, .png, .ppm, and .tga files
 	//	- texture dimensions will be rounded up to the nearest power of 2 (e.g. 2,4,8,16,32,64, etc.)
+	//	- define SGD_HEADLESS_GRAPHICS to build the headless backend instead of
+	//	  Direct3D: no window or GPU, textures are only measured & draw calls
+	//	  are recorded into a per-frame command buffer
 	class GraphicsManager
 	{
 	public:
@@ -64,9 +102,37 @@ namespace SGD
 		virtual	HTexture	LoadTexture			( const char* filename, Color colorKey = {0,0,0,0} )		= 0;
 		virtual	bool		DrawTexture			( HTexture handle, Point position, float rotation = 0.0f, Vector rotationOffset = {}, Color color = {}, Size scale = {1.0f, 1.0f} )						= 0;
 		virtual	bool		DrawTextureSection	( HTexture handle, Point position, Rectangle section, float rotation = 0.0f, Vector rotationOffset = {}, Color color = {}, Size scale = {1.0f, 1.0f} )	= 0;
+		virtual	bool		DrawTextureBatch	( HTexture handle, const SpriteQuad* quads, unsigned int count )	= 0;	// one submission for every quad (see SpriteBatch)
 		virtual	bool		UnloadTexture		( HTexture& handle )										= 0;
 
 
+		// Texture atlases (built with Kanmaku/tools/AtlasPacker)
+		//	- after LoadAtlas, LoadTexture of a packed sprite's file name
+		//	  returns a handle to its sub-rectangle of the page texture,
+		//	  which every draw method treats as a whole texture
+		//	- the color key of a packed sprite is ignored
+		virtual	bool		LoadAtlas			( const wchar_t* filename )									= 0;
+		virtual	bool		LoadAtlas			( const char* filename )									= 0;
+
+
+		// Asynchronous loading
+		//	- LoadTextureAsync returns a handle at once and reads & decodes
+		//	  the file on a worker thread; Update creates a few of the
+		//	  decoded textures each frame
+		//	- drawing a texture that is still loading quietly fails
+		//	- LoadTexture of a file that is still loading waits for it
+		//	- FinishLoads creates the decoded textures now (wait: until every
+		//	  load is done) & returns how many loads are still pending
+		virtual	HTexture	LoadTextureAsync	( const wchar_t* filename, Color colorKey = {0,0,0,0} )		= 0;
+		virtual	HTexture	LoadTextureAsync	( const char* filename, Color colorKey = {0,0,0,0} )		= 0;
+		virtual	LoadStatus	GetTextureStatus	( HTexture handle )											= 0;
+		virtual	unsigned int	FinishLoads		( bool wait = false )										= 0;
+
+
+		virtual	const GraphicsStats&	GetFrameStats	( void ) const		= 0;	// counters of the last completed frame
+		virtual	const CacheStats&		GetCacheStats	( void ) const		= 0;	// LoadTexture hits & misses by file name
+
+
 	protected:
 		GraphicsManager					( void )					= default;
 		virtual	~GraphicsManager		( void )					= default;
@@ -99,6 +99,37 @@ namespace SGD
 	//*****************************************************************//
 	// Global identifier for invalid handles
 	const SGD_IMPLEMENTATION::Handle INVALID_HANDLE;
+
+
+	//*****************************************************************//
+	// CacheStats
+	//	- file loads of a manager since it was initialized
+	//	- a hit reuses a file that is already loaded (same file name),
+	//	  a miss has to read the file
+	//	- bytes are the memory created by the loads (32-bit texels of
+	//	  a texture's top level, an audio file's sample data)
+	struct CacheStats
+	{
+		unsigned int		unHits				= 0;
+		unsigned int		unMisses			= 0;
+		unsigned int		unLoads				= 0;	// files read successfully
+		unsigned int		unUnloads			= 0;	// files freed by their last unload
+		unsigned int		unResident			= 0;	// files currently loaded
+		unsigned long long	ullBytesLoaded		= 0;
+	};
+
+
+	//*****************************************************************//
+	// LoadStatus
+	//	- state of a file loaded asynchronously (LoadTextureAsync,
+	//	  LoadAudioAsync); a synchronous load is Loaded at once
+	//	- enumerators REQUIRE the enum typename scope: LoadStatus::Pending
+	enum class LoadStatus
+	{
+		Pending,			// still reading, decoding or waiting to upload
+		Loaded,
+		Failed,				// unreadable file or invalid handle
+	};
 	
 }	// namespace SGD
 
@@ -17,8 +17,7 @@
 
 
 #include "SGD_Handle.h"		// Identifies data using unique handles
-#include <vector>			// Stores data in a std::vector
-#include <list>				// Stores recycled handles in a std::list
+#include <vector>			// Stores slots & data in std::vectors
 
 
 namespace SGD
@@ -28,9 +27,21 @@ namespace SGD
 		//*************************************************************//
 		// HandleManager<>
 		//	- templated data storage, using compressed handle identifiers
-		template< typename DataType >
+		//	- a handle is a slot index (the low IndexBits) and the slot's
+		//	  generation (the other bits, starting at 1: a handle is never
+		//	  INVALID_HANDLE); every store into a slot uses its next
+		//	  generation, so the handles of its earlier data stop validating
+		//	- free slots form a list linked through the slot array itself
+		//	  (no allocation per removal)
+		//	- the live data is packed in a dense array (removal moves the
+		//	  last element into the hole): ForEach only visits live data,
+		//	  and a GetData pointer is valid until the next StoreData or
+		//	  RemoveData
+		template< typename DataType, unsigned int IndexBits = 20 >
 		class HandleManager
 		{
+			static_assert( IndexBits >= 8 && IndexBits <= 28, "HandleManager - IndexBits must leave room for generations" );
+
 		public:
 			HandleManager	( void );					// Default constructor
 			~HandleManager	( void );					// Destructor
@@ -40,7 +51,10 @@ namespace SGD
 			bool			IsHandleValid	( Handle handle ) const;
 			DataType*		GetData			( Handle handle ) const;
 			bool			RemoveData		( Handle handle, DataType* data );
-			bool			Clear			( void );
+			bool			RemoveAll		( void );	// keeps the generations: every old handle stays invalid
+			bool			Clear			( void );	// forgets the generations: old handles may validate again
+
+			unsigned int	GetCount		( void ) const		{	return (unsigned int)m_vData.size();	}	// live data
 
 			template< typename TExtraInfo >
 			void			ForEach			( bool (*pFunction)( Handle handle, DataType& data, TExtraInfo* extra ), TExtraInfo* extra ) const;
@@ -51,14 +65,30 @@ namespace SGD
 			HandleManager&	operator=	( const HandleManager& )	= delete;	// Assignment operator
 
 
-			// Type names for data architecture
-			typedef std::pair	< Handle, DataType >		DataPair;
-			typedef std::vector	< DataPair >				DataVector;
-			typedef std::list	< Handle >					HandleList;
+			// Handle layout
+			static const unsigned long	INDEX_MASK		= (1ul << IndexBits) - 1;
+			static const unsigned long	MAX_GENERATION	= (1ul << (32 - IndexBits)) - 1;
+			static const unsigned int	NO_SLOT			= 0xFFFFFFFF;
+
+			// Slot
+			//	- live: its handle & the position of its data
+			//	- free: INVALID_HANDLE & the next free slot
+			struct Slot
+			{
+				Handle			handle;
+				unsigned long	ulGeneration;			// of the slot's latest handle
+				unsigned int	unLink;					// dense index, or next free slot (NO_SLOT ends the list)
+			};
+
+			unsigned int		FindSlot		( Handle handle ) const;	// NO_SLOT if the handle is not live
+
 
 			// Data Storage:
-			DataVector			m_vData;					// Vector of handle-data pairs
-			HandleList			m_lFreeIndices;				// Linked-list of empty locations in the vector
+			std::vector< Slot >		m_vSlots;				// indexed by the handles
+			unsigned int			m_unFreeSlot	= NO_SLOT;	// head of the free list
+
+			std::vector< DataType >	m_vData;				// live data (dense)
+			std::vector< Handle >	m_vHandles;				// handle of each live data
 		};
 
 	};	// namespace SGD_IMPLEMENTATION
@@ -27,73 +27,21 @@ namespace SGD
 	namespace SGD_IMPLEMENTATION
 	{
 		//*************************************************************//
-		// Handle Components
-		//	- union interprets between handle and components
-		//	- bitfield enforces how much data the component can store
-		//	  rrrrrrrr iiiiiiii iiiiiiii iiiiiiii
+		// HandleDecoder
+		//	- converts between handles and their 32-bit values
+		//	  (the HandleManager chooses the layout)
 		class HandleDecoder
 		{
-			#define BITS_REUSE	(8)
-			#define BITS_INDEX	(32 - BITS_REUSE)
-
-			#define MAX_REUSES	((1 << BITS_REUSE) - 1)
-			#define MAX_INDICES	((1 << BITS_INDEX) - 1)
-
-			union UHandle
-			{
-				unsigned long		handle;					// Handle data
-	
-				struct /* anonymous */
-				{
-					unsigned long	index	: BITS_INDEX;	// index into the vector
-					unsigned long	reuse	: BITS_REUSE;	// reuse number
-				};
-			};
-
 		public:
-			// Handle Conversion
-			//	- inline function attempts to optimize for speed
-			static inline unsigned long HandleToReuse( Handle handle )
+			static inline unsigned long HandleToValue( Handle handle )
 			{
-				UHandle convert = { handle.m_ulHandle };
-				return convert.reuse;
+				return handle.m_ulHandle;
 			}
-	
-			static inline unsigned long HandleToIndex( Handle handle )
-			{
-				UHandle convert = { handle.m_ulHandle };
-				return convert.index;
-			}
-	
-			static inline Handle CreateHandle( unsigned long reuse, unsigned long index )
-			{
-				SGD_ASSERT( index <= MAX_INDICES, "HandleDecoder::CreateHandle - index exceeds maximum value!" );
-				if( index > MAX_INDICES )
-					return SGD::INVALID_HANDLE;
 
-				UHandle convert = { };
-				convert.reuse = reuse;
-				convert.index = index;
-				return Handle( convert.handle );
-			}
-	
-			static inline Handle ReuseHandle( Handle handle )
+			static inline Handle ValueToHandle( unsigned long value )
 			{
-				UHandle convert = { handle.m_ulHandle };
-	
-				if( convert.reuse == MAX_REUSES )
-					convert.reuse = 1;
-				else
-					convert.reuse++;
-
-				return Handle( convert.handle );
+				return Handle( value );
 			}
-
-			#undef	BITS_REUSE
-			#undef	BITS_INDEX
-
-			#undef	MAX_REUSES
-			#undef	MAX_INDICES
 		};
 		//*************************************************************//
 	
@@ -101,11 +49,13 @@ namespace SGD
 
 		//*************************************************************//
 		// CONSTRUCTOR
-		template< typename DataType >
-		HandleManager< DataType >::HandleManager( void )
+		template< typename DataType, unsigned int IndexBits >
+		HandleManager< DataType, IndexBits >::HandleManager( void )
 		{
-			// Allocate some room in the vector
+			// Allocate some room in the vectors
+			m_vSlots.reserve( 4 );
 			m_vData.reserve( 4 );
+			m_vHandles.reserve( 4 );
 		}
 		//*************************************************************//
 
@@ -113,12 +63,13 @@ namespace SGD
 	
 		//*************************************************************//
 		// DESTRUCTOR
-		template< typename DataType >
-		HandleManager< DataType >::~HandleManager( void )
+		template< typename DataType, unsigned int IndexBits >
+		HandleManager< DataType, IndexBits >::~HandleManager( void )
 		{
 			// Explicitly empty the containers (does not deallocate stored data)
+			m_vSlots.clear();
 			m_vData.clear();
-			m_lFreeIndices.clear();
+			m_vHandles.clear();
 		}
 		//*************************************************************//
 	
@@ -126,47 +77,43 @@ namespace SGD
 	
 		//*************************************************************//
 		// STORE DATA
-		// - store data into the list (reusing an empty spot if available)
+		// - store data into a free slot (or a new one)
 		// - return the unique handle to the data
-		template< typename DataType >
-		Handle HandleManager< DataType >::StoreData( DataType data )
+		template< typename DataType, unsigned int IndexBits >
+		Handle HandleManager< DataType, IndexBits >::StoreData( DataType data )
 		{
-			// Are there any free spots available?
-			if( m_lFreeIndices.empty() == false )
+			// Pop a free slot, or append one
+			unsigned int index;
+			if( m_unFreeSlot != NO_SLOT )
 			{
-				// Reuse the last handle in the free list
-				Handle handle = m_lFreeIndices.back();
-				m_lFreeIndices.pop_back();
-				handle = HandleDecoder::ReuseHandle( handle );
-				SGD_ASSERT( handle != SGD::INVALID_HANDLE, "HandleManager::StoreData - new handle is invalid ... sorry!" );
-				if( handle == SGD::INVALID_HANDLE )
-					return SGD::INVALID_HANDLE;
-
-				// Store the new data
-				unsigned int index = HandleDecoder::HandleToIndex( handle );
-				m_vData[ index ].first	= handle;
-				m_vData[ index ].second	= data;
-
-				// Return the handle
-				return handle;
+				index = m_unFreeSlot;
+				m_unFreeSlot = m_vSlots[ index ].unLink;
 			}
 			else
 			{
-				// Create a new handle (at the end of the container)
-				Handle handle = HandleDecoder::CreateHandle( 1, m_vData.size() );
-				SGD_ASSERT( handle != SGD::INVALID_HANDLE, "HandleManager::StoreData - new handle is invalid ... sorry!" );
-				if( handle == SGD::INVALID_HANDLE )
+				SGD_ASSERT( m_vSlots.size() <= INDEX_MASK, "HandleManager::StoreData - index exceeds maximum value!" );
+				if( m_vSlots.size() > INDEX_MASK )
 					return SGD::INVALID_HANDLE;
-		
-				// Store the new data
-				DataPair info;
-				info.first		= handle;
-				info.second		= data;
-				m_vData.push_back( info );
-		
-				// Return the handle
-				return handle;
+
+				index = (unsigned int)m_vSlots.size();
+
+				Slot slot = { SGD::INVALID_HANDLE, 0, NO_SLOT };
+				m_vSlots.push_back( slot );
 			}
+
+
+			// Next generation (wrapping back to 1)
+			Slot& slot = m_vSlots[ index ];
+			slot.ulGeneration = (slot.ulGeneration >= MAX_GENERATION) ? 1 : slot.ulGeneration + 1;
+			slot.handle	= HandleDecoder::ValueToHandle( (slot.ulGeneration << IndexBits) | index );
+			slot.unLink	= (unsigned int)m_vData.size();
+
+			// Store the new data at the end of the dense arrays
+			m_vData.push_back( data );
+			m_vHandles.push_back( slot.handle );
+
+			// Return the handle
+			return slot.handle;
 		}
 		//*************************************************************//
 
@@ -175,21 +122,10 @@ namespace SGD
 		//*************************************************************//
 		// IS HANDLE VALID
 		//	- check if the handle is still valid
-		template< typename DataType >
-		bool HandleManager< DataType >::IsHandleValid( Handle handle ) const
+		template< typename DataType, unsigned int IndexBits >
+		bool HandleManager< DataType, IndexBits >::IsHandleValid( Handle handle ) const
 		{
-			// Easy check
-			if( handle == SGD::INVALID_HANDLE )
-				return false;
-
-			// Verify the index indicated by the handle
-			unsigned int index = HandleDecoder::HandleToIndex( handle );
-			if( index >= m_vData.size() )
-				return false;
-	
-			// Verify the handle still corresponds to the stored data
-			const DataPair& info = m_vData[ index ];
-			return (info.first == handle);
+			return FindSlot( handle ) != NO_SLOT;
 		}
 		//*************************************************************//
 	
@@ -197,30 +133,21 @@ namespace SGD
 	
 		//*************************************************************//
 		// GET DATA
-		//	- return the data stored at the location indicated by the handle
-		template< typename DataType >
-		DataType* HandleManager< DataType >::GetData( Handle handle ) const
+		//	- return the data stored for the handle
+		template< typename DataType, unsigned int IndexBits >
+		DataType* HandleManager< DataType, IndexBits >::GetData( Handle handle ) const
 		{
 			// Verify the parameter
 			SGD_ASSERT( handle != SGD::INVALID_HANDLE, "HandleManager::GetData - handle is invalid" );
-			if( handle == SGD::INVALID_HANDLE )
-				return nullptr;
 
-			// Access the data indicated by the handle
-			unsigned int index = HandleDecoder::HandleToIndex( handle );
-			SGD_ASSERT( index < m_vData.size(), "HandleManager::GetData - handle has invalid index" );
-			if( index >= m_vData.size() )
-				return nullptr;
-	
 			// Verify the handle still corresponds to the stored data
-			const DataPair& info = m_vData[ index ];
-			SGD_ASSERT( info.first != SGD::INVALID_HANDLE, "HandleManager::GetData - handle has been removed" );
-			SGD_ASSERT( info.first == handle, "HandleManager::GetData - handle has expired (another asset is using the location)" );
-			if( info.first != handle )
+			unsigned int index = FindSlot( handle );
+			SGD_ASSERT( handle == SGD::INVALID_HANDLE || index != NO_SLOT, "HandleManager::GetData - handle has expired (removed, or another asset is using the location)" );
+			if( index == NO_SLOT )
 				return nullptr;
 
 			// Return the stored data
-			return const_cast< DataType* >(&info.second);
+			return const_cast< DataType* >( &m_vData[ m_vSlots[ index ].unLink ] );
 		}
 		//*************************************************************//
 	
@@ -228,60 +155,91 @@ namespace SGD
 	
 		//*************************************************************//
 		// REMOVE DATA
-		//	- remove the data stored at the location indicated by the handle
+		//	- remove the data stored for the handle
 		//	- return the data
-		template< typename DataType >
-		bool HandleManager< DataType >::RemoveData( Handle handle, DataType* data )
+		template< typename DataType, unsigned int IndexBits >
+		bool HandleManager< DataType, IndexBits >::RemoveData( Handle handle, DataType* data )
 		{
 			// Verify the parameter
-			SGD_ASSERT( handle != SGD::INVALID_HANDLE, "HandleManager::GetData - handle is invalid" );
-			if( handle == SGD::INVALID_HANDLE )
-				return false;
+			SGD_ASSERT( handle != SGD::INVALID_HANDLE, "HandleManager::RemoveData - handle is invalid" );
 
-			// Access the data indicated by the handle
-			unsigned int index = HandleDecoder::HandleToIndex( handle );
-			SGD_ASSERT( index < m_vData.size(), "HandleManager::RemoveData - handle has invalid index" );
-			if( index >= m_vData.size() )
-				return false;
-	
 			// Verify the handle still corresponds to the stored data
-			DataPair& info = m_vData[ index ];
-			SGD_ASSERT( info.first != SGD::INVALID_HANDLE, "HandleManager::RemoveData - handle has already been removed" );
-			SGD_ASSERT( info.first == handle, "HandleManager::RemoveData - handle has expired (location has been reused)" );
-			if( info.first != handle )
+			unsigned int index = FindSlot( handle );
+			SGD_ASSERT( handle == SGD::INVALID_HANDLE || index != NO_SLOT, "HandleManager::RemoveData - handle has expired (already removed, or the location has been reused)" );
+			if( index == NO_SLOT )
 				return false;
 
+			Slot& slot = m_vSlots[ index ];
+			unsigned int dense = slot.unLink;
+
 
 			// Store the data in the parameter (if they want it)
 			if( data != nullptr )
-				*data = info.second;
+				*data = m_vData[ dense ];
+
+
+			// Move the last data into the hole
+			unsigned int last = (unsigned int)m_vData.size() - 1;
+			if( dense != last )
+			{
+				m_vData[ dense ]	= m_vData[ last ];
+				m_vHandles[ dense ]	= m_vHandles[ last ];
+
+				m_vSlots[ HandleDecoder::HandleToValue( m_vHandles[ dense ] ) & INDEX_MASK ].unLink = dense;
+			}
 
+			m_vData.pop_back();
+			m_vHandles.pop_back();
 
-			// Erase data from the container
-			m_vData[ index ].first	= SGD::INVALID_HANDLE;
-			m_vData[ index ].second	= DataType();			// calling the constructor may be harmful ... oh well
 
-			// Add the handle into the free list
-			m_lFreeIndices.push_back( handle );
+			// Push the slot onto the free list
+			slot.handle	= SGD::INVALID_HANDLE;
+			slot.unLink	= m_unFreeSlot;
+			m_unFreeSlot = index;
 			return true;
 		}
 		//*************************************************************//
 
 
 		
+		//*************************************************************//
+		// REMOVE ALL
+		//	- remove all data, but keep the slots & their generations
+		//	  (the next store into a slot still uses its next generation)
+		template< typename DataType, unsigned int IndexBits >
+		bool HandleManager< DataType, IndexBits >::RemoveAll( void )
+		{
+			// Push every live slot onto the free list
+			for( unsigned int i = 0; i < m_vHandles.size(); i++ )
+			{
+				unsigned int index = HandleDecoder::HandleToValue( m_vHandles[ i ] ) & INDEX_MASK;
+
+				m_vSlots[ index ].handle	= SGD::INVALID_HANDLE;
+				m_vSlots[ index ].unLink	= m_unFreeSlot;
+				m_unFreeSlot = index;
+			}
+
+			// Empty the dense arrays (keeping their storage)
+			m_vData.clear();
+			m_vHandles.clear();
+			return true;
+		}
+		//*************************************************************//
+
+
+
 		//*************************************************************//
 		// CLEAR
 		//	- remove all handles
-		template< typename DataType >
-		bool HandleManager< DataType >::Clear( void )
+		template< typename DataType, unsigned int IndexBits >
+		bool HandleManager< DataType, IndexBits >::Clear( void )
 		{
-			// Clear the free list
-			m_lFreeIndices.clear();
-
 			// Clear the data (does not deallocate individual objects)
-			m_vData.clear();
-			m_vData.swap( std::move( DataVector() ) );		// force the collapse
+			std::vector< Slot >().swap( m_vSlots );			// force the collapse
+			std::vector< DataType >().swap( m_vData );
+			std::vector< Handle >().swap( m_vHandles );
 
+			m_unFreeSlot = NO_SLOT;
 			return true;
 		}
 		//*************************************************************//
@@ -290,25 +248,49 @@ namespace SGD
 
 		//*************************************************************//
 		// FOR EACH
-		//	- iterate through the data, calling the provided function for each
-		template< typename DataType >
+		//	- iterate through the live data, calling the provided function for each
+		//	- the function must not store or remove data
+		template< typename DataType, unsigned int IndexBits >
 		template< typename TExtraInfo >
-		void HandleManager< DataType >::ForEach( bool (*pFunction)( Handle handle, DataType& data, TExtraInfo* extra ), TExtraInfo* extra ) const
+		void HandleManager< DataType, IndexBits >::ForEach( bool (*pFunction)( Handle handle, DataType& data, TExtraInfo* extra ), TExtraInfo* extra ) const
 		{
 			// Verify the callback function
 			SGD_ASSERT( pFunction != nullptr, "HandleManager::ForEach - invalid function pointer" );
 
-			// Iterate through all the (valid) stored data
-			DataVector::const_iterator iter;
-			for( iter = m_vData.cbegin(); iter != m_vData.cend(); ++iter )
+			// Iterate through the dense data
+			for( unsigned int i = 0; i < m_vData.size(); i++ )
 			{
-				if( iter->first != SGD::INVALID_HANDLE )
-					// Stop looping if the callback function returns false
-					if( pFunction( iter->first, *const_cast< DataType* >(&iter->second), extra ) == false )
-						break;
+				// Stop looping if the callback function returns false
+				if( pFunction( m_vHandles[ i ], *const_cast< DataType* >( &m_vData[ i ] ), extra ) == false )
+					break;
 			}
 		}
 		//*************************************************************//
+
+
+
+		//*************************************************************//
+		// FIND SLOT
+		//	- return the slot index of a live handle, or NO_SLOT
+		template< typename DataType, unsigned int IndexBits >
+		unsigned int HandleManager< DataType, IndexBits >::FindSlot( Handle handle ) const
+		{
+			// Easy check
+			if( handle == SGD::INVALID_HANDLE )
+				return NO_SLOT;
+
+			// Verify the index indicated by the handle
+			unsigned int index = (unsigned int)( HandleDecoder::HandleToValue( handle ) & INDEX_MASK );
+			if( index >= m_vSlots.size() )
+				return NO_SLOT;
+
+			// A free slot holds INVALID_HANDLE, a reused one a later generation
+			if( m_vSlots[ index ].handle != handle )
+				return NO_SLOT;
+
+			return index;
+		}
+		//*************************************************************//
 	
 
 	}	// namespace SGD_IMPLEMENTATION
@@ -0,0 +1,1483 @@
+/***********************************************************************\
+|																		|
+|	File:			SGD_HeadlessGraphicsManager.cpp						|
+|																		|
+|	Purpose:		To stand in for the Direct3D GraphicsManager		|
+|					without a window or GPU: textures are only			|
+|					measured and draw calls are recorded & counted		|
+|																		|
+\***********************************************************************/
+
+#include "SGD_GraphicsManager.h"
+
+
+// Only built in place of the Direct3D backend (SGD_GraphicsManager.cpp)
+#ifdef SGD_HEADLESS_GRAPHICS
+
+
+// Uses FILE* to read the image headers
+#include <cstdio>
+
+// Uses wcslen & towlower
+#include <cwchar>
+#include <cwctype>
+
+// Uses std::wstring for texture names
+#include <string>
+
+// Uses std::vector for the command buffer & file data
+#include <vector>
+
+// Uses std::shared_ptr for the pending loads
+#include <memory>
+
+// Uses ResourceCache for storing data
+#include "SGD_ResourceCache.h"
+
+// Uses AtlasIndex & AtlasDirectory for packed sprites
+#include "SGD_TextureAtlas.h"
+
+// Uses AsyncLoader & DecodePng for asynchronous loads
+#include "SGD_AsyncLoader.h"
+#include "SGD_PngDecoder.h"
+
+// Uses SGD_ASSERT for debug breaks
+#include "SGD_Utilities.h"
+
+
+// Asynchronous loads stored by each Update (as in the Direct3D backend)
+#define SGD_TEXTURES_PER_UPDATE		4
+
+
+namespace SGD
+{
+	namespace SGD_IMPLEMENTATION
+	{
+		//*************************************************************//
+		// TextureInfo
+		//	- stores info for the texture file: size
+		//	  (the cache stores the name & reference count)
+		//	- a packed sprite holds a reference to its atlas page
+		struct TextureInfo
+		{
+			float					fWidth;				// width (rounded up to a power of 2 if not packed)
+			float					fHeight;			// height (rounded up to a power of 2 if not packed)
+
+			HTexture				hPage;				// atlas page (INVALID_HANDLE if not packed)
+			float					fLeft;				// position within the page
+			float					fTop;
+
+			unsigned int			unTicket;			// asynchronous load in progress (0 if none)
+		};
+		//*************************************************************//
+
+
+
+		//*************************************************************//
+		// PendingTexture
+		//	- an asynchronous load, shared by its two loader steps
+		//	- the worker measures the image, the main thread stores it
+		struct PendingTexture
+		{
+			std::wstring			wsFilename;
+			unsigned int			unTicket;			// set once submitted
+
+			bool					bRead;				// was the image measured?
+			unsigned int			unWidth;			// image size
+			unsigned int			unHeight;
+		};
+		//*************************************************************//
+
+
+
+		//*************************************************************//
+		// DrawCommand
+		//	- one recorded draw call, with every parameter it was given
+		//	- texture draws record what the device would sample: a packed
+		//	  sprite records its page & the section within the page
+		struct DrawCommand
+		{
+			enum EType { E_TEXTURE, E_TEXTURE_SECTION, E_TEXTURE_BATCH, E_RECTANGLE, E_LINE, E_STRING };
+
+			EType					eType;
+			HTexture				hTexture;			// textures
+			Point					ptPosition;			// textures, strings, line start
+			Point					ptEnd;				// line end
+			Rectangle				rRect;				// texture section, rectangle
+			float					fRotation;			// textures
+			Vector					vtRotationOffset;	// textures
+			Size					szScale;			// textures
+			Color					color;				// modulation, fill, line or text color
+			Color					lineColor;			// rectangle outline
+			unsigned int			unLineWidth;		// lines, rectangle outline
+			unsigned int			unTextStart;		// strings: range in the text buffer
+			unsigned int			unTextLength;
+			unsigned int			unQuadStart;		// batches: range in the quad buffer
+			unsigned int			unQuadCount;
+		};
+		//*************************************************************//
+
+
+
+		//*************************************************************//
+		// GraphicsManager
+		//	- headless class with the same interface & texture handles
+		//	- textures are opened only to read their size from the header
+		//	  (.bmp, .dds, .dib, .jpg, .png, .ppm, .pfm and .tga)
+		//	- asynchronous loads decode PNG files on the loader's workers,
+		//	  so they do the same work as the Direct3D backend's
+		//	- every draw is appended to the frame's command buffer,
+		//	  which Update clears after closing the frame's counters
+		class GraphicsManager : public SGD::GraphicsManager
+		{
+		public:
+			// SINGLETON
+			static	GraphicsManager*	GetInstance		( void );
+			static	void				DeleteInstance	( void );
+
+
+			virtual	bool		Initialize				( bool bVsync )		override;
+			virtual	bool		Initialize				( const wchar_t* title, Size size, bool vsync )		override;
+			virtual	bool		Update					( void )			override;
+			virtual	bool		Terminate				( void )			override;
+
+
+			virtual bool		SetClearColor			( Color color )					override;
+			virtual bool		SetPixelatedMode		( bool pixelated )				override;
+			virtual bool		ShowCursor				( bool show )					override;
+			virtual bool		ShowConsoleWindow		( bool show )					override;
+			virtual bool		Resize					( Size size, bool windowed )	override;
+			virtual bool		IsForegroundWindow		( void )						override;
+
+
+			virtual bool		DrawString				( const wchar_t* text, Point position,  Color color )						override;
+			virtual bool		DrawString				( const char* text, Point position,  Color color )							override;
+			virtual bool		DrawLine				( Point position1, Point position2, Color color, unsigned int width )		override;
+			virtual bool		DrawRectangle			( Rectangle rect, Color fillColor, Color lineColor, unsigned int width )	override;
+
+
+			virtual	HTexture	LoadTexture				( const wchar_t* filename, Color colorKey )		override;
+			virtual	HTexture	LoadTexture				( const char* filename, Color colorKey )		override;
+			virtual	bool		DrawTexture				( HTexture handle, Point position, float rotation, Vector rotationOffset, Color color, Size scale )						override;
+			virtual	bool		DrawTextureSection		( HTexture handle, Point position, Rectangle section, float rotation, Vector rotationOffset, Color color, Size scale )	override;
+			virtual	bool		DrawTextureBatch		( HTexture handle, const SpriteQuad* quads, unsigned int count )		override;
+			virtual	bool		UnloadTexture			( HTexture& handle )							override;
+
+
+			virtual	bool		LoadAtlas				( const wchar_t* filename )						override;
+			virtual	bool		LoadAtlas				( const char* filename )						override;
+
+
+			virtual	HTexture	LoadTextureAsync		( const wchar_t* filename, Color colorKey )		override;
+			virtual	HTexture	LoadTextureAsync		( const char* filename, Color colorKey )		override;
+			virtual	LoadStatus	GetTextureStatus		( HTexture handle )								override;
+			virtual	unsigned int	FinishLoads			( bool wait )									override;
+
+
+			virtual	const GraphicsStats&	GetFrameStats	( void ) const		override	{	return m_FrameStats;	}
+			virtual	const CacheStats&		GetCacheStats	( void ) const		override	{	return m_Textures.GetStats();	}
+
+		private:
+			// SINGLETON
+			static	GraphicsManager*		s_Instance;		// the ONE instance
+
+			GraphicsManager					( void )					= default;		// Default constructor
+			virtual	~GraphicsManager		( void )					= default;		// Destructor
+
+			GraphicsManager					( const GraphicsManager& )	= delete;		// Copy constructor
+			GraphicsManager&	operator=	( const GraphicsManager& )	= delete;		// Assignment operator
+
+
+			// Wrapper Status
+			enum EGraphicsManagerStatus
+			{	
+				E_UNINITIALIZED,
+				E_INITIALIZED,
+				E_DESTROYED
+			};
+
+			EGraphicsManagerStatus		m_eStatus			= E_UNINITIALIZED;			// wrapper initialization status
+
+			ResourceCache< TextureInfo > m_Textures;									// data storage
+			AtlasDirectory				m_Atlases;										// packed sprites by file name
+			AsyncLoader					m_Loader;										// asynchronous texture loads
+
+			Color						m_ClearColor		= Color{0, 0, 0};			// background clear color
+			bool						m_bPixelated		= true;						// texel sample state
+			Size						m_WindowSize		= Size{};					// virtual window size
+
+			std::vector< DrawCommand >	m_vCommands;									// draws of the current frame
+			std::vector< wchar_t >		m_vText;										// string characters of the current frame
+			std::vector< SpriteQuad >	m_vQuads;										// batched quads of the current frame
+
+			GraphicsStats				m_FrameStats		= GraphicsStats{};			// counters of the last completed frame
+			GraphicsStats				m_CurrentStats		= GraphicsStats{};			// counters of the frame being drawn
+			int							m_nLastDraw			= -1;						// type of the previous draw
+			HTexture					m_hLastTexture		= HTexture{};				// texture of the previous texture draw
+
+
+			// COMMAND RECORDING HELPER METHOD
+			DrawCommand&	RecordCommand( DrawCommand::EType type, HTexture texture );
+
+
+			// ATLAS HELPER METHODS
+			HTexture		LoadAtlasSprite( const wchar_t* filename, const AtlasDirectory::Entry& sprite, bool async );
+			static	HTexture	GetSource( HTexture handle, const TextureInfo& data, Rectangle& section );
+
+
+			// IMAGE HEADER HELPER METHODS
+			static	FILE*	OpenFile( const wchar_t* filename );
+			static	bool	ReadImageSize( const wchar_t* filename, unsigned int& width, unsigned int& height );
+
+
+			// TEXTURE LOADING HELPER METHODS
+			static	void	StoreTextureSize( TextureInfo& data, unsigned int imageWidth, unsigned int imageHeight );
+			bool			IsTextureReady( const TextureInfo& data );
+			void			WaitForTexture( HTexture handle );
+
+			static	void	DecodeTexture( PendingTexture& pending );
+			void			FinishTexture( HTexture handle, PendingTexture& pending );
+		};
+		//*************************************************************//
+
+	}	// namespace SGD_IMPLEMENTATION
+
+
+
+	//*****************************************************************//
+	// Interface singleton accessor
+	/*static*/ GraphicsManager* GraphicsManager::GetInstance( void )
+	{
+		return (SGD::GraphicsManager*)SGD_IMPLEMENTATION::GraphicsManager::GetInstance();
+	}
+
+	// Interface singleton destructor
+	/*static*/ void GraphicsManager::DeleteInstance( void )
+	{
+		return SGD_IMPLEMENTATION::GraphicsManager::DeleteInstance();
+	}
+	//*****************************************************************//
+
+
+
+	namespace SGD_IMPLEMENTATION
+	{
+		//*************************************************************//	
+		// SINGLETON
+
+		// Instantiate static pointer to null (no instance yet)
+		/*static*/ GraphicsManager* GraphicsManager::s_Instance = nullptr;
+
+		// Singleton accessor
+		/*static*/ GraphicsManager* GraphicsManager::GetInstance( void )
+		{
+			// Allocate singleton on first use
+			if( GraphicsManager::s_Instance == nullptr )
+				GraphicsManager::s_Instance = new GraphicsManager;
+
+			// Return the singleton
+			return GraphicsManager::s_Instance;
+		}
+
+		// Singleton destructor
+		/*static*/ void GraphicsManager::DeleteInstance( void )
+		{
+			// Deallocate singleton
+			delete GraphicsManager::s_Instance;
+			GraphicsManager::s_Instance = nullptr;
+		}
+		//*************************************************************//
+
+
+
+		//*************************************************************//
+		// INITIALIZE
+		bool GraphicsManager::Initialize( bool bVsync )
+		{
+			// Sanity-check the wrapper's status
+			SGD_ASSERT( m_eStatus == E_UNINITIALIZED, "GraphicsManager::Initialize - wrapper has already been initialized" );
+			if( m_eStatus != E_UNINITIALIZED )
+				return false;
+
+			(void)bVsync;		// nothing is presented
+
+
+			// Default to the Direct3D backend's default window size
+			if( m_WindowSize.width <= 0 || m_WindowSize.height <= 0 )
+				m_WindowSize = Size{ 1024, 768 };
+
+			// Start the asynchronous loader's workers
+			m_Loader.Initialize();
+
+			m_eStatus = E_INITIALIZED;
+			return true;
+		}
+		//*************************************************************//
+
+
+
+		//*************************************************************//
+		// INITIALIZE
+		bool GraphicsManager::Initialize( const wchar_t* title, Size size, bool vsync )
+		{
+			// Sanity-check the wrapper's status
+			SGD_ASSERT( m_eStatus == E_UNINITIALIZED, "GraphicsManager::Initialize - wrapper has already been initialized" );
+			if( m_eStatus != E_UNINITIALIZED )
+				return false;
+
+			(void)title;		// no window
+
+			m_WindowSize = size;
+			return Initialize( vsync );
+		}
+		//*************************************************************//
+
+
+
+		//*************************************************************//
+		// UPDATE
+		//	- closes the frame: the counters become the frame stats
+		//	  and the command buffer starts over (keeping its storage)
+		//	- stores a few of the textures loaded asynchronously
+		bool GraphicsManager::Update( void )
+		{
+			// Sanity-check the wrapper's status
+			SGD_ASSERT( m_eStatus == E_INITIALIZED, "GraphicsManager::Update - wrapper has not been initialized" );
+			if( m_eStatus != E_INITIALIZED )
+				return false;
+
+
+			// Close the frame's counters
+			m_FrameStats	= m_CurrentStats;
+			m_CurrentStats	= GraphicsStats{};
+			m_nLastDraw		= -1;
+			m_hLastTexture	= HTexture{};
+
+			// Start a new command buffer
+			m_vCommands.clear();
+			m_vText.clear();
+			m_vQuads.clear();
+
+
+			// Store a few of the textures decoded asynchronously
+			m_Loader.Update( SGD_TEXTURES_PER_UPDATE );
+
+			return true;
+		}
+		//*************************************************************//
+
+
+
+		//*************************************************************//
+		// TERMINATE
+		bool GraphicsManager::Terminate( void )
+		{
+			// Sanity-check the wrapper's status
+			SGD_ASSERT( m_eStatus == E_INITIALIZED, "GraphicsManager::Terminate - wrapper has not been initialized" );
+			if( m_eStatus != E_INITIALIZED )
+				return false;
+
+
+			// Discard the unfinished loads
+			m_Loader.Terminate();
+
+
+			// Clear handles
+			m_Textures.Clear();
+			m_Atlases.Clear();
+
+			// Deallocate the command buffer
+			std::vector< DrawCommand >().swap( m_vCommands );
+			std::vector< wchar_t >().swap( m_vText );
+			std::vector< SpriteQuad >().swap( m_vQuads );
+
+
+			m_eStatus = E_DESTROYED;
+			return true;
+		}
+		//*************************************************************//
+
+
+
+		//*************************************************************//
+		// SET CLEAR COLOR
+		bool GraphicsManager::SetClearColor( Color color )
+		{
+			// Sanity-check the wrapper's status
+			SGD_ASSERT( m_eStatus == E_INITIALIZED, "GraphicsManager::SetClearColor - wrapper has not been initialized" );
+			if( m_eStatus != E_INITIALIZED )
+				return false;
+
+			// Store the parameter (and force opacity)
+			m_ClearColor = color;
+			m_ClearColor.alpha = 255;
+
+			return true;
+		}
+		//*************************************************************//
+
+
+
+		//*************************************************************//
+		// SET PIXELATED MODE
+		bool GraphicsManager::SetPixelatedMode( bool pixelated )
+		{
+			// Sanity-check the wrapper's status
+			SGD_ASSERT( m_eStatus == E_INITIALIZED, "GraphicsManager::SetPixelatedMode - wrapper has not been initialized" );
+			if( m_eStatus != E_INITIALIZED )
+				return false;
+			
+			// Count the sampler change
+			if( m_bPixelated != pixelated )
+				m_CurrentStats.unStateChanges++;
+
+			// Store the parameter
+			m_bPixelated = pixelated;
+
+			return true;
+		}
+		//*************************************************************//
+
+
+
+		//*************************************************************//
+		// SHOW CURSOR
+		bool GraphicsManager::ShowCursor( bool show )
+		{
+			// Sanity-check the wrapper's status
+			SGD_ASSERT( m_eStatus == E_INITIALIZED, "GraphicsManager::ShowCursor - wrapper has not been initialized" );
+			if( m_eStatus != E_INITIALIZED )
+				return false;
+
+			(void)show;			// no cursor
+			return true;
+		}
+		//*************************************************************//
+
+
+
+		//*************************************************************//
+		// SHOW CONSOLE WINDOW
+		bool GraphicsManager::ShowConsoleWindow( bool show )
+		{
+			(void)show;			// the console belongs to the host process
+			return true;
+		}
+		//*************************************************************//
+
+
+
+		//*************************************************************//
+		// RESIZE
+		bool GraphicsManager::Resize( Size size, bool windowed )
+		{
+			// Sanity-check the wrapper's status
+			SGD_ASSERT( m_eStatus == E_INITIALIZED, "GraphicsManager::Resize - wrapper has not been initialized" );
+			if( m_eStatus != E_INITIALIZED )
+				return false;
+
+			// Sanity-check the size
+			SGD_ASSERT( size.width > 0 && size.height > 0, "GraphicsManager::Resize - size must be positive" );
+			if( size.width <= 0 || size.height <= 0 )
+				return false;
+
+			(void)windowed;		// no display mode
+			m_WindowSize = size;
+			return true;
+		}
+		//*************************************************************//
+
+
+
+		//*************************************************************//
+		// IS FOREGROUND WINDOW
+		bool GraphicsManager::IsForegroundWindow( void )
+		{
+			// Always active, so input & updates are never paused
+			return m_eStatus == E_INITIALIZED;
+		}
+		//*************************************************************//
+
+
+
+		//*************************************************************//
+		// DRAW STRING
+		bool GraphicsManager::DrawString( const wchar_t* text, Point position, Color color )
+		{
+			// Sanity-check the wrapper's status
+			SGD_ASSERT( m_eStatus == E_INITIALIZED, "GraphicsManager::DrawString - wrapper has not been initialized" );
+			if( m_eStatus != E_INITIALIZED )
+				return false;
+			
+			// Sanity-check the text parameter
+			SGD_ASSERT( text != nullptr, "GraphicsManager::DrawString - text cannot be null" );
+			if( text == nullptr || text[0] == L'\0' )
+				return false;
+
+
+			DrawCommand& command	= RecordCommand( DrawCommand::E_STRING, HTexture{} );
+			command.ptPosition		= position;
+			command.color			= color;
+			command.unTextStart		= (unsigned int)m_vText.size();
+			command.unTextLength	= (unsigned int)wcslen( text );
+
+			m_vText.insert( m_vText.end(), text, text + command.unTextLength );
+			return true;
+		}
+		//*************************************************************//
+
+
+
+		//*************************************************************//
+		// DRAW STRING
+		bool GraphicsManager::DrawString( const char* text, Point position, Color color )
+		{
+			// Sanity-check the wrapper's status
+			SGD_ASSERT( m_eStatus == E_INITIALIZED, "GraphicsManager::DrawString - wrapper has not been initialized" );
+			if( m_eStatus != E_INITIALIZED )
+				return false;
+			
+			// Sanity-check the text parameter
+			SGD_ASSERT( text != nullptr, "GraphicsManager::DrawString - text cannot be null" );
+			if( text == nullptr || text[0] == '\0' )
+				return false;
+
+
+			// Widen the characters straight into the text buffer
+			//	(the game only draws ASCII, so no UTF-8 decoding)
+			DrawCommand& command	= RecordCommand( DrawCommand::E_STRING, HTexture{} );
+			command.ptPosition		= position;
+			command.color			= color;
+			command.unTextStart		= (unsigned int)m_vText.size();
+
+			for( const char* c = text; *c != '\0'; ++c )
+				m_vText.push_back( (wchar_t)(unsigned char)*c );
+
+			command.unTextLength	= (unsigned int)m_vText.size() - command.unTextStart;
+			return true;
+		}
+		//*************************************************************//
+
+
+
+		//*************************************************************//
+		// DRAW LINE
+		bool GraphicsManager::DrawLine( Point position1, Point position2, Color color, unsigned int lineWidth )
+		{
+			// Sanity-check the wrapper's status
+			SGD_ASSERT( m_eStatus == E_INITIALIZED, "GraphicsManager::DrawLine - wrapper has not been initialized" );
+			if( m_eStatus != E_INITIALIZED )
+				return false;
+
+
+			DrawCommand& command	= RecordCommand( DrawCommand::E_LINE, HTexture{} );
+			command.ptPosition		= position1;
+			command.ptEnd			= position2;
+			command.color			= color;
+			command.unLineWidth		= lineWidth;
+			return true;
+		}
+		//*************************************************************//
+
+
+
+		//*************************************************************//
+		// DRAW RECTANGLE
+		bool GraphicsManager::DrawRectangle( Rectangle rect, Color fillColor, Color lineColor, unsigned int lineWidth )
+		{
+			// Sanity-check the wrapper's status
+			SGD_ASSERT( m_eStatus == E_INITIALIZED, "GraphicsManager::DrawRectangle - wrapper has not been initialized" );
+			if( m_eStatus != E_INITIALIZED )
+				return false;
+
+
+			// Is the rectangle inverted?
+			SGD_ASSERT( rect.IsEmpty() == false, "GraphicsManager::DrawRectangle - rectangle is empty" );
+			if( rect.IsEmpty() == true )
+				return false;
+
+
+			DrawCommand& command	= RecordCommand( DrawCommand::E_RECTANGLE, HTexture{} );
+			command.rRect			= rect;
+			command.color			= fillColor;
+			command.lineColor		= lineColor;
+			command.unLineWidth		= lineWidth;
+			return true;
+		}
+		//*************************************************************//
+
+
+
+		//*************************************************************//
+		// LOAD TEXTURE
+		HTexture GraphicsManager::LoadTexture( const wchar_t* filename, Color colorKey )
+		{
+			// Sanity-check the wrapper's status
+			SGD_ASSERT( m_eStatus == E_INITIALIZED, "GraphicsManager::LoadTexture - wrapper has not been initialized" );
+			if( m_eStatus != E_INITIALIZED )
+				return SGD::INVALID_HANDLE;
+
+			SGD_ASSERT( filename != nullptr && filename[0] != L'\0', "GraphicsManager::LoadTexture - invalid filename" );
+			if( filename == nullptr || filename[0] == L'\0' )
+				return SGD::INVALID_HANDLE;
+
+			(void)colorKey;		// no pixels
+
+
+			// Attempt to find the texture in the cache
+			// (if it was found, it holds another reference)
+			HTexture existing = m_Textures.Acquire( filename );
+			if( existing != SGD::INVALID_HANDLE )
+			{
+				// Finish an asynchronous load of the file now
+				WaitForTexture( existing );
+
+				if( GetTextureStatus( existing ) == LoadStatus::Failed )
+				{
+					UnloadTexture( existing );
+					return SGD::INVALID_HANDLE;
+				}
+
+				return existing;
+			}
+
+
+			// Is it a packed sprite?
+			const AtlasDirectory::Entry* sprite = m_Atlases.Find( filename );
+			if( sprite != nullptr )
+				return LoadAtlasSprite( filename, *sprite, false );
+
+
+			// Could not find texture in the cache:
+			// read the size from the file's header
+			unsigned int width = 0, height = 0;
+			if( ReadImageSize( filename, width, height ) == false )
+			{
+				// MESSAGE
+				std::wstring message = L"!!! GraphicsManager::LoadTexture - failed to load texture file \"";
+				message += filename;
+				message += L"\" !!!";
+				Alert( message.c_str() );
+
+				return SGD::INVALID_HANDLE;
+			}
+
+
+			// Texture loaded successfully
+			TextureInfo data = { };
+			StoreTextureSize( data, width, height );
+			m_Textures.AddBytesLoaded( (unsigned int)data.fWidth * (unsigned int)data.fHeight * 4 );
+
+
+			// Store texture into the cache
+			return m_Textures.Store( filename, data );
+		}
+		//*************************************************************//
+
+
+
+		//*************************************************************//
+		// LOAD TEXTURE
+		HTexture GraphicsManager::LoadTexture( const char* filename, Color colorKey )
+		{
+			// Sanity-check the wrapper's status
+			SGD_ASSERT( m_eStatus == E_INITIALIZED, "GraphicsManager::LoadTexture - wrapper has not been initialized" );
+			if( m_eStatus != E_INITIALIZED )
+				return SGD::INVALID_HANDLE;
+
+			SGD_ASSERT( filename != nullptr && filename[0] != '\0', "GraphicsManager::LoadTexture - invalid filename" );
+			if( filename == nullptr || filename[0] == '\0' )
+				return SGD::INVALID_HANDLE;
+
+
+			// Widen the filename (file names are ASCII)
+			std::wstring widename;
+			for( const char* c = filename; *c != '\0'; ++c )
+				widename += (wchar_t)(unsigned char)*c;
+
+
+			// Use the UTF16 load
+			return LoadTexture( widename.c_str(), colorKey );
+		}
+		//*************************************************************//
+
+
+
+		//*************************************************************//
+		// DRAW TEXTURE
+		bool GraphicsManager::DrawTexture( HTexture handle, Point position, float rotation, Vector rotationOffset, Color color, Size scale )
+		{
+			// Sanity-check the wrapper's status
+			SGD_ASSERT( m_eStatus == E_INITIALIZED, "GraphicsManager::DrawTexture - wrapper has not been initialized" );
+			if( m_eStatus != E_INITIALIZED )
+				return false;
+
+			SGD_ASSERT( handle != SGD::INVALID_HANDLE, "GraphicsManager::DrawTexture - invalid handle" );
+			if( handle == SGD::INVALID_HANDLE )
+				return false;
+
+
+			// Get the texture info from the handle manager
+			TextureInfo* data = m_Textures.GetData( handle );
+			SGD_ASSERT( data != nullptr, "GraphicsManager::DrawTexture - handle has expired" );
+			if( data == nullptr )
+				return false;
+
+			// Quietly skip a texture that is still loading
+			if( IsTextureReady( *data ) == false )
+				return false;
+
+
+			Rectangle section			= Rectangle{ 0, 0, data->fWidth, data->fHeight };
+			HTexture source				= GetSource( handle, *data, section );
+
+			DrawCommand& command		= RecordCommand( DrawCommand::E_TEXTURE, source );
+			command.ptPosition			= position;
+			command.rRect				= section;
+			command.fRotation			= rotation;
+			command.vtRotationOffset	= rotationOffset;
+			command.color				= color;
+			command.szScale				= scale;
+			return true;
+		}
+		//*************************************************************//
+
+
+
+		//*************************************************************//
+		// DRAW TEXTURE SECTION
+		bool GraphicsManager::DrawTextureSection( HTexture handle, Point position, Rectangle section, float rotation, Vector rotationOffset, Color color, Size scale )
+		{
+			// Sanity-check the wrapper's status
+			SGD_ASSERT( m_eStatus == E_INITIALIZED, "GraphicsManager::DrawTextureSection - wrapper has not been initialized" );
+			if( m_eStatus != E_INITIALIZED )
+				return false;
+
+			SGD_ASSERT( handle != SGD::INVALID_HANDLE, "GraphicsManager::DrawTextureSection - invalid handle" );
+			if( handle == SGD::INVALID_HANDLE )
+				return false;
+
+
+			// Get the texture info from the handle manager
+			TextureInfo* data = m_Textures.GetData( handle );
+			SGD_ASSERT( data != nullptr, "GraphicsManager::DrawTextureSection - handle has expired" );
+			if( data == nullptr )
+				return false;
+
+			// Quietly skip a texture that is still loading
+			if( IsTextureReady( *data ) == false )
+				return false;
+
+			
+			// Is the section inverted?
+			SGD_ASSERT( section.IsEmpty() == false, "GraphicsManager::DrawTextureSection - section rectangle is empty" );
+			if( section.IsEmpty() == true )
+				return false;
+
+
+			HTexture source				= GetSource( handle, *data, section );
+
+			DrawCommand& command		= RecordCommand( DrawCommand::E_TEXTURE_SECTION, source );
+			command.ptPosition			= position;
+			command.rRect				= section;
+			command.fRotation			= rotation;
+			command.vtRotationOffset	= rotationOffset;
+			command.color				= color;
+			command.szScale				= scale;
+			return true;
+		}
+		//*************************************************************//
+
+
+
+		//*************************************************************//
+		// DRAW TEXTURE BATCH
+		bool GraphicsManager::DrawTextureBatch( HTexture handle, const SpriteQuad* quads, unsigned int count )
+		{
+			// Sanity-check the wrapper's status
+			SGD_ASSERT( m_eStatus == E_INITIALIZED, "GraphicsManager::DrawTextureBatch - wrapper has not been initialized" );
+			if( m_eStatus != E_INITIALIZED )
+				return false;
+
+			SGD_ASSERT( handle != SGD::INVALID_HANDLE, "GraphicsManager::DrawTextureBatch - invalid handle" );
+			if( handle == SGD::INVALID_HANDLE )
+				return false;
+
+			SGD_ASSERT( quads != nullptr || count == 0, "GraphicsManager::DrawTextureBatch - quads cannot be null" );
+			if( quads == nullptr || count == 0 )
+				return false;
+
+
+			// Get the texture info from the handle manager
+			TextureInfo* data = m_Textures.GetData( handle );
+			SGD_ASSERT( data != nullptr, "GraphicsManager::DrawTextureBatch - handle has expired" );
+			if( data == nullptr )
+				return false;
+
+			// Quietly skip a texture that is still loading
+			if( IsTextureReady( *data ) == false )
+				return false;
+
+
+			// The quads' sections are stored relative to the page
+			//	(rRect holds the sprite's sub-rectangle)
+			Rectangle section		= Rectangle{ 0, 0, data->fWidth, data->fHeight };
+			HTexture source			= GetSource( handle, *data, section );
+
+			DrawCommand& command	= RecordCommand( DrawCommand::E_TEXTURE_BATCH, source );
+			command.rRect			= section;
+			command.unQuadStart		= (unsigned int)m_vQuads.size();
+			command.unQuadCount		= count;
+
+			m_vQuads.insert( m_vQuads.end(), quads, quads + count );
+			for( unsigned int q = command.unQuadStart; q < m_vQuads.size(); q++ )
+			{
+				Rectangle& quadSection = m_vQuads[ q ].section;
+				if( quadSection.IsEmpty() == true )
+					quadSection = Rectangle{ 0, 0, data->fWidth, data->fHeight };
+
+				quadSection.left	+= data->fLeft;		quadSection.right	+= data->fLeft;
+				quadSection.top		+= data->fTop;		quadSection.bottom	+= data->fTop;
+			}
+			m_CurrentStats.unSprites += count;
+			return true;
+		}
+		//*************************************************************//
+
+
+
+		//*************************************************************//
+		// UNLOAD TEXTURE
+		bool GraphicsManager::UnloadTexture( HTexture& handle )	
+		{
+			// Sanity-check the wrapper's status
+			SGD_ASSERT( m_eStatus == E_INITIALIZED, "GraphicsManager::UnloadTexture - wrapper has not been initialized" );
+			if( m_eStatus != E_INITIALIZED )
+				return false;
+
+			// Quietly ignore bad handles
+			if( handle == INVALID_HANDLE )
+				return false;
+
+
+			// Validate the handle
+			if( m_Textures.GetData( handle ) == nullptr )
+				return false;
+
+			// Release a reference: was it the last one?
+			TextureInfo data = { };
+			if( m_Textures.Release( handle, &data ) == true )
+			{
+				// Release the atlas page of a packed sprite
+				if( data.hPage != SGD::INVALID_HANDLE )
+					UnloadTexture( data.hPage );
+			}
+
+
+			// Invalidate the handle
+			handle = INVALID_HANDLE;
+			return true;
+		}
+		//*************************************************************//
+
+
+
+		//*************************************************************//
+		// LOAD ATLAS
+		bool GraphicsManager::LoadAtlas( const wchar_t* filename )
+		{
+			// Sanity-check the wrapper's status
+			SGD_ASSERT( m_eStatus == E_INITIALIZED, "GraphicsManager::LoadAtlas - wrapper has not been initialized" );
+			if( m_eStatus != E_INITIALIZED )
+				return false;
+
+			SGD_ASSERT( filename != nullptr && filename[0] != L'\0', "GraphicsManager::LoadAtlas - invalid filename" );
+			if( filename == nullptr || filename[0] == L'\0' )
+				return false;
+
+
+			// Read the index (the pages load with their first sprite)
+			AtlasIndex index;
+			FILE* file = OpenFile( filename );
+			bool success = index.Read( file );
+
+			if( file != nullptr )
+				fclose( file );
+
+			if( success == false )
+			{
+				// MESSAGE
+				std::wstring message = L"!!! GraphicsManager::LoadAtlas - failed to load atlas index \"";
+				message += filename;
+				message += L"\" !!!";
+				Alert( message.c_str() );
+
+				return false;
+			}
+
+
+			m_Atlases.Add( index, filename );
+			return true;
+		}
+		//*************************************************************//
+
+
+
+		//*************************************************************//
+		// LOAD ATLAS
+		bool GraphicsManager::LoadAtlas( const char* filename )
+		{
+			// Sanity-check the wrapper's status
+			SGD_ASSERT( m_eStatus == E_INITIALIZED, "GraphicsManager::LoadAtlas - wrapper has not been initialized" );
+			if( m_eStatus != E_INITIALIZED )
+				return false;
+
+			SGD_ASSERT( filename != nullptr && filename[0] != '\0', "GraphicsManager::LoadAtlas - invalid filename" );
+			if( filename == nullptr || filename[0] == '\0' )
+				return false;
+
+
+			// Widen the filename (file names are ASCII)
+			std::wstring widename;
+			for( const char* c = filename; *c != '\0'; ++c )
+				widename += (wchar_t)(unsigned char)*c;
+
+
+			// Use the UTF16 load
+			return LoadAtlas( widename.c_str() );
+		}
+		//*************************************************************//
+
+
+
+		//*************************************************************//
+		// LOAD ATLAS SPRITE
+		//	- load (or reference) the page, then store the sprite as
+		//	  its own texture holding a page reference
+		HTexture GraphicsManager::LoadAtlasSprite( const wchar_t* filename, const AtlasDirectory::Entry& sprite, bool async )
+		{
+			HTexture page = (async == true)
+				? LoadTextureAsync( sprite.wsPage.c_str(), Color{ 0, 0, 0, 0 } )
+				: LoadTexture( sprite.wsPage.c_str(), Color{ 0, 0, 0, 0 } );
+			if( page == SGD::INVALID_HANDLE )
+				return SGD::INVALID_HANDLE;
+
+
+			TextureInfo data = { };
+			data.fWidth		= (float)sprite.unWidth;
+			data.fHeight	= (float)sprite.unHeight;
+			data.hPage		= page;
+			data.fLeft		= (float)sprite.unX;
+			data.fTop		= (float)sprite.unY;
+
+
+			// Store texture into the cache
+			return m_Textures.Store( filename, data );
+		}
+		//*************************************************************//
+
+
+
+		//*************************************************************//
+		// LOAD TEXTURE ASYNC
+		HTexture GraphicsManager::LoadTextureAsync( const wchar_t* filename, Color colorKey )
+		{
+			// Sanity-check the wrapper's status
+			SGD_ASSERT( m_eStatus == E_INITIALIZED, "GraphicsManager::LoadTextureAsync - wrapper has not been initialized" );
+			if( m_eStatus != E_INITIALIZED )
+				return SGD::INVALID_HANDLE;
+
+			SGD_ASSERT( filename != nullptr && filename[0] != L'\0', "GraphicsManager::LoadTextureAsync - invalid filename" );
+			if( filename == nullptr || filename[0] == L'\0' )
+				return SGD::INVALID_HANDLE;
+
+			(void)colorKey;		// no pixels
+
+
+			// Attempt to find the texture in the cache (loaded or still loading)
+			HTexture existing = m_Textures.Acquire( filename );
+			if( existing != SGD::INVALID_HANDLE )
+				return existing;
+
+
+			// Is it a packed sprite? (its page loads asynchronously)
+			const AtlasDirectory::Entry* sprite = m_Atlases.Find( filename );
+			if( sprite != nullptr )
+				return LoadAtlasSprite( filename, *sprite, true );
+
+
+			// Store the entry now: it has no size until the load finishes
+			TextureInfo data = { };
+			data.hPage = SGD::INVALID_HANDLE;
+
+			HTexture handle = m_Textures.Store( filename, data );
+
+
+			// Measure the file on a worker, store it in Update
+			std::shared_ptr< PendingTexture > pending = std::make_shared< PendingTexture >();
+			pending->wsFilename	= filename;
+
+			pending->unTicket = m_Loader.Submit(
+				[ pending ]()					{	DecodeTexture( *pending );			},
+				[ this, handle, pending ]()		{	FinishTexture( handle, *pending );	} );
+
+			m_Textures.GetData( handle )->unTicket = pending->unTicket;
+			return handle;
+		}
+		//*************************************************************//
+
+
+
+		//*************************************************************//
+		// LOAD TEXTURE ASYNC
+		HTexture GraphicsManager::LoadTextureAsync( const char* filename, Color colorKey )
+		{
+			// Sanity-check the wrapper's status
+			SGD_ASSERT( m_eStatus == E_INITIALIZED, "GraphicsManager::LoadTextureAsync - wrapper has not been initialized" );
+			if( m_eStatus != E_INITIALIZED )
+				return SGD::INVALID_HANDLE;
+
+			SGD_ASSERT( filename != nullptr && filename[0] != '\0', "GraphicsManager::LoadTextureAsync - invalid filename" );
+			if( filename == nullptr || filename[0] == '\0' )
+				return SGD::INVALID_HANDLE;
+
+
+			// Widen the filename (file names are ASCII)
+			std::wstring widename;
+			for( const char* c = filename; *c != '\0'; ++c )
+				widename += (wchar_t)(unsigned char)*c;
+
+
+			// Use the UTF16 load
+			return LoadTextureAsync( widename.c_str(), colorKey );
+		}
+		//*************************************************************//
+
+
+
+		//*************************************************************//
+		// GET TEXTURE STATUS
+		//	- a packed sprite is as ready as its page
+		LoadStatus GraphicsManager::GetTextureStatus( HTexture handle )
+		{
+			// Sanity-check the wrapper's status
+			SGD_ASSERT( m_eStatus == E_INITIALIZED, "GraphicsManager::GetTextureStatus - wrapper has not been initialized" );
+			if( m_eStatus != E_INITIALIZED )
+				return LoadStatus::Failed;
+
+			// Quietly report bad handles
+			if( handle == SGD::INVALID_HANDLE || m_Textures.IsHandleValid( handle ) == false )
+				return LoadStatus::Failed;
+
+
+			const TextureInfo* data = m_Textures.GetData( handle );
+			if( data->hPage != SGD::INVALID_HANDLE )
+				data = m_Textures.GetData( data->hPage );
+
+			if( data->unTicket != 0 )
+				return LoadStatus::Pending;
+
+			return (data->fWidth > 0.0f) ? LoadStatus::Loaded : LoadStatus::Failed;
+		}
+		//*************************************************************//
+
+
+
+		//*************************************************************//
+		// FINISH LOADS
+		unsigned int GraphicsManager::FinishLoads( bool wait )
+		{
+			// Sanity-check the wrapper's status
+			SGD_ASSERT( m_eStatus == E_INITIALIZED, "GraphicsManager::FinishLoads - wrapper has not been initialized" );
+			if( m_eStatus != E_INITIALIZED )
+				return 0;
+
+
+			if( wait == true )
+				m_Loader.CompleteAll();
+			else
+				m_Loader.Update( 0xFFFFFFFF );
+
+			return m_Loader.GetPendingCount();
+		}
+		//*************************************************************//
+
+
+
+		//*************************************************************//
+		// STORE TEXTURE SIZE
+		//	- rounded up to powers of 2, like the Direct3D textures
+		/*static*/ void GraphicsManager::StoreTextureSize( TextureInfo& data, unsigned int imageWidth, unsigned int imageHeight )
+		{
+			unsigned int surfaceWidth = 1, surfaceHeight = 1;
+			while( surfaceWidth < imageWidth )
+				surfaceWidth <<= 1;
+			while( surfaceHeight < imageHeight )
+				surfaceHeight <<= 1;
+
+			data.fWidth		= (float)surfaceWidth;
+			data.fHeight	= (float)surfaceHeight;
+			data.hPage		= SGD::INVALID_HANDLE;
+			data.fLeft		= 0.0f;
+			data.fTop		= 0.0f;
+		}
+		//*************************************************************//
+
+
+
+		//*************************************************************//
+		// IS TEXTURE READY
+		//	- false while the texture (or a packed sprite's page) is
+		//	  loading, or if its load failed
+		bool GraphicsManager::IsTextureReady( const TextureInfo& data )
+		{
+			const TextureInfo* texture = &data;
+			if( data.hPage != SGD::INVALID_HANDLE )
+				texture = m_Textures.GetData( data.hPage );
+
+			return texture != nullptr && texture->unTicket == 0 && texture->fWidth > 0.0f;
+		}
+		//*************************************************************//
+
+
+
+		//*************************************************************//
+		// WAIT FOR TEXTURE
+		//	- finish the asynchronous load of the texture (or a packed
+		//	  sprite's page) on this thread
+		void GraphicsManager::WaitForTexture( HTexture handle )
+		{
+			const TextureInfo* data = m_Textures.GetData( handle );
+			if( data != nullptr && data->hPage != SGD::INVALID_HANDLE )
+				data = m_Textures.GetData( data->hPage );
+
+			if( data != nullptr && data->unTicket != 0 )
+				m_Loader.Complete( data->unTicket );
+		}
+		//*************************************************************//
+
+
+
+		//*************************************************************//
+		// DECODE TEXTURE
+		//	- runs on a loader worker: decodes a PNG file completely (the
+		//	  pixels are dropped), other formats are measured from their
+		//	  header
+		//	- touches nothing but the pending load
+		/*static*/ void GraphicsManager::DecodeTexture( PendingTexture& pending )
+		{
+			pending.bRead = false;
+
+			// Read the whole file
+			std::vector< unsigned char > bytes;
+
+			FILE* file = OpenFile( pending.wsFilename.c_str() );
+			if( file == nullptr )
+				return;
+
+			unsigned char buffer[ 4096 ];
+			size_t read;
+			while( (read = fread( buffer, 1, sizeof( buffer ), file )) > 0 )
+				bytes.insert( bytes.end(), buffer, buffer + read );
+
+			fclose( file );
+
+
+			// Decode PNG files, measure the rest
+			std::vector< unsigned char > pixels;
+			if( IsPngFile( bytes.empty() ? nullptr : &bytes[ 0 ], (unsigned int)bytes.size() ) == true )
+				pending.bRead = DecodePng( &bytes[ 0 ], (unsigned int)bytes.size(), pending.unWidth, pending.unHeight, pixels );
+			else
+				pending.bRead = ReadImageSize( pending.wsFilename.c_str(), pending.unWidth, pending.unHeight );
+		}
+		//*************************************************************//
+
+
+
+		//*************************************************************//
+		// FINISH TEXTURE
+		//	- runs on the main thread: stores the size of a decoded load,
+		//	  unless the handle was unloaded in the meantime
+		void GraphicsManager::FinishTexture( HTexture handle, PendingTexture& pending )
+		{
+			// Was the texture unloaded while it was loading?
+			if( m_Textures.IsHandleValid( handle ) == false )
+				return;
+
+			TextureInfo* data = m_Textures.GetData( handle );
+			if( data->unTicket != pending.unTicket )
+				return;
+
+			data->unTicket = 0;
+
+
+			if( pending.bRead == false )
+			{
+				// The entry stays without a size (LoadStatus::Failed)
+
+				// MESSAGE
+				std::wstring message = L"!!! GraphicsManager::LoadTextureAsync - failed to load texture file \"";
+				message += pending.wsFilename;
+				message += L"\" !!!";
+				Alert( message.c_str() );
+
+				return;
+			}
+
+			StoreTextureSize( *data, pending.unWidth, pending.unHeight );
+			m_Textures.AddBytesLoaded( (unsigned int)data->fWidth * (unsigned int)data->fHeight * 4 );
+		}
+		//*************************************************************//
+
+
+
+		//*************************************************************//
+		// GET SOURCE
+		//	- the texture a draw samples: the page of a packed sprite,
+		//	  with the section moved into the page
+		/*static*/ HTexture GraphicsManager::GetSource( HTexture handle, const TextureInfo& data, Rectangle& section )
+		{
+			if( data.hPage == SGD::INVALID_HANDLE )
+				return handle;
+
+			section.left	+= data.fLeft;		section.right	+= data.fLeft;
+			section.top		+= data.fTop;		section.bottom	+= data.fTop;
+			return data.hPage;
+		}
+		//*************************************************************//
+
+
+
+		//*************************************************************//
+		// RECORD COMMAND
+		//	- append a command & count the draw
+		DrawCommand& GraphicsManager::RecordCommand( DrawCommand::EType type, HTexture texture )
+		{
+			switch( type )
+			{
+			case DrawCommand::E_TEXTURE:
+			case DrawCommand::E_TEXTURE_SECTION:	m_CurrentStats.unSprites++;		break;
+			case DrawCommand::E_TEXTURE_BATCH:		m_CurrentStats.unBatches++;		break;
+			case DrawCommand::E_RECTANGLE:			m_CurrentStats.unRectangles++;	break;
+			case DrawCommand::E_LINE:				m_CurrentStats.unLines++;		break;
+			case DrawCommand::E_STRING:				m_CurrentStats.unStrings++;		break;
+			}
+
+			// Different kind of draw? (every texture type draws sprites)
+			int kind = (type == DrawCommand::E_TEXTURE_SECTION || type == DrawCommand::E_TEXTURE_BATCH) ? (int)DrawCommand::E_TEXTURE : (int)type;
+			if( m_nLastDraw != kind )
+			{
+				if( m_nLastDraw != -1 )
+					m_CurrentStats.unStateChanges++;
+
+				m_nLastDraw = kind;
+			}
+
+			// Different texture?
+			if( kind == DrawCommand::E_TEXTURE && texture != m_hLastTexture )
+			{
+				if( m_hLastTexture != INVALID_HANDLE )
+					m_CurrentStats.unTextureSwitches++;
+
+				m_hLastTexture = texture;
+			}
+
+
+			// Append the command with neutral parameters
+			m_vCommands.push_back( DrawCommand() );
+
+			DrawCommand& command	= m_vCommands.back();
+			command.eType			= type;
+			command.hTexture		= texture;
+			command.fRotation		= 0.0f;
+			command.szScale			= Size{ 1.0f, 1.0f };
+			command.unLineWidth		= 0;
+			command.unTextStart		= 0;
+			command.unTextLength	= 0;
+			command.unQuadStart		= 0;
+			command.unQuadCount		= 0;
+
+			return command;
+		}
+		//*************************************************************//
+
+
+
+		//*************************************************************//
+		// OPEN FILE
+		//	- open the file for binary reading from a wide file name
+		/*static*/ FILE* GraphicsManager::OpenFile( const wchar_t* filename )
+		{
+			FILE* file = nullptr;
+
+#if defined( _WIN32 )
+			if( _wfopen_s( &file, filename, L"rb" ) != 0 )
+				file = nullptr;
+#else
+			// Encode the name as UTF-8
+			std::string narrow;
+			for( const wchar_t* c = filename; *c != L'\0'; ++c )
+			{
+				unsigned long code = (unsigned long)*c;
+
+				if( code < 0x80 )
+					narrow += (char)code;
+				else if( code < 0x800 )
+				{
+					narrow += (char)(0xC0 | (code >> 6));
+					narrow += (char)(0x80 | (code & 0x3F));
+				}
+				else if( code < 0x10000 )
+				{
+					narrow += (char)(0xE0 | (code >> 12));
+					narrow += (char)(0x80 | ((code >> 6) & 0x3F));
+					narrow += (char)(0x80 | (code & 0x3F));
+				}
+				else
+				{
+					narrow += (char)(0xF0 | (code >> 18));
+					narrow += (char)(0x80 | ((code >> 12) & 0x3F));
+					narrow += (char)(0x80 | ((code >> 6) & 0x3F));
+					narrow += (char)(0x80 | (code & 0x3F));
+				}
+			}
+
+			file = fopen( narrow.c_str(), "rb" );
+#endif
+
+			return file;
+		}
+		//*************************************************************//
+
+
+
+		//*************************************************************//
+		// READ IMAGE SIZE
+		//	- read the image dimensions from the file header
+		//	  (no pixels are decoded)
+		/*static*/ bool GraphicsManager::ReadImageSize( const wchar_t* filename, unsigned int& width, unsigned int& height )
+		{
+			FILE* file = OpenFile( filename );
+			if( file == nullptr )
+				return false;
+
+			unsigned char header[ 32 ] = { };
+			size_t size = fread( header, 1, sizeof( header ), file );
+
+			width	= 0;
+			height	= 0;
+
+
+			// Header field readers
+			#define SGD_READ_LE16( p )	( (unsigned int)(p)[0] | ((unsigned int)(p)[1] << 8) )
+			#define SGD_READ_LE32( p )	( SGD_READ_LE16( p ) | (SGD_READ_LE16( (p) + 2 ) << 16) )
+			#define SGD_READ_BE16( p )	( ((unsigned int)(p)[0] << 8) | (unsigned int)(p)[1] )
+			#define SGD_READ_BE32( p )	( (SGD_READ_BE16( p ) << 16) | SGD_READ_BE16( (p) + 2 ) )
+
+
+			// Extension (for the formats without a signature)
+			size_t length = wcslen( filename );
+			wchar_t extension[ 4 ] = { };
+			if( length >= 4 && filename[ length - 4 ] == L'.' )
+				for( int i = 0; i < 3; i++ )
+					extension[ i ] = (wchar_t)towlower( filename[ length - 3 + i ] );
+
+
+			if( size >= 24 && header[0] == 0x89 && header[1] == 'P' && header[2] == 'N' && header[3] == 'G' )
+			{
+				// PNG: the IHDR chunk comes first
+				width	= SGD_READ_BE32( header + 16 );
+				height	= SGD_READ_BE32( header + 20 );
+			}
+			else if( size >= 26 && header[0] == 'B' && header[1] == 'M' )
+			{
+				// BMP / DIB: BITMAPINFOHEADER (height is negative for top-down images)
+				width	= SGD_READ_LE32( header + 18 );
+				int h	= (int)SGD_READ_LE32( header + 22 );
+				height	= (unsigned int)(h < 0 ? -h : h);
+			}
+			else if( size >= 20 && header[0] == 'D' && header[1] == 'D' && header[2] == 'S' && header[3] == ' ' )
+			{
+				// DDS: DDS_HEADER follows the magic
+				height	= SGD_READ_LE32( header + 12 );
+				width	= SGD_READ_LE32( header + 16 );
+			}
+			else if( size >= 4 && header[0] == 0xFF && header[1] == 0xD8 )
+			{
+				// JPEG: walk the segments up to the start-of-frame
+				long offset = 2;
+				unsigned char segment[ 9 ];
+
+				while( fseek( file, offset, SEEK_SET ) == 0 && fread( segment, 1, 4, file ) == 4 && segment[0] == 0xFF )
+				{
+					unsigned char marker = segment[1];
+					unsigned int length = SGD_READ_BE16( segment + 2 );
+
+					// SOF0 - SOF15, except DHT (C4), JPG (C8) & DAC (CC)
+					if( marker >= 0xC0 && marker <= 0xCF && marker != 0xC4 && marker != 0xC8 && marker != 0xCC )
+					{
+						if( fread( segment + 4, 1, 5, file ) == 5 )
+						{
+							height	= SGD_READ_BE16( segment + 5 );
+							width	= SGD_READ_BE16( segment + 7 );
+						}
+						break;
+					}
+
+					offset += 2 + length;
+				}
+			}
+			else if( size >= 2 && header[0] == 'P' && (header[1] == '6' || header[1] == '5' || header[1] == '3' || header[1] == 'F' || header[1] == 'f') )
+			{
+				// PPM / PGM / PFM: text header "P6 <width> <height> ..."
+				unsigned int values[ 2 ] = { };
+				unsigned int count = 0;
+				size_t i = 2;
+
+				while( count < 2 && i < size )
+				{
+					if( header[i] == '#' )
+					{
+						// Skip a comment line
+						while( i < size && header[i] != '\n' )
+							i++;
+					}
+					else if( header[i] >= '0' && header[i] <= '9' )
+					{
+						while( i < size && header[i] >= '0' && header[i] <= '9' )
+							values[ count ] = values[ count ] * 10 + (header[i++] - '0');
+						count++;
+						continue;
+					}
+					i++;
+				}
+
+				if( count == 2 )
+				{
+					width	= values[0];
+					height	= values[1];
+				}
+			}
+			else if( size >= 18 && wcscmp( extension, L"tga" ) == 0 )
+			{
+				// TGA: no signature, the size is in the fixed header
+				width	= SGD_READ_LE16( header + 12 );
+				height	= SGD_READ_LE16( header + 14 );
+			}
+
+			#undef SGD_READ_LE16
+			#undef SGD_READ_LE32
+			#undef SGD_READ_BE16
+			#undef SGD_READ_BE32
+
+
+			fclose( file );
+			return width > 0 && height > 0;
+		}
+		//*************************************************************//
+
+	}	// namespace SGD_IMPLEMENTATION
+
+}	// namespace SGD
+
+#endif	//SGD_HEADLESS_GRAPHICS
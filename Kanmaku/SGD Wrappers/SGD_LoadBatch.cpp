@@ -0,0 +1,172 @@
+/***********************************************************************\
+|																		|
+|	File:			SGD_LoadBatch.cpp									|
+|																		|
+|	Purpose:		To track a set of asynchronous texture & audio		|
+|					loads so a state can show its progress				|
+|																		|
+\***********************************************************************/
+
+#include "SGD_LoadBatch.h"
+
+
+// Uses SGD_ASSERT for debug breaks
+#include "SGD_Utilities.h"
+
+
+namespace SGD
+{
+	//*****************************************************************//
+	// CONSTRUCTOR
+	//	- null managers are looked up by the first load, so the batch
+	//	  does not create the audio singleton unless audio is loaded
+	LoadBatch::LoadBatch( GraphicsManager* graphics, AudioManager* audio )
+		: m_pGraphics( graphics ), m_pAudio( audio )
+	{
+	}
+	//*****************************************************************//
+
+
+
+	//*****************************************************************//
+	// LOAD TEXTURE
+	//	- start the load & track the handle
+	HTexture LoadBatch::LoadTexture( const wchar_t* filename, Color colorKey )
+	{
+		if( m_pGraphics == nullptr )
+			m_pGraphics = GraphicsManager::GetInstance();
+
+		HTexture handle = m_pGraphics->LoadTextureAsync( filename, colorKey );
+		SGD_ASSERT( handle != SGD::INVALID_HANDLE, "LoadBatch::LoadTexture - failed to start the load" );
+
+		// An invalid handle counts as a completed, failed load
+		m_vTextures.push_back( handle );
+		return handle;
+	}
+	//*****************************************************************//
+
+
+
+	//*****************************************************************//
+	// LOAD AUDIO
+	//	- start the load & track the handle
+	HAudio LoadBatch::LoadAudio( const wchar_t* filename )
+	{
+		if( m_pAudio == nullptr )
+			m_pAudio = AudioManager::GetInstance();
+
+		HAudio handle = m_pAudio->LoadAudioAsync( filename );
+		SGD_ASSERT( handle != SGD::INVALID_HANDLE, "LoadBatch::LoadAudio - failed to start the load" );
+
+		// An invalid handle counts as a completed, failed load
+		m_vAudio.push_back( handle );
+		return handle;
+	}
+	//*****************************************************************//
+
+
+
+	//*****************************************************************//
+	// UPDATE
+	//	- finish the decoded loads without blocking & recount
+	bool LoadBatch::Update( void )
+	{
+		if( IsComplete() == true )
+			return true;
+
+
+		if( m_vTextures.empty() == false )
+			m_pGraphics->FinishLoads( false );
+		if( m_vAudio.empty() == false )
+			m_pAudio->FinishLoads( false );
+
+
+		m_unCompleted	= 0;
+		m_unFailed		= 0;
+
+		for( unsigned int i = 0; i < m_vTextures.size(); i++ )
+		{
+			LoadStatus status = m_pGraphics->GetTextureStatus( m_vTextures[ i ] );
+			if( status != LoadStatus::Pending )
+				++m_unCompleted;
+			if( status == LoadStatus::Failed )
+				++m_unFailed;
+		}
+
+		for( unsigned int i = 0; i < m_vAudio.size(); i++ )
+		{
+			LoadStatus status = m_pAudio->GetAudioStatus( m_vAudio[ i ] );
+			if( status != LoadStatus::Pending )
+				++m_unCompleted;
+			if( status == LoadStatus::Failed )
+				++m_unFailed;
+		}
+
+		return IsComplete();
+	}
+	//*****************************************************************//
+
+
+
+	//*****************************************************************//
+	// WAIT
+	//	- block until every load of the batch is complete
+	//	- also finishes the managers' other pending loads
+	void LoadBatch::Wait( void )
+	{
+		if( m_vTextures.empty() == false )
+			m_pGraphics->FinishLoads( true );
+		if( m_vAudio.empty() == false )
+			m_pAudio->FinishLoads( true );
+
+		Update();
+	}
+	//*****************************************************************//
+
+
+
+	//*****************************************************************//
+	// CLEAR
+	//	- forget the handles (the caller still owns & unloads them)
+	void LoadBatch::Clear( void )
+	{
+		m_vTextures.clear();
+		m_vAudio.clear();
+		m_unCompleted	= 0;
+		m_unFailed		= 0;
+	}
+	//*****************************************************************//
+
+
+
+	//*****************************************************************//
+	// UNLOAD
+	//	- release the batch's reference of every handle (loads still
+	//	  in progress are discarded if nothing else references them)
+	void LoadBatch::Unload( void )
+	{
+		for( unsigned int i = 0; i < m_vTextures.size(); i++ )
+			m_pGraphics->UnloadTexture( m_vTextures[ i ] );
+
+		for( unsigned int i = 0; i < m_vAudio.size(); i++ )
+			m_pAudio->UnloadAudio( m_vAudio[ i ] );
+
+		Clear();
+	}
+	//*****************************************************************//
+
+
+
+	//*****************************************************************//
+	// GET PROGRESS
+	//	- completed fraction of the batch as of the last Update
+	float LoadBatch::GetProgress( void ) const
+	{
+		if( GetCount() == 0 )
+			return 1.0f;
+
+		return (float)m_unCompleted / (float)GetCount();
+	}
+	//*****************************************************************//
+
+}	// namespace SGD
@@ -0,0 +1,67 @@
+/***********************************************************************\
+|																		|
+|	File:			SGD_LoadBatch.h										|
+|																		|
+|	Purpose:		To track a set of asynchronous texture & audio		|
+|					loads so a state can show its progress				|
+|																		|
+\***********************************************************************/
+
+#ifndef SGD_LOADBATCH_H
+#define SGD_LOADBATCH_H
+
+
+#include "SGD_GraphicsManager.h"	// Loads textures through LoadTextureAsync
+#include "SGD_AudioManager.h"		// Loads audio through LoadAudioAsync
+#include <vector>					// Stores the handles in std::vectors
+
+
+namespace SGD
+{
+	//*****************************************************************//
+	// LoadBatch
+	//	- the Load methods start asynchronous loads and return their
+	//	  handles at once (the handles belong to the caller, who still
+	//	  unloads them, unless the batch owns them & calls Unload)
+	//	- Update finishes the decoded loads & counts the completed ones,
+	//	  GetProgress is the completed fraction for a loading screen
+	//	- Wait blocks until every load of the batch is complete
+	//	- null managers use the GetInstance singletons
+	class LoadBatch
+	{
+	public:
+		LoadBatch		( GraphicsManager* graphics = nullptr, AudioManager* audio = nullptr );
+		~LoadBatch		( void )	= default;
+
+
+		HTexture		LoadTexture		( const wchar_t* filename, Color colorKey = {0,0,0,0} );
+		HAudio			LoadAudio		( const wchar_t* filename );
+
+		bool			Update			( void );		// true once every load is complete
+		void			Wait			( void );
+		void			Clear			( void );		// forget the handles (does not unload)
+		void			Unload			( void );		// unload the handles, then forget them
+
+		unsigned int	GetCount		( void ) const		{	return (unsigned int)(m_vTextures.size() + m_vAudio.size());	}
+		unsigned int	GetCompleted	( void ) const		{	return m_unCompleted;	}
+		unsigned int	GetFailed		( void ) const		{	return m_unFailed;		}
+		float			GetProgress		( void ) const;	// 0 to 1 (1 when empty)
+		bool			IsComplete		( void ) const		{	return m_unCompleted == GetCount();	}
+
+	private:
+		LoadBatch					( const LoadBatch& )	= delete;
+		LoadBatch&		operator=	( const LoadBatch& )	= delete;
+
+
+		GraphicsManager*			m_pGraphics		= nullptr;
+		AudioManager*				m_pAudio		= nullptr;
+
+		std::vector< HTexture >		m_vTextures;	// in load order
+		std::vector< HAudio >		m_vAudio;
+		unsigned int				m_unCompleted	= 0;	// loaded or failed at the last Update
+		unsigned int				m_unFailed		= 0;
+	};
+
+}	// namespace SGD
+
+#endif //SGD_LOADBATCH_H
@@ -0,0 +1,90 @@
+/***********************************************************************\
+|																		|
+|	File:			SGD_MPSCQueue.h										|
+|																		|
+|	Purpose:		To queue items from any number of threads for		|
+|					one consuming thread								|
+|																		|
+\***********************************************************************/
+
+#ifndef SGD_MPSCQUEUE_H
+#define SGD_MPSCQUEUE_H
+
+
+#include <atomic>		// Claims & publishes the ring cells with std::atomics
+#include <mutex>		// Guards the overflow with a std::mutex
+#include <vector>		// Stores the overflow in a std::vector
+
+
+namespace SGD
+{
+	namespace SGD_IMPLEMENTATION
+	{
+		//*************************************************************//
+		// MPSCQueue<>
+		//	- multi-producer, single-consumer queue of small copyable items
+		//	- Push (any thread) claims a cell of a bounded ring with one
+		//	  compare-exchange & publishes it with a sequence number:
+		//	  no lock & no allocation
+		//	- when the ring is full, Push appends to a mutex-guarded
+		//	  overflow instead, and every Push takes the overflow path
+		//	  until the consumer empties it
+		//	- Drain (consumer thread only) hands every item, including
+		//	  the ones pushed during the Drain, to a function; the items
+		//	  of one producer always arrive in the order it pushed them
+		template< typename ItemType >
+		class MPSCQueue
+		{
+		public:
+			explicit MPSCQueue	( unsigned int capacity = 1024 );	// ring cells (rounded up to a power of 2)
+			~MPSCQueue			( void );
+
+
+			void			Push		( const ItemType& item );		// any thread
+
+			template< typename Function >
+			void			Drain		( Function function );			// consumer thread only
+
+			bool			IsEmpty		( void );						// consumer thread only
+
+
+		private:
+			MPSCQueue				( const MPSCQueue& )	= delete;	// Copy constructor
+			MPSCQueue&	operator=	( const MPSCQueue& )	= delete;	// Assignment operator
+
+
+			// Ring cell
+			//	- unSequence == ticket: free for the producer of that ticket
+			//	- unSequence == ticket + 1: published for the consumer
+			struct Cell
+			{
+				std::atomic< unsigned int >	unSequence;
+				ItemType					item;
+			};
+
+			template< typename Function >
+			void			DrainRing	( unsigned int end, Function& function );
+
+
+			Cell*							m_pCells		= nullptr;
+			unsigned int					m_unMask		= 0;		// capacity - 1
+
+			std::atomic< unsigned int >		m_unEnqueue;				// next producer ticket
+			unsigned int					m_unDequeue		= 0;		// next consumer ticket
+
+			std::mutex						m_mtxOverflow;
+			std::vector< ItemType >			m_vOverflow;				// pushed while the ring was full
+			std::atomic< bool >				m_bOverflowing;				// m_vOverflow is not empty
+		};
+
+	}	// namespace SGD_IMPLEMENTATION
+
+}	// namespace SGD
+
+
+// Template definitions are within the .hpp
+#define	INC_SGD_MPSCQUEUE_HPP
+#include "SGD_MPSCQueue.hpp"
+#undef	INC_SGD_MPSCQUEUE_HPP
+
+#endif //SGD_MPSCQUEUE_H
@@ -0,0 +1,187 @@
+/***********************************************************************\
+|																		|
+|	File:			SGD_MPSCQueue.hpp									|
+|																		|
+|	Purpose:		To queue items from any number of threads for		|
+|					one consuming thread								|
+|																		|
+\***********************************************************************/
+
+// This .hpp can ONLY be included from SGD_MPSCQueue.h
+#ifndef INC_SGD_MPSCQUEUE_HPP
+#error	FILE "SGD_MPSCQueue.hpp" CANNOT BE INCLUDED EXPLICITLY
+#else
+
+
+#include <thread>		// Yields with std::this_thread::yield
+
+
+namespace SGD
+{
+	namespace SGD_IMPLEMENTATION
+	{
+		//*************************************************************//
+		// CONSTRUCTOR
+		//	- every cell starts free for its first ticket
+		template< typename ItemType >
+		MPSCQueue< ItemType >::MPSCQueue( unsigned int capacity )
+		{
+			unsigned int size = 2;
+			while( size < capacity )
+				size *= 2;
+
+			m_pCells = new Cell[ size ];
+			m_unMask = size - 1;
+
+			for( unsigned int i = 0; i < size; i++ )
+				m_pCells[ i ].unSequence.store( i, std::memory_order_relaxed );
+
+			m_unEnqueue.store( 0 );
+			m_bOverflowing.store( false );
+		}
+		//*************************************************************//
+
+
+
+		//*************************************************************//
+		// DESTRUCTOR
+		//	- the items left are discarded (the consumer Drains first)
+		template< typename ItemType >
+		MPSCQueue< ItemType >::~MPSCQueue( void )
+		{
+			delete[] m_pCells;
+		}
+		//*************************************************************//
+
+
+
+		//*************************************************************//
+		// PUSH
+		//	- claim the next ring cell, or append to the overflow
+		template< typename ItemType >
+		void MPSCQueue< ItemType >::Push( const ItemType& item )
+		{
+			// The ring is only used while nothing waits in the overflow
+			// (a producer's overflowed items must not be overtaken)
+			if( m_bOverflowing.load() == false )
+			{
+				unsigned int ticket = m_unEnqueue.load( std::memory_order_relaxed );
+
+				for( ;; )
+				{
+					Cell& cell = m_pCells[ ticket & m_unMask ];
+					int difference = (int)( cell.unSequence.load( std::memory_order_acquire ) - ticket );
+
+					if( difference == 0 )
+					{
+						// Free: claim the ticket, then publish the item
+						if( m_unEnqueue.compare_exchange_weak( ticket, ticket + 1, std::memory_order_relaxed ) == true )
+						{
+							cell.item = item;
+							cell.unSequence.store( ticket + 1, std::memory_order_release );
+							return;
+						}
+					}
+					else if( difference < 0 )
+						break;		// full: the consumer has not freed the cell yet
+					else
+						ticket = m_unEnqueue.load( std::memory_order_relaxed );		// claimed by another producer
+				}
+			}
+
+
+			// Overflow
+			std::lock_guard< std::mutex > lock( m_mtxOverflow );
+			m_vOverflow.push_back( item );
+			m_bOverflowing.store( true );
+		}
+		//*************************************************************//
+
+
+
+		//*************************************************************//
+		// DRAIN
+		//	- empty the ring, then take the overflow: the ring items
+		//	  claimed before the overflow was taken go first, since a
+		//	  producer only overflows after its ring items
+		//	- repeat until both are empty
+		template< typename ItemType >
+		template< typename Function >
+		void MPSCQueue< ItemType >::Drain( Function function )
+		{
+			for( ;; )
+			{
+				DrainRing( m_unEnqueue.load(), function );
+
+
+				// Take the overflow
+				std::vector< ItemType > overflow;
+				unsigned int end;
+				{
+					std::lock_guard< std::mutex > lock( m_mtxOverflow );
+
+					end = m_unEnqueue.load();
+					if( m_vOverflow.empty() == true && end == m_unDequeue )
+						return;
+
+					overflow.swap( m_vOverflow );
+					m_bOverflowing.store( false );
+				}
+
+
+				// Ring items claimed before the overflow was taken, then the overflow
+				DrainRing( end, function );
+
+				for( unsigned int i = 0; i < overflow.size(); i++ )
+					function( overflow[ i ] );
+			}
+		}
+		//*************************************************************//
+
+
+
+		//*************************************************************//
+		// IS EMPTY
+		//	- nothing pushed since the last Drain
+		template< typename ItemType >
+		bool MPSCQueue< ItemType >::IsEmpty( void )
+		{
+			std::lock_guard< std::mutex > lock( m_mtxOverflow );
+			return m_vOverflow.empty() == true && m_unEnqueue.load() == m_unDequeue;
+		}
+		//*************************************************************//
+
+
+
+		//*************************************************************//
+		// DRAIN RING
+		//	- consume the tickets up to the end (exclusive), waiting for
+		//	  a producer still copying its item into a claimed cell
+		//	- the function may Push or Drain again
+		template< typename ItemType >
+		template< typename Function >
+		void MPSCQueue< ItemType >::DrainRing( unsigned int end, Function& function )
+		{
+			while( (int)( end - m_unDequeue ) > 0 )
+			{
+				unsigned int ticket = m_unDequeue;
+				Cell& cell = m_pCells[ ticket & m_unMask ];
+
+				while( cell.unSequence.load( std::memory_order_acquire ) != ticket + 1 )
+					std::this_thread::yield();
+
+				// Free the cell for the ticket one lap later
+				ItemType item = cell.item;
+				cell.unSequence.store( ticket + m_unMask + 1, std::memory_order_release );
+				++m_unDequeue;
+
+				function( item );
+			}
+		}
+		//*************************************************************//
+
+	}	// namespace SGD_IMPLEMENTATION
+
+}	// namespace SGD
+
+#endif //INC_SGD_MPSCQUEUE_HPP
@@ -19,6 +19,114 @@
 // Uses Message Manager
 #include "SGD_MessageManager.h"
 
+// Uses std::vector for storing the pool's pages
+#include <vector>
+
+// Uses SpinLock for sharing the pool between threads
+#include "SGD_SpinLock.h"
+
+
+namespace SGD
+{
+	namespace SGD_IMPLEMENTATION
+	{
+		//*************************************************************//
+		// MessagePool
+		//	- fixed-size blocks carved from pages that are never returned
+		//	  to the heap (until exit), linked in a free list
+		//	- worker threads may create messages too: a spin lock
+		//	  guards the few instructions of Allocate & Deallocate
+		class MessagePool
+		{
+		public:
+			static const unsigned int	BLOCK_SIZE		= 64;	// bytes
+			static const unsigned int	BLOCKS_PER_PAGE	= 256;
+
+			MessagePool				( void )			= default;
+			~MessagePool			( void );
+
+			void*		Allocate	( void );
+			void		Deallocate	( void* pBlock );
+
+		private:
+			MessagePool				( const MessagePool& )	= delete;
+			MessagePool& operator=	( const MessagePool& )	= delete;
+
+			struct FreeBlock
+			{
+				FreeBlock*	pNext;
+			};
+
+			SpinLock						m_Lock;
+			FreeBlock*						m_pFree		= nullptr;	// free list head
+			std::vector< unsigned char* >	m_vPages;				// every allocated page
+		};
+
+
+		// Pool accessor
+		//	- constructed on first use, which is InitializeMessagePool
+		//	  on the main thread
+		static MessagePool& GetMessagePool( void )
+		{
+			static MessagePool s_Pool;
+			return s_Pool;
+		}
+
+		// Pool builder
+		void InitializeMessagePool( void )
+		{
+			GetMessagePool();
+		}
+
+
+		// Destructor
+		//	- release the pages
+		MessagePool::~MessagePool( void )
+		{
+			for( unsigned int i = 0; i < m_vPages.size(); i++ )
+				delete[] m_vPages[ i ];
+		}
+
+		// Allocate
+		//	- pop the free list, adding a page when it is empty
+		void* MessagePool::Allocate( void )
+		{
+			std::lock_guard< SpinLock > lock( m_Lock );
+
+			if( m_pFree == nullptr )
+			{
+				unsigned char* page = new unsigned char[ BLOCK_SIZE * BLOCKS_PER_PAGE ];
+				m_vPages.push_back( page );
+
+				for( unsigned int i = BLOCKS_PER_PAGE; i-- > 0; )
+				{
+					FreeBlock* block = reinterpret_cast< FreeBlock* >( page + i * BLOCK_SIZE );
+					block->pNext = m_pFree;
+					m_pFree = block;
+				}
+			}
+
+			FreeBlock* block = m_pFree;
+			m_pFree = block->pNext;
+			return block;
+		}
+
+		// Deallocate
+		//	- push the block onto the free list
+		void MessagePool::Deallocate( void* pBlock )
+		{
+			std::lock_guard< SpinLock > lock( m_Lock );
+
+			FreeBlock* block = static_cast< FreeBlock* >( pBlock );
+			block->pNext = m_pFree;
+			m_pFree = block;
+		}
+		//*************************************************************//
+
+	}	// namespace SGD_IMPLEMENTATION
+
+}	// namespace SGD
+
 
 namespace SGD
 {
@@ -35,6 +143,28 @@ namespace SGD
 	{
 		return MessageManager::GetInstance()->SendMessageNow( this );
 	}
+
+
+	// Pool Allocation:
+	/*static*/ void* Message::operator new( std::size_t size )
+	{
+		if( size > SGD_IMPLEMENTATION::MessagePool::BLOCK_SIZE )
+			return ::operator new( size );
+
+		return SGD_IMPLEMENTATION::GetMessagePool().Allocate();
+	}
+
+	/*static*/ void Message::operator delete( void* pBlock, std::size_t size )
+	{
+		if( pBlock == nullptr )
+			return;
+
+		// (the virtual destructor passes the child's size)
+		if( size > SGD_IMPLEMENTATION::MessagePool::BLOCK_SIZE )
+			::operator delete( pBlock );
+		else
+			SGD_IMPLEMENTATION::GetMessagePool().Deallocate( pBlock );
+	}
 	//*****************************************************************//
 
 
@@ -17,6 +17,8 @@
 #define SGD_MESSAGE_H
 
 
+#include <cstddef>		// uses std::size_t
+
 //*********************************************************************//
 // Forward enum class declaration (MUST BE DEFINED SOMEWHERE)
 enum class MessageID;
@@ -28,6 +30,8 @@ namespace SGD
 	// Message
 	//	- data packet sent to the function registered with the Message Manager
 	//	- children classes can be derived to store more specific data
+	//	- messages are allocated from a pool of fixed-size blocks
+	//	  (no heap allocation per message once the pool has grown)
 	class Message
 	{
 	public:
@@ -45,6 +49,12 @@ namespace SGD
 
 		// Accessors:
 		MessageID		GetMessageID	( void )	const	{	return m_nMessageID;	}
+
+
+		// Pool Allocation:
+		//	- a child larger than a block is allocated from the heap
+		static	void*	operator new	( std::size_t size );
+		static	void	operator delete	( void* pBlock, std::size_t size );
 		
 	private:
 		Message				( const Message& )	= delete;	// Copy constructor
@@ -54,6 +64,19 @@ namespace SGD
 		MessageID		m_nMessageID;		// message ID
 	};
 
+
+	namespace SGD_IMPLEMENTATION
+	{
+		//*************************************************************//
+		// InitializeMessagePool
+		//	- builds the pool that stores the messages
+		//	- MessageManager::Initialize calls it on the main thread, so a
+		//	  worker thread never constructs the pool (the VS2013 toolset
+		//	  does not guard the construction of function-local statics)
+		void	InitializeMessagePool	( void );
+
+	}	// namespace SGD_IMPLEMENTATION
+
 }	// namespace SGD
 
 #endif	//SGD_MESSAGE_H
@@ -22,8 +22,11 @@
 // Uses TSTRING for text
 #include "SGD_String.h"
 
-// Uses std::queue for storing messages
-#include <queue>
+// Uses MPSCQueue for storing messages from any thread
+#include "SGD_MPSCQueue.h"
+
+// Uses std::atomic for the status read by any thread
+#include <atomic>
 
 // Uses Message (virtual destructor)
 #include "SGD_Message.h"
@@ -61,7 +64,7 @@ namespace SGD
 			// SINGLETON
 			static	MessageManager*		s_Instance;		// the ONE instance
 
-			MessageManager				( void )					= default;		// Default constructor
+			MessageManager				( void )					: m_eStatus( E_UNINITIALIZED )	{	}		// Default constructor
 			virtual	~MessageManager		( void )					= default;		// Destructor
 
 			MessageManager				( const MessageManager& )	= delete;		// Copy constructor
@@ -76,11 +79,16 @@ namespace SGD
 				E_DESTROYED
 			};
 
-			EMessageManagerStatus		m_eStatus	= E_UNINITIALIZED;		// wrapper initialization status
+			std::atomic< EMessageManagerStatus >	m_eStatus;		// wrapper initialization status (read by any thread)
 			
-			typedef std::queue< const Message* > MessageQueue;
+			// Message queue
+			//	- any thread may queue (lock-free unless the ring is full),
+			//	  Update delivers each thread's messages in its order
+			typedef MPSCQueue< const Message* > MessageQueue;
 			MessageQueue				m_qMessages;						// message queue
 
+			void				DeleteMessages			( void );
+
 			typedef void (*MessageProcedure)( const Message* );
 			MessageProcedure			m_pCallback	= nullptr;				// callback function
 		};
@@ -156,6 +164,9 @@ namespace SGD
 			// Store the callback function
 			m_pCallback = pfMessageProc;
 
+			// Build the message pool on this (main) thread
+			InitializeMessagePool();
+
 
 			// Success!
 			m_eStatus = E_INITIALIZED;
@@ -176,12 +187,13 @@ namespace SGD
 
 
 			// Iterate through the entire queue
-			while( m_qMessages.empty() == false )
+			// (including messages queued by the callback or other threads meanwhile)
+			MessageProcedure callback = m_pCallback;
+			m_qMessages.Drain( [ callback ]( const Message* pMsg )
 			{
-				(*m_pCallback)( m_qMessages.front() );		// send the message to the callback function to process
-				delete m_qMessages.front();					// deallocate the message (virtual destructor)
-				m_qMessages.pop();							// remove the message from the queue
-			}
+				(*callback)( pMsg );						// send the message to the callback function to process
+				delete pMsg;								// deallocate the message (virtual destructor)
+			} );
 
 
 			return true;
@@ -201,11 +213,7 @@ namespace SGD
 
 			
 			// Deallocate all messages in the queue
-			while( m_qMessages.empty() == false )
-			{
-				delete m_qMessages.front();
-				m_qMessages.pop();
-			}
+			DeleteMessages();
 
 			// Remove the callback function
 			m_pCallback = nullptr;
@@ -233,8 +241,8 @@ namespace SGD
 				return false;
 
 			
-			// Queue the message
-			m_qMessages.push( pMsg );
+			// Queue the message (from any thread)
+			m_qMessages.Push( pMsg );
 
 
 			return true;
@@ -280,16 +288,26 @@ namespace SGD
 
 			
 			// Deallocate all messages in the queue
-			while( m_qMessages.empty() == false )
-			{
-				delete m_qMessages.front();
-				m_qMessages.pop();
-			}
+			DeleteMessages();
 
 
 			return true;
 		}
 		//*************************************************************//
+
+
+
+		//*************************************************************//
+		// DELETE MESSAGES
+		//	- deallocate all messages in the queue
+		void MessageManager::DeleteMessages( void )
+		{
+			m_qMessages.Drain( []( const Message* pMsg )
+			{
+				delete pMsg;
+			} );
+		}
+		//*************************************************************//
 		
 
 	}	// namespace SGD_IMPLEMENTATION
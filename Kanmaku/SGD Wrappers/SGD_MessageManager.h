@@ -26,6 +26,8 @@ namespace SGD
 	//*****************************************************************//
 	// MessageManager
 	//	- SINGLETON class for queuing messages sent to a specified function
+	//	- any thread may queue; every other method belongs to the thread
+	//	  that calls Update (each thread's queue order is kept)
 	class MessageManager
 	{
 	public:
@@ -37,7 +39,7 @@ namespace SGD
 		virtual	bool		Update					( void )				= 0;
 		virtual	bool		Terminate				( void )				= 0;
 
-		virtual bool		QueueMessage			( const Message* pMsg )	= 0;
+		virtual bool		QueueMessage			( const Message* pMsg )	= 0;	// any thread (Initialize first)
 		virtual bool		SendMessageNow			( const Message* pMsg )	= 0;
 
 		virtual bool		ClearMessages			( void )				= 0;
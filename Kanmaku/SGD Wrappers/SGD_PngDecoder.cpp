@@ -0,0 +1,680 @@
+/***********************************************************************\
+|																		|
+|	File:			SGD_PngDecoder.cpp									|
+|																		|
+|	Purpose:		To decode PNG files into 8-bit RGBA pixels without	|
+|					touching the graphics device, so images can be		|
+|					decoded on worker threads							|
+|																		|
+\***********************************************************************/
+
+#include "SGD_PngDecoder.h"
+
+
+// Uses memcmp, memcpy & memset
+#include <cstring>
+
+// Uses abs
+#include <cstdlib>
+
+
+//*********************************************************************//
+// Deflate limits (RFC 1951)
+#define PNG_MAX_BITS		15
+#define PNG_MAX_LITERALS	288
+#define PNG_MAX_DISTANCES	30
+
+
+namespace SGD
+{
+	namespace SGD_IMPLEMENTATION
+	{
+		//*************************************************************//
+		// DEFLATE TABLES
+		//	- base value & extra bits of each length / distance code
+		const unsigned short s_LengthBase[ 29 ]	= { 3, 4, 5, 6, 7, 8, 9, 10, 11, 13, 15, 17, 19, 23, 27, 31,
+													35, 43, 51, 59, 67, 83, 99, 115, 131, 163, 195, 227, 258 };
+		const unsigned char s_LengthExtra[ 29 ]	= { 0, 0, 0, 0, 0, 0, 0, 0, 1, 1, 1, 1, 2, 2, 2, 2,
+													3, 3, 3, 3, 4, 4, 4, 4, 5, 5, 5, 5, 0 };
+		const unsigned short s_DistBase[ 30 ]	= { 1, 2, 3, 4, 5, 7, 9, 13, 17, 25, 33, 49, 65, 97, 129, 193,
+													257, 385, 513, 769, 1025, 1537, 2049, 3073, 4097, 6145, 8193, 12289, 16385, 24577 };
+		const unsigned char s_DistExtra[ 30 ]	= { 0, 0, 0, 0, 1, 1, 2, 2, 3, 3, 4, 4, 5, 5, 6, 6,
+													7, 7, 8, 8, 9, 9, 10, 10, 11, 11, 12, 12, 13, 13 };
+
+		// Order of the code length code lengths in a dynamic block header
+		const unsigned char s_CodeLengthOrder[ 19 ] = { 16, 17, 18, 0, 8, 7, 9, 6, 10, 5, 11, 4, 12, 3, 13, 2, 14, 1, 15 };
+
+
+		//*************************************************************//
+		// CrcTable
+		//	- CRC of a chunk's type & data
+		//	- built by each decode instead of once in a static, so
+		//	  concurrent decodes share nothing
+		struct CrcTable
+		{
+			unsigned long	table[ 256 ];
+
+			CrcTable( void )
+			{
+				for( unsigned long n = 0; n < 256; n++ )
+				{
+					unsigned long c = n;
+					for( int k = 0; k < 8; k++ )
+						c = (c & 1) ? (0xEDB88320UL ^ (c >> 1)) : (c >> 1);
+					table[ n ] = c;
+				}
+			}
+
+			unsigned long Compute( const unsigned char* data, size_t size ) const
+			{
+				unsigned long crc = 0xFFFFFFFFUL;
+				for( size_t i = 0; i < size; i++ )
+					crc = table[ (crc ^ data[ i ]) & 0xFF ] ^ (crc >> 8);
+
+				return crc ^ 0xFFFFFFFFUL;
+			}
+		};
+
+
+		//*************************************************************//
+		// Adler32
+		//	- checksum at the end of a zlib stream
+		static unsigned long Adler32( const unsigned char* data, size_t size )
+		{
+			unsigned long a = 1, b = 0;
+			for( size_t i = 0; i < size; i++ )
+			{
+				a = (a + data[ i ]) % 65521;
+				b = (b + a) % 65521;
+			}
+			return (b << 16) | a;
+		}
+
+
+		//*************************************************************//
+		// Big-endian helpers
+		static unsigned long ReadBE32( const unsigned char* p )
+		{
+			return ((unsigned long)p[0] << 24) | ((unsigned long)p[1] << 16) | ((unsigned long)p[2] << 8) | (unsigned long)p[3];
+		}
+
+
+		//*************************************************************//
+		// Huffman decoding table (canonical codes)
+		//	- counts[len]: number of codes of each length
+		//	- symbols: the symbols ordered by code
+		struct Huffman
+		{
+			short	counts[ PNG_MAX_BITS + 1 ];
+			short	symbols[ PNG_MAX_LITERALS ];
+		};
+
+		// Returns 0 for a complete code, > 0 for an incomplete one, < 0 if over-subscribed
+		static int BuildHuffman( Huffman& huffman, const unsigned char* lengths, int count )
+		{
+			memset( huffman.counts, 0, sizeof( huffman.counts ) );
+			for( int s = 0; s < count; s++ )
+				huffman.counts[ lengths[ s ] ]++;
+
+			if( huffman.counts[ 0 ] == count )
+				return 0;
+
+			int left = 1;
+			for( int len = 1; len <= PNG_MAX_BITS; len++ )
+			{
+				left <<= 1;
+				left -= huffman.counts[ len ];
+				if( left < 0 )
+					return left;
+			}
+
+			short offsets[ PNG_MAX_BITS + 1 ];
+			offsets[ 1 ] = 0;
+			for( int len = 1; len < PNG_MAX_BITS; len++ )
+				offsets[ len + 1 ] = offsets[ len ] + huffman.counts[ len ];
+
+			for( int s = 0; s < count; s++ )
+				if( lengths[ s ] != 0 )
+					huffman.symbols[ offsets[ lengths[ s ] ]++ ] = (short)s;
+
+			return left;
+		}
+
+
+		//*************************************************************//
+		// BitReader
+		//	- deflate bits are packed starting at the least significant bit
+		struct BitReader
+		{
+			const unsigned char*	pData;
+			size_t					unSize;
+			size_t					unPos;
+			unsigned long			ulBuffer;
+			int						nCount;
+
+			// Returns -1 past the end of the data
+			long Bits( int need )
+			{
+				while( nCount < need )
+				{
+					if( unPos >= unSize )
+						return -1;
+
+					ulBuffer |= (unsigned long)pData[ unPos++ ] << nCount;
+					nCount += 8;
+				}
+
+				long value = (long)(ulBuffer & ((1UL << need) - 1));
+				ulBuffer >>= need;
+				nCount -= need;
+				return value;
+			}
+
+			// Returns -1 for an invalid code or the end of the data
+			int Decode( const Huffman& huffman )
+			{
+				int code = 0, first = 0, index = 0;
+
+				for( int len = 1; len <= PNG_MAX_BITS; len++ )
+				{
+					long bit = Bits( 1 );
+					if( bit < 0 )
+						return -1;
+
+					code |= (int)bit;
+					int count = huffman.counts[ len ];
+					if( code - count < first )
+						return huffman.symbols[ index + (code - first) ];
+
+					index += count;
+					first += count;
+					first <<= 1;
+					code <<= 1;
+				}
+
+				return -1;
+			}
+		};
+
+
+		//*************************************************************//
+		// InflateCodes
+		//	- decode one Huffman-coded block
+		static bool InflateCodes( BitReader& in, std::vector< unsigned char >& out, const Huffman& lengths, const Huffman& distances )
+		{
+			for( ;; )
+			{
+				int symbol = in.Decode( lengths );
+				if( symbol < 0 )
+					return false;
+
+				if( symbol < 256 )
+				{
+					out.push_back( (unsigned char)symbol );
+					continue;
+				}
+
+				if( symbol == 256 )
+					return true;
+
+				// Length / distance pair
+				symbol -= 257;
+				if( symbol >= 29 )
+					return false;
+
+				long extra = in.Bits( s_LengthExtra[ symbol ] );
+				if( extra < 0 )
+					return false;
+				size_t length = s_LengthBase[ symbol ] + (size_t)extra;
+
+				symbol = in.Decode( distances );
+				if( symbol < 0 || symbol >= 30 )
+					return false;
+
+				extra = in.Bits( s_DistExtra[ symbol ] );
+				if( extra < 0 )
+					return false;
+				size_t distance = s_DistBase[ symbol ] + (size_t)extra;
+
+				if( distance > out.size() )
+					return false;
+
+				// Byte by byte: the copy may overlap its own output
+				size_t from = out.size() - distance;
+				for( size_t i = 0; i < length; i++ )
+					out.push_back( out[ from + i ] );
+			}
+		}
+
+
+		//*************************************************************//
+		// Inflate
+		//	- decompress a zlib stream
+		static bool Inflate( const unsigned char* data, size_t size, std::vector< unsigned char >& out )
+		{
+			// zlib header: deflate, no preset dictionary
+			if( size < 6 || (data[0] & 0x0F) != 8 || ((data[0] << 8) | data[1]) % 31 != 0 || (data[1] & 0x20) != 0 )
+				return false;
+
+			BitReader in = { data + 2, size - 2, 0, 0, 0 };
+			out.clear();
+
+			long last;
+			do
+			{
+				last = in.Bits( 1 );
+				long type = in.Bits( 2 );
+				if( last < 0 || type < 0 )
+					return false;
+
+				if( type == 0 )
+				{
+					// Stored block: byte aligned LEN & NLEN
+					in.ulBuffer = 0;
+					in.nCount = 0;
+
+					if( in.unPos + 4 > in.unSize )
+						return false;
+
+					size_t length	= in.pData[ in.unPos ] | (in.pData[ in.unPos + 1 ] << 8);
+					size_t inverse	= in.pData[ in.unPos + 2 ] | (in.pData[ in.unPos + 3 ] << 8);
+					in.unPos += 4;
+
+					if( length != (~inverse & 0xFFFF) || in.unPos + length > in.unSize )
+						return false;
+
+					out.insert( out.end(), in.pData + in.unPos, in.pData + in.unPos + length );
+					in.unPos += length;
+				}
+				else if( type == 1 )
+				{
+					// Fixed codes
+					unsigned char lengths[ PNG_MAX_LITERALS ];
+					int s = 0;
+					for( ; s < 144; s++ )	lengths[ s ] = 8;
+					for( ; s < 256; s++ )	lengths[ s ] = 9;
+					for( ; s < 280; s++ )	lengths[ s ] = 7;
+					for( ; s < 288; s++ )	lengths[ s ] = 8;
+
+					Huffman literalCodes, distanceCodes;
+					BuildHuffman( literalCodes, lengths, PNG_MAX_LITERALS );
+
+					for( s = 0; s < PNG_MAX_DISTANCES; s++ )
+						lengths[ s ] = 5;
+					BuildHuffman( distanceCodes, lengths, PNG_MAX_DISTANCES );
+
+					if( InflateCodes( in, out, literalCodes, distanceCodes ) == false )
+						return false;
+				}
+				else if( type == 2 )
+				{
+					// Dynamic codes
+					long numLiterals	= in.Bits( 5 );
+					long numDistances	= in.Bits( 5 );
+					long numCodeLengths	= in.Bits( 4 );
+					if( numLiterals < 0 || numDistances < 0 || numCodeLengths < 0 )
+						return false;
+
+					numLiterals += 257;
+					numDistances += 1;
+					numCodeLengths += 4;
+					if( numLiterals > 286 || numDistances > PNG_MAX_DISTANCES )
+						return false;
+
+					unsigned char lengths[ PNG_MAX_LITERALS + PNG_MAX_DISTANCES ] = { };
+					for( int i = 0; i < numCodeLengths; i++ )
+					{
+						long len = in.Bits( 3 );
+						if( len < 0 )
+							return false;
+						lengths[ s_CodeLengthOrder[ i ] ] = (unsigned char)len;
+					}
+
+					Huffman codeLengthCodes;
+					if( BuildHuffman( codeLengthCodes, lengths, 19 ) != 0 )
+						return false;
+
+
+					// Literal / length & distance code lengths, in one sequence
+					int index = 0;
+					int total = (int)(numLiterals + numDistances);
+					memset( lengths, 0, sizeof( lengths ) );
+
+					while( index < total )
+					{
+						int symbol = in.Decode( codeLengthCodes );
+						if( symbol < 0 )
+							return false;
+
+						if( symbol < 16 )
+						{
+							lengths[ index++ ] = (unsigned char)symbol;
+							continue;
+						}
+
+						unsigned char value = 0;
+						long repeat;
+						if( symbol == 16 )
+						{
+							if( index == 0 )
+								return false;
+							value = lengths[ index - 1 ];
+							repeat = in.Bits( 2 );
+							repeat = (repeat < 0) ? -1 : 3 + repeat;
+						}
+						else if( symbol == 17 )
+						{
+							repeat = in.Bits( 3 );
+							repeat = (repeat < 0) ? -1 : 3 + repeat;
+						}
+						else
+						{
+							repeat = in.Bits( 7 );
+							repeat = (repeat < 0) ? -1 : 11 + repeat;
+						}
+
+						if( repeat < 0 || index + repeat > total )
+							return false;
+
+						while( repeat-- > 0 )
+							lengths[ index++ ] = value;
+					}
+
+					// The block must be able to end
+					if( lengths[ 256 ] == 0 )
+						return false;
+
+					Huffman literalCodes, distanceCodes;
+					int result = BuildHuffman( literalCodes, lengths, (int)numLiterals );
+					if( result < 0 || (result > 0 && numLiterals - literalCodes.counts[ 0 ] != 1) )
+						return false;
+
+					result = BuildHuffman( distanceCodes, lengths + numLiterals, (int)numDistances );
+					if( result < 0 || (result > 0 && numDistances - distanceCodes.counts[ 0 ] != 1) )
+						return false;
+
+					if( InflateCodes( in, out, literalCodes, distanceCodes ) == false )
+						return false;
+				}
+				else
+					return false;
+			}
+			while( last == 0 );
+
+
+			// Adler-32 follows on the next byte boundary
+			size_t end = in.unPos - (size_t)(in.nCount / 8);
+			if( end + 4 > size - 2 )
+				return false;
+
+			return ReadBE32( data + 2 + end ) == Adler32( out.empty() ? nullptr : &out[ 0 ], out.size() );
+		}
+
+
+		//*************************************************************//
+		// Paeth
+		//	- PNG filter type 4 predictor
+		static unsigned char Paeth( int a, int b, int c )
+		{
+			int p = a + b - c;
+			int pa = abs( p - a ), pb = abs( p - b ), pc = abs( p - c );
+
+			if( pa <= pb && pa <= pc )
+				return (unsigned char)a;
+			if( pb <= pc )
+				return (unsigned char)b;
+			return (unsigned char)c;
+		}
+
+
+		//*************************************************************//
+		// Fail
+		//	- report the reason & return false
+		static bool Fail( const char** error, const char* message )
+		{
+			if( error != nullptr )
+				*error = message;
+			return false;
+		}
+
+	}	// namespace SGD_IMPLEMENTATION
+
+
+	//*****************************************************************//
+	// IsPngFile
+	bool IsPngFile( const unsigned char* data, unsigned int size )
+	{
+		const unsigned char signature[ 8 ] = { 0x89, 'P', 'N', 'G', '\r', '\n', 0x1A, '\n' };
+		return data != nullptr && size >= 8 && memcmp( data, signature, 8 ) == 0;
+	}
+
+
+	//*****************************************************************//
+	// DecodePng
+	//	- parse the chunks, inflate the image data, undo the row filters
+	//	  & expand every color type to RGBA
+	bool DecodePng( const unsigned char* data, unsigned int size,
+					unsigned int& width, unsigned int& height,
+					std::vector< unsigned char >& pixels,
+					const char** error )
+	{
+		using namespace SGD_IMPLEMENTATION;
+
+		if( IsPngFile( data, size ) == false )
+			return Fail( error, "not a PNG file" );
+
+		const CrcTable crc;
+
+
+		// Chunks
+		unsigned long imageWidth = 0, imageHeight = 0;
+		unsigned int bitDepth = 0, colorType = 0;
+		bool foundHeader = false, foundEnd = false;
+
+		std::vector< unsigned char > palette;		// RGBA per entry
+		std::vector< unsigned char > idat;
+		unsigned int transparentKey[ 3 ] = { };
+		bool hasTransparentKey = false;
+
+		size_t pos = 8;
+		while( foundEnd == false )
+		{
+			if( pos + 12 > size )
+				return Fail( error, "truncated file" );
+
+			unsigned long length = ReadBE32( data + pos );
+			if( length > size - pos - 12 )
+				return Fail( error, "truncated chunk" );
+
+			const unsigned char* type = data + pos + 4;
+			const unsigned char* chunk = data + pos + 8;
+
+			if( crc.Compute( type, length + 4 ) != ReadBE32( chunk + length ) )
+				return Fail( error, "chunk CRC mismatch" );
+
+			if( memcmp( type, "IHDR", 4 ) == 0 )
+			{
+				if( length != 13 )
+					return Fail( error, "invalid IHDR chunk" );
+
+				imageWidth	= ReadBE32( chunk );
+				imageHeight	= ReadBE32( chunk + 4 );
+				bitDepth	= chunk[ 8 ];
+				colorType	= chunk[ 9 ];
+
+				if( chunk[ 10 ] != 0 || chunk[ 11 ] != 0 )
+					return Fail( error, "unknown compression or filter method" );
+				if( chunk[ 12 ] != 0 )
+					return Fail( error, "interlaced PNG files are not supported" );
+
+				foundHeader = true;
+			}
+			else if( memcmp( type, "PLTE", 4 ) == 0 )
+			{
+				palette.clear();
+				for( unsigned long i = 0; i + 2 < length; i += 3 )
+				{
+					palette.push_back( chunk[ i ] );
+					palette.push_back( chunk[ i + 1 ] );
+					palette.push_back( chunk[ i + 2 ] );
+					palette.push_back( 255 );
+				}
+			}
+			else if( memcmp( type, "tRNS", 4 ) == 0 )
+			{
+				if( colorType == 3 )
+				{
+					for( unsigned long i = 0; i < length && i * 4 + 3 < palette.size(); i++ )
+						palette[ i * 4 + 3 ] = chunk[ i ];
+				}
+				else if( colorType == 0 && length >= 2 )
+				{
+					transparentKey[ 0 ] = (chunk[ 0 ] << 8) | chunk[ 1 ];
+					hasTransparentKey = true;
+				}
+				else if( colorType == 2 && length >= 6 )
+				{
+					for( int c = 0; c < 3; c++ )
+						transparentKey[ c ] = (chunk[ c * 2 ] << 8) | chunk[ c * 2 + 1 ];
+					hasTransparentKey = true;
+				}
+			}
+			else if( memcmp( type, "IDAT", 4 ) == 0 )
+				idat.insert( idat.end(), chunk, chunk + length );
+			else if( memcmp( type, "IEND", 4 ) == 0 )
+				foundEnd = true;
+
+			pos += 12 + length;
+		}
+
+		if( foundHeader == false || imageWidth == 0 || imageHeight == 0 || imageWidth > 0x8000 || imageHeight > 0x8000 )
+			return Fail( error, "missing or invalid IHDR chunk" );
+
+
+		// Channels per color type: gray, -, RGB, palette, gray + alpha, -, RGBA
+		const unsigned int channelTable[ 7 ] = { 1, 0, 3, 1, 2, 0, 4 };
+		unsigned int channels = (colorType < 7) ? channelTable[ colorType ] : 0;
+
+		bool validDepth = (bitDepth == 8 || bitDepth == 16)
+			|| ((colorType == 0 || colorType == 3) && (bitDepth == 1 || bitDepth == 2 || bitDepth == 4));
+		if( channels == 0 || validDepth == false || (colorType == 3 && bitDepth == 16) )
+			return Fail( error, "invalid color type or bit depth" );
+
+		if( colorType == 3 && palette.empty() == true )
+			return Fail( error, "missing palette" );
+
+
+		// Inflate
+		size_t stride	= ((size_t)imageWidth * channels * bitDepth + 7) / 8;
+		size_t pixel	= (channels * bitDepth + 7) / 8;		// filter distance in bytes
+
+		std::vector< unsigned char > raw;
+		if( idat.empty() == true || Inflate( &idat[ 0 ], idat.size(), raw ) == false )
+			return Fail( error, "corrupt image data" );
+
+		if( raw.size() < (stride + 1) * imageHeight )
+			return Fail( error, "not enough image data" );
+
+
+		// Undo the filters in place (each row keeps its filter type byte)
+		for( unsigned long y = 0; y < imageHeight; y++ )
+		{
+			unsigned char* row		= &raw[ y * (stride + 1) + 1 ];
+			const unsigned char* above	= (y > 0) ? row - (stride + 1) : nullptr;
+			unsigned char type		= row[ -1 ];
+
+			for( size_t i = 0; i < stride; i++ )
+			{
+				int a = (i >= pixel) ? row[ i - pixel ] : 0;
+				int b = (above != nullptr) ? above[ i ] : 0;
+				int c = (i >= pixel && above != nullptr) ? above[ i - pixel ] : 0;
+
+				switch( type )
+				{
+				case 0:												break;
+				case 1:	row[ i ] = (unsigned char)(row[ i ] + a);			break;
+				case 2:	row[ i ] = (unsigned char)(row[ i ] + b);			break;
+				case 3:	row[ i ] = (unsigned char)(row[ i ] + (a + b) / 2);	break;
+				case 4:	row[ i ] = (unsigned char)(row[ i ] + Paeth( a, b, c ));	break;
+				default:
+					return Fail( error, "invalid filter type" );
+				}
+			}
+		}
+
+
+		// Expand to RGBA
+		pixels.assign( (size_t)imageWidth * imageHeight * 4, 0 );
+
+		unsigned int maxSample	= (1u << bitDepth) - 1;
+		for( unsigned long y = 0; y < imageHeight; y++ )
+		{
+			const unsigned char* row = &raw[ y * (stride + 1) + 1 ];
+			unsigned char* out = &pixels[ y * imageWidth * 4 ];
+
+			for( unsigned long x = 0; x < imageWidth; x++, out += 4 )
+			{
+				// Read the samples at full precision
+				unsigned int samples[ 4 ] = { };
+				for( unsigned int c = 0; c < channels; c++ )
+				{
+					size_t index = (size_t)x * channels + c;
+
+					if( bitDepth == 16 )
+						samples[ c ] = (row[ index * 2 ] << 8) | row[ index * 2 + 1 ];
+					else if( bitDepth == 8 )
+						samples[ c ] = row[ index ];
+					else
+					{
+						size_t bit = index * bitDepth;
+						samples[ c ] = (row[ bit / 8 ] >> (8 - bitDepth - (bit % 8))) & maxSample;
+					}
+				}
+
+				// Scale a sample to 8 bits
+				#define PNG_TO_8BIT( s )	(unsigned char)( (bitDepth == 16) ? ((s) >> 8) : ((s) * 255 / maxSample) )
+
+				switch( colorType )
+				{
+				case 0:		// gray
+					out[0] = out[1] = out[2] = PNG_TO_8BIT( samples[0] );
+					out[3] = (hasTransparentKey == true && samples[0] == transparentKey[0]) ? 0 : 255;
+					break;
+
+				case 2:		// RGB
+					out[0] = PNG_TO_8BIT( samples[0] );
+					out[1] = PNG_TO_8BIT( samples[1] );
+					out[2] = PNG_TO_8BIT( samples[2] );
+					out[3] = (hasTransparentKey == true && samples[0] == transparentKey[0]
+						&& samples[1] == transparentKey[1] && samples[2] == transparentKey[2]) ? 0 : 255;
+					break;
+
+				case 3:		// palette
+					if( samples[0] * 4 >= palette.size() )
+						return Fail( error, "palette index out of range" );
+					memcpy( out, &palette[ samples[0] * 4 ], 4 );
+					break;
+
+				case 4:		// gray + alpha
+					out[0] = out[1] = out[2] = PNG_TO_8BIT( samples[0] );
+					out[3] = PNG_TO_8BIT( samples[1] );
+					break;
+
+				case 6:		// RGBA
+					out[0] = PNG_TO_8BIT( samples[0] );
+					out[1] = PNG_TO_8BIT( samples[1] );
+					out[2] = PNG_TO_8BIT( samples[2] );
+					out[3] = PNG_TO_8BIT( samples[3] );
+					break;
+				}
+
+				#undef PNG_TO_8BIT
+			}
+		}
+
+		width	= (unsigned int)imageWidth;
+		height	= (unsigned int)imageHeight;
+		return true;
+	}
+
+}	// namespace SGD
@@ -0,0 +1,41 @@
+/***********************************************************************\
+|																		|
+|	File:			SGD_PngDecoder.h									|
+|																		|
+|	Purpose:		To decode PNG files into 8-bit RGBA pixels without	|
+|					touching the graphics device, so images can be		|
+|					decoded on worker threads							|
+|																		|
+\***********************************************************************/
+
+#ifndef SGD_PNGDECODER_H
+#define SGD_PNGDECODER_H
+
+
+#include <vector>		// Stores the pixels in a std::vector
+
+
+namespace SGD
+{
+	//*****************************************************************//
+	// DecodePng
+	//	- decodes a whole PNG file held in memory, with its own inflate
+	//	  (no zlib)
+	//	- accepts every non-interlaced color type & bit depth (16-bit
+	//	  samples are reduced to 8 bits)
+	//	- pixels are stored top-down, 4 bytes per pixel (R, G, B, A)
+	//	- thread-safe: no shared state between calls
+	//	- on failure, returns false & points error (if given) at a
+	//	  static description
+	bool	DecodePng	( const unsigned char* data, unsigned int size,
+						  unsigned int& width, unsigned int& height,
+						  std::vector< unsigned char >& pixels,
+						  const char** error = nullptr );
+
+	// IsPngFile
+	//	- true if the data starts with the PNG signature
+	bool	IsPngFile	( const unsigned char* data, unsigned int size );
+
+}	// namespace SGD
+
+#endif //SGD_PNGDECODER_H
@@ -0,0 +1,357 @@
+/***********************************************************************\
+|																		|
+|	File:			SGD_RectangleBatch.cpp								|
+|																		|
+|	Purpose:		To store many rectangles as separate arrays			|
+|					and test one rectangle against all of them,			|
+|					using SSE2 / AVX when the CPU supports it			|
+|																		|
+\***********************************************************************/
+
+#include "SGD_RectangleBatch.h"
+
+
+// Uses SGD_ASSERT for debug breaks
+#include "SGD_Utilities.h"
+
+// Uses std::atomic for the kernel read by worker threads
+#include <atomic>
+
+
+//*********************************************************************//
+// SIMD kernels are only compiled for x86 / x64 targets
+//	- MSVC allows the AVX intrinsics without /arch:AVX
+//	- GCC & Clang need the target attribute on the AVX kernel
+#if defined( _M_IX86 ) || defined( _M_X64 ) || defined( __i386__ ) || defined( __x86_64__ )
+	#define SGD_RECTANGLEBATCH_X86
+
+	// Uses SSE2 & AVX intrinsics
+	#include <immintrin.h>
+
+	#if defined( _MSC_VER )
+		// Uses __cpuid, _xgetbv & _BitScanForward
+		#include <intrin.h>
+		#define SGD_TARGET_AVX
+	#else
+		#define SGD_TARGET_AVX	__attribute__(( target( "avx" ) ))
+	#endif
+#endif
+
+
+namespace SGD
+{
+	namespace SGD_IMPLEMENTATION
+	{
+		//*************************************************************//
+		// Kernel signature: test [first, first+count) and write the hits
+		typedef unsigned int (*IntersectionKernel)( const Rectangle& rect,
+			const float* L, const float* T, const float* R, const float* B,
+			unsigned int first, unsigned int count, unsigned int* hits );
+
+
+		//*************************************************************//
+		// ScalarKernel
+		//	- same comparisons as Rectangle::IsIntersecting (NaN never hits),
+		//	  the query rectangle is validated once by the caller
+		static unsigned int ScalarKernel( const Rectangle& rect,
+			const float* L, const float* T, const float* R, const float* B,
+			unsigned int first, unsigned int count, unsigned int* hits )
+		{
+			unsigned int numHits = 0;
+			unsigned int end = first + count;
+
+			for( unsigned int i = first; i < end; i++ )
+			{
+				if( (rect.left < R[ i ]) && (rect.right > L[ i ]) && (rect.top < B[ i ]) && (rect.bottom > T[ i ])
+					&& (L[ i ] < R[ i ]) && (T[ i ] < B[ i ]) )
+					hits[ numHits++ ] = i;
+			}
+
+			return numHits;
+		}
+
+
+#ifdef SGD_RECTANGLEBATCH_X86
+
+		//*************************************************************//
+		// LowestBit
+		//	- index of the lowest set bit (mask cannot be 0)
+		static inline unsigned int LowestBit( unsigned int mask )
+		{
+#if defined( _MSC_VER )
+			unsigned long index;
+			_BitScanForward( &index, mask );
+			return (unsigned int)index;
+#else
+			return (unsigned int)__builtin_ctz( mask );
+#endif
+		}
+
+
+		//*************************************************************//
+		// SSE2Kernel
+		//	- 4 rectangles per step, the remainder is scalar
+		//	- ordered compares are false for NaN, like the scalar code
+		static unsigned int SSE2Kernel( const Rectangle& rect,
+			const float* L, const float* T, const float* R, const float* B,
+			unsigned int first, unsigned int count, unsigned int* hits )
+		{
+			const __m128 qL = _mm_set1_ps( rect.left );
+			const __m128 qT = _mm_set1_ps( rect.top );
+			const __m128 qR = _mm_set1_ps( rect.right );
+			const __m128 qB = _mm_set1_ps( rect.bottom );
+
+			unsigned int numHits = 0;
+			unsigned int i = first;
+			unsigned int end = first + count;
+
+			for( ; i + 4 <= end; i += 4 )
+			{
+				__m128 l = _mm_loadu_ps( L + i );
+				__m128 t = _mm_loadu_ps( T + i );
+				__m128 r = _mm_loadu_ps( R + i );
+				__m128 b = _mm_loadu_ps( B + i );
+
+				__m128 m = _mm_and_ps( _mm_cmplt_ps( qL, r ), _mm_cmpgt_ps( qR, l ) );
+				m = _mm_and_ps( m, _mm_and_ps( _mm_cmplt_ps( qT, b ), _mm_cmpgt_ps( qB, t ) ) );
+				m = _mm_and_ps( m, _mm_and_ps( _mm_cmplt_ps( l, r ), _mm_cmplt_ps( t, b ) ) );
+
+				unsigned int mask = (unsigned int)_mm_movemask_ps( m );
+				while( mask != 0 )
+				{
+					hits[ numHits++ ] = i + LowestBit( mask );
+					mask &= mask - 1;
+				}
+			}
+
+			return numHits + ScalarKernel( rect, L, T, R, B, i, end - i, hits + numHits );
+		}
+
+
+		//*************************************************************//
+		// AVXKernel
+		//	- 8 rectangles per step, the remainder goes through SSE2
+		SGD_TARGET_AVX
+		static unsigned int AVXKernel( const Rectangle& rect,
+			const float* L, const float* T, const float* R, const float* B,
+			unsigned int first, unsigned int count, unsigned int* hits )
+		{
+			const __m256 qL = _mm256_set1_ps( rect.left );
+			const __m256 qT = _mm256_set1_ps( rect.top );
+			const __m256 qR = _mm256_set1_ps( rect.right );
+			const __m256 qB = _mm256_set1_ps( rect.bottom );
+
+			unsigned int numHits = 0;
+			unsigned int i = first;
+			unsigned int end = first + count;
+
+			for( ; i + 8 <= end; i += 8 )
+			{
+				__m256 l = _mm256_loadu_ps( L + i );
+				__m256 t = _mm256_loadu_ps( T + i );
+				__m256 r = _mm256_loadu_ps( R + i );
+				__m256 b = _mm256_loadu_ps( B + i );
+
+				__m256 m = _mm256_and_ps( _mm256_cmp_ps( qL, r, _CMP_LT_OQ ), _mm256_cmp_ps( qR, l, _CMP_GT_OQ ) );
+				m = _mm256_and_ps( m, _mm256_and_ps( _mm256_cmp_ps( qT, b, _CMP_LT_OQ ), _mm256_cmp_ps( qB, t, _CMP_GT_OQ ) ) );
+				m = _mm256_and_ps( m, _mm256_and_ps( _mm256_cmp_ps( l, r, _CMP_LT_OQ ), _mm256_cmp_ps( t, b, _CMP_LT_OQ ) ) );
+
+				unsigned int mask = (unsigned int)_mm256_movemask_ps( m );
+				while( mask != 0 )
+				{
+					hits[ numHits++ ] = i + LowestBit( mask );
+					mask &= mask - 1;
+				}
+			}
+
+			// Avoid the AVX / SSE transition penalty before the SSE2 tail
+			_mm256_zeroupper();
+
+			return numHits + SSE2Kernel( rect, L, T, R, B, i, end - i, hits + numHits );
+		}
+
+
+		//*************************************************************//
+		// DetectSimdLevel
+		//	- AVX also needs the OS to save the YMM registers (XCR0)
+		static SimdLevel DetectSimdLevel( void )
+		{
+#if defined( _MSC_VER )
+			int info[ 4 ];
+			__cpuid( info, 1 );
+
+			bool sse2		= (info[ 3 ] & (1 << 26)) != 0;
+			bool osxsave	= (info[ 2 ] & (1 << 27)) != 0;
+			bool avx		= (info[ 2 ] & (1 << 28)) != 0;
+
+			if( osxsave && avx && (_xgetbv( 0 ) & 0x6) == 0x6 )
+				return SimdLevel::AVX;
+			if( sse2 )
+				return SimdLevel::SSE2;
+#else
+			__builtin_cpu_init();
+
+			if( __builtin_cpu_supports( "avx" ) )
+				return SimdLevel::AVX;
+			if( __builtin_cpu_supports( "sse2" ) )
+				return SimdLevel::SSE2;
+#endif
+			return SimdLevel::SCALAR;
+		}
+
+#else	// !SGD_RECTANGLEBATCH_X86
+
+		static SimdLevel DetectSimdLevel( void )
+		{
+			return SimdLevel::SCALAR;
+		}
+
+#endif	// SGD_RECTANGLEBATCH_X86
+
+
+		//*************************************************************//
+		// SelectKernel
+		static IntersectionKernel SelectKernel( SimdLevel level )
+		{
+			switch( level )
+			{
+#ifdef SGD_RECTANGLEBATCH_X86
+			case SimdLevel::AVX:	return &AVXKernel;
+			case SimdLevel::SSE2:	return &SSE2Kernel;
+#endif
+			default:				return &ScalarKernel;
+			}
+		}
+
+
+		//*************************************************************//
+		// Dispatch state, detected during static initialization
+		//	- SetSimdLevel may run while workers call FindIntersections,
+		//	  so the level & kernel are atomic (relaxed: every kernel
+		//	  returns the same hits, any one of them is correct)
+		static const SimdLevel						s_MaxLevel	= DetectSimdLevel();
+		static std::atomic< SimdLevel >				s_Level( s_MaxLevel );
+		static std::atomic< IntersectionKernel >	s_pKernel( SelectKernel( s_MaxLevel ) );
+
+	}	// namespace SGD_IMPLEMENTATION
+
+
+	//*****************************************************************//
+	// SIMD LEVEL
+
+	SimdLevel GetSimdLevel( void )
+	{
+		return SGD_IMPLEMENTATION::s_Level.load( std::memory_order_relaxed );
+	}
+
+	SimdLevel GetMaxSimdLevel( void )
+	{
+		return SGD_IMPLEMENTATION::s_MaxLevel;
+	}
+
+	bool SetSimdLevel( SimdLevel level )
+	{
+		// Is the instruction set available?
+		if( (int)level > (int)SGD_IMPLEMENTATION::s_MaxLevel )
+			return false;
+
+		SGD_IMPLEMENTATION::s_Level.store( level, std::memory_order_relaxed );
+		SGD_IMPLEMENTATION::s_pKernel.store( SGD_IMPLEMENTATION::SelectKernel( level ), std::memory_order_relaxed );
+		return true;
+	}
+
+
+#pragma region RECTANGLEBATCH_METHODS
+
+	//*****************************************************************//
+	// RECTANGLE BATCH METHODS
+
+	// Replace the contents
+	void RectangleBatch::Assign( const Rectangle* rects, unsigned int count )
+	{
+		SGD_ASSERT( rects != nullptr || count == 0, "RectangleBatch::Assign - rectangles cannot be null" );
+
+		Resize( count );
+		for( unsigned int i = 0; i < count; i++ )
+			Set( i, rects[ i ] );
+	}
+
+	// Add to the end
+	void RectangleBatch::Append( const Rectangle& rect )
+	{
+		m_vLeft.push_back( rect.left );
+		m_vTop.push_back( rect.top );
+		m_vRight.push_back( rect.right );
+		m_vBottom.push_back( rect.bottom );
+	}
+
+	// Change the count (new rectangles are empty)
+	void RectangleBatch::Resize( unsigned int count )
+	{
+		m_vLeft.resize( count, 0.0f );
+		m_vTop.resize( count, 0.0f );
+		m_vRight.resize( count, 0.0f );
+		m_vBottom.resize( count, 0.0f );
+	}
+
+	// Overwrite one rectangle
+	void RectangleBatch::Set( unsigned int index, const Rectangle& rect )
+	{
+		SGD_ASSERT( index < GetCount(), "RectangleBatch::Set - invalid index" );
+
+		m_vLeft[ index ]	= rect.left;
+		m_vTop[ index ]		= rect.top;
+		m_vRight[ index ]	= rect.right;
+		m_vBottom[ index ]	= rect.bottom;
+	}
+
+	// Remove all (keeps the storage)
+	void RectangleBatch::Clear( void )
+	{
+		m_vLeft.clear();
+		m_vTop.clear();
+		m_vRight.clear();
+		m_vBottom.clear();
+	}
+
+	// Preallocate
+	void RectangleBatch::Reserve( unsigned int count )
+	{
+		m_vLeft.reserve( count );
+		m_vTop.reserve( count );
+		m_vRight.reserve( count );
+		m_vBottom.reserve( count );
+	}
+
+	// Read one rectangle
+	Rectangle RectangleBatch::Get( unsigned int index ) const
+	{
+		SGD_ASSERT( index < GetCount(), "RectangleBatch::Get - invalid index" );
+
+		return Rectangle{ m_vLeft[ index ], m_vTop[ index ], m_vRight[ index ], m_vBottom[ index ] };
+	}
+
+
+	// Test against every rectangle
+	unsigned int RectangleBatch::FindIntersections( const Rectangle& rect, unsigned int* hits ) const
+	{
+		return FindIntersections( rect, 0, GetCount(), hits );
+	}
+
+	// Test against a range of rectangles
+	unsigned int RectangleBatch::FindIntersections( const Rectangle& rect, unsigned int first, unsigned int count, unsigned int* hits ) const
+	{
+		SGD_ASSERT( first + count <= GetCount(), "RectangleBatch::FindIntersections - invalid range" );
+		SGD_ASSERT( hits != nullptr || count == 0, "RectangleBatch::FindIntersections - hits cannot be null" );
+
+		// An empty (or NaN) query rectangle cannot intersect anything
+		if( count == 0 || !(rect.left < rect.right) || !(rect.top < rect.bottom) )
+			return 0;
+
+		SGD_IMPLEMENTATION::IntersectionKernel pKernel = SGD_IMPLEMENTATION::s_pKernel.load( std::memory_order_relaxed );
+		return pKernel( rect, m_vLeft.data(), m_vTop.data(), m_vRight.data(), m_vBottom.data(), first, count, hits );
+	}
+
+#pragma endregion
+
+}	// namespace SGD
@@ -0,0 +1,78 @@
+/***********************************************************************\
+|																		|
+|	File:			SGD_RectangleBatch.h								|
+|																		|
+|	Purpose:		To store many rectangles as separate arrays			|
+|					and test one rectangle against all of them,			|
+|					using SSE2 / AVX when the CPU supports it			|
+|																		|
+\***********************************************************************/
+
+#ifndef SGD_RECTANGLEBATCH_H
+#define SGD_RECTANGLEBATCH_H
+
+
+#include "SGD_Geometry.h"	// Uses Rectangle
+#include <vector>			// Stores the components in std::vectors
+
+
+namespace SGD
+{
+	//*****************************************************************//
+	// SimdLevel
+	//	- instruction set used by the batch intersection kernels
+	//	- detected once at startup, can be lowered for testing
+	enum class SimdLevel
+	{
+		SCALAR,		// plain C++ (identical to Rectangle::IsIntersecting)
+		SSE2,		// 4 rectangles per step
+		AVX,		// 8 rectangles per step
+	};
+
+	SimdLevel	GetSimdLevel		( void );
+	SimdLevel	GetMaxSimdLevel		( void );
+	bool		SetSimdLevel		( SimdLevel level );	// fails if the CPU does not support it
+
+
+	//*****************************************************************//
+	// RectangleBatch
+	//	- structure-of-arrays copy of many rectangles
+	//	- FindIntersections tests one rectangle against a range of
+	//	  the batch, with the same result as IsIntersecting per pair
+	class RectangleBatch
+	{
+	public:
+		RectangleBatch	( void )	= default;
+		~RectangleBatch	( void )	= default;
+
+
+		void			Assign		( const Rectangle* rects, unsigned int count );
+		void			Append		( const Rectangle& rect );
+		void			Resize		( unsigned int count );
+		void			Set			( unsigned int index, const Rectangle& rect );
+		void			Clear		( void );
+		void			Reserve		( unsigned int count );
+
+		unsigned int	GetCount	( void ) const		{	return (unsigned int)m_vLeft.size();	}
+		Rectangle		Get			( unsigned int index ) const;
+
+
+		//*************************************************************//
+		// FindIntersections
+		//	- writes the index of every rectangle in [first, first+count)
+		//	  that intersects the given rectangle, in ascending order
+		//	- hits must have room for count indices
+		//	- returns the number of indices written
+		unsigned int	FindIntersections( const Rectangle& rect, unsigned int* hits ) const;
+		unsigned int	FindIntersections( const Rectangle& rect, unsigned int first, unsigned int count, unsigned int* hits ) const;
+
+	private:
+		std::vector< float >	m_vLeft;
+		std::vector< float >	m_vTop;
+		std::vector< float >	m_vRight;
+		std::vector< float >	m_vBottom;
+	};
+
+}	// namespace SGD
+
+#endif //SGD_RECTANGLEBATCH_H
@@ -0,0 +1,86 @@
+/***********************************************************************\
+|																		|
+|	File:			SGD_ResourceCache.h									|
+|																		|
+|	Purpose:		To share loaded files by name, with reference		|
+|					counts and a hash index over the names				|
+|																		|
+\***********************************************************************/
+
+#ifndef SGD_RESOURCECACHE_H
+#define SGD_RESOURCECACHE_H
+
+
+#include "SGD_HandleManager.h"	// Stores the entries with unique handles
+#include <string>				// Stores the names in std::wstrings
+#include <unordered_map>		// Indexes the names in a std::unordered_map
+
+
+namespace SGD
+{
+	namespace SGD_IMPLEMENTATION
+	{
+		//*************************************************************//
+		// ResourceCache<>
+		//	- HandleManager of loaded files, keyed by file name
+		//	- Acquire finds an already-loaded file in constant time
+		//	  (instead of comparing the name of every stored file)
+		//	- each entry is reference counted: Acquire & Store add a
+		//	  reference, Release removes one and the last Release
+		//	  erases the entry (the caller frees the data it returns)
+		//	- names are compared exactly, as the managers always did
+		template< typename DataType >
+		class ResourceCache
+		{
+		public:
+			ResourceCache	( void )					= default;	// Default constructor
+			~ResourceCache	( void )					= default;	// Destructor
+
+
+			Handle			Acquire			( const wchar_t* name );
+			Handle			Store			( const wchar_t* name, DataType data );
+			bool			Release			( Handle handle, DataType* data );
+			bool			Clear			( void );
+
+			bool			IsHandleValid	( Handle handle ) const		{	return m_Entries.IsHandleValid( handle );	}
+			DataType*		GetData			( Handle handle ) const;
+			unsigned int	GetRefCount		( Handle handle ) const;
+
+			const CacheStats&	GetStats	( void ) const				{	return m_Stats;	}
+			void			AddBytesLoaded	( unsigned int bytes )		{	m_Stats.ullBytesLoaded += bytes;	}	// called once the data exists
+
+
+		private:
+			ResourceCache				( const ResourceCache& )	= delete;	// Copy constructor
+			ResourceCache&	operator=	( const ResourceCache& )	= delete;	// Assignment operator
+
+
+			// Stored entry: the manager's data & the cache's bookkeeping
+			struct Entry
+			{
+				DataType		data;
+				std::wstring	wsName;
+				unsigned int	unRefCount;
+			};
+
+			// Type names for data architecture
+			typedef std::unordered_map< std::wstring, Handle >	NameIndex;
+
+			// Data Storage:
+			HandleManager< Entry >	m_Entries;				// Handle-indexed entries
+			NameIndex				m_Index;				// Name of every entry -> handle
+			std::wstring			m_wsKey;				// Lookup key (reused to avoid allocating)
+			CacheStats				m_Stats;
+		};
+
+	};	// namespace SGD_IMPLEMENTATION
+
+}	// namespace SGD
+
+
+// Template definitions are within the .hpp
+#define	INC_SGD_RESOURCE_CACHE_HPP
+#include "SGD_ResourceCache.hpp"
+#undef	INC_SGD_RESOURCE_CACHE_HPP
+
+#endif //SGD_RESOURCECACHE_H
@@ -0,0 +1,167 @@
+/***********************************************************************\
+|																		|
+|	File:			SGD_ResourceCache.hpp								|
+|																		|
+|	Purpose:		To share loaded files by name, with reference		|
+|					counts and a hash index over the names				|
+|																		|
+\***********************************************************************/
+
+// This .hpp can ONLY be included from SGD_ResourceCache.h
+#ifndef INC_SGD_RESOURCE_CACHE_HPP
+#error	FILE "SGD_ResourceCache.hpp" CANNOT BE INCLUDED EXPLICITLY
+#else
+
+
+namespace SGD
+{
+	namespace SGD_IMPLEMENTATION
+	{
+		//*************************************************************//
+		// ACQUIRE
+		//	- find the entry loaded with the name & add a reference
+		//	- return INVALID_HANDLE if the name has not been stored
+		//	  (the caller loads the file & calls Store)
+		template< typename DataType >
+		Handle ResourceCache< DataType >::Acquire( const wchar_t* name )
+		{
+			// Verify the parameter
+			SGD_ASSERT( name != nullptr, "ResourceCache::Acquire - name cannot be null" );
+			if( name == nullptr )
+				return SGD::INVALID_HANDLE;
+
+			m_wsKey.assign( name );
+			typename NameIndex::const_iterator iter = m_Index.find( m_wsKey );
+			if( iter == m_Index.end() )
+			{
+				m_Stats.unMisses++;
+				return SGD::INVALID_HANDLE;
+			}
+
+			m_Stats.unHits++;
+
+			Entry* entry = m_Entries.GetData( iter->second );
+			entry->unRefCount++;
+			return iter->second;
+		}
+		//*************************************************************//
+
+
+
+		//*************************************************************//
+		// STORE
+		//	- store the newly loaded data under the name, with one reference
+		template< typename DataType >
+		Handle ResourceCache< DataType >::Store( const wchar_t* name, DataType data )
+		{
+			// Verify the parameter
+			SGD_ASSERT( name != nullptr, "ResourceCache::Store - name cannot be null" );
+			if( name == nullptr )
+				return SGD::INVALID_HANDLE;
+
+			SGD_ASSERT( m_Index.count( name ) == 0, "ResourceCache::Store - name is already stored" );
+
+
+			Entry entry;
+			entry.data			= data;
+			entry.wsName		= name;
+			entry.unRefCount	= 1;
+
+			Handle handle = m_Entries.StoreData( entry );
+			if( handle == SGD::INVALID_HANDLE )
+				return SGD::INVALID_HANDLE;
+
+			m_Index[ entry.wsName ] = handle;
+
+			m_Stats.unLoads++;
+			m_Stats.unResident++;
+			return handle;
+		}
+		//*************************************************************//
+
+
+
+		//*************************************************************//
+		// RELEASE
+		//	- remove a reference
+		//	- return true if it was the last one: the entry is erased
+		//	  and its data is copied into the parameter to be freed
+		template< typename DataType >
+		bool ResourceCache< DataType >::Release( Handle handle, DataType* data )
+		{
+			Entry* entry = m_Entries.GetData( handle );
+			if( entry == nullptr )
+				return false;
+
+			entry->unRefCount--;
+			if( entry->unRefCount > 0 )
+				return false;
+
+
+			// Last reference
+			if( data != nullptr )
+				*data = entry->data;
+
+			m_Index.erase( entry->wsName );
+			m_Entries.RemoveData( handle, nullptr );
+
+			m_Stats.unUnloads++;
+			m_Stats.unResident--;
+			return true;
+		}
+		//*************************************************************//
+
+
+
+		//*************************************************************//
+		// CLEAR
+		//	- remove every entry (does not free the stored data)
+		//	- the stats are kept
+		template< typename DataType >
+		bool ResourceCache< DataType >::Clear( void )
+		{
+			m_Index.clear();
+			m_Stats.unResident = 0;
+
+			return m_Entries.Clear();
+		}
+		//*************************************************************//
+
+
+
+		//*************************************************************//
+		// GET DATA
+		//	- return the data stored for the handle
+		template< typename DataType >
+		DataType* ResourceCache< DataType >::GetData( Handle handle ) const
+		{
+			Entry* entry = m_Entries.GetData( handle );
+			if( entry == nullptr )
+				return nullptr;
+
+			return &entry->data;
+		}
+		//*************************************************************//
+
+
+
+		//*************************************************************//
+		// GET REF COUNT
+		//	- return the number of references held on the handle's entry
+		template< typename DataType >
+		unsigned int ResourceCache< DataType >::GetRefCount( Handle handle ) const
+		{
+			if( m_Entries.IsHandleValid( handle ) == false )
+				return 0;
+
+			return m_Entries.GetData( handle )->unRefCount;
+		}
+		//*************************************************************//
+
+
+	}	// namespace SGD_IMPLEMENTATION
+
+}	// namespace SGD
+
+
+#endif //INC_SGD_RESOURCE_CACHE_HPP
@@ -0,0 +1,56 @@
+/***********************************************************************\
+|																		|
+|	File:			SGD_SpinLock.h										|
+|																		|
+|	Purpose:		To guard very short critical sections shared by		|
+|					worker threads without a kernel object				|
+|																		|
+\***********************************************************************/
+
+#ifndef SGD_SPINLOCK_H
+#define SGD_SPINLOCK_H
+
+
+#include <atomic>		// Spins on a std::atomic_flag
+#include <mutex>		// Locked through std::lock_guard
+#include <thread>		// Yields with std::this_thread::yield
+
+
+namespace SGD
+{
+	namespace SGD_IMPLEMENTATION
+	{
+		//*************************************************************//
+		// SpinLock
+		//	- lock / unlock (usable with std::lock_guard)
+		//	- only for a few instructions: a waiting thread yields its
+		//	  time slice but never sleeps
+		class SpinLock
+		{
+		public:
+			SpinLock		( void )	{	m_Flag.clear();		}	// Default constructor
+			~SpinLock		( void )	= default;					// Destructor
+
+			void	lock	( void )
+			{
+				while( m_Flag.test_and_set( std::memory_order_acquire ) == true )
+					std::this_thread::yield();
+			}
+
+			void	unlock	( void )
+			{
+				m_Flag.clear( std::memory_order_release );
+			}
+
+		private:
+			SpinLock				( const SpinLock& )	= delete;	// Copy constructor
+			SpinLock&	operator=	( const SpinLock& )	= delete;	// Assignment operator
+
+			std::atomic_flag	m_Flag;
+		};
+
+	}	// namespace SGD_IMPLEMENTATION
+
+}	// namespace SGD
+
+#endif //SGD_SPINLOCK_H
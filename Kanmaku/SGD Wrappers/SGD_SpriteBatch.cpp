@@ -0,0 +1,140 @@
+/***********************************************************************\
+|																		|
+|	File:			SGD_SpriteBatch.cpp									|
+|																		|
+|	Purpose:		To collect the frame's sprites, sort them by		|
+|					depth then texture, and draw each run of one		|
+|					texture with a single DrawTextureBatch call			|
+|																		|
+\***********************************************************************/
+
+#include "SGD_SpriteBatch.h"
+
+
+// Uses std::sort
+#include <algorithm>
+
+// Uses SGD_ASSERT for debug breaks
+#include "SGD_Utilities.h"
+
+
+namespace SGD
+{
+	//*****************************************************************//
+	// BEGIN
+	//	- start collecting a new set of sprites
+	void SpriteBatch::Begin( void )
+	{
+		SGD_ASSERT( m_bBegun == false, "SpriteBatch::Begin - End was not called" );
+
+		m_vEntries.clear();
+		m_vQuads.clear();
+		m_bBegun = true;
+	}
+	//*****************************************************************//
+
+
+
+	//*****************************************************************//
+	// DRAW
+	//	- store the sprite until End
+	void SpriteBatch::Draw( HTexture handle, Point position, Rectangle section, float rotation, Vector rotationOffset, Color color, Size scale, float depth )
+	{
+		SGD_ASSERT( m_bBegun == true, "SpriteBatch::Draw - Begin was not called" );
+		if( m_bBegun == false )
+			return;
+
+		SGD_ASSERT( handle != SGD::INVALID_HANDLE, "SpriteBatch::Draw - invalid handle" );
+		if( handle == SGD::INVALID_HANDLE )
+			return;
+
+
+		Entry entry;
+		entry.fDepth	= depth;
+		entry.hTexture	= handle;
+		entry.unQuad	= (unsigned int)m_vQuads.size();
+		m_vEntries.push_back( entry );
+
+		SpriteQuad quad;
+		quad.position		= position;
+		quad.section		= section;
+		quad.rotation		= rotation;
+		quad.rotationOffset	= rotationOffset;
+		quad.color			= color;
+		quad.scale			= scale;
+		m_vQuads.push_back( quad );
+	}
+	//*****************************************************************//
+
+
+
+	//*****************************************************************//
+	// END
+	//	- sort the sprites & draw one batch per run of one texture
+	//	- returns false if any batch failed to draw
+	bool SpriteBatch::End( GraphicsManager* graphics )
+	{
+		SGD_ASSERT( m_bBegun == true, "SpriteBatch::End - Begin was not called" );
+		if( m_bBegun == false )
+			return false;
+
+		m_bBegun = false;
+
+		if( graphics == nullptr )
+			graphics = GraphicsManager::GetInstance();
+
+
+		// Equal keys keep the Draw order (the quad index breaks the tie,
+		// so no stable_sort & its temporary buffer every frame)
+		std::sort( m_vEntries.begin(), m_vEntries.end(), &SpriteBatch::EntryLess );
+
+
+		m_Stats = SpriteBatchStats{};
+		bool success = true;
+
+		unsigned int count = (unsigned int)m_vEntries.size();
+		unsigned int first = 0;
+
+		while( first < count )
+		{
+			// Gather the run: same texture, any depth in between
+			HTexture texture = m_vEntries[ first ].hTexture;
+
+			m_vRun.clear();
+			unsigned int last = first;
+			while( last < count && m_vEntries[ last ].hTexture == texture )
+				m_vRun.push_back( m_vQuads[ m_vEntries[ last++ ].unQuad ] );
+
+
+			if( graphics->DrawTextureBatch( texture, &m_vRun[ 0 ], (unsigned int)m_vRun.size() ) == false )
+				success = false;
+
+			m_Stats.unRuns++;
+			first = last;
+		}
+
+		m_Stats.unSprites			= count;
+		m_Stats.unDrawCallsSaved	= count - m_Stats.unRuns;
+
+		return success;
+	}
+	//*****************************************************************//
+
+
+
+	//*****************************************************************//
+	// ENTRY LESS
+	//	- order by depth, then texture, then Draw order
+	/*static*/ bool SpriteBatch::EntryLess( const Entry& a, const Entry& b )
+	{
+		if( a.fDepth != b.fDepth )
+			return a.fDepth < b.fDepth;
+
+		if( a.hTexture != b.hTexture )
+			return a.hTexture < b.hTexture;
+
+		return a.unQuad < b.unQuad;
+	}
+	//*****************************************************************//
+
+}	// namespace SGD
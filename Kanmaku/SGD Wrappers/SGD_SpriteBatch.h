@@ -0,0 +1,85 @@
+/***********************************************************************\
+|																		|
+|	File:			SGD_SpriteBatch.h									|
+|																		|
+|	Purpose:		To collect the frame's sprites, sort them by		|
+|					depth then texture, and draw each run of one		|
+|					texture with a single DrawTextureBatch call			|
+|																		|
+\***********************************************************************/
+
+#ifndef SGD_SPRITEBATCH_H
+#define SGD_SPRITEBATCH_H
+
+
+#include "SGD_GraphicsManager.h"	// Submits SpriteQuads through DrawTextureBatch
+#include <vector>					// Stores the sprites in std::vectors
+
+
+namespace SGD
+{
+	//*****************************************************************//
+	// SpriteBatchStats
+	//	- counters of the last End call
+	//	- each run replaces one draw call per sprite with a single
+	//	  submission, so the saved draw calls are sprites - runs
+	struct SpriteBatchStats
+	{
+		unsigned int	unSprites			= 0;	// quads submitted
+		unsigned int	unRuns				= 0;	// DrawTextureBatch calls
+		unsigned int	unDrawCallsSaved	= 0;
+	};
+
+
+	//*****************************************************************//
+	// SpriteBatch
+	//	- Draw takes the parameters of DrawTextureSection plus a depth,
+	//	  and only stores them
+	//	- End stable-sorts the sprites by depth, then by texture,
+	//	  and draws each run of one texture in one call
+	//	- sprites with equal depth & texture keep the Draw order
+	//	- does not know the backend: End draws through any GraphicsManager
+	//	- the storage is kept between frames, so a steady frame
+	//	  does not allocate
+	class SpriteBatch
+	{
+	public:
+		SpriteBatch		( void )	= default;
+		~SpriteBatch	( void )	= default;
+
+
+		void			Begin		( void );
+		void			Draw		( HTexture handle, Point position, Rectangle section = {}, float rotation = 0.0f, Vector rotationOffset = {}, Color color = {}, Size scale = {1.0f, 1.0f}, float depth = 0.0f );
+		bool			End			( GraphicsManager* graphics = nullptr );	// null uses GraphicsManager::GetInstance
+
+		unsigned int	GetCount	( void ) const		{	return (unsigned int)m_vEntries.size();	}
+		const SpriteBatchStats&	GetStats	( void ) const		{	return m_Stats;		}
+
+	private:
+		SpriteBatch					( const SpriteBatch& )	= delete;
+		SpriteBatch&	operator=	( const SpriteBatch& )	= delete;
+
+
+		//*************************************************************//
+		// Entry
+		//	- sort key of one sprite, the quad stays in m_vQuads
+		struct Entry
+		{
+			float			fDepth;
+			HTexture		hTexture;
+			unsigned int	unQuad;		// index into m_vQuads
+		};
+
+		static	bool	EntryLess	( const Entry& a, const Entry& b );
+
+
+		std::vector< Entry >		m_vEntries;		// in Draw order until End sorts them
+		std::vector< SpriteQuad >	m_vQuads;		// in Draw order
+		std::vector< SpriteQuad >	m_vRun;			// contiguous quads of the run being drawn
+		SpriteBatchStats			m_Stats;
+		bool						m_bBegun	= false;
+	};
+
+}	// namespace SGD
+
+#endif //SGD_SPRITEBATCH_H
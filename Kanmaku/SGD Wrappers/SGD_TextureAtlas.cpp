@@ -0,0 +1,394 @@
+/***********************************************************************\
+|																		|
+|	File:			SGD_TextureAtlas.cpp								|
+|																		|
+|	Purpose:		To read & write the sub-rectangle index of a packed	|
+|					texture atlas and find a sprite's page by its		|
+|					original file name, and the tile index of a			|
+|					tiled background layer								|
+|																		|
+\***********************************************************************/
+
+#include "SGD_TextureAtlas.h"
+
+
+// Uses towlower
+#include <cwctype>
+
+// Uses swprintf for the tile names
+#include <cwchar>
+
+
+namespace SGD
+{
+	namespace SGD_IMPLEMENTATION
+	{
+		//*************************************************************//
+		// FILE HELPERS
+		//	- integers are assembled byte by byte, so the format does not
+		//	  depend on the host's endianness
+		static bool ReadU16( FILE* file, unsigned int& value )
+		{
+			unsigned char bytes[ 2 ];
+			if( fread( bytes, 1, 2, file ) != 2 )
+				return false;
+
+			value = (unsigned int)bytes[0] | ((unsigned int)bytes[1] << 8);
+			return true;
+		}
+
+		static bool ReadU32( FILE* file, unsigned int& value )
+		{
+			unsigned char bytes[ 4 ];
+			if( fread( bytes, 1, 4, file ) != 4 )
+				return false;
+
+			value = (unsigned int)bytes[0] | ((unsigned int)bytes[1] << 8)
+				| ((unsigned int)bytes[2] << 16) | ((unsigned int)bytes[3] << 24);
+			return true;
+		}
+
+		static bool WriteU16( FILE* file, unsigned int value )
+		{
+			unsigned char bytes[ 2 ] = { (unsigned char)value, (unsigned char)(value >> 8) };
+			return fwrite( bytes, 1, 2, file ) == 2;
+		}
+
+		static bool WriteU32( FILE* file, unsigned int value )
+		{
+			unsigned char bytes[ 4 ] = { (unsigned char)value, (unsigned char)(value >> 8),
+										 (unsigned char)(value >> 16), (unsigned char)(value >> 24) };
+			return fwrite( bytes, 1, 4, file ) == 4;
+		}
+
+
+		//*************************************************************//
+		// NAME HELPERS
+		//	- names are stored as UTF-8 with a 16-bit byte count
+		static bool ReadName( FILE* file, std::wstring& name )
+		{
+			unsigned int length;
+			if( ReadU16( file, length ) == false )
+				return false;
+
+			std::string bytes( length, '\0' );
+			if( length > 0 && fread( &bytes[0], 1, length, file ) != length )
+				return false;
+
+
+			// Decode UTF-8 (invalid bytes pass through as Latin-1)
+			name.clear();
+			for( unsigned int i = 0; i < length; )
+			{
+				unsigned int lead = (unsigned char)bytes[ i ];
+				unsigned int extra = (lead >= 0xF0) ? 3 : (lead >= 0xE0) ? 2 : (lead >= 0xC0) ? 1 : 0;
+
+				if( extra == 0 || i + extra >= length )
+				{
+					name += (wchar_t)lead;
+					i++;
+					continue;
+				}
+
+				unsigned int code = lead & (0x3F >> extra);
+				for( unsigned int e = 1; e <= extra; e++ )
+					code = (code << 6) | ((unsigned char)bytes[ i + e ] & 0x3F);
+
+				name += (wchar_t)code;
+				i += 1 + extra;
+			}
+
+			return true;
+		}
+
+		static bool WriteName( FILE* file, const std::wstring& name )
+		{
+			// Encode UTF-8
+			std::string bytes;
+			for( size_t i = 0; i < name.size(); i++ )
+			{
+				unsigned long code = (unsigned long)name[ i ];
+
+				if( code < 0x80 )
+					bytes += (char)code;
+				else if( code < 0x800 )
+				{
+					bytes += (char)(0xC0 | (code >> 6));
+					bytes += (char)(0x80 | (code & 0x3F));
+				}
+				else if( code < 0x10000 )
+				{
+					bytes += (char)(0xE0 | (code >> 12));
+					bytes += (char)(0x80 | ((code >> 6) & 0x3F));
+					bytes += (char)(0x80 | (code & 0x3F));
+				}
+				else
+				{
+					bytes += (char)(0xF0 | (code >> 18));
+					bytes += (char)(0x80 | ((code >> 12) & 0x3F));
+					bytes += (char)(0x80 | ((code >> 6) & 0x3F));
+					bytes += (char)(0x80 | (code & 0x3F));
+				}
+			}
+
+			if( bytes.size() > 0xFFFF )
+				return false;
+
+			return WriteU16( file, (unsigned int)bytes.size() )
+				&& fwrite( bytes.data(), 1, bytes.size(), file ) == bytes.size();
+		}
+
+	}	// namespace SGD_IMPLEMENTATION
+
+
+
+	//*****************************************************************//
+	// ATLAS INDEX READ
+	bool AtlasIndex::Read( FILE* file )
+	{
+		using namespace SGD_IMPLEMENTATION;
+
+		vPages.clear();
+		vSprites.clear();
+
+		if( file == nullptr )
+			return false;
+
+
+		// Header
+		char magic[ 4 ];
+		unsigned int version, numPages, numSprites;
+
+		if( fread( magic, 1, 4, file ) != 4
+			|| magic[0] != 'S' || magic[1] != 'G' || magic[2] != 'D' || magic[3] != 'A' )
+			return false;
+
+		if( ReadU32( file, version ) == false || version != SGD_ATLAS_VERSION
+			|| ReadU32( file, numPages ) == false || ReadU32( file, numSprites ) == false )
+			return false;
+
+
+		// Pages
+		for( unsigned int p = 0; p < numPages; p++ )
+		{
+			Page page;
+			if( ReadName( file, page.wsFilename ) == false
+				|| ReadU32( file, page.unWidth ) == false || ReadU32( file, page.unHeight ) == false )
+				return false;
+
+			vPages.push_back( page );
+		}
+
+
+		// Sprites
+		for( unsigned int s = 0; s < numSprites; s++ )
+		{
+			Sprite sprite;
+			if( ReadName( file, sprite.wsFilename ) == false
+				|| ReadU32( file, sprite.unPage ) == false
+				|| ReadU32( file, sprite.unX ) == false || ReadU32( file, sprite.unY ) == false
+				|| ReadU32( file, sprite.unWidth ) == false || ReadU32( file, sprite.unHeight ) == false )
+				return false;
+
+			// Reject sprites outside their page
+			if( sprite.unPage >= numPages
+				|| sprite.unX + sprite.unWidth > vPages[ sprite.unPage ].unWidth
+				|| sprite.unY + sprite.unHeight > vPages[ sprite.unPage ].unHeight )
+				return false;
+
+			vSprites.push_back( sprite );
+		}
+
+		return true;
+	}
+	//*****************************************************************//
+
+
+
+	//*****************************************************************//
+	// ATLAS INDEX WRITE
+	bool AtlasIndex::Write( FILE* file ) const
+	{
+		using namespace SGD_IMPLEMENTATION;
+
+		if( file == nullptr )
+			return false;
+
+		bool success = fwrite( "SGDA", 1, 4, file ) == 4
+			&& WriteU32( file, SGD_ATLAS_VERSION )
+			&& WriteU32( file, (unsigned int)vPages.size() )
+			&& WriteU32( file, (unsigned int)vSprites.size() );
+
+		for( unsigned int p = 0; success == true && p < vPages.size(); p++ )
+		{
+			success = WriteName( file, vPages[ p ].wsFilename )
+				&& WriteU32( file, vPages[ p ].unWidth )
+				&& WriteU32( file, vPages[ p ].unHeight );
+		}
+
+		for( unsigned int s = 0; success == true && s < vSprites.size(); s++ )
+		{
+			const Sprite& sprite = vSprites[ s ];
+			success = WriteName( file, sprite.wsFilename )
+				&& WriteU32( file, sprite.unPage )
+				&& WriteU32( file, sprite.unX )			&& WriteU32( file, sprite.unY )
+				&& WriteU32( file, sprite.unWidth )		&& WriteU32( file, sprite.unHeight );
+		}
+
+		return success;
+	}
+	//*****************************************************************//
+
+
+
+	//*****************************************************************//
+	// TILE LAYER INDEX READ
+	bool TileLayerIndex::Read( FILE* file )
+	{
+		using namespace SGD_IMPLEMENTATION;
+
+		vHasTile.clear();
+
+		if( file == nullptr )
+			return false;
+
+
+		// Header
+		char magic[ 4 ];
+		unsigned int version;
+
+		if( fread( magic, 1, 4, file ) != 4
+			|| magic[0] != 'S' || magic[1] != 'G' || magic[2] != 'D' || magic[3] != 'T' )
+			return false;
+
+		if( ReadU32( file, version ) == false || version != SGD_TILES_VERSION
+			|| ReadU32( file, unWidth ) == false || ReadU32( file, unHeight ) == false
+			|| ReadU32( file, unTileWidth ) == false || ReadU32( file, unTileHeight ) == false
+			|| ReadU32( file, unColumns ) == false || ReadU32( file, unRows ) == false
+			|| ReadName( file, wsPrefix ) == false )
+			return false;
+
+		// Reject a grid that does not cover the layer exactly
+		if( unTileWidth == 0 || unTileHeight == 0
+			|| unColumns != (unWidth + unTileWidth - 1) / unTileWidth
+			|| unRows != (unHeight + unTileHeight - 1) / unTileHeight )
+			return false;
+
+
+		// Tile flags
+		vHasTile.resize( unColumns * unRows );
+		if( vHasTile.empty() == false && fread( &vHasTile[0], 1, vHasTile.size(), file ) != vHasTile.size() )
+		{
+			vHasTile.clear();
+			return false;
+		}
+
+		return true;
+	}
+	//*****************************************************************//
+
+
+
+	//*****************************************************************//
+	// TILE LAYER INDEX WRITE
+	bool TileLayerIndex::Write( FILE* file ) const
+	{
+		using namespace SGD_IMPLEMENTATION;
+
+		if( file == nullptr || vHasTile.size() != unColumns * unRows )
+			return false;
+
+		return fwrite( "SGDT", 1, 4, file ) == 4
+			&& WriteU32( file, SGD_TILES_VERSION )
+			&& WriteU32( file, unWidth )		&& WriteU32( file, unHeight )
+			&& WriteU32( file, unTileWidth )	&& WriteU32( file, unTileHeight )
+			&& WriteU32( file, unColumns )		&& WriteU32( file, unRows )
+			&& WriteName( file, wsPrefix )
+			&& (vHasTile.empty() == true || fwrite( &vHasTile[0], 1, vHasTile.size(), file ) == vHasTile.size());
+	}
+	//*****************************************************************//
+
+
+
+	//*****************************************************************//
+	// TILE LAYER INDEX GET TILE NAME & SUFFIX
+	std::wstring TileLayerIndex::GetTileName( unsigned int column, unsigned int row ) const
+	{
+		wchar_t suffix[ 32 ];
+		GetTileSuffix( column, row, suffix, 32 );
+
+		return wsPrefix + suffix;
+	}
+
+	void TileLayerIndex::GetTileSuffix( unsigned int column, unsigned int row, wchar_t* buffer, unsigned int size ) const
+	{
+		swprintf( buffer, size, L"_%u_%u.png", column, row );
+	}
+	//*****************************************************************//
+
+
+
+	//*****************************************************************//
+	// ATLAS DIRECTORY ADD
+	//	- resolve the names against the index's folder
+	void AtlasDirectory::Add( const AtlasIndex& index, const wchar_t* indexFilename )
+	{
+		// Folder of the index, with its trailing slash
+		std::wstring folder = (indexFilename != nullptr) ? indexFilename : L"";
+		size_t slash = folder.find_last_of( L"/\\" );
+		folder.resize( (slash == std::wstring::npos) ? 0 : slash + 1 );
+
+
+		for( unsigned int s = 0; s < index.vSprites.size(); s++ )
+		{
+			const AtlasIndex::Sprite& sprite = index.vSprites[ s ];
+
+			Entry entry;
+			entry.wsPage	= folder + index.vPages[ sprite.unPage ].wsFilename;
+			entry.unX		= sprite.unX;
+			entry.unY		= sprite.unY;
+			entry.unWidth	= sprite.unWidth;
+			entry.unHeight	= sprite.unHeight;
+
+			// insert keeps an existing entry
+			m_Entries.insert( std::make_pair( MakeKey( (folder + sprite.wsFilename).c_str() ), entry ) );
+		}
+	}
+	//*****************************************************************//
+
+
+
+	//*****************************************************************//
+	// ATLAS DIRECTORY FIND
+	const AtlasDirectory::Entry* AtlasDirectory::Find( const wchar_t* filename ) const
+	{
+		if( filename == nullptr || m_Entries.empty() == true )
+			return nullptr;
+
+		std::map< std::wstring, Entry >::const_iterator iter = m_Entries.find( MakeKey( filename ) );
+		if( iter == m_Entries.end() )
+			return nullptr;
+
+		return &iter->second;
+	}
+	//*****************************************************************//
+
+
+
+	//*****************************************************************//
+	// MAKE KEY
+	//	- lower case with forward slashes, no leading "./"
+	/*static*/ std::wstring AtlasDirectory::MakeKey( const wchar_t* filename )
+	{
+		std::wstring key;
+		for( const wchar_t* c = filename; *c != L'\0'; ++c )
+			key += (*c == L'\\') ? L'/' : (wchar_t)towlower( *c );
+
+		while( key.compare( 0, 2, L"./" ) == 0 )
+			key.erase( 0, 2 );
+
+		return key;
+	}
+	//*****************************************************************//
+
+}	// namespace SGD
@@ -0,0 +1,137 @@
+/***********************************************************************\
+|																		|
+|	File:			SGD_TextureAtlas.h									|
+|																		|
+|	Purpose:		To read & write the sub-rectangle index of a packed	|
+|					texture atlas and find a sprite's page by its		|
+|					original file name, and the tile index of a			|
+|					tiled background layer								|
+|																		|
+\***********************************************************************/
+
+#ifndef SGD_TEXTUREATLAS_H
+#define SGD_TEXTUREATLAS_H
+
+
+#include <cstdio>		// Reads & writes through FILE*
+#include <map>			// Finds the sprites in a std::map
+#include <string>		// Stores the names in std::wstrings
+#include <vector>		// Stores the pages & sprites in std::vectors
+
+
+namespace SGD
+{
+	//*****************************************************************//
+	// AtlasIndex
+	//	- the pages & sprite sub-rectangles written by the AtlasPacker
+	//	  tool (Kanmaku/tools/AtlasPacker)
+	//	- file layout, every integer little-endian:
+	//		char[4]	"SGDA"
+	//		u32		version (SGD_ATLAS_VERSION)
+	//		u32		page count
+	//		u32		sprite count
+	//		pages:		u16 name length, UTF-8 name, u32 width, u32 height
+	//		sprites:	u16 name length, UTF-8 name, u32 page, u32 x, y, width, height
+	//	- page & sprite names are relative to the index file's folder
+	#define SGD_ATLAS_VERSION	1
+
+	struct AtlasIndex
+	{
+		struct Page
+		{
+			std::wstring	wsFilename;
+			unsigned int	unWidth;
+			unsigned int	unHeight;
+		};
+
+		struct Sprite
+		{
+			std::wstring	wsFilename;		// original image file
+			unsigned int	unPage;			// index into vPages
+			unsigned int	unX;			// sub-rectangle within the page
+			unsigned int	unY;
+			unsigned int	unWidth;
+			unsigned int	unHeight;
+		};
+
+		std::vector< Page >		vPages;
+		std::vector< Sprite >	vSprites;
+
+
+		bool	Read	( FILE* file );			// false if the file is not a valid index
+		bool	Write	( FILE* file ) const;
+	};
+
+
+	//*****************************************************************//
+	// TileLayerIndex
+	//	- a background layer cut into a grid of equal tiles by the
+	//	  TileSlicer tool (Kanmaku/tools/TileSlicer)
+	//	- file layout, every integer little-endian:
+	//		char[4]	"SGDT"
+	//		u32		version (SGD_TILES_VERSION)
+	//		u32		layer width, height (pixels)
+	//		u32		tile width, height
+	//		u32		column count, row count
+	//		u16 name length, UTF-8 tile name prefix
+	//		u8		per tile, row by row: 1 if the tile has a file
+	//				(0: fully transparent, no file was written)
+	//	- tile (column, row) is "<prefix>_<column>_<row>.png", relative
+	//	  to the index file's folder
+	#define SGD_TILES_VERSION	1
+
+	struct TileLayerIndex
+	{
+		unsigned int					unWidth			= 0;	// layer size
+		unsigned int					unHeight		= 0;
+		unsigned int					unTileWidth		= 0;
+		unsigned int					unTileHeight	= 0;
+		unsigned int					unColumns		= 0;
+		unsigned int					unRows			= 0;
+		std::wstring					wsPrefix;
+		std::vector< unsigned char >	vHasTile;				// unColumns * unRows flags
+
+
+		bool			Read		( FILE* file );			// false if the file is not a valid index
+		bool			Write		( FILE* file ) const;
+
+		bool			HasTile		( unsigned int column, unsigned int row ) const		{	return vHasTile[ row * unColumns + column ] != 0;	}
+		std::wstring	GetTileName	( unsigned int column, unsigned int row ) const;	// relative to the index
+		void			GetTileSuffix	( unsigned int column, unsigned int row, wchar_t* buffer, unsigned int size ) const;	// the name after wsPrefix
+	};
+
+
+	//*****************************************************************//
+	// AtlasDirectory
+	//	- maps each sprite of the added indices to its page & sub-rectangle
+	//	- sprites are found by the path the game would load them with
+	//	  (folder of the index + sprite name), ignoring case & slash style
+	//	- a sprite added twice keeps its first location
+	class AtlasDirectory
+	{
+	public:
+		struct Entry
+		{
+			std::wstring	wsPage;			// page path, ready for LoadTexture
+			unsigned int	unX;
+			unsigned int	unY;
+			unsigned int	unWidth;
+			unsigned int	unHeight;
+		};
+
+
+		void			Add		( const AtlasIndex& index, const wchar_t* indexFilename );
+		const Entry*	Find	( const wchar_t* filename ) const;	// null if not in any atlas
+		void			Clear	( void )			{	m_Entries.clear();	}
+
+		unsigned int	GetCount( void ) const		{	return (unsigned int)m_Entries.size();	}
+
+	private:
+		static	std::wstring	MakeKey	( const wchar_t* filename );
+
+		std::map< std::wstring, Entry >		m_Entries;		// by normalized sprite path
+	};
+
+}	// namespace SGD
+
+#endif //SGD_TEXTUREATLAS_H
@@ -15,10 +15,21 @@
 #include "SGD_Utilities.h"
 		
 
+#if defined( _WIN32 )
+
 // Uses MessageBox & OutputDebugString
 #define WIN32_LEAN_AND_MEAN
 #include <Windows.h>
 
+#else
+
+// Uses fprintf & abort in place of the Win32 Output window & breakpoint
+// (the headless builds: SGD_HEADLESS_GRAPHICS)
+#include <cstdio>
+#include <cstdlib>
+
+#endif
+
 
 namespace SGD
 {	
@@ -30,10 +41,12 @@ namespace SGD
 		SGD::Print( message );
 		SGD::Print( "\n" );
 		
+#if defined( _WIN32 )
 		// Display a message box (using the active window & its title)
 		char title[ 128 ];
 		::GetWindowTextA( ::GetActiveWindow(), title, 128 ); 
 		::MessageBoxA( ::GetActiveWindow(), message, title, MB_OK | MB_ICONEXCLAMATION );
+#endif
 	}
 
 	void Alert( const wchar_t* message )
@@ -42,10 +55,12 @@ namespace SGD
 		SGD::Print( message );
 		SGD::Print( "\n" );
 
+#if defined( _WIN32 )
 		// Display a message box (using the active window & its title)
 		wchar_t title[ 128 ];
 		::GetWindowTextW( ::GetActiveWindow(), title, 128 ); 
 		::MessageBoxW( ::GetActiveWindow(), message, title, MB_OK | MB_ICONEXCLAMATION );
+#endif
 	}
 	//*****************************************************************//
 
@@ -62,7 +77,11 @@ namespace SGD
 			SGD::Alert( message );
 
 			// Trigger a breakpoint
+#if defined( _WIN32 )
 			__debugbreak();				// USE THE CALLSTACK TO DEBUG!
+#else
+			abort();					// USE THE CORE DUMP TO DEBUG!
+#endif
 		}
 	}
 
@@ -75,7 +94,11 @@ namespace SGD
 			SGD::Alert( message );
 
 			// Trigger a breakpoint
+#if defined( _WIN32 )
 			__debugbreak();				// USE THE CALLSTACK TO DEBUG!
+#else
+			abort();					// USE THE CORE DUMP TO DEBUG!
+#endif
 		}
 	}
 	//*****************************************************************//
@@ -87,13 +110,21 @@ namespace SGD
 	void Print( const char* message )
 	{
 		// Print message to Output window
+#if defined( _WIN32 )
 		::OutputDebugStringA( message );
+#else
+		fprintf( stderr, "%s", message );
+#endif
 	}
 
 	void Print( const wchar_t* message )
 	{
 		// Print message to Output window
+#if defined( _WIN32 )
 		::OutputDebugStringW( message );
+#else
+		fprintf( stderr, "%ls", message );
+#endif
 	}
 	//*****************************************************************//
 
@@ -12,18 +12,19 @@
 
 #pragma once
 
-#include "../SGD Wrappers/SGD_Handle.h"
 #include "../SGD Wrappers/SGD_Geometry.h"
 #include "../SGD Wrappers/SGD_Color.h"
-#include <vector>
+#include "AnimationLibrary.h"				// uses AnimationLibrary & ANIMATION_INVALID_CLIP
 
 
 //*********************************************************************//
 // AnchorPointAnimation class
-//	- runs animation using an image of variable-size frames
+//	- plays one clip of an AnimationLibrary
 //	- stores a relative offset from the top-left corner of the frame rect 
 //	  to the render position
-//	- image MUST have a size power-of-2 (e.g. 64, 128, 256, 512)
+//	- only a playback cursor (clip, frame, time): the frames & image
+//	  belong to the library, so any number of instances can share them
+//	- a reversed animation plays the clip's frames last to first
 class AnchorPointAnimation
 {
 public:
@@ -34,15 +35,14 @@ public:
 	
 
 	//*****************************************************************//
-	// Initialize & Terminate
-	void	Initialize	( void );	// SHOULD have a config file
-	void	Terminate	( void );
-	void	InitialPlayer();
+	// Initialize
+	bool	Initialize	( const AnimationLibrary* library, const char* clipName );		// false if the clip is missing
+	void	Initialize	( const AnimationLibrary* library, unsigned int clip );		// a clip ID from FindClip
 
 
 	//*****************************************************************//
 	// Animation Controls:
-	void	Update(float elapsedTime, bool isFlipped);
+	void	Update		( float elapsedTime, bool reversed = false );
 	void	Render		( SGD::Point position, bool flipped = false, float scale = 1.0f, SGD::Color color = { } ) const;
 	
 	SGD::Rectangle GetRect( SGD::Point position, bool flipped = false, float scale = 1.0f ) const;
@@ -58,22 +58,17 @@ public:
 
 private:
 	//*****************************************************************//
-	// image
-	SGD::HTexture			m_hImage		= SGD::INVALID_HANDLE;
+	// Helper Methods
+	const AnimationLibrary::Frame&	GetFrame	( bool reversed ) const;
 
-	// frame data
-	struct Frame
-	{
-		SGD::Rectangle		rFrame;		// source rectangle
-		SGD::Point			ptAnchor;	// relative position within source
-		float				fDuration;	// time to wait on this frame
-	};
 
-	std::vector< Frame >	m_vFrames;
-	std::vector< Frame >	m_rvFrames;
+	//*****************************************************************//
+	// clip
+	const AnimationLibrary*	m_pLibrary		= nullptr;
+	unsigned int			m_unClip		= ANIMATION_INVALID_CLIP;
 
 	// animation data
-	int						m_nCurrFrame	= 0;
+	unsigned int			m_unCurrFrame	= 0;
 
 	float					m_fTimeWaited	= 0.0f;
 	float					m_fSpeed		= 1.0f;		// multiplier: 2.0 - twice as fast
@@ -0,0 +1,160 @@
+//*********************************************************************//
+//	File:		AnimationLibrary.cpp
+//	Author:		
+//	Course:		
+//	Purpose:	AnimationLibrary class loads the animation clips from
+//				an XML file & shares them between every animation
+//*********************************************************************//
+
+#include "AnimationLibrary.h"
+
+#include "../SGD Wrappers/SGD_GraphicsManager.h"
+#include "../SGD Wrappers/SGD_Utilities.h"
+
+#include "../TinyXML/tinyxml.h"
+
+#include <cstring>
+
+
+//*********************************************************************//
+// Load
+//	- read every clip of the file & load their images
+//	- a malformed clip fails the whole file
+bool AnimationLibrary::Load( const char* filename )
+{
+	SGD_ASSERT( filename != nullptr, "AnimationLibrary::Load - filename cannot be null" );
+	if( filename == nullptr )
+		return false;
+
+
+	// Parse the file
+	TiXmlDocument doc;
+	if( doc.LoadFile( filename ) == false )
+		return false;
+
+	TiXmlElement* pRoot = doc.RootElement();
+	if( pRoot == nullptr || strcmp( pRoot->Value(), "animations" ) != 0 )
+		return false;
+
+
+	// Read the clips into temporary arrays (appended on success)
+	std::vector< Clip >		clips;
+	std::vector< Frame >	frames;
+	std::vector< std::string >	images;
+
+	for( TiXmlElement* pClip = pRoot->FirstChildElement( "clip" ); pClip != nullptr;
+		pClip = pClip->NextSiblingElement( "clip" ) )
+	{
+		const char* name	= pClip->Attribute( "name" );
+		const char* image	= pClip->Attribute( "image" );
+		if( name == nullptr || image == nullptr )
+			return false;
+
+		Clip clip;
+		clip.sName			= name;
+		clip.unFirstFrame	= (unsigned int)( m_vFrames.size() + frames.size() );
+
+
+		// Variable-size frames
+		for( TiXmlElement* pFrame = pClip->FirstChildElement( "frame" ); pFrame != nullptr;
+			pFrame = pFrame->NextSiblingElement( "frame" ) )
+		{
+			Frame frame = { };
+			if( pFrame->QueryFloatAttribute( "left", &frame.rFrame.left ) != TIXML_SUCCESS
+				|| pFrame->QueryFloatAttribute( "top", &frame.rFrame.top ) != TIXML_SUCCESS
+				|| pFrame->QueryFloatAttribute( "right", &frame.rFrame.right ) != TIXML_SUCCESS
+				|| pFrame->QueryFloatAttribute( "bottom", &frame.rFrame.bottom ) != TIXML_SUCCESS
+				|| pFrame->QueryFloatAttribute( "duration", &frame.fDuration ) != TIXML_SUCCESS )
+				return false;
+
+			pFrame->QueryFloatAttribute( "anchorX", &frame.ptAnchor.x );	// optional (0)
+			pFrame->QueryFloatAttribute( "anchorY", &frame.ptAnchor.y );
+
+			frames.push_back( frame );
+		}
+
+
+		// Fixed-size frames, using the Cell Algorithm
+		for( TiXmlElement* pGrid = pClip->FirstChildElement( "grid" ); pGrid != nullptr;
+			pGrid = pGrid->NextSiblingElement( "grid" ) )
+		{
+			int width = 0, height = 0, columns = 0, count = 0;
+			Frame frame = { };
+
+			if( pGrid->QueryIntAttribute( "width", &width ) != TIXML_SUCCESS
+				|| pGrid->QueryIntAttribute( "height", &height ) != TIXML_SUCCESS
+				|| pGrid->QueryIntAttribute( "columns", &columns ) != TIXML_SUCCESS
+				|| pGrid->QueryIntAttribute( "count", &count ) != TIXML_SUCCESS
+				|| pGrid->QueryFloatAttribute( "duration", &frame.fDuration ) != TIXML_SUCCESS
+				|| width <= 0 || height <= 0 || columns <= 0 || count <= 0 )
+				return false;
+
+			pGrid->QueryFloatAttribute( "anchorX", &frame.ptAnchor.x );	// optional (0)
+			pGrid->QueryFloatAttribute( "anchorY", &frame.ptAnchor.y );
+
+			for( int i = 0; i < count; i++ )
+			{
+				frame.rFrame.left	= (float)( (i % columns) * width  );
+				frame.rFrame.top	= (float)( (i / columns) * height );
+				frame.rFrame.right	= frame.rFrame.left + width;
+				frame.rFrame.bottom	= frame.rFrame.top  + height;
+
+				frames.push_back( frame );
+			}
+		}
+
+
+		clip.unFrameCount = (unsigned int)( m_vFrames.size() + frames.size() ) - clip.unFirstFrame;
+		if( clip.unFrameCount == 0 )
+			return false;
+
+		// Do the frames share one duration?
+		const Frame* first = &frames[ clip.unFirstFrame - m_vFrames.size() ];
+		clip.fUniformDuration = first->fDuration;
+
+		for( unsigned int i = 1; i < clip.unFrameCount; i++ )
+			if( first[ i ].fDuration != clip.fUniformDuration )
+				clip.fUniformDuration = 0.0f;
+
+		clips.push_back( clip );
+		images.push_back( image );
+	}
+
+
+	// Load the images (the GraphicsManager shares a file loaded twice)
+	SGD::GraphicsManager* pGraphics = SGD::GraphicsManager::GetInstance();
+
+	for( unsigned int i = 0; i < clips.size(); i++ )
+		clips[ i ].hImage = pGraphics->LoadTexture( images[ i ].c_str() );
+
+	m_vClips.insert( m_vClips.end(), clips.begin(), clips.end() );
+	m_vFrames.insert( m_vFrames.end(), frames.begin(), frames.end() );
+	return true;
+}
+
+
+//*********************************************************************//
+// Unload
+void AnimationLibrary::Unload( void )
+{
+	SGD::GraphicsManager* pGraphics = SGD::GraphicsManager::GetInstance();
+
+	for( unsigned int i = 0; i < m_vClips.size(); i++ )
+		pGraphics->UnloadTexture( m_vClips[ i ].hImage );
+
+	m_vClips.clear();
+	m_vFrames.clear();
+}
+
+
+//*********************************************************************//
+// FindClip
+//	- look the name up once, then keep the ID
+unsigned int AnimationLibrary::FindClip( const char* name ) const
+{
+	for( unsigned int i = 0; i < m_vClips.size(); i++ )
+		if( m_vClips[ i ].sName == name )
+			return i;
+
+	return ANIMATION_INVALID_CLIP;
+}
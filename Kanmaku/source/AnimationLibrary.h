@@ -0,0 +1,92 @@
+//*********************************************************************//
+//	File:		AnimationLibrary.h
+//	Author:		
+//	Course:		
+//	Purpose:	AnimationLibrary class loads the animation clips from
+//				an XML file & shares them between every animation
+//*********************************************************************//
+
+#pragma once
+
+#include "../SGD Wrappers/SGD_Handle.h"			// uses HTexture
+#include "../SGD Wrappers/SGD_Geometry.h"			// uses Rectangle & Point
+#include <string>									// uses std::string
+#include <vector>									// uses std::vector
+
+
+//*********************************************************************//
+// Clip ID of a clip that was not found
+#define ANIMATION_INVALID_CLIP		0xFFFFFFFF
+
+
+//*********************************************************************//
+// AnimationLibrary class
+//	- every clip's frames are stored once, in one array, and its
+//	  image is loaded once: an animation instance only keeps a
+//	  cursor (see AnchorPointAnimation)
+//	- clips are immutable once loaded; IDs stay valid until Unload
+//	- file format (TinyXML):
+//		<animations>
+//			<clip name="walk" image="resource/graphics/walk.png">
+//				<frame left="0" top="0" right="64" bottom="64"
+//					   anchorX="32" anchorY="32" duration="0.1" />
+//			</clip>
+//			<clip name="boom" image="resource/graphics/boom.png">
+//				<grid width="60" height="50" columns="6" count="10"
+//					  anchorX="0" anchorY="0" duration="0.1" />
+//			</clip>
+//		</animations>
+//	- a grid is expanded into its frames using the Cell Algorithm
+class AnimationLibrary
+{
+public:
+	//*****************************************************************//
+	// Frame & Clip
+	struct Frame
+	{
+		SGD::Rectangle		rFrame;		// source rectangle
+		SGD::Point			ptAnchor;	// relative position within source
+		float				fDuration;	// time to wait on this frame
+	};
+
+	struct Clip
+	{
+		std::string			sName;
+		SGD::HTexture		hImage;
+		unsigned int		unFirstFrame;	// index of the library's frames
+		unsigned int		unFrameCount;
+		float				fUniformDuration;	// every frame's duration, 0 if they differ
+	};
+
+
+	//*****************************************************************//
+	// Default Constructor & Destructor
+	AnimationLibrary( void )	= default;
+	~AnimationLibrary( void )	= default;
+
+
+	//*****************************************************************//
+	// Load & Unload
+	bool			Load		( const char* filename );	// adds the file's clips (none if it fails)
+	void			Unload		( void );					// removes every clip & unloads the images
+
+
+	//*****************************************************************//
+	// Accessors:
+	unsigned int	FindClip		( const char* name ) const;		// ANIMATION_INVALID_CLIP if missing
+	unsigned int	GetClipCount	( void ) const		{	return (unsigned int)m_vClips.size();	}
+	const Clip&		GetClip			( unsigned int clip ) const		{	return m_vClips[ clip ];	}
+	const Frame&	GetFrame		( const Clip& clip, unsigned int frame ) const	{	return m_vFrames[ clip.unFirstFrame + frame ];	}
+
+private:
+	//*****************************************************************//
+	// Not copyable
+	AnimationLibrary( const AnimationLibrary& )				= delete;
+	AnimationLibrary& operator= ( const AnimationLibrary& )	= delete;
+
+
+	//*****************************************************************//
+	// Data
+	std::vector< Clip >		m_vClips;
+	std::vector< Frame >	m_vFrames;		// every clip's frames, in order
+};
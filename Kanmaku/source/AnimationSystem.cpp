@@ -0,0 +1,451 @@
+//*********************************************************************//
+//	File:		AnimationSystem.cpp
+//	Author:		
+//	Course:		
+//	Purpose:	AnimationSystem class stores every playing animation
+//				cursor in contiguous arrays & advances them all in
+//				one pass per tick
+//*********************************************************************//
+
+#include "AnimationSystem.h"
+
+#include "../SGD Wrappers/SGD_GraphicsManager.h"
+#include "../SGD Wrappers/SGD_Utilities.h"
+
+
+//*********************************************************************//
+// Initialize
+void AnimationSystem::Initialize( const AnimationLibrary* library )
+{
+	SGD_ASSERT( library != nullptr, "AnimationSystem::Initialize - library cannot be null" );
+
+	m_pLibrary = library;
+}
+
+//*********************************************************************//
+// Terminate
+void AnimationSystem::Terminate( void )
+{
+	m_vTime.clear();
+	m_vRate.clear();
+	m_vDuration.clear();
+	m_vSpeed.clear();
+	m_vClip.clear();
+	m_vFrame.clear();
+	m_vFlags.clear();
+	m_vCursors.clear();
+
+	m_vIndices.clear();
+	m_vFreeIDs.clear();
+
+	m_vRanges.clear();
+	m_vEvents.clear();
+
+	m_pLibrary = nullptr;
+}
+
+
+//*********************************************************************//
+// Create
+//	- insert a cursor at the end of its clip's range, stopped at the
+//	  first frame: each later clip moves its first cursor to its end
+unsigned int AnimationSystem::Create( unsigned int clip )
+{
+	SGD_ASSERT( m_pLibrary != nullptr && clip < m_pLibrary->GetClipCount(),
+		"AnimationSystem::Create - invalid clip" );
+	if( m_pLibrary == nullptr || clip >= m_pLibrary->GetClipCount() )
+		return ANIMATION_INVALID_CURSOR;
+
+
+	// Reuse a free ID
+	unsigned int cursor;
+	if( m_vFreeIDs.empty() == false )
+	{
+		cursor = m_vFreeIDs.back();
+		m_vFreeIDs.pop_back();
+	}
+	else
+	{
+		cursor = (unsigned int)m_vIndices.size();
+		m_vIndices.push_back( ANIMATION_INVALID_CURSOR );
+	}
+
+	// A new clip's range starts after every cursor
+	if( clip >= m_vRanges.size() )
+	{
+		ClipRange empty = { (unsigned int)m_vCursors.size(), 0 };
+		m_vRanges.resize( clip + 1, empty );
+	}
+
+
+	// Open a hole at the end of the arrays
+	m_vTime.push_back( 0.0f );
+	m_vRate.push_back( 0.0f );
+	m_vDuration.push_back( 0.0f );
+	m_vSpeed.push_back( 1.0f );
+	m_vClip.push_back( clip );
+	m_vFrame.push_back( 0 );
+	m_vFlags.push_back( 0 );
+	m_vCursors.push_back( cursor );
+
+	// Move it down to the end of the clip's range
+	unsigned int index = (unsigned int)m_vCursors.size() - 1;
+
+	for( unsigned int c = (unsigned int)m_vRanges.size() - 1; c > clip; c-- )
+	{
+		ClipRange& range = m_vRanges[ c ];
+		if( range.unCount != 0 )
+		{
+			MoveCursor( range.unFirst, index );
+			index = range.unFirst;
+		}
+
+		++range.unFirst;
+	}
+
+	++m_vRanges[ clip ].unCount;
+
+
+	m_vTime[ index ]		= 0.0f;
+	m_vRate[ index ]		= 0.0f;
+	m_vSpeed[ index ]		= 1.0f;
+	m_vClip[ index ]		= clip;
+	m_vFrame[ index ]		= 0;
+	m_vFlags[ index ]		= 0;
+	m_vCursors[ index ]		= cursor;
+	m_vIndices[ cursor ]	= index;
+
+	m_vDuration[ index ] = GetFrame( index ).fDuration;
+	return cursor;
+}
+
+//*********************************************************************//
+// Destroy
+//	- move the last cursor of the clip into the hole, then the last
+//	  cursor of each later clip into the hole before it
+void AnimationSystem::Destroy( unsigned int& cursor )
+{
+	unsigned int index = FindIndex( cursor );
+	if( index == ANIMATION_INVALID_CURSOR )
+		return;
+
+	unsigned int clip = m_vClip[ index ];
+
+	ClipRange& range = m_vRanges[ clip ];
+	--range.unCount;
+
+	MoveCursor( range.unFirst + range.unCount, index );
+	index = range.unFirst + range.unCount;
+
+	for( unsigned int c = clip + 1; c < m_vRanges.size(); c++ )
+	{
+		ClipRange& next = m_vRanges[ c ];
+		if( next.unCount != 0 )
+		{
+			MoveCursor( next.unFirst + next.unCount - 1, index );
+			index = next.unFirst + next.unCount - 1;
+		}
+
+		--next.unFirst;
+	}
+
+
+	// The hole is the last element now
+	m_vTime.pop_back();
+	m_vRate.pop_back();
+	m_vDuration.pop_back();
+	m_vSpeed.pop_back();
+	m_vClip.pop_back();
+	m_vFrame.pop_back();
+	m_vFlags.pop_back();
+	m_vCursors.pop_back();
+
+	m_vIndices[ cursor ] = ANIMATION_INVALID_CURSOR;
+	m_vFreeIDs.push_back( cursor );
+
+	cursor = ANIMATION_INVALID_CURSOR;
+}
+
+
+//*********************************************************************//
+// Restart
+//	- start the animation over from frame 0
+void AnimationSystem::Restart( unsigned int cursor, bool looping, float speed )
+{
+	unsigned int index = FindIndex( cursor );
+	if( index == ANIMATION_INVALID_CURSOR )
+		return;
+
+	unsigned char flags = m_vFlags[ index ] & FLAG_REVERSED;
+	flags |= FLAG_PLAYING;
+	if( looping == true )
+		flags |= FLAG_LOOPING;
+
+	m_vFlags[ index ]		= flags;
+	m_vSpeed[ index ]		= speed;
+	m_vFrame[ index ]		= 0;
+	m_vTime[ index ]		= 0.0f;
+	m_vDuration[ index ]	= GetFrame( index ).fDuration;
+	SetRate( index );
+}
+
+//*********************************************************************//
+// Pause
+void AnimationSystem::Pause( unsigned int cursor, bool pause )
+{
+	unsigned int index = FindIndex( cursor );
+	if( index == ANIMATION_INVALID_CURSOR )
+		return;
+
+	if( pause == true )
+		m_vFlags[ index ] &= ~FLAG_PLAYING;
+	else
+		m_vFlags[ index ] |= FLAG_PLAYING;
+
+	SetRate( index );
+}
+
+//*********************************************************************//
+// SetReversed
+//	- the current frame is counted from the other end
+void AnimationSystem::SetReversed( unsigned int cursor, bool reversed )
+{
+	unsigned int index = FindIndex( cursor );
+	if( index == ANIMATION_INVALID_CURSOR )
+		return;
+
+	if( ((m_vFlags[ index ] & FLAG_REVERSED) != 0) == reversed )
+		return;
+
+	m_vFlags[ index ] ^= FLAG_REVERSED;
+	m_vDuration[ index ] = GetFrame( index ).fDuration;
+}
+
+
+//*********************************************************************//
+// IsPlaying & IsFinished
+bool AnimationSystem::IsPlaying( unsigned int cursor ) const
+{
+	unsigned int index = FindIndex( cursor );
+	return index != ANIMATION_INVALID_CURSOR && (m_vFlags[ index ] & FLAG_PLAYING) != 0;
+}
+
+bool AnimationSystem::IsFinished( unsigned int cursor ) const
+{
+	unsigned int index = FindIndex( cursor );
+	return index != ANIMATION_INVALID_CURSOR && (m_vFlags[ index ] & FLAG_FINISHED) != 0;
+}
+
+
+//*********************************************************************//
+// Update
+//	- run every cursor's timer, clip by clip
+//	- like AnchorPointAnimation: at most one frame per Update,
+//	  and the time restarts at 0 on the next frame
+void AnimationSystem::Update( float elapsedTime )
+{
+	m_vEvents.clear();
+
+	for( unsigned int c = 0; c < m_vRanges.size(); c++ )
+		if( m_vRanges[ c ].unCount != 0 )
+			UpdateClip( c, elapsedTime );
+}
+
+
+//*********************************************************************//
+// Render
+//	- draw the current frame offset from the given position
+void AnimationSystem::Render( unsigned int cursor, SGD::Point position, bool flipped, float scale, SGD::Color color ) const
+{
+	unsigned int index = FindIndex( cursor );
+	SGD_ASSERT( index != ANIMATION_INVALID_CURSOR, "AnimationSystem::Render - invalid cursor" );
+
+	// Check the parameters
+	if( index == ANIMATION_INVALID_CURSOR || scale <= 0.0f || color.alpha == 0 )
+		return;
+
+
+	// Mirror a flipped frame
+	float scaleX = scale;
+
+	if( flipped == true )
+		scaleX = -scaleX;
+
+
+	// Draw the current frame, offset from the position by
+	// the anchor amount (to get the top-left corner)
+	const AnimationLibrary::Frame& frame = GetFrame( index );
+
+	SGD::GraphicsManager::GetInstance()->DrawTextureSection(
+		m_pLibrary->GetClip( m_vClip[ index ] ).hImage,
+		{ position.x - (frame.ptAnchor.x * scaleX),
+		  position.y - (frame.ptAnchor.y * scale) },
+		frame.rFrame,
+		0.0f, {},
+		color, {scaleX, scale} );
+}
+
+
+//*********************************************************************//
+// GetRect
+//	- return the frame rect at the given position
+SGD::Rectangle AnimationSystem::GetRect( unsigned int cursor, SGD::Point position, bool flipped, float scale ) const
+{
+	unsigned int index = FindIndex( cursor );
+	if( index == ANIMATION_INVALID_CURSOR )
+		return SGD::Rectangle{ position, SGD::Size{ 0, 0 } };
+
+	const AnimationLibrary::Frame& frame = GetFrame( index );
+	SGD::Rectangle result = { };
+
+	// Is it flipped?
+	if( flipped == true ) {
+		result.right	= position.x + (frame.ptAnchor.x * scale);
+		result.left		= result.right - (frame.rFrame.ComputeWidth() * scale);
+	} else {
+		result.left		= position.x - (frame.ptAnchor.x * scale);
+		result.right	= result.left + (frame.rFrame.ComputeWidth() * scale);
+	}
+
+	result.top		= position.y - (frame.ptAnchor.y * scale);
+	result.bottom	= result.top + (frame.rFrame.ComputeHeight() * scale);
+	return result;
+}
+
+
+//*********************************************************************//
+// FindIndex
+//	- ANIMATION_INVALID_CURSOR for a destroyed or invalid ID
+unsigned int AnimationSystem::FindIndex( unsigned int cursor ) const
+{
+	if( cursor >= m_vIndices.size() )
+		return ANIMATION_INVALID_CURSOR;
+
+	return m_vIndices[ cursor ];
+}
+
+
+//*********************************************************************//
+// MoveCursor
+//	- copy an element over another (Create & Destroy regroup the clips)
+void AnimationSystem::MoveCursor( unsigned int from, unsigned int to )
+{
+	if( from == to )
+		return;
+
+	m_vTime[ to ]		= m_vTime[ from ];
+	m_vRate[ to ]		= m_vRate[ from ];
+	m_vDuration[ to ]	= m_vDuration[ from ];
+	m_vSpeed[ to ]		= m_vSpeed[ from ];
+	m_vClip[ to ]		= m_vClip[ from ];
+	m_vFrame[ to ]		= m_vFrame[ from ];
+	m_vFlags[ to ]		= m_vFlags[ from ];
+	m_vCursors[ to ]	= m_vCursors[ from ];
+	m_vIndices[ m_vCursors[ to ] ] = to;
+}
+
+
+//*********************************************************************//
+// UpdateClip
+//	- advance the timers of one clip's cursors, then move the ones
+//	  past their frame's duration to the next frame, or loop / finish
+//	  at the end (the clip is looked up once, not per cursor)
+void AnimationSystem::UpdateClip( unsigned int clip, float elapsedTime )
+{
+	const ClipRange& range = m_vRanges[ clip ];
+	const AnimationLibrary::Clip& data = m_pLibrary->GetClip( clip );
+	const AnimationLibrary::Frame* frames = &m_pLibrary->GetFrame( data, 0 );
+
+	unsigned int	first		= range.unFirst;
+	unsigned int	end			= range.unFirst + range.unCount;
+	unsigned int	lastFrame	= data.unFrameCount - 1;
+	bool			uniform		= data.fUniformDuration != 0.0f;
+
+	float*			time		= &m_vTime[ 0 ];
+	float*			rate		= &m_vRate[ 0 ];
+	float*			duration	= &m_vDuration[ 0 ];
+
+
+	// Advance the timers (a stopped cursor's rate is 0)
+	for( unsigned int i = first; i < end; i++ )
+		time[ i ] += elapsedTime * rate[ i ];
+
+
+	// Did any frame end? (a straight reduction: vectorized too)
+	//	- most ticks step no cursor & skip the steps
+	unsigned int ended = 0;
+	for( unsigned int i = first; i < end; i++ )
+		ended |= (unsigned int)( time[ i ] >= duration[ i ] );
+
+	if( ended == 0 )
+		return;
+
+
+	// Move the cursors whose frame ended
+	unsigned int*	frame		= &m_vFrame[ 0 ];
+	unsigned char*	flags		= &m_vFlags[ 0 ];
+
+	for( unsigned int i = first; i < end; i++ )
+	{
+		if( time[ i ] < duration[ i ] || rate[ i ] <= 0.0f )
+			continue;
+
+		time[ i ] = 0.0f;
+
+		// Has it reached the end?
+		if( frame[ i ] == lastFrame )
+		{
+			Event event = { m_vCursors[ i ], EVENT_LOOPED };
+
+			// Should the animation loop from the beginning?
+			if( (flags[ i ] & FLAG_LOOPING) != 0 )
+				frame[ i ] = 0;
+			else
+			{
+				// Stop on the last valid frame
+				flags[ i ] = (flags[ i ] & ~FLAG_PLAYING) | FLAG_FINISHED;
+				rate[ i ] = 0.0f;
+
+				event.eType = EVENT_FINISHED;
+			}
+
+			m_vEvents.push_back( event );
+		}
+		else
+			++frame[ i ];
+
+		// A clip of uniform frames keeps its duration
+		if( uniform == false )
+		{
+			unsigned int current = frame[ i ];
+			if( (flags[ i ] & FLAG_REVERSED) != 0 )
+				current = lastFrame - current;
+
+			duration[ i ] = frames[ current ].fDuration;
+		}
+	}
+}
+
+
+//*********************************************************************//
+// SetRate
+//	- the speed while playing, 0 otherwise
+void AnimationSystem::SetRate( unsigned int index )
+{
+	m_vRate[ index ] = ( (m_vFlags[ index ] & FLAG_PLAYING) != 0 ) ? m_vSpeed[ index ] : 0.0f;
+}
+
+
+//*********************************************************************//
+// GetFrame
+//	- the library's frame under the cursor
+const AnimationLibrary::Frame& AnimationSystem::GetFrame( unsigned int index ) const
+{
+	const AnimationLibrary::Clip& clip = m_pLibrary->GetClip( m_vClip[ index ] );
+
+	unsigned int frame = m_vFrame[ index ];
+	if( (m_vFlags[ index ] & FLAG_REVERSED) != 0 )
+		frame = clip.unFrameCount - 1 - frame;
+
+	return m_pLibrary->GetFrame( clip, frame );
+}
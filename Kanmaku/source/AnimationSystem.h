@@ -0,0 +1,142 @@
+//*********************************************************************//
+//	File:		AnimationSystem.h
+//	Author:		
+//	Course:		
+//	Purpose:	AnimationSystem class stores every playing animation
+//				cursor in contiguous arrays & advances them all in
+//				one pass per tick
+//*********************************************************************//
+
+#pragma once
+
+#include "../SGD Wrappers/SGD_Geometry.h"
+#include "../SGD Wrappers/SGD_Color.h"
+#include "AnimationLibrary.h"				// uses AnimationLibrary
+#include <vector>							// uses std::vector
+
+
+//*********************************************************************//
+// Cursor ID of a cursor that was not created
+#define ANIMATION_INVALID_CURSOR	0xFFFFFFFF
+
+
+//*********************************************************************//
+// AnimationSystem class
+//	- a cursor plays one clip of the library, like an
+//	  AnchorPointAnimation, but its fields are stored in parallel
+//	  arrays (time, rate, current frame duration, ...)
+//	- the arrays are kept grouped by clip: Update looks each clip up
+//	  once, adds the elapsed time to its cursors in one straight loop
+//	  (no branch or library lookup, so the compiler can vectorize it),
+//	  then steps the cursors past their frame's duration with the
+//	  clip's frames at hand
+//	- a clip whose frames share one duration never looks it up again
+//	- the cursors that finished or looped during an Update are
+//	  reported together by GetEvents (clip by clip)
+//	- cursor IDs stay valid until Destroy (the arrays are compacted &
+//	  regrouped, the IDs are not)
+class AnimationSystem
+{
+public:
+	//*****************************************************************//
+	// Event
+	enum EventType { EVENT_FINISHED, EVENT_LOOPED };
+
+	struct Event
+	{
+		unsigned int	unCursor;
+		EventType		eType;
+	};
+
+
+	//*****************************************************************//
+	// Default Constructor & Destructor
+	AnimationSystem( void )		= default;
+	~AnimationSystem( void )	= default;
+
+
+	//*****************************************************************//
+	// Initialize & Terminate
+	void			Initialize	( const AnimationLibrary* library );
+	void			Terminate	( void );		// destroys every cursor
+
+
+	//*****************************************************************//
+	// Cursors:
+	unsigned int	Create		( unsigned int clip );		// stopped at the first frame
+	void			Destroy		( unsigned int& cursor );	// sets the ID to ANIMATION_INVALID_CURSOR
+
+	void			Restart		( unsigned int cursor, bool looping = false, float speed = 1.0f );
+	void			Pause		( unsigned int cursor, bool pause = true );
+	void			SetReversed	( unsigned int cursor, bool reversed );		// play the frames last to first
+
+	bool			IsPlaying	( unsigned int cursor ) const;
+	bool			IsFinished	( unsigned int cursor ) const;
+	unsigned int	GetCount	( void ) const		{	return (unsigned int)m_vCursors.size();	}
+
+
+	//*****************************************************************//
+	// Play & Draw:
+	void			Update		( float elapsedTime );
+	const std::vector< Event >&	GetEvents	( void ) const		{	return m_vEvents;	}		// of the last Update
+
+	void			Render		( unsigned int cursor, SGD::Point position, bool flipped = false, float scale = 1.0f, SGD::Color color = { } ) const;
+	SGD::Rectangle	GetRect		( unsigned int cursor, SGD::Point position, bool flipped = false, float scale = 1.0f ) const;
+
+private:
+	//*****************************************************************//
+	// Not copyable
+	AnimationSystem( const AnimationSystem& )				= delete;
+	AnimationSystem& operator= ( const AnimationSystem& )	= delete;
+
+
+	//*****************************************************************//
+	// Flags
+	enum CursorFlags
+	{
+		FLAG_PLAYING	= 1,
+		FLAG_LOOPING	= 2,
+		FLAG_FINISHED	= 4,
+		FLAG_REVERSED	= 8,
+	};
+
+
+	//*****************************************************************//
+	// ClipRange
+	//	- the elements of one clip's cursors
+	struct ClipRange
+	{
+		unsigned int	unFirst;
+		unsigned int	unCount;
+	};
+
+
+	//*****************************************************************//
+	// Helper Methods
+	unsigned int	FindIndex	( unsigned int cursor ) const;		// index into the arrays
+	void			MoveCursor	( unsigned int from, unsigned int to );
+	void			UpdateClip	( unsigned int clip, float elapsedTime );
+	void			SetRate		( unsigned int index );
+	const AnimationLibrary::Frame&	GetFrame	( unsigned int index ) const;
+
+
+	//*****************************************************************//
+	// Data
+	const AnimationLibrary*			m_pLibrary	= nullptr;
+
+	// parallel arrays, one element per cursor
+	std::vector< float >			m_vTime;		// waited on the current frame
+	std::vector< float >			m_vRate;		// speed, 0 when not playing
+	std::vector< float >			m_vDuration;	// of the current frame
+	std::vector< float >			m_vSpeed;
+	std::vector< unsigned int >		m_vClip;
+	std::vector< unsigned int >		m_vFrame;		// counted from the playing direction's start
+	std::vector< unsigned char >	m_vFlags;
+	std::vector< unsigned int >		m_vCursors;		// ID of each element
+
+	std::vector< unsigned int >		m_vIndices;		// array index of each ID (or ANIMATION_INVALID_CURSOR)
+	std::vector< unsigned int >		m_vFreeIDs;
+
+	std::vector< ClipRange >		m_vRanges;		// of each clip, in clip order
+	std::vector< Event >			m_vEvents;
+};
@@ -0,0 +1,178 @@
+//*********************************************************************//
+//	File:		AssetResidency.cpp
+//	Author:		
+//	Course:		
+//	Purpose:	AssetResidency class keeps the assets shared by two
+//				game states loaded across a state change, preloads
+//				the next state's assets & measures each transition
+//*********************************************************************//
+
+#include "AssetResidency.h"
+
+#include "IGameState.h"
+
+#include "../SGD Wrappers/SGD_AudioManager.h"
+#include "../SGD Wrappers/SGD_GraphicsManager.h"
+
+#define WIN32_LEAN_AND_MEAN
+#include <Windows.h>
+#include <cstdio>
+
+
+//*********************************************************************//
+// BeginTransition
+//	- called before the old state's Exit
+//	- pin the next state's files, then release the prefetched ones
+//	  (a prefetch of the next state turns into reused files)
+void AssetResidency::BeginTransition( IGameState* pNext )
+{
+	// Report a transition that is still loading as it stands
+	if( m_bTransitioning == true )
+		FinishReport();
+
+
+	// Start measuring
+	m_Current		= TransitionStats{};
+	m_llBeginTicks	= GetTicks();
+	m_BeginTextures	= SGD::GraphicsManager::GetInstance()->GetCacheStats();
+	m_BeginAudio	= SGD::AudioManager::GetInstance()->GetCacheStats();
+	m_bTransitioning = true;
+
+
+	// Pin the next state's files
+	if( pNext != nullptr )
+	{
+		Pin( pNext, m_Pins );
+		m_Current.unAssets = m_Pins.GetCount();
+
+		const SGD::CacheStats& textures	= SGD::GraphicsManager::GetInstance()->GetCacheStats();
+		const SGD::CacheStats& audio	= SGD::AudioManager::GetInstance()->GetCacheStats();
+
+		m_Current.unReused = (textures.unHits - m_BeginTextures.unHits) + (audio.unHits - m_BeginAudio.unHits);
+		m_Current.unLoaded = (textures.unMisses - m_BeginTextures.unMisses) + (audio.unMisses - m_BeginAudio.unMisses);
+	}
+
+
+	// The prefetched files are either pinned now or no longer needed
+	m_Prefetch.Unload();
+	m_pPrefetched = nullptr;
+}
+
+
+//*********************************************************************//
+// EndTransition
+//	- called after the new state's Enter
+void AssetResidency::EndTransition( void )
+{
+	m_Current.fStallTime = (float)( GetTicks() - m_llBeginTicks ) / (float)GetFrequency();
+}
+
+
+//*********************************************************************//
+// Prefetch
+//	- start loading a state's files while the current state runs
+//	- replaces the previous prefetch
+void AssetResidency::Prefetch( IGameState* pState )
+{
+	if( pState == m_pPrefetched )
+		return;
+
+	m_Prefetch.Unload();
+	m_pPrefetched = nullptr;
+
+	if( pState != nullptr )
+	{
+		Pin( pState, m_Prefetch );
+		m_pPrefetched = pState;
+	}
+}
+
+
+//*********************************************************************//
+// Update
+//	- once the pinned files have loaded, release the pins & report
+void AssetResidency::Update( void )
+{
+	if( m_bTransitioning == false )
+		return;
+
+	if( m_Pins.Update() == true )
+		FinishReport();
+}
+
+
+//*********************************************************************//
+// Terminate
+//	- release every pin (before the wrappers terminate)
+void AssetResidency::Terminate( void )
+{
+	m_Pins.Unload();
+	m_Prefetch.Unload();
+	m_pPrefetched		= nullptr;
+	m_bTransitioning	= false;
+}
+
+
+//*********************************************************************//
+// Pin
+//	- add a reference to each file of the state's manifest
+//	  (a file that is not resident starts loading asynchronously)
+void AssetResidency::Pin( IGameState* pState, SGD::LoadBatch& pins )
+{
+	AssetManifest manifest;
+	pState->GetAssets( manifest );
+
+	for( unsigned int i = 0; i < manifest.vTextures.size(); i++ )
+		pins.LoadTexture( manifest.vTextures[ i ] );
+
+	for( unsigned int i = 0; i < manifest.vAudio.size(); i++ )
+		pins.LoadAudio( manifest.vAudio[ i ] );
+}
+
+
+//*********************************************************************//
+// FinishReport
+//	- store the stats of the transition & release its pins
+//	  (the new state holds its own references by now)
+void AssetResidency::FinishReport( void )
+{
+	const SGD::CacheStats& textures	= SGD::GraphicsManager::GetInstance()->GetCacheStats();
+	const SGD::CacheStats& audio	= SGD::AudioManager::GetInstance()->GetCacheStats();
+
+	m_Current.unUnloaded		= (textures.unUnloads - m_BeginTextures.unUnloads) + (audio.unUnloads - m_BeginAudio.unUnloads);
+	m_Current.ullBytesLoaded	= (textures.ullBytesLoaded - m_BeginTextures.ullBytesLoaded) + (audio.ullBytesLoaded - m_BeginAudio.ullBytesLoaded);
+	m_Current.fLoadTime			= (float)( GetTicks() - m_llBeginTicks ) / (float)GetFrequency();
+
+	m_Pins.Unload();
+
+	m_LastTransition	= m_Current;
+	m_bTransitioning	= false;
+
+
+#if _DEBUG
+	char szBuffer[ 256 ];
+	_snprintf_s( szBuffer, 256, _TRUNCATE, 
+		"Transition: %u assets (%u reused, %u loaded, %u freed), %llu bytes, stall %.1f ms, loaded in %.1f ms\n",
+		m_LastTransition.unAssets, m_LastTransition.unReused, m_LastTransition.unLoaded, m_LastTransition.unUnloaded,
+		m_LastTransition.ullBytesLoaded, m_LastTransition.fStallTime * 1000.0f, m_LastTransition.fLoadTime * 1000.0f );
+	OutputDebugStringA( szBuffer );
+#endif
+}
+
+
+//*********************************************************************//
+// GetTicks & GetFrequency
+//	- high-resolution counter
+long long AssetResidency::GetTicks( void ) const
+{
+	LARGE_INTEGER counter;
+	QueryPerformanceCounter( &counter );
+	return counter.QuadPart;
+}
+
+long long AssetResidency::GetFrequency( void ) const
+{
+	LARGE_INTEGER frequency;
+	QueryPerformanceFrequency( &frequency );
+	return frequency.QuadPart;
+}
@@ -0,0 +1,111 @@
+//*********************************************************************//
+//	File:		AssetResidency.h
+//	Author:		
+//	Course:		
+//	Purpose:	AssetResidency class keeps the assets shared by two
+//				game states loaded across a state change, preloads
+//				the next state's assets & measures each transition
+//*********************************************************************//
+
+#pragma once
+
+#include "../SGD Wrappers/SGD_LoadBatch.h"		// uses LoadBatch
+#include <vector>								// uses std::vector
+
+
+//*********************************************************************//
+// Forward class declaration
+class IGameState;
+
+
+//*********************************************************************//
+// AssetManifest
+//	- the files a game state loads in Enter
+//	- the names are string literals (only the pointers are stored)
+struct AssetManifest
+{
+	std::vector< const wchar_t* >	vTextures;
+	std::vector< const wchar_t* >	vAudio;
+};
+
+
+//*********************************************************************//
+// TransitionStats
+//	- one state change, from ChangeState until the new state's
+//	  assets have finished loading
+struct TransitionStats
+{
+	unsigned int		unAssets		= 0;	// files in the new state's manifest
+	unsigned int		unReused		= 0;	// already resident (shared or prefetched)
+	unsigned int		unLoaded		= 0;	// files read for the transition
+	unsigned int		unUnloaded		= 0;	// files freed (not needed by the new state)
+	unsigned long long	ullBytesLoaded	= 0;
+	float				fStallTime		= 0.0f;	// seconds spent in Exit & Enter
+	float				fLoadTime		= 0.0f;	// seconds until the assets were loaded
+};
+
+
+//*********************************************************************//
+// AssetResidency class
+//	- BeginTransition pins the next state's manifest: each file gets
+//	  one extra reference (loading it asynchronously if it is not
+//	  resident), so the old state's Exit cannot free a shared file
+//	  and the new state's Enter finds it in the cache
+//	- the pins are released once the files have loaded, leaving the
+//	  state's own references
+//	- Prefetch pins a state's manifest ahead of time (held until
+//	  the next transition)
+class AssetResidency
+{
+public:
+	//*****************************************************************//
+	// Constructor & destructor
+	AssetResidency( void )		= default;
+	~AssetResidency( void )		= default;
+
+
+	//*****************************************************************//
+	// State Changes
+	//	- Game::ChangeState calls Begin before Exit & End after Enter
+	void	BeginTransition	( IGameState* pNext );
+	void	EndTransition	( void );
+
+	void	Prefetch		( IGameState* pState );
+	void	Update			( void );		// once per frame: finishes the report
+	void	Terminate		( void );		// release every pin
+
+
+	//*****************************************************************//
+	// Instrumentation
+	const TransitionStats&	GetLastTransition	( void ) const	{	return m_LastTransition;	}
+	bool					IsTransitioning		( void ) const	{	return m_bTransitioning;	}
+
+
+private:
+	AssetResidency( const AssetResidency& )				= delete;
+	AssetResidency& operator= ( const AssetResidency& )	= delete;
+
+
+	//*****************************************************************//
+	// Helper Methods
+	void			Pin				( IGameState* pState, SGD::LoadBatch& pins );
+	void			FinishReport	( void );
+	long long		GetTicks		( void ) const;
+	long long		GetFrequency	( void ) const;
+
+
+	//*****************************************************************//
+	// Pinned files
+	SGD::LoadBatch		m_Pins;							// the transition's manifest
+	SGD::LoadBatch		m_Prefetch;						// a state's manifest, loaded early
+	IGameState*			m_pPrefetched		= nullptr;
+
+	//*****************************************************************//
+	// Transition in progress
+	bool				m_bTransitioning	= false;
+	long long			m_llBeginTicks		= 0;
+	SGD::CacheStats		m_BeginTextures;				// manager stats at BeginTransition
+	SGD::CacheStats		m_BeginAudio;
+	TransitionStats		m_Current;
+	TransitionStats		m_LastTransition;
+};
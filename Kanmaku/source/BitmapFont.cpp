@@ -39,14 +39,15 @@ void BitmapFont::Initialize( void )
 void BitmapFont::Terminate( void )
 {
 	SGD::GraphicsManager::GetInstance()->UnloadTexture( m_hImage );
+
+	m_mRuns.clear();
+	m_CacheStats = CacheStats();
 }
 
 
 //*********************************************************************//
 // Draw
-//	- render the array of characters, one-at-a-time,
-//	  using the Cell Algorithm to calculate the source rect
-//	  of the glyph within the image
+//	- render the string's cached glyph run (laid out on the first draw)
 void BitmapFont::Draw( const char* output, SGD::Point position, float scale, SGD::Color color ) const
 {
 	// Validate the image
@@ -64,113 +65,104 @@ void BitmapFont::Draw( const char* output, SGD::Point position, float scale, SGD
 		return;
 
 
-	// Store the starting x
-	float startX = position.x;
+	// Key the text (the string keeps its capacity: no allocation)
+	m_sKey.assign( output );
+	DrawKey( (unsigned int)m_sKey.length(), scale, position, color );
+}
 
+//*********************************************************************//
+// Draw
+//	- render the string's cached glyph run (laid out on the first draw)
+void BitmapFont::Draw( const wchar_t* output, SGD::Point position, float scale, SGD::Color color ) const
+{
+	// Validate the image
+	SGD_ASSERT( m_hImage != SGD::INVALID_HANDLE,
+		"BitmapFont::Draw - font was not initialized" );
+	
+	// Validate the string
+	SGD_ASSERT( output != nullptr,
+		"BitmapFont::Draw - string CANNOT be null!" );
 
-	// Loop through the string, until hitting null terminator
-	for( unsigned int i = 0; output[ i ] != '\0'; i++ )
-	{
-		char ch = output[ i ];
+	// Check the parameters
+	if( output[ 0 ] == L'\0'		// empty string
+		|| scale <= 0.0f			// no size or inverted
+		|| color.alpha == 0 )		// transparent
+		return;
 
-		// Handle the whitespace
-		if( ch == ' ' )
-		{
-			// Move to the next position on screen
-			position.x += m_nCharWidth * scale;
-			continue;
-		}
-		else if( ch == '\n' )
-		{
-			// Drop down a line & reset to the starting x position
-			position.x = startX;
-			position.y += m_nCharHeight * scale;
-			continue;
-		}
-		else if( ch == '\t' )
-		{
-			// Calculate the number of pixels on this line
-			float pixels = position.x - startX;
 
-			// Calculate the numbers of characters on this line
-			int chars = (int)( pixels / (m_nCharWidth * scale) );
+	// Key the text, narrowed to ASCII
+	m_sKey.clear();
+	for( unsigned int i = 0; output[ i ] != L'\0'; i++ )
+		m_sKey.push_back( (char)output[ i ] );
 
-			// Calculate the number of spaces to add
-			// for a 4-space alignment
-			int spaces = 4 - (chars % 4);
+	DrawKey( (unsigned int)m_sKey.length(), scale, position, color );
+}
 
-			
-			// Move to the next position on screen
-			position.x += m_nCharWidth * scale * spaces;
-			continue;
-		}
 
+//*********************************************************************//
+// DrawKey
+//	- complete the key held in m_sKey with the scale,
+//	  find or lay out its glyph run, then draw it in one batch
+void BitmapFont::DrawKey( unsigned int length, float scale, SGD::Point position, SGD::Color color ) const
+{
+	m_sKey.push_back( '\0' );
+	m_sKey.append( (const char*)&scale, sizeof( scale ) );
 
-		// Do we need to convert to uppercase?
-		if( m_bOnlyUppercase == true )
-			ch = toupper( ch );
 
-		// Calculate the tile ID that matches the ASCII character
-		// (characters MUST be in ASCII order!)
-		int ID = ch - m_cFirstChar;
+	// Find the cached run
+	auto iter = m_mRuns.find( m_sKey );
+	if( iter != m_mRuns.end() )
+		m_CacheStats.unHits++;
+	else
+	{
+		m_CacheStats.unMisses++;
 
-		// Calculate the source rect of the tile
-		// using the Cell Algorithm
-		SGD::Rectangle cell = { };
+		if( m_mRuns.size() >= BITMAPFONT_CACHE_SIZE )
+			EvictOldest();
 
-		cell.left = (float)( (ID % m_nNumCols) * m_nCharWidth  );
-		cell.top  = (float)( (ID / m_nNumCols) * m_nCharHeight );
+		iter = m_mRuns.insert( std::make_pair( m_sKey, GlyphRun() ) ).first;
+		LayOut( m_sKey.c_str(), length, scale, iter->second );
+	}
 
-		cell.right  = cell.left + m_nCharWidth;
-		cell.bottom = cell.top  + m_nCharHeight;
+	GlyphRun& run = iter->second;
+	run.unLastUsed = ++m_unUses;
 
+	if( run.vQuads.empty() == true )
+		return;		// only whitespace
 
-		// Draw the character section
-		SGD::GraphicsManager::GetInstance()->DrawTextureSection(
-			m_hImage,
-			position,
-			cell,
-			0.0f, {},
-			color,
-			{ scale, scale } );
 
-		
-		// Move to the next position on screen
-		position.x += m_nCharWidth * scale;
+	// Move & tint a copy of the run
+	m_vQuads.assign( run.vQuads.begin(), run.vQuads.end() );
+
+	for( unsigned int i = 0; i < m_vQuads.size(); i++ )
+	{
+		m_vQuads[ i ].position.x += position.x;
+		m_vQuads[ i ].position.y += position.y;
+		m_vQuads[ i ].color = color;
 	}
+
+	SGD::GraphicsManager::GetInstance()->DrawTextureBatch(
+		m_hImage, &m_vQuads[ 0 ], (unsigned int)m_vQuads.size() );
 }
 
+
 //*********************************************************************//
-// Draw
-//	- render the array of characters, one-at-a-time,
+// LayOut
+//	- fill the run with one quad per glyph, at (0,0),
 //	  using the Cell Algorithm to calculate the source rect
 //	  of the glyph within the image
-void BitmapFont::Draw( const wchar_t* output, SGD::Point position, float scale, SGD::Color color ) const
+void BitmapFont::LayOut( const char* text, unsigned int length, float scale, GlyphRun& run ) const
 {
-	// Validate the image
-	SGD_ASSERT( m_hImage != SGD::INVALID_HANDLE,
-		"BitmapFont::Draw - font was not initialized" );
-	
-	// Validate the string
-	SGD_ASSERT( output != nullptr,
-		"BitmapFont::Draw - string CANNOT be null!" );
-
-	// Check the parameters
-	if( output[ 0 ] == L'\0'		// empty string
-		|| scale <= 0.0f			// no size or inverted
-		|| color.alpha == 0 )		// transparent
-		return;
-
+	run.vQuads.clear();
 
-	// Store the starting x
-	float startX = position.x;
+	// Start at the origin
+	SGD::Point position = { 0, 0 };
 
 
-	// Loop through the string, until hitting null terminator
-	for( unsigned int i = 0; output[ i ] != '\0'; i++ )
+	// Loop through the characters
+	for( unsigned int i = 0; i < length; i++ )
 	{
-		// Get the current character (narrowed to ASCII)
-		char ch = (char)output[ i ];
+		char ch = text[ i ];
 
 		// Handle the whitespace
 		if( ch == ' ' )
@@ -182,17 +174,14 @@ void BitmapFont::Draw( const wchar_t* output, SGD::Point position, float scale,
 		else if( ch == '\n' )
 		{
 			// Drop down a line & reset to the starting x position
-			position.x = startX;
+			position.x = 0;
 			position.y += m_nCharHeight * scale;
 			continue;
 		}
 		else if( ch == '\t' )
 		{
-			// Calculate the number of pixels on this line
-			float pixels = position.x - startX;
-
 			// Calculate the numbers of characters on this line
-			int chars = (int)( pixels / (m_nCharWidth * scale) );
+			int chars = (int)( position.x / (m_nCharWidth * scale) );
 
 			// Calculate the number of spaces to add
 			// for a 4-space alignment
@@ -208,33 +197,47 @@ void BitmapFont::Draw( const wchar_t* output, SGD::Point position, float scale,
 		// Do we need to convert to uppercase?
 		if( m_bOnlyUppercase == true )
 			ch = toupper( ch );
-		
+
 		// Calculate the tile ID that matches the ASCII character
 		// (characters MUST be in ASCII order!)
 		int ID = ch - m_cFirstChar;
 
 		// Calculate the source rect of the tile
 		// using the Cell Algorithm
-		SGD::Rectangle cell = { };
+		SGD::SpriteQuad quad = { };
 
-		cell.left = (float)( (ID % m_nNumCols) * m_nCharWidth  );
-		cell.top  = (float)( (ID / m_nNumCols) * m_nCharHeight );
+		quad.section.left = (float)( (ID % m_nNumCols) * m_nCharWidth  );
+		quad.section.top  = (float)( (ID / m_nNumCols) * m_nCharHeight );
 
-		cell.right  = cell.left + m_nCharWidth;
-		cell.bottom = cell.top  + m_nCharHeight;
+		quad.section.right  = quad.section.left + m_nCharWidth;
+		quad.section.bottom = quad.section.top  + m_nCharHeight;
 
+		quad.position	= position;
+		quad.scale		= SGD::Size{ scale, scale };
 
-		// Draw the character section
-		SGD::GraphicsManager::GetInstance()->DrawTextureSection(
-			m_hImage,
-			position,
-			cell,
-			0.0f, {},
-			color,
-			{ scale, scale } );
+		run.vQuads.push_back( quad );
 
 		
 		// Move to the next position on screen
 		position.x += m_nCharWidth * scale;
 	}
 }
+
+
+//*********************************************************************//
+// EvictOldest
+//	- remove the least recently drawn run
+void BitmapFont::EvictOldest( void ) const
+{
+	auto oldest = m_mRuns.begin();
+
+	for( auto iter = m_mRuns.begin(); iter != m_mRuns.end(); ++iter )
+		if( iter->second.unLastUsed < oldest->second.unLastUsed )
+			oldest = iter;
+
+	if( oldest == m_mRuns.end() )
+		return;
+
+	m_mRuns.erase( oldest );
+	m_CacheStats.unEvictions++;
+}
@@ -11,6 +11,16 @@
 #include "../SGD Wrappers/SGD_Handle.h"
 #include "../SGD Wrappers/SGD_Geometry.h"
 #include "../SGD Wrappers/SGD_Color.h"
+#include "../SGD Wrappers/SGD_GraphicsManager.h"	// uses SpriteQuad
+
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+
+//*********************************************************************//
+// Most glyph runs kept by the layout cache
+#define BITMAPFONT_CACHE_SIZE		64
 
 
 //*********************************************************************//
@@ -22,9 +32,23 @@
 //		- glyphs MUST be in ASCII order (with empty space reserved for missing glyphs)
 //		- can skip over glyphs at the beginning
 //		- can skip over glyphs at the end
+//	- a string is laid out into glyph quads once per text & scale
+//	  (the glyph run is cached), then drawn with one DrawTextureBatch
+//	- the cache keeps the most recently drawn runs: a steady HUD
+//	  does not lay out or allocate again
 class BitmapFont
 {
 public:
+	//*****************************************************************//
+	// Layout cache counters (since Initialize)
+	struct CacheStats
+	{
+		unsigned int	unHits			= 0;
+		unsigned int	unMisses		= 0;	// strings laid out
+		unsigned int	unEvictions		= 0;
+	};
+
+
 	//*****************************************************************//
 	// Default Constructor & Destructor
 	BitmapFont( void )	= default;
@@ -42,7 +66,27 @@ public:
 	void Draw( const char* output, SGD::Point position, float scale = 1.0f, SGD::Color color = { } ) const;
 	void Draw( const wchar_t* output, SGD::Point position, float scale = 1.0f, SGD::Color color = { } ) const;
 
+	const CacheStats&	GetCacheStats	( void ) const	{	return m_CacheStats;	}
+	unsigned int		GetCachedCount	( void ) const	{	return (unsigned int)m_mRuns.size();	}
+
 private:
+	//*****************************************************************//
+	// Glyph run
+	//	- quads at (0,0), white; Draw offsets & tints a copy
+	struct GlyphRun
+	{
+		std::vector< SGD::SpriteQuad >	vQuads;
+		unsigned int					unLastUsed	= 0;
+	};
+
+
+	//*****************************************************************//
+	// Helper Methods
+	void	DrawKey		( unsigned int length, float scale, SGD::Point position, SGD::Color color ) const;
+	void	LayOut		( const char* text, unsigned int length, float scale, GlyphRun& run ) const;
+	void	EvictOldest	( void ) const;
+
+
 	//*****************************************************************//
 	// image
 	SGD::HTexture	m_hImage			= SGD::INVALID_HANDLE;
@@ -56,4 +100,12 @@ private:
 	char			m_cFirstChar		= 0;
 	bool			m_bOnlyUppercase	= false;
 
+	// layout cache (Draw is const, the cache is not)
+	//	- key: the text narrowed to char, '\0', then the scale's bytes
+	mutable std::unordered_map< std::string, GlyphRun >	m_mRuns;
+	mutable std::string						m_sKey;			// reused by every Draw
+	mutable std::vector< SGD::SpriteQuad >	m_vQuads;		// run offset & tinted for the draw
+	mutable unsigned int					m_unUses		= 0;
+	mutable CacheStats						m_CacheStats;
+
 };
@@ -0,0 +1,323 @@
+//*********************************************************************//
+//	File:		BulletSystem.cpp
+//	Author:		
+//	Course:		
+//	Purpose:	BulletSystem class stores every projectile in contiguous
+//				arrays and moves / draws them as a single entity
+//*********************************************************************//
+
+#include "BulletSystem.h"
+
+#include "Game.h"
+#include "JobPool.h"
+
+#include "../SGD Wrappers/SGD_GraphicsManager.h"
+#include "../SGD Wrappers/SGD_Utilities.h"
+
+
+//*********************************************************************//
+// Initial number of bullet slots
+#define BULLETSYSTEM_DEFAULT_CAPACITY	1024
+
+// Bullets per job when the movement is split across the job pool
+#define BULLETSYSTEM_PARALLEL_GRAIN		4096
+
+
+//*********************************************************************//
+// Constructor
+//	- preallocate the arrays so spawning does not allocate
+BulletSystem::BulletSystem( void )
+{
+	m_vImages.resize( ENT_BULLET_SYSTEM + 1 );
+	Reserve( BULLETSYSTEM_DEFAULT_CAPACITY );
+}
+
+
+//*********************************************************************//
+// Update
+//	- move every bullet by its velocity (split across the job pool
+//	  when enabled, each job owns a slot range)
+//	- despawn the bullets that left the screen
+/*virtual*/ void BulletSystem::Update( float elapsedTime )	/*override*/
+{
+	float* pPosX = m_vPosX.data();
+	float* pPosY = m_vPosY.data();
+	const float* pVelX = m_vVelX.data();
+	const float* pVelY = m_vVelY.data();
+
+	// Dead slots hold zero velocity, so the loop needs no branch
+	auto moveRange = [ pPosX, pPosY, pVelX, pVelY, elapsedTime ]( unsigned int first, unsigned int last )
+	{
+		for( unsigned int i = first; i < last; i++ )
+		{
+			pPosX[ i ] += pVelX[ i ] * elapsedTime;
+			pPosY[ i ] += pVelY[ i ] * elapsedTime;
+		}
+	};
+
+	if( m_bParallelUpdate == true && m_pJobs != nullptr )
+		m_pJobs->ParallelFor( m_unSlotCount, BULLETSYSTEM_PARALLEL_GRAIN, moveRange );
+	else
+		moveRange( 0, m_unSlotCount );
+
+
+	// Is the bullet off the screen?
+	SGD::Size offsetScreen = Game::GetInstance()->GetScreenSize();
+	offsetScreen.height -= 65.0f;
+	SGD::Rectangle rScreen =
+	{
+		SGD::Point{ 0, 65.0f },			// top left point
+		offsetScreen					// rect size
+	};
+
+	for( unsigned int i = 0; i < m_unSlotCount; i++ )
+	{
+		if( m_vAlive[ i ] == 0 )
+			continue;
+
+		SGD::Rectangle rBullet =
+		{
+			pPosX[ i ] - m_vWidth[ i ] / 2,		pPosY[ i ] - m_vHeight[ i ] / 2,
+			pPosX[ i ] + m_vWidth[ i ] / 2,		pPosY[ i ] + m_vHeight[ i ] / 2
+		};
+
+		if( rBullet.IsIntersecting( rScreen ) == false )
+			Despawn( i );
+	}
+}
+
+
+//*********************************************************************//
+// Render
+//	- draw every live bullet from world coordinates
+//	- bullets move in straight lines, so the position between the last
+//	  two simulation steps is found from the velocity (no extra arrays)
+//	- the sprites go through the batch, so each bullet type is one
+//	  draw call
+//	- the system has no rect for EntityManager to cull, so each
+//	  bullet off the screen is skipped here
+/*virtual*/ void BulletSystem::Render( void )	/*override*/
+{
+	SGD::GraphicsManager* pGraphics = SGD::GraphicsManager::GetInstance();
+	SGD::Point ptCamera = m_ptCamera;
+
+	Game* pGame = Game::GetInstance();
+	float rewind = pGame->GetFixedTimeStep() * (1.0f - pGame->GetInterpolation());
+	SGD::Size szScreen = pGame->GetScreenSize();
+
+	m_Batch.Begin();
+
+	for( unsigned int i = 0; i < m_unSlotCount; i++ )
+	{
+		if( m_vAlive[ i ] == 0 )
+			continue;
+
+		const BulletImage& image = m_vImages[ m_vType[ i ] ];
+
+		// Validate the image
+		SGD_ASSERT( image.hImage != SGD::INVALID_HANDLE,
+					"BulletSystem::Render - image was not set!" );
+
+		SGD::Size szSize = { m_vWidth[ i ], m_vHeight[ i ] };
+		SGD::Point ptRender = { m_vPosX[ i ] - m_vVelX[ i ] * rewind, m_vPosY[ i ] - m_vVelY[ i ] * rewind };
+		SGD::Point ptOffset = { ptRender.x - szSize.width / 2 - ptCamera.x, ptRender.y - szSize.height / 2 - ptCamera.y };
+
+		// Off the screen? (a rotated sprite stays within
+		// (width + height) / 2 of its center)
+		float extent = (szSize.width + szSize.height) / 2;
+		float centerX = ptRender.x - ptCamera.x;
+		float centerY = ptRender.y - ptCamera.y;
+
+		if( centerX + extent < 0.0f || centerX - extent > szScreen.width
+			|| centerY + extent < 0.0f || centerY - extent > szScreen.height )
+			continue;
+
+		// Draw the image
+		m_Batch.Draw( image.hImage, ptOffset, SGD::Rectangle{ }, m_vRotation[ i ], szSize / 2 );
+	}
+
+	m_Batch.End( pGraphics );
+}
+
+
+//*********************************************************************//
+// GetType
+//	- the colliding bullet's type lets other entities treat it
+//	  like a single bullet in their HandleCollision
+/*virtual*/ int BulletSystem::GetType( void ) const	/*override*/
+{
+	if( m_unColliding != INVALID_BULLET )
+		return m_vType[ m_unColliding ];
+
+	return ENT_BULLET_SYSTEM;
+}
+
+
+//*********************************************************************//
+// HandleCollision
+//	- the system itself never collides
+/*virtual*/ void BulletSystem::HandleCollision( const IEntity* pOther )	/*override*/
+{
+	/* DO NOTHING */
+	(void)pOther;		// unused parameter
+}
+
+
+//*********************************************************************//
+// SetBulletImage
+//	- store the image & size for the bullet type
+void BulletSystem::SetBulletImage( EntityType type, SGD::HTexture image, SGD::Size size )
+{
+	// Validate the parameter
+	SGD_ASSERT( (unsigned int)type < m_vImages.size(),
+				"BulletSystem::SetBulletImage - invalid bullet type" );
+	if( (unsigned int)type >= m_vImages.size() )
+		return;
+
+	m_vImages[ type ].hImage = image;
+	m_vImages[ type ].szSize = size;
+}
+
+
+//*********************************************************************//
+// Spawn
+//	- reuse a dead slot, or append past the high-water mark
+//	- the arrays only grow when every slot is live
+unsigned int BulletSystem::Spawn( EntityType type, SGD::Point position, SGD::Vector velocity, float rotation )
+{
+	// Validate the parameter
+	SGD_ASSERT( (unsigned int)type < m_vImages.size(),
+				"BulletSystem::Spawn - invalid bullet type" );
+	if( (unsigned int)type >= m_vImages.size() )
+		return INVALID_BULLET;
+
+
+	// Find a slot
+	unsigned int slot;
+	if( m_vFreeSlots.empty() == false )
+	{
+		slot = m_vFreeSlots.back();
+		m_vFreeSlots.pop_back();
+	}
+	else
+	{
+		if( m_unSlotCount == GetCapacity() )
+			Reserve( GetCapacity() * 2 );
+
+		slot = m_unSlotCount++;
+	}
+
+
+	// Store the bullet
+	m_vPosX[ slot ]		= position.x;
+	m_vPosY[ slot ]		= position.y;
+	m_vVelX[ slot ]		= velocity.x;
+	m_vVelY[ slot ]		= velocity.y;
+	m_vRotation[ slot ]	= rotation;
+	m_vWidth[ slot ]	= m_vImages[ type ].szSize.width;
+	m_vHeight[ slot ]	= m_vImages[ type ].szSize.height;
+	m_vType[ slot ]		= (unsigned char)type;
+	m_vAlive[ slot ]	= 1;
+
+	++m_unLiveCount;
+	return slot;
+}
+
+
+//*********************************************************************//
+// Despawn
+//	- return the slot to the free list
+void BulletSystem::Despawn( unsigned int slot )
+{
+	// Quietly ignore dead slots (e.g. despawned twice in one frame)
+	if( IsAlive( slot ) == false )
+		return;
+
+	m_vAlive[ slot ]	= 0;
+	m_vVelX[ slot ]		= 0.0f;
+	m_vVelY[ slot ]		= 0.0f;
+	m_vFreeSlots.push_back( slot );
+
+	--m_unLiveCount;
+}
+
+
+//*********************************************************************//
+// DespawnAll
+//	- kill every bullet but keep the storage
+void BulletSystem::DespawnAll( void )
+{
+	for( unsigned int i = 0; i < m_unSlotCount; i++ )
+	{
+		m_vAlive[ i ]	= 0;
+		m_vVelX[ i ]	= 0.0f;
+		m_vVelY[ i ]	= 0.0f;
+	}
+
+	m_vFreeSlots.clear();
+	m_unSlotCount	= 0;
+	m_unLiveCount	= 0;
+}
+
+
+//*********************************************************************//
+// Reserve
+//	- grow every array to the capacity
+//	- the free list is reserved too, so Despawn never allocates
+void BulletSystem::Reserve( unsigned int capacity )
+{
+	if( capacity <= GetCapacity() )
+		return;
+
+	m_vPosX.resize( capacity, 0.0f );
+	m_vPosY.resize( capacity, 0.0f );
+	m_vVelX.resize( capacity, 0.0f );
+	m_vVelY.resize( capacity, 0.0f );
+	m_vRotation.resize( capacity, 0.0f );
+	m_vWidth.resize( capacity, 0.0f );
+	m_vHeight.resize( capacity, 0.0f );
+	m_vType.resize( capacity, 0 );
+	m_vAlive.resize( capacity, 0 );
+
+	m_vFreeSlots.reserve( capacity );
+}
+
+
+//*********************************************************************//
+// GetBulletRects
+//	- bounding rectangles centered on the bullet positions
+void BulletSystem::GetBulletRects( FrameVector< SGD::Rectangle >& rects ) const
+{
+	rects.resize( m_unSlotCount );
+
+	for( unsigned int i = 0; i < m_unSlotCount; i++ )
+	{
+		if( m_vAlive[ i ] == 0 )
+		{
+			rects[ i ] = SGD::Rectangle{ };
+			continue;
+		}
+
+		rects[ i ] = SGD::Rectangle
+		{
+			m_vPosX[ i ] - m_vWidth[ i ] / 2,	m_vPosY[ i ] - m_vHeight[ i ] / 2,
+			m_vPosX[ i ] + m_vWidth[ i ] / 2,	m_vPosY[ i ] + m_vHeight[ i ] / 2
+		};
+	}
+}
+
+
+//*********************************************************************//
+// HandleBulletCollision
+//	- the other entity handles the collision, seeing this system
+//	  as the single colliding bullet
+void BulletSystem::HandleBulletCollision( unsigned int slot, IEntity* pOther )
+{
+	// Was the bullet already despawned this frame?
+	if( IsAlive( slot ) == false )
+		return;
+
+	m_unColliding = slot;
+	pOther->HandleCollision( this );
+	m_unColliding = INVALID_BULLET;
+}
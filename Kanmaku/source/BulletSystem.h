@@ -0,0 +1,129 @@
+//*********************************************************************//
+//	File:		BulletSystem.h
+//	Author:		
+//	Course:		
+//	Purpose:	BulletSystem class stores every projectile in contiguous
+//				arrays and moves / draws them as a single entity
+//*********************************************************************//
+
+#pragma once
+
+#include "Entity.h"							// Entity type
+#include "../SGD Wrappers/SGD_SpriteBatch.h"	// uses SpriteBatch
+#include "FrameArena.h"						// uses FrameVector
+#include <vector>							// uses std::vector
+
+
+//*********************************************************************//
+// Forward class declaration
+class JobPool;
+
+
+//*********************************************************************//
+// BulletSystem class
+//	- one entity in the Entity Manager owns all the bullets
+//	- structure-of-arrays storage, indexed by bullet slot
+//	- O(1) spawn & despawn through a free list of dead slots,
+//	  no allocation per bullet
+class BulletSystem : public Entity
+{
+public:		BulletSystem( void );
+protected:	virtual ~BulletSystem( void )	= default;		// protected to force reference counting
+
+
+public:
+	//*****************************************************************//
+	// Invalid slot returned when a spawn fails
+	enum { INVALID_BULLET = 0xFFFFFFFF };
+
+
+	//*****************************************************************//
+	// Interface:
+	//	- GetRect is empty, the bullets collide individually through
+	//	  EntityManager::CheckCollisions( bucket, BulletSystem* )
+	//	- GetType reports the colliding bullet's type during
+	//	  HandleBulletCollision, otherwise ENT_BULLET_SYSTEM
+	virtual void	Update			( float elapsedTime )		override;
+	virtual void	Render			( void )					override;
+
+	virtual int		GetType			( void )	const			override;
+	virtual SGD::Rectangle GetRect	( void )	const			override	{	return SGD::Rectangle{ };	}
+	virtual void	HandleCollision	( const IEntity* pOther )	override;
+
+
+	//*****************************************************************//
+	// Bullet Types:
+	//	- the image & size shared by every bullet of the type
+	void			SetBulletImage	( EntityType type, SGD::HTexture image, SGD::Size size );
+
+
+	//*****************************************************************//
+	// Bullet Storage:
+	unsigned int	Spawn			( EntityType type, SGD::Point position, SGD::Vector velocity, float rotation );
+	void			Despawn			( unsigned int slot );
+	void			DespawnAll		( void );
+	void			Reserve			( unsigned int capacity );
+
+	bool			IsAlive			( unsigned int slot ) const	{	return slot < m_unSlotCount && m_vAlive[ slot ] != 0;	}
+	unsigned int	GetLiveCount	( void ) const				{	return m_unLiveCount;	}
+	unsigned int	GetSlotCount	( void ) const				{	return m_unSlotCount;	}
+	unsigned int	GetCapacity		( void ) const				{	return (unsigned int)m_vAlive.size();	}
+
+
+	//*****************************************************************//
+	// Camera:
+	//	- Render draws the bullets relative to the world camera
+	void			SetCamera		( SGD::Point camera )		{	m_ptCamera = camera;	}
+
+
+	//*****************************************************************//
+	// Parallel Update (opt-in):
+	//	- Update splits the movement across the job pool once there
+	//	  are enough bullets (each job owns a slot range)
+	void			SetJobPool		( JobPool* pJobs )			{	m_pJobs = pJobs;				}
+	void			SetParallelUpdate( bool parallel )			{	m_bParallelUpdate = parallel;	}
+
+
+	//*****************************************************************//
+	// Collision:
+	//	- rects for slots [0, GetSlotCount), dead slots are empty
+	//	- HandleBulletCollision only runs the other entity's side: its
+	//	  HandleCollision sees this system as the one bullet, the bullet
+	//	  itself does not react (it flies on until despawned)
+	void			GetBulletRects	( FrameVector< SGD::Rectangle >& rects ) const;
+	void			HandleBulletCollision( unsigned int slot, IEntity* pOther );
+
+private:
+	//*****************************************************************//
+	// Per-type data
+	struct BulletImage
+	{
+		SGD::HTexture	hImage	= SGD::INVALID_HANDLE;
+		SGD::Size		szSize	= SGD::Size{ 0, 0 };
+	};
+
+
+	//*****************************************************************//
+	// Bullet arrays (parallel, indexed by slot)
+	std::vector< float >			m_vPosX;
+	std::vector< float >			m_vPosY;
+	std::vector< float >			m_vVelX;
+	std::vector< float >			m_vVelY;
+	std::vector< float >			m_vRotation;
+	std::vector< float >			m_vWidth;
+	std::vector< float >			m_vHeight;
+	std::vector< unsigned char >	m_vType;		// EntityType
+	std::vector< unsigned char >	m_vAlive;		// 1 = live, 0 = on the free list
+
+	std::vector< unsigned int >		m_vFreeSlots;	// stack of dead slots below m_unSlotCount
+	std::vector< BulletImage >		m_vImages;		// indexed by EntityType
+	SGD::SpriteBatch				m_Batch;		// one draw call per bullet type
+
+	unsigned int	m_unSlotCount	= 0;			// slots ever used (high-water mark)
+	unsigned int	m_unLiveCount	= 0;
+	unsigned int	m_unColliding	= INVALID_BULLET;	// slot inside HandleBulletCollision
+	SGD::Point		m_ptCamera		= SGD::Point{ 0, 0 };
+
+	JobPool*		m_pJobs				= nullptr;
+	bool			m_bParallelUpdate	= false;
+};
@@ -8,6 +8,8 @@
 
 #include "Entity.h"
 
+#include "Game.h"
+
 #include "../SGD Wrappers/SGD_GraphicsManager.h"
 #include "../SGD Wrappers/SGD_Utilities.h"
 
@@ -16,8 +18,11 @@
 // Update
 //	- move the entity by its velocity
 //	  (given that velocity is the rate of change in pixels-per-second)
+//	- elapsedTime is the fixed simulation step
 /*virtual*/ void Entity::Update( float elapsedTime )	/*override*/
 {
+	StorePreviousPosition();
+
 	m_ptPosition += m_vtVelocity * elapsedTime;
 }
 
@@ -35,11 +40,24 @@
 	
 	// Draw the image
 	SGD::GraphicsManager::GetInstance()->DrawTexture( 
-		m_hImage, m_ptPosition,
+		m_hImage, GetRenderPosition(),
 		m_fRotation, m_szSize / 2 );
 }
 
 
+//*********************************************************************//
+// GetRenderPosition
+//	- blend the last two simulated positions by the time left over
+//	  after the frame's fixed steps, so motion stays smooth at any
+//	  render rate
+SGD::Point Entity::GetRenderPosition( void ) const
+{
+	float alpha = Game::GetInstance()->GetInterpolation();
+
+	return m_ptPrevPosition + (m_ptPosition - m_ptPrevPosition) * alpha;
+}
+
+
 //*********************************************************************//
 // GetRect
 //	- calculate the entity's bounding rectangle
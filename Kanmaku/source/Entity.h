@@ -30,7 +30,7 @@ protected:	virtual ~Entity( void )	= default;		// protected to force reference c
 public:
 	//*****************************************************************//
 	// Entity Types:
-	enum EntityType { ENT_BASE, ENT_PLAYER, ENT_PUFF, ENT_BULLET_A, ENT_BULLET_B, ENT_BULLET_C };
+	enum EntityType { ENT_BASE, ENT_PLAYER, ENT_PUFF, ENT_BULLET_A, ENT_BULLET_B, ENT_BULLET_C, ENT_BULLET_SYSTEM };
 
 
 	//*****************************************************************//
@@ -54,6 +54,7 @@ public:
 	// Accessors:
 	SGD::HTexture	GetImage	( void ) const			{	return m_hImage;		}
 	SGD::Point		GetPosition	( void ) const			{	return m_ptPosition;	}
+	SGD::Point		GetRenderPosition( void ) const;		// interpolated between simulation steps
 	SGD::Vector		GetVelocity	( void ) const			{	return m_vtVelocity;	}
 	SGD::Size		GetSize		( void ) const			{	return m_szSize;		}
 	float			GetRotation	( void ) const			{	return m_fRotation;		}
@@ -63,16 +64,24 @@ public:
 	
 	// Mutators:
 	void			SetImage	( SGD::HTexture	img  )	{	m_hImage		= img;	}
-	void			SetPosition	( SGD::Point	pos  ) 	{	m_ptPosition	= pos;	}
+	void			SetPosition	( SGD::Point	pos  ) 	{	m_ptPosition	= pos;	m_ptPrevPosition = pos;	}	// teleport
 	void			SetVelocity	( SGD::Vector	vel	 ) 	{	m_vtVelocity	= vel;	}
 	void			SetSize		( SGD::Size		size ) 	{	m_szSize		= size;	}
 	void			SetRotation	( float			rad	 )	{	m_fRotation		= rad;	}
 
 protected:
+	//*****************************************************************//
+	// Interpolation:
+	//	- call at the start of a step before moving the entity
+	//	  (Entity::Update does)
+	void			StorePreviousPosition( void )		{	m_ptPrevPosition = m_ptPosition;	}
+
+
 	//*****************************************************************//
 	// Shared members:
 	SGD::HTexture	m_hImage		= SGD::INVALID_HANDLE;	// image handle
 	SGD::Point		m_ptPosition	= SGD::Point{ 0, 0 };	// 2D position
+	SGD::Point		m_ptPrevPosition= SGD::Point{ 0, 0 };	// 2D position at the previous step
 	SGD::Vector		m_vtVelocity	= SGD::Vector{ 0, 0 };	// 2D velocity
 	SGD::Vector		m_vtGravity		= SGD::Vector{ 0, 100.0f }; // 2D Gravity
 	SGD::Size		m_szSize		= SGD::Size{ 0, 0 };	// 2D size
@@ -9,9 +9,21 @@
 
 #include "../SGD Wrappers/SGD_Utilities.h"
 #include "IEntity.h"
+#include "BulletSystem.h"
+#include "FrameArena.h"
+#include "Game.h"
+#include "JobPool.h"
 #include <algorithm>
 
-bool zsortfunc(IEntity * a, IEntity * b) { return a->GetDepth() < b->GetDepth(); }
+
+//*********************************************************************//
+// Parallel update chunking: smaller buckets are not worth the hand-off
+#define ENTITYMANAGER_PARALLEL_MIN		256
+#define ENTITYMANAGER_PARALLEL_GRAIN	128
+
+// Queries per narrow-phase job
+#define ENTITYMANAGER_COLLISION_GRAIN	64
+
 
 //*********************************************************************//
 // AddEntity
@@ -22,6 +34,10 @@ void EntityManager::AddEntity( IEntity* pEntity, unsigned int bucket )
 	// Validate the parameter
 	SGD_ASSERT( pEntity != nullptr,
 				"EntityManager::AddEntity - parameter cannot be null" );
+	SGD_ASSERT( pEntity->m_hEntity == SGD::INVALID_HANDLE,
+				"EntityManager::AddEntity - entity is already stored" );
+	if( pEntity->m_hEntity != SGD::INVALID_HANDLE )
+		return;
 
 
 	// Expand the table?
@@ -29,9 +45,28 @@ void EntityManager::AddEntity( IEntity* pEntity, unsigned int bucket )
 		m_tEntities.resize( bucket +1 );
 
 
+	// Claim a slot for the entity
+	EntitySlot slot;
+	slot.pEntity	= pEntity;
+	slot.unBucket	= bucket;
+	slot.unIndex	= (unsigned int)m_tEntities[ bucket ].size();
+
+	pEntity->m_hEntity = m_Slots.StoreData( slot );
+
 	// Append the entity into the specified vector
 	m_tEntities[ bucket ].push_back( pEntity );
 
+	// Insert into the render list after every entry of the same depth
+	//	(the keys stay sorted, stale entries included, so no entity
+	//	is touched)
+	RenderEntry entry = { pEntity, pEntity->m_hEntity, pEntity->GetDepth() };
+	RenderVector::iterator where = std::upper_bound( m_vRenderList.begin(), m_vRenderList.end(), entry,
+		[]( const RenderEntry& a, const RenderEntry& b ) { return a.fDepth < b.fDepth; } );
+	m_vRenderList.insert( where, entry );
+
+	// SetDepth marks the render list for sorting
+	pEntity->m_pDepthDirty = &m_bRenderDirty;
+
 	// Hold a reference to keep the entity in memory
 	pEntity->AddRef();
 }
@@ -54,18 +89,12 @@ void EntityManager::RemoveEntity( IEntity* pEntity, unsigned int bucket )
 				"EntityManager::RemoveEntity - invalid bucket" );
 
 
-	// Try to find the entity
-	EntityVector& vec = m_tEntities[ bucket ];
-	for( unsigned int i = 0; i < vec.size(); i++ )
-	{
-		if( vec[ i ] == pEntity )
-		{
-			// Remove the entity
-			vec.erase( vec.begin() + i );
-			pEntity->Release();
-			break;
-		}
-	}
+	// Is the entity stored in that bucket?
+	if( m_Slots.IsHandleValid( pEntity->m_hEntity ) == false
+		|| m_Slots.GetData( pEntity->m_hEntity )->unBucket != bucket )
+		return;
+
+	RemoveSlot( pEntity->m_hEntity );
 }
 
 
@@ -83,21 +112,71 @@ void EntityManager::RemoveEntity( IEntity* pEntity )
 				"EntityManager::RemoveEntity - pointer cannot be null" );
 
 
-	// Try to find the entity in any buckect
-	for( unsigned int bucket = 0; bucket < m_tEntities.size(); bucket++ )
-	{
-		EntityVector& vec = m_tEntities[ bucket ];
-		for( unsigned int i = 0; i < vec.size(); i++ )
-		{
-			if( vec[ i ] == pEntity )
-			{
-				// Remove the entity
-				vec.erase( vec.begin() + i );
-				pEntity->Release();
-				return;
-			}
-		}
-	}
+	// Is the entity stored?
+	if( m_Slots.IsHandleValid( pEntity->m_hEntity ) == false )
+		return;
+
+	RemoveSlot( pEntity->m_hEntity );
+}
+
+
+//*********************************************************************//
+// RemoveEntity
+//	- remove & release the entity identified by the handle
+//	- stale handles are quietly ignored
+void EntityManager::RemoveEntity( EntityHandle hEntity )
+{
+	// Validate the iteration state
+	SGD_ASSERT( m_bIterating == false,
+				"EntityManager::RemoveEntity - cannot remove while iterating" );
+
+
+	if( m_Slots.IsHandleValid( hEntity ) == false )
+		return;
+
+	RemoveSlot( hEntity );
+}
+
+
+//*********************************************************************//
+// GetEntity
+//	- return the entity identified by the handle
+//	- return nullptr if the entity has been removed
+IEntity* EntityManager::GetEntity( EntityHandle hEntity ) const
+{
+	if( m_Slots.IsHandleValid( hEntity ) == false )
+		return nullptr;
+
+	return m_Slots.GetData( hEntity )->pEntity;
+}
+
+
+//*********************************************************************//
+// RemoveSlot
+//	- O(1) removal: swap-and-pop within the bucket, the last entity
+//	  takes the empty spot and its slot is updated
+//	- the render list entry goes stale and is dropped by RenderAll
+void EntityManager::RemoveSlot( EntityHandle hEntity )
+{
+	EntitySlot slot;
+	m_Slots.RemoveData( hEntity, &slot );
+
+	EntityVector& vec = m_tEntities[ slot.unBucket ];
+	IEntity* pLast = vec.back();
+
+	vec[ slot.unIndex ] = pLast;
+	vec.pop_back();
+
+	if( pLast != slot.pEntity )
+		m_Slots.GetData( pLast->m_hEntity )->unIndex = slot.unIndex;
+
+
+	// Release the entity
+	slot.pEntity->m_hEntity = EntityHandle();
+	slot.pEntity->m_pDepthDirty = nullptr;
+	slot.pEntity->Release();
+
+	++m_unStaleRender;
 }
 
 
@@ -122,10 +201,15 @@ void EntityManager::RemoveAll( unsigned int unBucket )
 		EntityVector& vec = m_tEntities[ unBucket ];
 		for( unsigned int i = 0; i < vec.size(); i++ )
 		{
+			m_Slots.RemoveData( vec[ i ]->m_hEntity, nullptr );
+			vec[ i ]->m_hEntity = EntityHandle();
+			vec[ i ]->m_pDepthDirty = nullptr;
+
 			vec[ i ]->Release();
 			vec[ i ] = nullptr;
 		}
 
+		m_unStaleRender += (unsigned int)vec.size();
 		vec.clear();
 	}
 	// Unlock the iterator
@@ -137,6 +221,8 @@ void EntityManager::RemoveAll( unsigned int unBucket )
 //*********************************************************************//
 // RemoveAll
 //	- release each entity in the table
+//	- the slots keep their generations, so a handle kept from before
+//	  never matches an entity added after
 void EntityManager::RemoveAll( void )
 {
 	// Validate the iteration state
@@ -152,6 +238,9 @@ void EntityManager::RemoveAll( void )
 			EntityVector& vec = m_tEntities[ bucket ];
 			for( unsigned int i = 0; i < vec.size( ); i++ )
 			{
+				vec[ i ]->m_hEntity = EntityHandle();
+				vec[ i ]->m_pDepthDirty = nullptr;
+
 				vec[ i ]->Release( );
 				vec[ i ] = nullptr;
 			}
@@ -163,12 +252,124 @@ void EntityManager::RemoveAll( void )
 
 	// Collapse the table
 	m_tEntities.clear();
+	m_Slots.RemoveAll();
+	m_vRenderList.clear();
+	m_unStaleRender = 0;
+	m_bRenderDirty	= false;
+
+	// Drop the queues (queued adds hold a reference)
+	for( unsigned int i = 0; i < m_vPendingAdds.size(); i++ )
+		m_vPendingAdds[ i ].pEntity->Release();
+
+	m_vPendingAdds.clear();
+	m_vPendingRemoves.clear();
+
+	m_Grid.Clear();
+}
+
+
+//*********************************************************************//
+// QueueAdd
+//	- store the entity into the bucket at the next ProcessQueues
+//	- the queue holds a reference until then
+void EntityManager::QueueAdd( IEntity* pEntity, unsigned int bucket )
+{
+	// Validate the parameter
+	SGD_ASSERT( pEntity != nullptr,
+				"EntityManager::QueueAdd - parameter cannot be null" );
+
+	PendingEntity pending = { pEntity, EntityHandle(), bucket };
+	m_vPendingAdds.push_back( pending );
+
+	pEntity->AddRef();
+}
+
+
+//*********************************************************************//
+// QueueRemove
+//	- remove the entity from the bucket at the next ProcessQueues
+//	- the handle is captured now, so queuing the same entity twice
+//	  (or after it was released) is harmless
+//	- removing an entity that is only queued to be added cancels the add
+void EntityManager::QueueRemove( IEntity* pEntity, unsigned int bucket )
+{
+	// Validate the parameter
+	SGD_ASSERT( pEntity != nullptr,
+				"EntityManager::QueueRemove - parameter cannot be null" );
+
+	if( m_Slots.IsHandleValid( pEntity->m_hEntity ) == true )
+	{
+		PendingEntity pending = { nullptr, pEntity->m_hEntity, bucket };
+		m_vPendingRemoves.push_back( pending );
+		return;
+	}
+
+
+	// Not stored yet: cancel the queued add
+	for( unsigned int i = 0; i < m_vPendingAdds.size(); i++ )
+	{
+		if( m_vPendingAdds[ i ].pEntity == pEntity
+			&& (bucket == (unsigned int)ANY_BUCKET || m_vPendingAdds[ i ].unBucket == bucket) )
+		{
+			m_vPendingAdds.erase( m_vPendingAdds.begin() + i );
+			pEntity->Release();
+			return;
+		}
+	}
+}
+
+
+//*********************************************************************//
+// QueueRemove
+//	- remove the entity from every bucket at the next ProcessQueues
+void EntityManager::QueueRemove( IEntity* pEntity )
+{
+	QueueRemove( pEntity, (unsigned int)ANY_BUCKET );
+}
+
+
+//*********************************************************************//
+// ProcessQueues
+//	- the sync point: apply the queued adds, then the queued removes
+//	- each remove is O(1) through the captured slot handle
+void EntityManager::ProcessQueues( void )
+{
+	// Validate the iteration state
+	SGD_ASSERT( m_bIterating == false,
+				"EntityManager::ProcessQueues - cannot process while iterating" );
+
+
+	// Adds: move the queue's reference into the table
+	for( unsigned int i = 0; i < m_vPendingAdds.size(); i++ )
+	{
+		AddEntity( m_vPendingAdds[ i ].pEntity, m_vPendingAdds[ i ].unBucket );
+		m_vPendingAdds[ i ].pEntity->Release();
+	}
+	m_vPendingAdds.clear();
+
+
+	// Removes: skip handles that went stale since they were queued
+	for( unsigned int i = 0; i < m_vPendingRemoves.size(); i++ )
+	{
+		const PendingEntity& pending = m_vPendingRemoves[ i ];
+
+		if( m_Slots.IsHandleValid( pending.hEntity ) == false )
+			continue;
+
+		if( pending.unBucket != (unsigned int)ANY_BUCKET
+			&& m_Slots.GetData( pending.hEntity )->unBucket != pending.unBucket )
+			continue;
+
+		RemoveSlot( pending.hEntity );
+	}
+	m_vPendingRemoves.clear();
 }
 
 
 //*********************************************************************//
 // UpdateAll
 //	- update each entity in the table
+//	- large parallel-safe buckets are split across the job pool
 void EntityManager::UpdateAll( float elapsedTime )
 {
 	// Validate the iteration state
@@ -182,174 +383,449 @@ void EntityManager::UpdateAll( float elapsedTime )
 		for( unsigned int bucket = 0; bucket < m_tEntities.size( ); bucket++ )
 		{
 			EntityVector& vec = m_tEntities[ bucket ];
+
+			// Split the bucket across the job pool?
+			if( m_bParallelUpdate == true && m_pJobs != nullptr
+				&& vec.size() >= ENTITYMANAGER_PARALLEL_MIN
+				&& IsBucketParallel( bucket ) == true )
+			{
+				IEntity** ppEntities = vec.data();
+				auto updateRange = [ ppEntities, elapsedTime ]( unsigned int first, unsigned int last )
+				{
+					for( unsigned int i = first; i < last; i++ )
+						ppEntities[ i ]->Update( elapsedTime );
+				};
+
+				m_pJobs->ParallelFor( (unsigned int)vec.size(), ENTITYMANAGER_PARALLEL_GRAIN, updateRange );
+				continue;
+			}
+
 			for( unsigned int i = 0; i < vec.size( ); i++ )
 				vec[ i ]->Update( elapsedTime );
 		}
 	}
 	// Unlock the iterator
 	m_bIterating = false;
+
+
+	// Start a new collision frame
+	m_CollisionStats	= CollisionStats();
 }
 
 
 
 
 //*********************************************************************//
-// RenderAll
-//	- render each entity in the table
+// SetBucketParallel
+//	- mark the bucket as safe to update from worker threads
+void EntityManager::SetBucketParallel( unsigned int bucket, bool parallel )
+{
+	if( bucket >= m_vParallelBuckets.size() )
+		m_vParallelBuckets.resize( bucket +1, false );
+
+	m_vParallelBuckets[ bucket ] = parallel;
+}
+
+
+//*********************************************************************//
+// IsBucketParallel
+bool EntityManager::IsBucketParallel( unsigned int bucket ) const
+{
+	return bucket < m_vParallelBuckets.size() && m_vParallelBuckets[ bucket ] == true;
+}
+
 
-#if 0
+//*********************************************************************//
+// RenderAll
+//	- render every entity in depth order (lowest depth first)
 void EntityManager::RenderAll( void )
+{
+	RenderEntities( nullptr );
+}
+
+
+//*********************************************************************//
+// RenderAll
+//	- render the entities intersecting the view in depth order
+void EntityManager::RenderAll( const SGD::Rectangle& view )
+{
+	RenderEntities( &view );
+}
+
+
+//*********************************************************************//
+// RenderEntities
+//	- the render list persists between frames & AddEntity inserts in
+//	  depth order, so it is only sorted after a SetDepth changed a
+//	  depth (one insertion-sort pass: the list is nearly sorted)
+//	- culling happens after the sort, so culled entities keep their
+//	  place in the list
+void EntityManager::RenderEntities( const SGD::Rectangle* pView )
 {
 	// Validate the iteration state
 	SGD_ASSERT( m_bIterating == false,
 				"EntityManager::RenderAll - cannot render while iterating" );
+
+	m_RenderStats = RenderStats{ };
 	
 	// Lock the iterator
 	m_bIterating = true;
 	{
-		// Render every entity
-		for( unsigned int bucket = 0; bucket < m_tEntities.size( ); bucket++ )
+		// Drop the entries of removed entities (before touching any pointer)
+		if( m_unStaleRender > 0 )
 		{
-			EntityVector& vec = m_tEntities[ bucket ];
-			for( unsigned int i = 0; i < vec.size( ); i++ )
-				vec[ i ]->Render( );
+			unsigned int kept = 0;
+			for( unsigned int i = 0; i < m_vRenderList.size(); i++ )
+				if( m_Slots.IsHandleValid( m_vRenderList[ i ].hEntity ) == true )
+					m_vRenderList[ kept++ ] = m_vRenderList[ i ];
+
+			m_vRenderList.resize( kept );
+			m_unStaleRender = 0;
+		}
+
+		// Stable insertion sort by the new depths
+		if( m_bRenderDirty == true )
+		{
+			for( unsigned int i = 0; i < m_vRenderList.size(); i++ )
+				m_vRenderList[ i ].fDepth = m_vRenderList[ i ].pEntity->GetDepth();
+
+			for( unsigned int i = 1; i < m_vRenderList.size(); i++ )
+			{
+				RenderEntry entry = m_vRenderList[ i ];
+
+				unsigned int j = i;
+				while( j > 0 && m_vRenderList[ j - 1 ].fDepth > entry.fDepth )
+				{
+					m_vRenderList[ j ] = m_vRenderList[ j - 1 ];
+					j--;
+				}
+				m_vRenderList[ j ] = entry;
+			}
+
+			m_bRenderDirty = false;
+		}
+
+		// Render every entity (inside the view)
+		for( unsigned int i = 0; i < m_vRenderList.size(); i++ )
+		{
+			IEntity* pEntity = m_vRenderList[ i ].pEntity;
+
+			if( pView != nullptr )
+			{
+				SGD::Rectangle rect = pEntity->GetRect();
+				if( rect.IsEmpty() == false && rect.IsIntersecting( *pView ) == false )
+				{
+					m_RenderStats.unCulled++;
+					continue;
+				}
+			}
+
+			pEntity->Render();
+			m_RenderStats.unDrawn++;
 		}
 	}
 	// Unlock the iterator
 	m_bIterating = false;
 }
-#else 1 // Z-Sorting
-//	- render each entity in the table
-void EntityManager::RenderAll() {
+
+
+//*********************************************************************//
+// CheckCollisions
+//	- check collision between the entities within the two buckets
+//	- the larger bucket is stored in a spatial hash, so only entities
+//	  sharing a grid cell reach the narrow phase
+//	- the contacts are found first (in parallel when enabled), then
+//	  both entities of each pair handle collision on this thread,
+//	  in bucket1 index order
+void EntityManager::CheckCollisions( unsigned int bucket1, unsigned int bucket2 )
+{
 	// Validate the iteration state
-	SGD_ASSERT(m_bIterating == false,
-		"EntityManager::RenderAll - cannot render while iterating");
+	SGD_ASSERT( m_bIterating == false,
+				"EntityManager::CheckCollisions - cannot collide while iterating" );
+
+	// Quietly validate the parameters
+	if( bucket1 >= m_tEntities.size() 
+		|| bucket2 >= m_tEntities.size()
+		|| m_tEntities[ bucket1 ].size() == 0 
+		|| m_tEntities[ bucket2 ].size() == 0 )
+		return;
 
-	std::vector<IEntity*> priorityQueue;
-	std::vector<IEntity*>::iterator priorityIter;
 
 	// Lock the iterator
 	m_bIterating = true;
 	{
-		for (unsigned int bucket = 0; bucket < m_tEntities.size(); bucket++) {
-			EntityVector& vec = m_tEntities[bucket];
-			for (unsigned int i = 0; i < vec.size(); i++)
-				priorityQueue.push_back(vec[i]);
+		FindPairs( bucket1, bucket2 );
+
+		EntityVector& vec1 = m_tEntities[ bucket1 ];
+		EntityVector& vec2 = m_tEntities[ bucket2 ];
+
+		for( unsigned int c = 0; c < m_vContacts.size(); c++ )
+		{
+			IEntity* pFirst		= vec1[ m_vContacts[ c ].unFirst ];
+			IEntity* pSecond	= vec2[ m_vContacts[ c ].unSecond ];
+
+			// Both objects handle collision
+			m_CollisionStats.unContacts++;
+			pFirst->HandleCollision( pSecond );
+			pSecond->HandleCollision( pFirst );
 		}
 	}
 	// Unlock the iterator
 	m_bIterating = false;
+}
+
 
-	std::sort(priorityQueue.begin(), priorityQueue.end(), zsortfunc);
+//*********************************************************************//
+// FindContacts
+//	- the colliding pairs of CheckCollisions, without handling them
+const EntityManager::ContactVector& EntityManager::FindContacts( unsigned int bucket1, unsigned int bucket2 )
+{
+	// Validate the iteration state
+	SGD_ASSERT( m_bIterating == false,
+				"EntityManager::FindContacts - cannot collide while iterating" );
+
+	m_vContacts.clear();
+
+	// Quietly validate the parameters
+	if( bucket1 >= m_tEntities.size() 
+		|| bucket2 >= m_tEntities.size()
+		|| m_tEntities[ bucket1 ].size() == 0 
+		|| m_tEntities[ bucket2 ].size() == 0 )
+		return m_vContacts;
 
-	for (priorityIter = priorityQueue.begin(); priorityIter != priorityQueue.end(); priorityIter++) {
-		(*priorityIter)->Render();
+
+	// Lock the iterator
+	m_bIterating = true;
+	{
+		FindPairs( bucket1, bucket2 );
 	}
+	// Unlock the iterator
+	m_bIterating = false;
+
+	return m_vContacts;
 }
 
-#endif
 
 //*********************************************************************//
 // CheckCollisions
-//	- check collision between the entities within the two buckets
-void EntityManager::CheckCollisions( unsigned int bucket1, unsigned int bucket2 )
+//	- check collision between the entities in the bucket and each
+//	  bullet in the bullet system
+//	- the bullets go into the spatial hash, the bucket is the outer loop
+void EntityManager::CheckCollisions( unsigned int bucket, BulletSystem* pBullets )
 {
 	// Validate the iteration state
 	SGD_ASSERT( m_bIterating == false,
 				"EntityManager::CheckCollisions - cannot collide while iterating" );
 
+	// Validate the parameter
+	SGD_ASSERT( pBullets != nullptr,
+				"EntityManager::CheckCollisions - bullet system cannot be null" );
+
 	// Quietly validate the parameters
-	if( bucket1 >= m_tEntities.size() 
-		|| bucket2 >= m_tEntities.size()
-		|| m_tEntities[ bucket1 ].size() == 0 
-		|| m_tEntities[ bucket2 ].size() == 0 )
+	if( pBullets == nullptr
+		|| pBullets->GetLiveCount() == 0
+		|| bucket >= m_tEntities.size()
+		|| m_tEntities[ bucket ].size() == 0 )
 		return;
 
 
 	// Lock the iterator
 	m_bIterating = true;
 	{
-		// Are they different buckets?
-		if( bucket1 != bucket2 )
+		EntityVector& vec = m_tEntities[ bucket ];
+
+		FrameArena* pArena = Game::GetInstance()->GetFrameArena();
+
+		// The grid holds the bullets (it copies the snapshot)
 		{
-			// Which bucket is smaller?
-			//	should be the outer loop for less checks (n0)*(n1+1) + 1
-			EntityVector* pVec1 = &m_tEntities[ bucket1 ];
-			EntityVector* pVec2 = &m_tEntities[ bucket2 ];
+			FrameVector< SGD::Rectangle > bulletRects( pArena );
+			pBullets->GetBulletRects( bulletRects );
+			m_Grid.Build( bulletRects.data(), (unsigned int)bulletRects.size() );
+		}
 
-			if( pVec2->size() < pVec1->size() )
-			{
-				EntityVector* pTemp = pVec1;
-				pVec1 = pVec2;
-				pVec2 = pTemp;
-			}
+		m_CollisionStats.unBruteForce += (unsigned int)vec.size() * pBullets->GetLiveCount();
 
-			EntityVector& vec1 = *pVec1;
-			EntityVector& vec2 = *pVec2;
 
+		// Snapshot the entity rects (the bullet system itself never collides)
+		FrameVector< SGD::Rectangle > outerRects( pArena );
+		outerRects.resize( vec.size() );
+		for( unsigned int i = 0; i < vec.size(); i++ )
+			outerRects[ i ] = (vec[ i ] != pBullets) ? vec[ i ]->GetRect() : SGD::Rectangle{ };
 
-			// Iterate through the smaller bucket
-			for( unsigned int i = 0; i < vec1.size(); i++ )
-			{
-				// Is the entity too small to collide?
-				if( vec1[ i ]->GetRect( ).IsEmpty() == true )
-					continue;
+		FindGridContacts( outerRects.data(), (unsigned int)outerRects.size(), false );
 
-				// Iterate through the larger bucket
-				for( unsigned int j = 0; j < vec2.size(); j++ )
-				{
-					// Ignore self-collision
-					if( vec1[ i ] == vec2[ j ] )
-						continue;
 
-					// Local variables help with debugging
-					SGD::Rectangle rEntity1 = vec1[ i ]->GetRect( );
-					SGD::Rectangle rEntity2 = vec2[ j ]->GetRect( );
-
-					// Check for collision between the entities
-					if( rEntity1.IsIntersecting( rEntity2 ) == true )
-					{
-						// Both objects handle collision
-						vec1[ i ]->HandleCollision( vec2[ j ] );
-						vec2[ j ]->HandleCollision( vec1[ i ] );
-					}
-				}
-			}
+		for( unsigned int c = 0; c < m_vContacts.size(); c++ )
+		{
+			unsigned int slot = m_vContacts[ c ].unSecond;
+
+			// Was the bullet despawned by an earlier collision?
+			if( pBullets->IsAlive( slot ) == false )
+				continue;
+
+			// Both objects handle collision
+			m_CollisionStats.unContacts++;
+			pBullets->HandleBulletCollision( slot, vec[ m_vContacts[ c ].unFirst ] );
 		}
-		else // bucket1 == bucket2
+	}
+	// Unlock the iterator
+	m_bIterating = false;
+}
+
+
+//*********************************************************************//
+// SetCollisionCellSize
+//	- grid cell size in world units, ideally about the size of the
+//	  largest common entity (bullets are 16, the player is 64)
+void EntityManager::SetCollisionCellSize( float cellSize )
+{
+	m_Grid.SetCellSize( cellSize );
+}
+
+
+//*********************************************************************//
+// BuildGrid
+//	- snapshot the bucket's rects and rebuild the spatial hash
+//	- rebuilt for every check: HandleCollision (or the caller, between
+//	  two checks) may have moved the entities since the last one
+void EntityManager::BuildGrid( unsigned int bucket )
+{
+	EntityVector& vec = m_tEntities[ bucket ];
+
+	// One virtual GetRect per entity instead of one per pair
+	//	- the snapshot only lives for the Build (the grid copies it)
+	FrameVector< SGD::Rectangle > rects( Game::GetInstance()->GetFrameArena() );
+	rects.resize( vec.size() );
+	for( unsigned int i = 0; i < vec.size(); i++ )
+		rects[ i ] = vec[ i ]->GetRect();
+
+	m_Grid.Build( rects.data(), (unsigned int)rects.size() );
+}
+
+
+//*********************************************************************//
+// FindPairs
+//	- fill m_vContacts with the overlapping pairs of the two buckets
+//	- the larger bucket goes into the grid, the smaller one queries it
+//	- the contacts are sorted by (bucket1 index, bucket2 index)
+void EntityManager::FindPairs( unsigned int bucket1, unsigned int bucket2 )
+{
+	// Are they different buckets?
+	if( bucket1 != bucket2 )
+	{
+		// Which bucket is smaller?
+		bool swapped = m_tEntities[ bucket2 ].size() < m_tEntities[ bucket1 ].size();
+
+		unsigned int outer	= swapped ? bucket2 : bucket1;
+		unsigned int inner	= swapped ? bucket1 : bucket2;
+
+		EntityVector& vecOuter = m_tEntities[ outer ];
+
+		BuildGrid( inner );
+		m_CollisionStats.unBruteForce += (unsigned int)( vecOuter.size() * m_tEntities[ inner ].size() );
+
+
+		// One virtual GetRect per entity, before any worker runs
+		FrameVector< SGD::Rectangle > outerRects( Game::GetInstance()->GetFrameArena() );
+		outerRects.resize( vecOuter.size() );
+		for( unsigned int i = 0; i < vecOuter.size(); i++ )
+			outerRects[ i ] = vecOuter[ i ]->GetRect();
+
+		FindGridContacts( outerRects.data(), (unsigned int)outerRects.size(), false );
+
+
+		// Report the pairs in the caller's bucket order
+		if( swapped == true )
+		{
+			for( unsigned int c = 0; c < m_vContacts.size(); c++ )
+				std::swap( m_vContacts[ c ].unFirst, m_vContacts[ c ].unSecond );
+
+			std::sort( m_vContacts.begin(), m_vContacts.end(),
+				[]( const Contact& a, const Contact& b )
+				{
+					return a.unFirst < b.unFirst
+						|| (a.unFirst == b.unFirst && a.unSecond < b.unSecond);
+				} );
+		}
+	}
+	else // bucket1 == bucket2
+	{
+		EntityVector& vec = m_tEntities[ bucket1 ];
+
+		BuildGrid( bucket1 );
+		m_CollisionStats.unBruteForce += (unsigned int)( vec.size() * (vec.size() - 1) / 2 );
+
+		// Only the entities AFTER [i], so pairs do not collide twice
+		FindGridContacts( &m_Grid.GetRect( 0 ), m_Grid.GetCount(), true );
+	}
+}
+
+
+//*********************************************************************//
+// FindGridContacts
+//	- query the grid with each rect, as one job per chunk of rects
+//	- every chunk covers ascending rects & each query returns ascending
+//	  hits, so joining the chunk lists in chunk order gives the contacts
+//	  sorted by (rect, hit) however the chunks were scheduled
+//	- upperOnly keeps the hits after the rect (same set on both sides)
+void EntityManager::FindGridContacts( const SGD::Rectangle* pRects, unsigned int count, bool upperOnly )
+{
+	m_vContacts.clear();
+	if( count == 0 )
+		return;
+
+	unsigned int grain		= ENTITYMANAGER_COLLISION_GRAIN;
+	unsigned int numChunks	= (count + grain - 1) / grain;
+
+	if( m_vChunks.size() < numChunks )
+		m_vChunks.resize( numChunks );
+
+
+	// Find the contacts of the rects [first, last), one chunk at a time
+	//	(the grid & rects are read-only, each chunk owns its lists)
+	const SpatialHash& grid	= m_Grid;
+	ContactChunk* pChunks	= m_vChunks.data();
+
+	auto findRange = [ &grid, pChunks, pRects, grain, upperOnly ]( unsigned int first, unsigned int last )
+	{
+		for( unsigned int c = first / grain; c * grain < last; c++ )
 		{
-			EntityVector& vec = m_tEntities[ bucket1 ];
+			ContactChunk& chunk = pChunks[ c ];
+			chunk.vContacts.clear();
+			chunk.unTests = 0;
 
-			// Optimized loop to ensure objects do not collide with
-			// each other twice
-			for( unsigned int i = 0; i < vec.size()-1; i++ )
+			unsigned int end = (c + 1) * grain < last ? (c + 1) * grain : last;
+			for( unsigned int i = c * grain; i < end; i++ )
 			{
 				// Is the entity too small to collide?
-				if( vec[ i ]->GetRect( ).IsEmpty() == true )
+				if( pRects[ i ].IsEmpty() == true )
 					continue;
 
-				// Iterate through the entities AFTER [i]
-				for( unsigned int j = i+1; j < vec.size(); j++ )
+				chunk.unTests += grid.Query( pRects[ i ], chunk.vHits );
+
+				for( unsigned int h = 0; h < chunk.vHits.size(); h++ )
 				{
-					// Ignore self-collision
-					if( vec[ i ] == vec[ j ] )
+					unsigned int j = chunk.vHits[ h ];
+					if( upperOnly == true && j <= i )
 						continue;
 
-					// Local variables help with debugging
-					SGD::Rectangle rEntity1 = vec[ i ]->GetRect( );
-					SGD::Rectangle rEntity2 = vec[ j ]->GetRect( );
-
-					// Check for collision between the entities
-					if( rEntity1.IsIntersecting( rEntity2 ) == true )
-					{
-						// Both objects handle collision
-						vec[ i ]->HandleCollision( vec[ j ] );
-						vec[ j ]->HandleCollision( vec[ i ] );
-					}
+					Contact contact = { i, j };
+					chunk.vContacts.push_back( contact );
 				}
 			}
 		}
+	};
+
+	if( m_bParallelCollisions == true && m_pJobs != nullptr )
+		m_pJobs->ParallelFor( count, grain, findRange );
+	else
+		findRange( 0, count );
+
+
+	// Merge in chunk order
+	for( unsigned int c = 0; c < numChunks; c++ )
+	{
+		m_CollisionStats.unPairTests += m_vChunks[ c ].unTests;
+		m_vContacts.insert( m_vContacts.end(), m_vChunks[ c ].vContacts.begin(), m_vChunks[ c ].vContacts.end() );
 	}
-	// Unlock the iterator
-	m_bIterating = false;
 }
@@ -8,13 +8,19 @@
 #pragma once
 
 #include <vector>		// std::vector type
-class IEntity;			// IEntity type
+#include "SpatialHash.h"	// SpatialHash type
+#include "IEntity.h"		// IEntity & EntityHandle types
+#include "../SGD Wrappers/SGD_HandleManager.h"	// HandleManager type
+class BulletSystem;		// BulletSystem type
+class JobPool;			// JobPool type
 
 
 //*********************************************************************//
 // EntityManager class
 //	- stores references to game entities
 //	- updates & renders all game entities
+//	- each stored entity owns a slot handle, so removal is O(1)
+//	  (an entity can only be stored in one bucket at a time)
 class EntityManager
 {
 public:
@@ -29,16 +35,94 @@ public:
 	void	AddEntity	( IEntity* pEntity, unsigned int bucket );
 	void	RemoveEntity( IEntity* pEntity, unsigned int bucket );
 	void	RemoveEntity( IEntity* pEntity );
+	void	RemoveEntity( EntityHandle hEntity );
 	void	RemoveAll	( unsigned int bucket );
 	void	RemoveAll	( void );
 
+	IEntity*	GetEntity	( EntityHandle hEntity ) const;		// nullptr if stale
+
+
+	//*****************************************************************//
+	// Deferred Storage:
+	//	- safe during UpdateAll, CheckCollisions & HandleCollision
+	//	- applied together by ProcessQueues, the sync point called
+	//	  once the frame's updates & collisions are done
+	//	- queued entities stay in their buckets until then
+	void	QueueAdd	( IEntity* pEntity, unsigned int bucket );
+	void	QueueRemove	( IEntity* pEntity, unsigned int bucket );
+	void	QueueRemove	( IEntity* pEntity );
+	void	ProcessQueues( void );
+
 
 	//*****************************************************************//
 	// Entity Upkeep:
 	void	UpdateAll( float elapsedTime );
 	void	RenderAll( void );
+	void	RenderAll( const SGD::Rectangle& view );
 	
 	void	CheckCollisions( unsigned int bucket1, unsigned int bucket2 );
+	void	CheckCollisions( unsigned int bucket, BulletSystem* pBullets );
+
+
+	//*****************************************************************//
+	// Parallel Update (opt-in):
+	//	- UpdateAll splits each large parallel-safe bucket into chunks
+	//	  run across the job pool; every other bucket stays serial
+	//	- a parallel-safe entity's Update may only write to itself
+	//	  (no queuing, messages, events, singletons or reference counts)
+	void	SetJobPool			( JobPool* pJobs )			{	m_pJobs = pJobs;				}
+	void	SetParallelUpdate	( bool parallel )			{	m_bParallelUpdate = parallel;	}
+	void	SetBucketParallel	( unsigned int bucket, bool parallel );
+	bool	IsBucketParallel	( unsigned int bucket ) const;
+
+
+	//*****************************************************************//
+	// View Culling:
+	//	- RenderAll( view ) skips the entities whose GetRect does not
+	//	  intersect the view (in world coordinates)
+	//	- an empty GetRect has no bounds, so the entity is always drawn
+	//	- stats count the entities of the last RenderAll
+	struct RenderStats
+	{
+		unsigned int	unDrawn			= 0;	// Render calls
+		unsigned int	unCulled		= 0;	// entities outside the view
+	};
+
+	const RenderStats&	GetRenderStats( void ) const		{	return m_RenderStats;	}
+
+
+	//*****************************************************************//
+	// Collision Broad Phase:
+	//	- the grid is rebuilt by every check, from the current rects
+	//	- stats accumulate over every CheckCollisions since UpdateAll
+	struct CollisionStats
+	{
+		unsigned int	unPairTests		= 0;	// narrow-phase IsIntersecting calls
+		unsigned int	unBruteForce	= 0;	// pairs a brute-force loop would have tested
+		unsigned int	unContacts		= 0;	// pairs passed to HandleCollision
+	};
+
+	void	SetCollisionCellSize( float cellSize );
+	const CollisionStats&	GetCollisionStats( void ) const		{	return m_CollisionStats;	}
+
+
+	//*****************************************************************//
+	// Collision Narrow Phase:
+	//	- the grid queries are split across the job pool (when set &
+	//	  enabled), each chunk collecting its own contact list
+	//	- the lists are merged in (first, second) index order, so
+	//	  HandleCollision runs in the same order for any thread count
+	//	- FindContacts returns the pairs CheckCollisions would dispatch,
+	//	  as indices into bucket1 & bucket2 (valid until the next call)
+	struct Contact
+	{
+		unsigned int	unFirst;		// index in bucket1
+		unsigned int	unSecond;		// index in bucket2
+	};
+	typedef std::vector< Contact >	ContactVector;
+
+	void	SetParallelCollisions( bool parallel )		{	m_bParallelCollisions = parallel;	}
+	const ContactVector&	FindContacts( unsigned int bucket1, unsigned int bucket2 );
 
 private:
 	//*****************************************************************//
@@ -52,11 +136,71 @@ private:
 	typedef std::vector< IEntity* >		EntityVector;
 	typedef std::vector< EntityVector >	EntityTable;
 
+	struct EntitySlot
+	{
+		IEntity*		pEntity		= nullptr;
+		unsigned int	unBucket	= 0;
+		unsigned int	unIndex		= 0;	// position in the bucket
+	};
+	typedef SGD::SGD_IMPLEMENTATION::HandleManager< EntitySlot >	SlotManager;
+
+	struct RenderEntry
+	{
+		IEntity*		pEntity;
+		EntityHandle	hEntity;		// entry is stale once the handle is invalid
+		float			fDepth;			// sort key (the depth at the last sort)
+	};
+	typedef std::vector< RenderEntry >		RenderVector;
+
+	struct PendingEntity
+	{
+		IEntity*		pEntity;		// adds only
+		EntityHandle	hEntity;		// removes only
+		unsigned int	unBucket;		// ANY_BUCKET removes from every bucket
+	};
+	typedef std::vector< PendingEntity >	PendingVector;
+
+	enum { ANY_BUCKET = 0xFFFFFFFF };
+
+	// Contacts found by one chunk of the outer loop
+	struct ContactChunk
+	{
+		ContactVector				vContacts;
+		std::vector< unsigned int >	vHits;			// query scratch
+		unsigned int				unTests	= 0;
+	};
+	typedef std::vector< ContactChunk >		ChunkVector;
+
 
 	//*****************************************************************//
 	// members:
 	EntityTable		m_tEntities;			// vector-of-vector-of-IEntity* (2D table)
 	bool			m_bIterating = false;	// read/write lock
+	SlotManager		m_Slots;				// entity handle -> bucket & index
+
+	RenderVector	m_vRenderList;			// every entity, kept sorted by depth
+	unsigned int	m_unStaleRender = 0;	// removed entities still in the render list
+	bool			m_bRenderDirty	= false;	// an entity's SetDepth changed its depth
+
+	PendingVector	m_vPendingAdds;			// queued adds (holding a reference)
+	PendingVector	m_vPendingRemoves;		// queued removes
+
+	JobPool*		m_pJobs				= nullptr;
+	bool			m_bParallelUpdate	= false;
+	bool			m_bParallelCollisions	= false;
+	std::vector< bool >	m_vParallelBuckets;			// parallel-safe flag per bucket
+
+	SpatialHash		m_Grid;								// broad phase of the last check
+	ContactVector					m_vContacts;		// merged contacts of the last check
+	ChunkVector						m_vChunks;			// per-chunk contacts (reused storage)
+	CollisionStats	m_CollisionStats;
+	RenderStats		m_RenderStats;
+
+	void	RenderEntities( const SGD::Rectangle* pView );
+	void	BuildGrid( unsigned int bucket );
+	void	FindPairs( unsigned int bucket1, unsigned int bucket2 );
+	void	FindGridContacts( const SGD::Rectangle* pRects, unsigned int count, bool upperOnly );
+	void	RemoveSlot( EntityHandle hEntity );
 
 };
 
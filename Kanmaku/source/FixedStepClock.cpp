@@ -0,0 +1,56 @@
+//*********************************************************************//
+//	File:		FixedStepClock.cpp
+//	Author:		
+//	Course:		
+//	Purpose:	FixedStepClock class turns the frame times into
+//				a whole number of fixed simulation steps
+//*********************************************************************//
+
+#include "FixedStepClock.h"
+
+#include "../SGD Wrappers/SGD_Utilities.h"
+
+
+//*********************************************************************//
+// Constructor
+FixedStepClock::FixedStepClock( float fixedTimeStep, unsigned int maxSteps )
+{
+	SGD_ASSERT( fixedTimeStep > 0.0f && maxSteps > 0,
+		"FixedStepClock - the step & the clamp must be positive" );
+
+	m_fFixedTimeStep	= fixedTimeStep;
+	m_unMaxSteps		= maxSteps;
+}
+
+
+//*********************************************************************//
+// Start
+//	- round the step to whole ticks & reset the accumulator
+void FixedStepClock::Start( long long frequency )
+{
+	m_llFrequency		= frequency;
+	m_llStepTicks		= (long long)( frequency * (double)m_fFixedTimeStep + 0.5 );
+
+	if( m_llStepTicks < 1 )
+		m_llStepTicks = 1;
+
+	m_llAccumulator		= 0;
+	m_unSimulationSteps	= 0;
+	m_fInterpolation	= 0.0f;
+}
+
+
+//*********************************************************************//
+// Advance
+//	- add the frame's ticks, then take out the whole steps
+void FixedStepClock::Advance( long long elapsedTicks )
+{
+	m_llAccumulator += elapsedTicks;
+
+	if( m_llAccumulator > m_llStepTicks * m_unMaxSteps )
+		m_llAccumulator = m_llStepTicks * m_unMaxSteps;
+
+	m_unSimulationSteps	= (unsigned int)( m_llAccumulator / m_llStepTicks );
+	m_llAccumulator		-= m_unSimulationSteps * m_llStepTicks;
+	m_fInterpolation	= (float)( (double)m_llAccumulator / m_llStepTicks );
+}
@@ -0,0 +1,57 @@
+//*********************************************************************//
+//	File:		FixedStepClock.h
+//	Author:		
+//	Course:		
+//	Purpose:	FixedStepClock class turns the frame times into
+//				a whole number of fixed simulation steps
+//*********************************************************************//
+
+#pragma once
+
+
+//*********************************************************************//
+// FixedStepClock class
+//	- Advance adds a frame's elapsed ticks to the accumulator and takes
+//	  out as many whole steps as it holds
+//	- time is kept in whole ticks, so the step count never drifts
+//	  (the same total time gives the same steps at any frame rate)
+//	- a slow frame runs at most maxSteps steps and drops the rest,
+//	  rather than falling further behind every frame (spiral of death)
+class FixedStepClock
+{
+public:
+	//*****************************************************************//
+	// Constructor
+	explicit FixedStepClock( float fixedTimeStep = 1.0f / 60.0f, unsigned int maxSteps = 5 );
+
+
+	//*****************************************************************//
+	// Clock
+	void			Start				( long long frequency );		// ticks per second, empties the accumulator
+	void			Advance				( long long elapsedTicks );		// one rendered frame
+
+
+	//*****************************************************************//
+	// Accessors
+	//	- GetInterpolation is the fraction of a step left over [0, 1)
+	float			GetFixedTimeStep	( void ) const	{	return m_fFixedTimeStep;	}
+	unsigned int	GetMaxSteps			( void ) const	{	return m_unMaxSteps;		}
+	long long		GetFrequency		( void ) const	{	return m_llFrequency;		}
+	long long		GetStepTicks		( void ) const	{	return m_llStepTicks;		}
+
+	unsigned int	GetSimulationSteps	( void ) const	{	return m_unSimulationSteps;	}
+	float			GetInterpolation	( void ) const	{	return m_fInterpolation;	}
+
+private:
+	//*****************************************************************//
+	// Data
+	float			m_fFixedTimeStep;
+	unsigned int	m_unMaxSteps;
+
+	long long		m_llFrequency		= 0;		// ticks per second
+	long long		m_llStepTicks		= 1;		// ticks per fixed step
+	long long		m_llAccumulator		= 0;		// ticks not yet simulated
+
+	unsigned int	m_unSimulationSteps	= 0;		// steps of the last Advance
+	float			m_fInterpolation	= 0.0f;
+};
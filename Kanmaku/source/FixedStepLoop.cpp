@@ -0,0 +1,49 @@
+//*********************************************************************//
+//	File:		FixedStepLoop.cpp
+//	Author:		
+//	Course:		
+//	Purpose:	RunFixedSteps runs a frame's fixed simulation steps
+//				over the gameplay systems
+//*********************************************************************//
+
+#include "FixedStepLoop.h"
+
+#include "../SGD Wrappers/SGD_EventManager.h"
+#include "../SGD Wrappers/SGD_MessageManager.h"
+
+#include "AnimationSystem.h"
+#include "EntityManager.h"
+#include "FixedStepClock.h"
+
+
+//*********************************************************************//
+// RunFixedSteps
+unsigned int RunFixedSteps( const FixedStepClock& clock, const FixedStepSystems& systems )
+{
+	float fixedStep = clock.GetFixedTimeStep();
+
+	for( unsigned int step = 0; step < clock.GetSimulationSteps(); step++ )
+	{
+		// Update the entities
+		if( systems.pEntities != nullptr )
+			systems.pEntities->UpdateAll( fixedStep );
+
+		// Advance every animation cursor in one pass
+		if( systems.pAnimations != nullptr )
+			systems.pAnimations->Update( fixedStep );
+
+		// Process the Event Manager
+		//	- all the events will be sent to the registered IListeners' HandleEvent methods
+		SGD::EventManager::GetInstance()->Update();
+
+		// Process the Message Manager
+		//	- all the messages will be sent to the MessageProc
+		SGD::MessageManager::GetInstance()->Update();
+
+		// Apply the entity adds & removes queued during this step
+		if( systems.pEntities != nullptr )
+			systems.pEntities->ProcessQueues();
+	}
+
+	return clock.GetSimulationSteps();
+}
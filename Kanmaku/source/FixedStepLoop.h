@@ -0,0 +1,34 @@
+//*********************************************************************//
+//	File:		FixedStepLoop.h
+//	Author:		
+//	Course:		
+//	Purpose:	RunFixedSteps runs a frame's fixed simulation steps
+//				over the gameplay systems
+//*********************************************************************//
+
+#pragma once
+
+class AnimationSystem;		// AnimationSystem type
+class EntityManager;		// EntityManager type
+class FixedStepClock;		// FixedStepClock type
+
+
+//*********************************************************************//
+// FixedStepSystems
+//	- what one step advances (a null system is skipped)
+struct FixedStepSystems
+{
+	EntityManager*		pEntities		= nullptr;
+	AnimationSystem*	pAnimations		= nullptr;
+};
+
+
+//*********************************************************************//
+// RunFixedSteps
+//	- runs clock.GetSimulationSteps() steps of clock.GetFixedTimeStep(),
+//	  each one: update the entities, advance the animation cursors,
+//	  deliver the queued events & messages, apply the entity adds &
+//	  removes they queued
+//	- the EventManager & MessageManager must be initialized
+//	- returns the steps run
+unsigned int	RunFixedSteps	( const FixedStepClock& clock, const FixedStepSystems& systems );
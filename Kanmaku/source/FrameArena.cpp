@@ -0,0 +1,135 @@
+//*********************************************************************//
+//	File:		FrameArena.cpp
+//	Author:		
+//	Course:		
+//	Purpose:	FrameArena class hands out transient memory that
+//				lives until the end of the frame
+//*********************************************************************//
+
+#include "FrameArena.h"
+
+#include "../SGD Wrappers/SGD_Utilities.h"
+
+#include <cstdlib>
+#include <cstring>
+
+
+//*********************************************************************//
+// Constructor
+//	- reserve the block
+FrameArena::FrameArena( unsigned int capacity )
+{
+	m_pBuffer		= new unsigned char[ capacity ];
+	m_unCapacity	= capacity;
+
+#if _DEBUG
+	memset( m_pBuffer, FRAMEARENA_POISON, capacity );
+#endif
+}
+
+//*********************************************************************//
+// Destructor
+FrameArena::~FrameArena( void )
+{
+	Reset();
+
+	delete[] m_pBuffer;
+	m_pBuffer = nullptr;
+}
+
+
+//*********************************************************************//
+// Allocate
+//	- move the cursor past the aligned allocation
+void* FrameArena::Allocate( unsigned int size, unsigned int alignment )
+{
+	SGD_ASSERT( alignment != 0 && (alignment & (alignment - 1)) == 0,
+		"FrameArena::Allocate - alignment must be a power of two" );
+
+	// Align the buffer's address, not the offset
+	size_t address	= (size_t)(m_pBuffer + m_unUsed);
+	size_t padding	= (alignment - (address & (alignment - 1))) & (alignment - 1);
+
+	if( size > m_unCapacity - m_unUsed || padding > m_unCapacity - m_unUsed - size )
+		return AllocateOverflow( size, alignment );
+
+	void* memory = m_pBuffer + m_unUsed + padding;
+	m_unUsed += (unsigned int)padding + size;
+
+	UpdateHighWater();
+	return memory;
+}
+
+
+//*********************************************************************//
+// Free
+//	- only the latest allocation is taken back,
+//	  the rest waits for the Reset
+void FrameArena::Free( void* memory, unsigned int size )
+{
+	if( memory == nullptr || (unsigned char*)memory + size != m_pBuffer + m_unUsed )
+		return;
+
+	m_unUsed -= size;
+
+#if _DEBUG
+	memset( memory, FRAMEARENA_POISON, size );
+#endif
+}
+
+
+//*********************************************************************//
+// Reset
+//	- release every allocation & the heap blocks
+void FrameArena::Reset( void )
+{
+#if _DEBUG
+	// Poison the used bytes, so a pointer kept past
+	// the frame reads garbage instead of stale data
+	memset( m_pBuffer, FRAMEARENA_POISON, m_unUsed );
+#endif
+
+	m_unUsed = 0;
+
+	while( m_pOverflow != nullptr )
+	{
+		Overflow* next = m_pOverflow->pNext;
+		free( m_pOverflow );
+		m_pOverflow = next;
+	}
+
+	m_unOverflowBytes = 0;
+}
+
+
+//*********************************************************************//
+// AllocateOverflow
+//	- the block is full: allocate from the heap until the Reset
+void* FrameArena::AllocateOverflow( unsigned int size, unsigned int alignment )
+{
+	Overflow* block = (Overflow*)malloc( sizeof( Overflow ) + size + alignment );
+	if( block == nullptr )
+		throw std::bad_alloc();
+
+	size_t address	= (size_t)(block + 1);
+	address			= (address + alignment - 1) & ~(size_t)(alignment - 1);
+
+	block->pNext	= m_pOverflow;
+	block->pMemory	= (void*)address;
+	m_pOverflow		= block;
+
+	m_unOverflowBytes += size;
+	m_unOverflows++;
+
+	UpdateHighWater();
+	return block->pMemory;
+}
+
+
+//*********************************************************************//
+// UpdateHighWater
+void FrameArena::UpdateHighWater( void )
+{
+	if( GetUsed() > m_unHighWater )
+		m_unHighWater = GetUsed();
+}
@@ -0,0 +1,169 @@
+//*********************************************************************//
+//	File:		FrameArena.h
+//	Author:		
+//	Course:		
+//	Purpose:	FrameArena class hands out transient memory that
+//				lives until the end of the frame
+//*********************************************************************//
+
+#pragma once
+
+#include <cstddef>							// uses size_t
+#include <new>								// uses std::bad_alloc
+#include <string>							// uses std::basic_string
+#include <type_traits>						// uses std::alignment_of
+#include <vector>							// uses std::vector
+
+
+//*********************************************************************//
+// Bytes the arena reserves up front
+#define FRAMEARENA_CAPACITY			(256 * 1024)
+
+// Byte written over the released memory in debug builds
+#define FRAMEARENA_POISON			0xFA
+
+
+//*********************************************************************//
+// FrameArena class
+//	- a linear (bump) allocator: Allocate moves a cursor through one
+//	  block reserved at construction, Reset moves it back to the start
+//	- Game resets it at the top of every frame, so a pointer from the
+//	  arena is valid until the next Game::Update (never store it)
+//	- freeing is free: Free only takes back the latest allocation
+//	  (so a growing FrameVector reuses its old space)
+//	- when the block runs out, the allocation comes from the heap and
+//	  is released by the next Reset (the high-water mark counts it, so
+//	  the capacity can be raised to fit)
+//	- debug builds fill the released bytes with FRAMEARENA_POISON
+//	- main thread only (not thread-safe)
+class FrameArena
+{
+public:
+	//*****************************************************************//
+	// Constructor & Destructor
+	explicit FrameArena( unsigned int capacity = FRAMEARENA_CAPACITY );
+	~FrameArena( void );
+
+
+	//*****************************************************************//
+	// Allocation
+	void*			Allocate	( unsigned int size, unsigned int alignment = 8 );	// alignment is a power of two
+	void			Free		( void* memory, unsigned int size );
+	void			Reset		( void );		// releases everything
+
+
+	//*****************************************************************//
+	// Stats
+	unsigned int	GetCapacity		( void ) const	{	return m_unCapacity;	}
+	unsigned int	GetUsed			( void ) const	{	return m_unUsed + m_unOverflowBytes;	}		// this frame
+	unsigned int	GetHighWater	( void ) const	{	return m_unHighWater;	}		// most used in one frame
+	unsigned int	GetOverflows	( void ) const	{	return m_unOverflows;	}		// heap allocations, in total
+
+private:
+	//*****************************************************************//
+	// Not copyable
+	FrameArena( const FrameArena& )				= delete;
+	FrameArena& operator= ( const FrameArena& )	= delete;
+
+
+	//*****************************************************************//
+	// Heap block of an allocation that did not fit
+	//	- the allocation follows the header
+	struct Overflow
+	{
+		Overflow*		pNext;
+		void*			pMemory;
+	};
+
+	void*			AllocateOverflow	( unsigned int size, unsigned int alignment );
+	void			UpdateHighWater		( void );
+
+
+	//*****************************************************************//
+	// Data
+	unsigned char*	m_pBuffer			= nullptr;
+	unsigned int	m_unCapacity		= 0;
+	unsigned int	m_unUsed			= 0;		// cursor into the buffer
+	unsigned int	m_unHighWater		= 0;
+
+	Overflow*		m_pOverflow			= nullptr;	// this frame's heap blocks
+	unsigned int	m_unOverflowBytes	= 0;
+	unsigned int	m_unOverflows		= 0;
+};
+
+
+//*********************************************************************//
+// FrameAllocator class
+//	- STL allocator adapter on a FrameArena, so a container's
+//	  storage comes from the arena:
+//		FrameVector< IEntity* > visible( pGame->GetFrameArena() );
+//	- the container must not outlive the frame
+template< typename T >
+class FrameAllocator
+{
+public:
+	//*****************************************************************//
+	// Allocator types
+	typedef T					value_type;
+	typedef T*					pointer;
+	typedef const T*			const_pointer;
+	typedef T&					reference;
+	typedef const T&			const_reference;
+	typedef size_t				size_type;
+	typedef ptrdiff_t			difference_type;
+
+	template< typename U >
+	struct rebind	{	typedef FrameAllocator< U > other;	};
+
+
+	//*****************************************************************//
+	// Constructors
+	FrameAllocator( FrameArena* arena )		: m_pArena( arena )					{	}
+
+	template< typename U >
+	FrameAllocator( const FrameAllocator< U >& other )	: m_pArena( other.GetArena() )	{	}
+
+
+	//*****************************************************************//
+	// Allocation
+	T* allocate( size_t count )
+	{
+		if( count > max_size() )
+			throw std::bad_alloc();
+
+		return (T*)m_pArena->Allocate( (unsigned int)(count * sizeof( T )), std::alignment_of< T >::value );
+	}
+
+	void deallocate( T* memory, size_t count )
+	{
+		m_pArena->Free( memory, (unsigned int)(count * sizeof( T )) );
+	}
+
+	size_t max_size( void ) const		{	return 0x7FFFFFFF / sizeof( T );	}
+
+
+	//*****************************************************************//
+	// Arena Accessor
+	FrameArena*	GetArena	( void ) const	{	return m_pArena;	}
+
+private:
+	//*****************************************************************//
+	// Data
+	FrameArena*		m_pArena;
+};
+
+// Allocators on the same arena can free each other's memory
+template< typename T, typename U >
+bool operator== ( const FrameAllocator< T >& lhs, const FrameAllocator< U >& rhs )	{	return lhs.GetArena() == rhs.GetArena();	}
+
+template< typename T, typename U >
+bool operator!= ( const FrameAllocator< T >& lhs, const FrameAllocator< U >& rhs )	{	return lhs.GetArena() != rhs.GetArena();	}
+
+
+//*********************************************************************//
+// Containers on the frame arena
+template< typename T >
+using FrameVector = std::vector< T, FrameAllocator< T > >;
+
+typedef std::basic_string< char, std::char_traits< char >, FrameAllocator< char > >			FrameString;
+typedef std::basic_string< wchar_t, std::char_traits< wchar_t >, FrameAllocator< wchar_t > >	FrameWString;
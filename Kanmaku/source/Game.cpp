@@ -14,9 +14,14 @@
 #include "../SGD Wrappers/SGD_String.h"
 #include "../SGD Wrappers/SGD_Utilities.h"
 
+#include "AnimationLibrary.h"
+#include "AssetResidency.h"
 #include "BitmapFont.h"
+#include "FrameArena.h"
+#include "JobPool.h"
 #include "IGameState.h"
 #include "MainMenuState.h"
+#include "TextBuilder.h"
 
 #include <ctime>
 #include <cstdlib>
@@ -25,6 +30,28 @@
 #define WIN32_LEAN_AND_MEAN
 #include <Windows.h>
 
+#include <cstdio>
+
+
+#if defined( _DEBUG ) && defined( _MSC_VER )
+#include <crtdbg.h>
+
+//*********************************************************************//
+// Heap allocation counter (debug CRT hook)
+//	- counts the allocations of every thread, so ReportMemory
+//	  can show that a steady frame allocates nothing
+static volatile long	s_lHeapAllocations	= 0;
+static _CRT_ALLOC_HOOK	s_pfPrevAllocHook	= nullptr;
+
+static int __cdecl CountAllocation( int allocType, void*, size_t, int, long, const unsigned char*, int )
+{
+	if( allocType == _HOOK_ALLOC || allocType == _HOOK_REALLOC )
+		InterlockedIncrement( &s_lHeapAllocations );
+
+	return TRUE;	// let the allocation happen
+}
+#endif
+
 
 //*********************************************************************//
 // SINGLETON
@@ -77,24 +104,53 @@ bool Game::Initialize( void )
 	
 	// Change the background color
 	SGD::GraphicsManager::GetInstance()->SetClearColor( { 0, 0, 0 } );	// black
-	
+
+
+	// Load the sprite atlas index BEFORE any texture
+	// (the packed sprites then share one page texture)
+	SGD::GraphicsManager::GetInstance()->LoadAtlas( L"resource/graphics/sprites.atlas" );
+
+
+	// Allocate the frame arena (before any state uses it)
+	m_pFrameArena = new FrameArena;
 
 	// Allocate & Initialize the font
 	m_pFont = new BitmapFont;
 	m_pFont->Initialize();
 
+	// Allocate & Load the animation clips
+	m_pAnimations = new AnimationLibrary;
+	m_pAnimations->Load( "resource/animations.xml" );
+
+	// Allocate & Initialize the job pool (one worker per extra core)
+	m_pJobs = new JobPool;
+	m_pJobs->Initialize();
+
+	// Allocate the asset residency (before the first state change)
+	m_pResidency = new AssetResidency;
+
 	// Start in the MainMenuState
 	ChangeState( MainMenuState::GetInstance() );
 	
 
-	// Store the starting time
-	m_ulGameTime = GetTickCount();
+	// Store the starting time & reset the simulation clock
+	LARGE_INTEGER counter;
+	QueryPerformanceFrequency( &counter );
+	m_Clock.Start( counter.QuadPart );
+	QueryPerformanceCounter( &counter );
+	m_llGameTime		= counter.QuadPart;
 
 	// Reset the FPS
 	m_unFPS = 60;
 	m_unFrames = 0;
 	m_fFPSTimer = 0.0f;
 
+	// Count the heap allocations from now on
+#if defined( _DEBUG ) && defined( _MSC_VER )
+	s_lHeapAllocations = 0;
+	s_pfPrevAllocHook = _CrtSetAllocHook( CountAllocation );
+#endif
+
 	return true;	// success!
 }
 
@@ -104,23 +160,38 @@ bool Game::Initialize( void )
 //	- update & render the current state
 int	Game::Update( void )
 {
+	// Release the last frame's transient memory
+	m_pFrameArena->Reset();
+
 	// Try to update the wrappers
 	if( SGD::GraphicsManager::GetInstance()->Update() == false 
 		|| SGD::InputManager::GetInstance()->Update() == false 
 		|| SGD::AudioManager::GetInstance()->Update() == false )
 		return +1;	// exit when window is closed
 
+	// Release the last state change's pins once its assets loaded
+	m_pResidency->Update();
+
 	
 	// Calculate the elapsed time between frames
-	unsigned long now = GetTickCount();
-	float elapsedTime = (now - m_ulGameTime) / 1000.0f;
-	m_ulGameTime = now;
+	LARGE_INTEGER counter;
+	QueryPerformanceCounter( &counter );
+
+	long long elapsedTicks = counter.QuadPart - m_llGameTime;
+	m_llGameTime = counter.QuadPart;
+
+	float elapsedTime = (float)( (double)elapsedTicks / m_Clock.GetFrequency() );
 	
 	// Cap the elapsed time to 1/8th of a second
 	if( elapsedTime > 0.125f )
 		elapsedTime = 0.125f;
 
 
+	// Advance the simulation clock
+	//	- a slow frame runs at most 5 steps and drops the rest
+	m_Clock.Advance( elapsedTicks );
+
+
 	// Update & Render the current state
 	if( m_pCurrState->Update( elapsedTime ) == false )
 		return +1;	// exit success
@@ -142,17 +213,19 @@ int	Game::Update( void )
 
 	if (m_fFPSTimer >= 1.0f)		// 1 second refresh rate
 	{
+		ReportMemory( m_unFrames, false );
+
 		m_unFPS = m_unFrames;
 		m_unFrames = 0;
 		m_fFPSTimer = 0.0f;
 	}
 
-	// Render the FPS
-	SGD::OStringStream output;
-	output << "FPS: " << m_unFPS;
+	// Render the FPS (formatted without allocating)
+	TextBuilder output;
+	output.Append( "FPS: " ).Append( m_unFPS );
 
 	SGD::GraphicsManager::GetInstance()->DrawString(
-		output.str().c_str(),
+		output.GetText(),
 		{ 0, 0 },
 		{ 0, 255, 0 });
 
@@ -168,6 +241,19 @@ void Game::Terminate( void )
 	// Exit the current state
 	ChangeState( nullptr );
 
+	// Stop counting the heap allocations
+#if defined( _DEBUG ) && defined( _MSC_VER )
+	_CrtSetAllocHook( s_pfPrevAllocHook );
+#endif
+
+	// Release the pinned assets (before the wrappers terminate)
+	if( m_pResidency != nullptr )
+	{
+		m_pResidency->Terminate();
+		delete m_pResidency;
+		m_pResidency = nullptr;
+	}
+
 
 	// Terminate & Deallocate the font
 	if( m_pFont != nullptr )
@@ -176,6 +262,31 @@ void Game::Terminate( void )
 		delete m_pFont;
 	}
 
+	// Unload & Deallocate the animation clips
+	if( m_pAnimations != nullptr )
+	{
+		m_pAnimations->Unload();
+		delete m_pAnimations;
+		m_pAnimations = nullptr;
+	}
+
+	// Terminate & Deallocate the job pool
+	if( m_pJobs != nullptr )
+	{
+		m_pJobs->Terminate();
+		delete m_pJobs;
+		m_pJobs = nullptr;
+	}
+
+	// Report & Deallocate the frame arena
+	if( m_pFrameArena != nullptr )
+	{
+		ReportMemory( m_unFrames, true );
+
+		delete m_pFrameArena;
+		m_pFrameArena = nullptr;
+	}
+
 
 	// Terminate the SGD wrappers (in reverse order)
 	SGD::AudioManager::GetInstance()->Terminate();
@@ -193,8 +304,13 @@ void Game::Terminate( void )
 // ChangeState
 //	- unload the old state
 //	- load the new state
+//	- the files both states use stay loaded (pinned by the residency)
 void Game::ChangeState( IGameState* pNextState )
 {
+	// Pin the new state's files before the old state unloads its own
+	if( m_pResidency != nullptr )
+		m_pResidency->BeginTransition( pNextState );
+
 	// Exit the current state (if it exists)
 	if( m_pCurrState != nullptr )
 		m_pCurrState->Exit();
@@ -205,4 +321,62 @@ void Game::ChangeState( IGameState* pNextState )
 	// Enter the new state (if it exists)
 	if( m_pCurrState != nullptr )
 		m_pCurrState->Enter();
+
+	if( m_pResidency != nullptr )
+		m_pResidency->EndTransition();
+}
+
+
+//*********************************************************************//
+// RenderLoading
+//	- draw a progress bar & caption centered on the screen
+void Game::RenderLoading( float progress ) const
+{
+	if( progress < 0.0f )	progress = 0.0f;
+	if( progress > 1.0f )	progress = 1.0f;
+
+	SGD::GraphicsManager* pGraphics = SGD::GraphicsManager::GetInstance();
+
+	// Bar outline, then the loaded part
+	SGD::Rectangle rBar = { 
+		SGD::Point{ m_szScreenSize.width * 0.25f, m_szScreenSize.height * 0.5f }, 
+		SGD::Size{ m_szScreenSize.width * 0.5f, 24 } 
+	};
+	pGraphics->DrawRectangle( rBar, SGD::Color{ 255, 32, 32, 32 }, SGD::Color{ 255, 255, 255, 255 }, 2 );
+
+	SGD::Rectangle rFill = rBar;
+	rFill.right = rBar.left + rBar.ComputeWidth() * progress;
+	if( rFill.right > rFill.left )
+		pGraphics->DrawRectangle( rFill, SGD::Color{ 255, 255, 255, 255 } );
+
+	// Caption above the bar
+	m_pFont->Draw( "Loading", 
+		SGD::Point{ (m_szScreenSize.width - (7 * 32 * 1.0f)) / 2, rBar.top - 48 }, 
+		1.0f, SGD::Color{ 255, 255, 255 } );
+}
+
+
+//*********************************************************************//
+// ReportMemory
+//	- debug output of the frame arena's high-water mark & of the heap
+//	  allocations made during the last frames (a steady frame should
+//	  make none: only a report with allocations prints, unless always)
+void Game::ReportMemory( unsigned int frames, bool always ) const
+{
+#if _DEBUG
+	unsigned int allocations = 0;
+
+#if defined( _MSC_VER )
+	allocations = (unsigned int)InterlockedExchange( &s_lHeapAllocations, 0 );
+#endif
+
+	if( allocations == 0 && always == false )
+		return;
+
+	char szBuffer[ 256 ];
+	_snprintf_s( szBuffer, 256, _TRUNCATE, 
+		"Frame memory: %u heap allocations in %u frames, arena high water %u of %u bytes (%u overflows)\n",
+		allocations, frames, m_pFrameArena->GetHighWater(), m_pFrameArena->GetCapacity(), m_pFrameArena->GetOverflows() );
+	OutputDebugStringA( szBuffer );
+#endif
 }
@@ -9,12 +9,17 @@
 #pragma once
 
 #include "../SGD Wrappers/SGD_Geometry.h"
+#include "FixedStepClock.h"
 
 
 //*********************************************************************//
 // Forward class declarations
+class AnimationLibrary;
+class AssetResidency;
 class BitmapFont;
+class FrameArena;
 class IGameState;
+class JobPool;
 
 
 //*********************************************************************//
@@ -48,10 +53,41 @@ public:
 	// Font Accessor (#include "BitmapFont.h" to use!)
 	BitmapFont*	GetFont			( void ) const	{	return	m_pFont;		}
 
+	// Job Pool Accessor (#include "JobPool.h" to use!)
+	JobPool*	GetJobPool		( void ) const	{	return	m_pJobs;		}
+
+	// Asset Residency Accessor (#include "AssetResidency.h" to use!)
+	AssetResidency*	GetResidency	( void ) const	{	return	m_pResidency;	}
+
+	// Animation Library Accessor (#include "AnimationLibrary.h" to use!)
+	AnimationLibrary*	GetAnimations	( void ) const	{	return	m_pAnimations;	}
+
+	// Frame Arena Accessor (#include "FrameArena.h" to use!)
+	//	- its memory is released at the start of the next frame
+	FrameArena*	GetFrameArena	( void ) const	{	return	m_pFrameArena;	}
+
+
+	//*****************************************************************//
+	// Simulation Clock:
+	//	- the current state runs GetSimulationSteps() steps of
+	//	  GetFixedTimeStep() seconds during this frame's Update
+	//	- GetInterpolation is the fraction of a step left over [0, 1),
+	//	  for rendering between the last two simulated positions
+	//	- GetClock is for RunFixedSteps (FixedStepLoop.h)
+	const FixedStepClock&	GetClock	( void ) const	{	return m_Clock;		}
+	float			GetFixedTimeStep	( void ) const	{	return m_Clock.GetFixedTimeStep();		}
+	unsigned int	GetSimulationSteps	( void ) const	{	return m_Clock.GetSimulationSteps();	}
+	float			GetInterpolation	( void ) const	{	return m_Clock.GetInterpolation();		}
+
 
 	//*****************************************************************//
 	// Game State Mutator:
 	void	ChangeState( IGameState* pNextState );
+
+	//*****************************************************************//
+	// Loading Screen:
+	//	- drawn by a state while its assets load asynchronously
+	void	RenderLoading( float progress ) const;	// progress in [0, 1]
 	
 private:
 	//*****************************************************************//
@@ -77,6 +113,18 @@ private:
 	// Font
 	BitmapFont*		m_pFont				= nullptr;
 
+	// Worker threads
+	JobPool*		m_pJobs				= nullptr;
+
+	// Assets kept loaded across state changes
+	AssetResidency*	m_pResidency		= nullptr;
+
+	// Animation clips shared by every animation
+	AnimationLibrary*	m_pAnimations	= nullptr;
+
+	// Transient memory of the current frame
+	FrameArena*		m_pFrameArena		= nullptr;
+
 
 	//*****************************************************************//
 	// Active Game State
@@ -85,7 +133,10 @@ private:
 
 	//*****************************************************************//
 	// Game Time
-	unsigned long	m_ulGameTime	= 0;
+	//	- high-resolution counter ticks, split into 1/60 s steps
+	//	  (at most 5 per frame: the spiral-of-death clamp)
+	long long		m_llGameTime		= 0;		// ticks at the last frame
+	FixedStepClock	m_Clock				= FixedStepClock( 1.0f / 60.0f, 5 );
 
 	//*******************************************************************
 	// FPS
@@ -93,4 +144,8 @@ private:
 	unsigned int	m_unFrames = 0;
 	float			m_fFPSTimer = 0.0f;
 
+	//*******************************************************************
+	// Helper Methods
+	void			ReportMemory	( unsigned int frames, bool always ) const;		// debug output
+
 };
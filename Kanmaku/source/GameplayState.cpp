@@ -10,6 +10,7 @@
 #include "Game.h"
 #include "MainMenuState.h"
 #include "BitmapFont.h"
+#include "TextBuilder.h"
 
 #include "../SGD Wrappers/SGD_AudioManager.h"
 #include "../SGD Wrappers/SGD_GraphicsManager.h"
@@ -26,12 +27,15 @@
 
 #include "EntityManager.h"
 #include "Entity.h"
+#include "FixedStepLoop.h"
 
 #include "Player.h"
 #include "Puff.h"
-#include "Bullet.h"
+#include "BulletSystem.h"
 
+#include "AssetResidency.h"
 #include "CreateBulletMessage.h"
+#include "DestroyEntityMessage.h"
 
 #define WIN32_LEAN_AND_MEAN
 #include <Windows.h>
@@ -43,6 +47,23 @@
 #endif
 
 
+//*********************************************************************//
+// Entities this far outside the camera are still drawn
+// (covers interpolation & sprites larger than their rects)
+#define GAMEPLAY_CULL_MARGIN	64.0f
+
+
+//*********************************************************************//
+// Asset files (loaded by Enter, listed by GetAssets)
+#define GAMEPLAY_BACKGROUND_IMG			L"resource/graphics/DEBUG_GameStateBG.png"
+#define GAMEPLAY_PLAYER_IMG				L"resource/graphics/Cus_NorthernPrincess.png"
+#define GAMEPLAY_PUFF_IMG				L"resource/graphics/DEBUG_Puff.png"
+#define GAMEPLAY_BULLET_A_IMG			L"resource/graphics/kc_BulletTypeA.png"
+
+// Tiled background layers (cut by tools/TileSlicer), back to front
+#define GAMEPLAY_BACKGROUND_BACK_TILES		L"resource/graphics/tiles/bg_back.tiles"
+#define GAMEPLAY_BACKGROUND_MIDDLE_TILES	L"resource/graphics/tiles/bg_middle.tiles"
+#define GAMEPLAY_BACKGROUND_FRONT_TILES		L"resource/graphics/tiles/bg_front.tiles"
 
 
 //*********************************************************************//
@@ -68,26 +89,42 @@
 	SGD::MessageManager::GetInstance()->Initialize( &GameplayState::MessageProc );
 
 	// loading assets
-#if _DEBUG
-	m_hBackgroundImg = SGD::GraphicsManager::GetInstance()->LoadTexture(L"resource/graphics/DEBUG_GameStateBG.png");
+	//	- the loads finish on worker threads while Update shows the loading screen
+	m_Loading.Clear();
 
-	m_hBackgroundImg_Front = SGD::GraphicsManager::GetInstance()->LoadTexture(L"resource/graphics/DEBUG_GameStateBG_Front.png");
-	m_hBackgroundImg_Middle = SGD::GraphicsManager::GetInstance()->LoadTexture(L"resource/graphics/DEBUG_GameStateBG_Middle.png");
-	m_hBackgroundImg_Back = SGD::GraphicsManager::GetInstance()->LoadTexture(L"resource/graphics/DEBUG_GameStateBG_Back.png");
+#if _DEBUG
+	m_hBackgroundImg = m_Loading.LoadTexture(GAMEPLAY_BACKGROUND_IMG);
 
 	//m_hPlayerImg = SGD::GraphicsManager::GetInstance()->LoadTexture(L"resource/graphics/DEBUG_PlayerEntity.png");
-	m_hPlayerImg = SGD::GraphicsManager::GetInstance()->LoadTexture(L"resource/graphics/Cus_NorthernPrincess.png");
+	m_hPlayerImg = m_Loading.LoadTexture(GAMEPLAY_PLAYER_IMG);
 
-	m_hPuffImg = SGD::GraphicsManager::GetInstance()->LoadTexture(L"resource/graphics/DEBUG_Puff.png");
-	m_hBulletTypeA = SGD::GraphicsManager::GetInstance()->LoadTexture(L"resource/graphics/kc_BulletTypeA.png");
+	m_hPuffImg = m_Loading.LoadTexture(GAMEPLAY_PUFF_IMG);
+	m_hBulletTypeA = m_Loading.LoadTexture(GAMEPLAY_BULLET_A_IMG);
 
 #else
 
 #endif
 
+	// The background tiles stream in & out around the camera
+	//	- Update waits in the loading screen for the tiles in view
+	m_Background.AddLayer(GAMEPLAY_BACKGROUND_BACK_TILES, 0.5f);
+	m_Background.AddLayer(GAMEPLAY_BACKGROUND_MIDDLE_TILES, 0.8f);
+	m_Background.AddLayer(GAMEPLAY_BACKGROUND_FRONT_TILES, 1.0f);
+
 	// Allocate the Entity Manager
 	m_pEntities = new EntityManager;
 
+	// No bucket holds enough independent entities for a parallel
+	// UpdateAll (Player & Puff read the game state; the bullets split
+	// their own update), so every bucket updates serially
+	m_pEntities->SetJobPool(Game::GetInstance()->GetJobPool());
+
+	// Collision pairs are found in parallel, then handled in order
+	m_pEntities->SetParallelCollisions(true);
+
+	// The entities' animation cursors (before creating the entities)
+	m_Animations.Initialize(Game::GetInstance()->GetAnimations());
+
 	// Initialize the player's entity
 	m_pPlayer = CreatePlayer();
 	m_pEntities->AddEntity(m_pPlayer, BUCKET_PLAYER);
@@ -95,9 +132,16 @@
 	m_pPuff = CreatePuff();
 	m_pEntities->AddEntity(m_pPuff, BUCKET_PUFF);
 
+	// Every bullet lives in the one bullet system entity
+	m_pBullets = new BulletSystem;
+	m_pBullets->SetBulletImage(Entity::ENT_BULLET_A, m_hBulletTypeA, SGD::Size{ 16, 16 });
+	m_pBullets->SetJobPool(Game::GetInstance()->GetJobPool());
+	m_pBullets->SetParallelUpdate(true);
+	m_pEntities->AddEntity(m_pBullets, BUCKET_BULLET_A);
+
 
-	// Setting World Size
-	m_szWorldSize = SGD::Size{ 2048, 768 };
+	// Setting World Size (as wide as the front layer)
+	m_szWorldSize = SGD::Size{ m_Background.GetLayerSize(2).width, 768 };
 
 	
 }
@@ -120,15 +164,20 @@
 		m_pPuff = nullptr;
 	}	
 
-	// Unload the resources
+	if (m_pBullets != nullptr) {
+		m_pBullets->Release();
+		m_pBullets = nullptr;
+	}
+
+	// Unload the resources (even those still loading)
+	m_Loading.Clear();
+
 	SGD::GraphicsManager*	pGraphics = SGD::GraphicsManager::GetInstance();
 	SGD::AudioManager*		pAudio = SGD::AudioManager::GetInstance();
 
 	pGraphics->UnloadTexture(m_hBackgroundImg);
 
-	pGraphics->UnloadTexture(m_hBackgroundImg_Front);
-	pGraphics->UnloadTexture(m_hBackgroundImg_Middle);
-	pGraphics->UnloadTexture(m_hBackgroundImg_Back);
+	m_Background.Clear();
 
 
 	pGraphics->UnloadTexture(m_hPlayerImg);
@@ -147,6 +196,9 @@
 		delete m_pEntities;
 		m_pEntities = nullptr;
 	}
+
+	// Release the animation cursors (after the entities destroyed theirs)
+	m_Animations.Terminate();
 	
 	// Terminate & deallocate the SGD wrappers
 	SGD::MessageManager::GetInstance()->Terminate();
@@ -158,9 +210,24 @@
 
 
 
+//*********************************************************************//
+// GetAssets
+//	- list the files Enter loads
+/*virtual*/ void GameplayState::GetAssets( AssetManifest& assets ) const	/*override*/
+{
+#if _DEBUG
+	assets.vTextures.push_back(GAMEPLAY_BACKGROUND_IMG);
+	assets.vTextures.push_back(GAMEPLAY_PLAYER_IMG);
+	assets.vTextures.push_back(GAMEPLAY_PUFF_IMG);
+	assets.vTextures.push_back(GAMEPLAY_BULLET_A_IMG);
+#endif
+}
+
+
 //*********************************************************************//
 // Update
-//	- handle input & update entities
+//	- handle input once per frame
+//	- update entities in fixed steps (Game decides how many)
 /*virtual*/ bool GameplayState::Update( float elapsedTime )	/*override*/ {
 
 	SGD::InputManager* pInput = SGD::InputManager::GetInstance();
@@ -177,46 +244,48 @@
 		return true;	// keep playing in the new state
 	}
 
-	
-	// draw the background image
-	//SGD::GraphicsManager::GetInstance()->DrawTexture(m_hBackgroundImg, -m_ptWorldCamPosition);
 
-	
-	SGD::Point offsetBack = { m_ptWorldCamPosition.x * 0.5f, m_ptWorldCamPosition.y * 0.5f };
-	SGD::Point offsetMiddle = { m_ptWorldCamPosition.x * 0.8f, m_ptWorldCamPosition.y * 0.8f };
+	// Stream the background tiles around the camera
+	SGD::Size screenSize = Game::GetInstance()->GetScreenSize();
+	m_Background.Update( m_ptWorldCamPosition, screenSize );
 
 
-	SGD::GraphicsManager::GetInstance()->DrawTexture(m_hBackgroundImg_Back, -offsetBack);
-	SGD::GraphicsManager::GetInstance()->DrawTexture(m_hBackgroundImg_Middle, -offsetMiddle);
-	SGD::GraphicsManager::GetInstance()->DrawTexture(m_hBackgroundImg_Front, -m_ptWorldCamPosition);
-	
-	// Update the entities
-	m_pEntities->UpdateAll( elapsedTime );
+	// Wait in the loading screen until the assets & the background in view are loaded
+	if( m_Loading.Update() == false
+		|| m_Background.IsViewLoaded( m_ptWorldCamPosition, screenSize ) == false )
+		return true;	// keep playing
+
+
+	// Latch the frame's input for the simulation steps
+	dynamic_cast<Player*>(m_pPlayer)->Input();
+
+
+	// Run the fixed simulation steps of this frame
+	//	- the events & messages go to the IListeners & our MessageProc
+	FixedStepSystems systems;
+	systems.pEntities	= m_pEntities;
+	systems.pAnimations	= &m_Animations;
+
+	RunFixedSteps( Game::GetInstance()->GetClock(), systems );
+
+	// Draw the bullets with the same depth as the puff
+	m_pBullets->SetDepth(m_pPuff->GetDepth() - 0.1f);
 	
 
 	//World Cam Update
 	//m_ptWorldCamPosition = m_pTank->GetPosition() - m_szScreenSize / 2;
 
-	SGD::Point CamOffset = m_pPlayer->GetPosition() - Game::GetInstance()->GetScreenSize() / 2;
+	// Follow the interpolated position, the same one the player is drawn at
+	SGD::Point CamOffset = m_pPlayer->GetRenderPosition() - Game::GetInstance()->GetScreenSize() / 2;
 
 	if (CamOffset.y > 0) CamOffset.y = 0;
 	else if (CamOffset.y < Game::GetInstance()->GetScreenSize().height) CamOffset.y = Game::GetInstance()->GetScreenSize().height;
 	if (CamOffset.x < 0) CamOffset.x = 0;
-	else if (CamOffset.x > Game::GetInstance()->GetScreenSize().width) CamOffset.x = Game::GetInstance()->GetScreenSize().width;
+	else if (CamOffset.x > m_szWorldSize.width - screenSize.width) CamOffset.x = m_szWorldSize.width - screenSize.width;
 
 	m_ptWorldCamPosition = CamOffset;
 
 
-	
-	// Process the Event Manager
-	//	- all the events will be sent to the registered IListeners' HandleEvent methods
-	SGD::EventManager::GetInstance()->Update();
-
-	// Process the Message Manager
-	//	- all the messages will be sent to our MessageProc
-	SGD::MessageManager::GetInstance()->Update();
-
-
 #if 0
 	system("cls");
 	std::cout << "X: " << pInput->GetCursorPosition().x << " Y: " << pInput->GetCursorPosition().y << std::endl;
@@ -232,10 +301,25 @@
 //	- render the game entities
 /*virtual*/ void GameplayState::Render( float elapsedTime )	/*override*/ {
 
-	
+	// Show the progress while the assets are loading
+	SGD::Size screenSize = Game::GetInstance()->GetScreenSize();
+
+	if( m_Loading.IsComplete() == false
+		|| m_Background.IsViewLoaded( m_ptWorldCamPosition, screenSize ) == false )
+	{
+		Game::GetInstance()->RenderLoading( m_Loading.GetProgress() );
+		return;
+	}
+
+	// Render the background tiles in view
+	m_Background.Render( m_ptWorldCamPosition, screenSize );
+
+	// Render the entities inside the camera's view
+	SGD::Rectangle rView = { m_ptWorldCamPosition, screenSize };
+	rView.Inflate( GAMEPLAY_CULL_MARGIN, GAMEPLAY_CULL_MARGIN );
 
-	// Render the entities
-	m_pEntities->RenderAll();
+	m_pBullets->SetCamera( m_ptWorldCamPosition );
+	m_pEntities->RenderAll( rView );
 
 	// Access the bitmap font
 	BitmapFont* pFont = Game::GetInstance()->GetFont();
@@ -247,13 +331,16 @@
 	int lives = dynamic_cast<Player*>(m_pPlayer)->GetLive();
 	int hp = dynamic_cast<Player*>(m_pPlayer)->GetHealth();
 
-	std::string score = "Lives:" + std::to_string(lives) + "   "
-						"Health:" + std::to_string(hp) + "   "
-						"Senka:" + std::to_string(senka);
+	// Formatted without allocating: the font reuses the cached glyph
+	// run until one of the counters changes
+	TextBuilder score;
+	score.Append("Lives:").Append(lives).Append("   ")
+		.Append("Health:").Append(hp).Append("   ")
+		.Append("Senka:").Append(senka);
 
 	pFont->Draw(
-		score.c_str(), 
-		SGD::Point{ (width - (score.length() * 32 * 1.0f)) / 2, 16 },
+		score.GetText(), 
+		SGD::Point{ (width - (score.GetLength() * 32 * 1.0f)) / 2, 16 },
 		1.0f, SGD::Color{ 255, 255, 255 }
 	);
 
@@ -278,31 +365,25 @@
 	switch( pMsg->GetMessageID() ) {
 	case MessageID::MSG_CREATE_BULLET: {
 		// Downcast to the actual message type
-		const CreateBulletMessage* pCreateMsg = dynamic_cast< const CreateBulletMessage* >(pMsg);
-
-		// Verify the cast succeeded
-		SGD_ASSERT(pCreateMsg != nullptr,
-			"GameplayState::MessageProc - MSG_CREATE_LASER is not actually a CreateLaserMessage");
+		// (only CreateBulletMessage's constructor uses this ID: no RTTI check)
+		const CreateBulletMessage* pCreateMsg = static_cast< const CreateBulletMessage* >(pMsg);
 
 
 		// Access our own singleton
 		GameplayState* self = GameplayState::GetInstance();
 
-		Entity* pBullet = nullptr;
 		switch (pCreateMsg->GetType()) {
 			case BULLET_A: {
 				// Play sfx
 				//SGD::AudioManager::GetInstance()->PlayAudio(/*TO-DO*/);
 
-				// Create a new bullet entity using the message attributes
-				pBullet = self->CreateBullet(
+				// Spawn a new bullet using the message attributes
+				self->CreateBullet(
 					pCreateMsg->GetPosX(),
 					pCreateMsg->GetPosY(),
 					pCreateMsg->GetRotation(),
 					BUCKET_BULLET_A/*is BucketType *NOT* BulletType*/
 				);
-				// Add the entity to the Entity Manager
-				self->m_pEntities->AddEntity(pBullet, BUCKET_BULLET_A);
 				break;
 			}
 			case BULLET_B: {
@@ -322,13 +403,15 @@
 				break;
 			}
 		}
-
-		// Release the local pointer
-		pBullet->Release();
-		pBullet = nullptr;
 		break;
 	}
 	case MessageID::MSG_DESTROY_ENTITY: {
+		// Downcast to the actual message type
+		// (only DestroyEntityMessage's constructor uses this ID: no RTTI check)
+		const DestroyEntityMessage* pDestroyMsg = static_cast< const DestroyEntityMessage* >(pMsg);
+
+		// Removed at the end of the frame
+		GameplayState::GetInstance()->m_pEntities->QueueRemove(pDestroyMsg->GetEntity());
 		break;
 	}
 
@@ -365,25 +448,21 @@ Entity* GameplayState::CreatePuff() const {
 	return pPuff;
 }
 
-Entity* GameplayState::CreateBullet(float posX, float posY, float rotation, EntityBucket _bulletType) const {
-	Bullet* pBullet = new Bullet;
+unsigned int GameplayState::CreateBullet(float posX, float posY, float rotation, EntityBucket _bulletType) const {
+	// Bullets are slots in the bullet system, not heap entities
+	unsigned int unBullet = BulletSystem::INVALID_BULLET;
 
 	switch (_bulletType) {
 		
 		case BUCKET_BULLET_A: {
-			pBullet->SetImage(m_hBulletTypeA);
-			//pBullet->SetBulletHitSfx(/*TO-DO*/);
-			pBullet->SetPosition({ posX - 16 / 2, posY - 16 / 2 });	// centered on position
-			pBullet->SetSize({ 16, 16 });
 			// Create a vector for the velocity
 			SGD::Vector velocity = { 0, -1 };
 			velocity.Rotate(rotation);
 			velocity *= 400;
 
-			pBullet->SetVelocity(velocity);
-			pBullet->SetRotation(rotation);
-
-			pBullet->SetBulletType(Entity::ENT_BULLET_A);	// remeber to set the type!!!
+			unBullet = m_pBullets->Spawn(Entity::ENT_BULLET_A,	// remeber to set the type!!!
+				SGD::Point{ posX - 16 / 2, posY - 16 / 2 },			// centered on position
+				velocity, rotation);
 			break;
 		}	 				
 		case BUCKET_BULLET_B: {
@@ -400,5 +479,5 @@ Entity* GameplayState::CreateBullet(float posX, float posY, float rotation, Enti
 		}
 	}
 
-	return pBullet;
+	return unBullet;
 }
@@ -11,6 +11,9 @@
 #include "../SGD Wrappers/SGD_Handle.h"			// uses HTexture & HAudio
 #include "../SGD Wrappers/SGD_Declarations.h"	// uses Message
 #include "../SGD Wrappers/SGD_Geometry.h"
+#include "../SGD Wrappers/SGD_LoadBatch.h"		// uses LoadBatch
+#include "ParallaxBackground.h"					// uses ParallaxBackground
+#include "AnimationSystem.h"					// uses AnimationSystem
 
 
 
@@ -21,6 +24,7 @@
 //	- MUST include their headers in the .cpp to dereference
 class Entity;
 class EntityManager;
+class BulletSystem;
 
 
 //***********************************************************************
@@ -46,6 +50,8 @@ public:
 	virtual bool	Update(float elapsedTime)	override;	// handle input & update game entities
 	virtual void	Render(float elapsedTime)	override;	// render game entities / menus
 
+	virtual void	GetAssets(AssetManifest& assets) const	override;	// files loaded by Enter
+
 
 	//World Accessors
 	SGD::Size GetWorldSize() { return m_szWorldSize; }
@@ -54,6 +60,8 @@ public:
 	// Entity
 	Entity* GetPlayer() { return m_pPlayer; }
 	Entity* GetPuff() { return m_pPuff; }
+	EntityManager* GetEntityManager() { return m_pEntities; }
+	AnimationSystem* GetAnimations() { return &m_Animations; }
 
 
 private:
@@ -77,22 +85,28 @@ private:
 	// Game Assets:
 	SGD::HTexture	m_hBackgroundImg = SGD::INVALID_HANDLE;
 
-	SGD::HTexture	m_hBackgroundImg_Front = SGD::INVALID_HANDLE;
-	SGD::HTexture	m_hBackgroundImg_Middle = SGD::INVALID_HANDLE;
-	SGD::HTexture	m_hBackgroundImg_Back = SGD::INVALID_HANDLE;
-
-
 	SGD::HTexture	m_hPlayerImg = SGD::INVALID_HANDLE;
 	SGD::HTexture	m_hPuffImg = SGD::INVALID_HANDLE;
 	SGD::HTexture	m_hBulletTypeA = SGD::INVALID_HANDLE;
 	
 	SGD::HAudio		m_hBackgroundMus = SGD::INVALID_HANDLE;
+
+	// Asynchronous loads of the assets above (the state waits in a
+	// loading screen until they complete)
+	SGD::LoadBatch	m_Loading;
+
+	// Tiled background layers, streamed around the camera
+	ParallaxBackground	m_Background;
 	
 	//*****************************************************************//
 	// Game Entities
 	EntityManager*	m_pEntities			= nullptr;
 	Entity*			m_pPlayer = nullptr;
 	Entity*			m_pPuff = nullptr;
+	BulletSystem*	m_pBullets = nullptr;
+
+	// Every entity's animation cursor
+	AnimationSystem	m_Animations;
 
 	
 	//*******************************************************************
@@ -100,7 +114,7 @@ private:
 
 	Entity* CreatePlayer() const;
 	Entity* CreatePuff() const;
-	Entity* CreateBullet(float posX, float posY, float rotation, EntityBucket _entityBucket) const;
+	unsigned int CreateBullet(float posX, float posY, float rotation, EntityBucket _entityBucket) const;
 
 	//*****************************************************************//
 	// Message Callback Procedure
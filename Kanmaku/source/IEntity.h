@@ -9,13 +9,27 @@
 #pragma once
 
 #include "../SGD Wrappers/SGD_Geometry.h"	// Rectangle type
+#include "../SGD Wrappers/SGD_Handle.h"		// Handle type
+
+
+//*********************************************************************//
+// EntityHandle
+//	- generational slot handle given by the Entity Manager
+//	- stale handles (entity removed, slot reused) are rejected
+typedef SGD::SGD_IMPLEMENTATION::Handle		EntityHandle;
 
 
 //*********************************************************************//
 // IEntity class
 //	- interface base class:
 //		- virtual methods for children classes to override
-//		- no data members
+//		- the only data members are the ones the Entity Manager
+//		  reaches through an IEntity* (it stores no Entity):
+//			- m_fDepth: the render list's sort key
+//			- m_pDepthDirty: the render list's flag, so SetDepth marks
+//			  the list for sorting without a search
+//			- m_hEntity: the entity's slot handle, so removing it or
+//			  checking a handle does not search the buckets
 class IEntity
 {
 public:
@@ -38,11 +52,20 @@ public:
 	virtual void	Release			( void )					= 0;
 
 	// Z-Sorting interface
+	//	- a new depth marks the Entity Manager's render list for sorting
+	//	  (so SetDepth is not safe in a parallel Update)
 	float GetDepth() const { return m_fDepth; }
-	void SetDepth(float _fDepth) { m_fDepth = _fDepth; }
+	void SetDepth(float _fDepth) { if (_fDepth != m_fDepth) { m_fDepth = _fDepth; if (m_pDepthDirty != nullptr) *m_pDepthDirty = true; } }
+
+	// Entity Manager slot (INVALID_HANDLE when not stored)
+	EntityHandle GetEntityHandle() const { return m_hEntity; }
 
 private:
 	float			m_fDepth = 0.0f;	// Z-Sorting
+	EntityHandle	m_hEntity;			// set by the Entity Manager
+	bool*			m_pDepthDirty = nullptr;	// the Entity Manager's render list flag
+
+	friend class EntityManager;
 
 
 protected:
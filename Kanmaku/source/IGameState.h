@@ -10,6 +10,11 @@
 
 #define SCREEN_OFFSET 256
 
+
+//*********************************************************************//
+// Forward class declaration
+struct AssetManifest;
+
 //*********************************************************************//
 // IGameState class
 //	- abstract base class!
@@ -24,6 +29,10 @@ public:
 
 	virtual bool	Update	( float elapsedTime )	= 0;	// handle input & update entities
 	virtual void	Render	( float elapsedTime )	= 0;	// render menu / entities
+
+	// List the files Enter loads, so the AssetResidency can keep
+	// them loaded across a state change (#include "AssetResidency.h")
+	virtual void	GetAssets	( AssetManifest& assets ) const		{	(void)assets;	}	// unused parameter
 	
 protected:
 	//*****************************************************************//
@@ -0,0 +1,215 @@
+//*********************************************************************//
+//	File:		JobPool.cpp
+//	Author:		
+//	Course:		
+//	Purpose:	JobPool class runs data-parallel loops on a small set
+//				of work-stealing worker threads
+//*********************************************************************//
+
+#include "JobPool.h"
+
+#include "../SGD Wrappers/SGD_Utilities.h"
+
+
+//*********************************************************************//
+// Upper limit on AUTO_WORKERS, beyond which the game's loops
+// are too short to gain anything
+#define JOBPOOL_MAX_AUTO_WORKERS	7
+
+
+//*********************************************************************//
+// Destructor
+//	- stop the workers if Terminate was not called
+JobPool::~JobPool( void )
+{
+	Terminate();
+}
+
+
+//*********************************************************************//
+// Initialize
+//	- allocate the queues & start the worker threads
+void JobPool::Initialize( unsigned int numWorkers )
+{
+	// Validate the state
+	SGD_ASSERT( m_pQueues == nullptr,
+				"JobPool::Initialize - pool is already initialized" );
+	if( m_pQueues != nullptr )
+		return;
+
+
+	if( numWorkers == (unsigned int)AUTO_WORKERS )
+	{
+		unsigned int hardware = std::thread::hardware_concurrency();
+		numWorkers = (hardware > 1) ? hardware - 1 : 0;
+
+		if( numWorkers > JOBPOOL_MAX_AUTO_WORKERS )
+			numWorkers = JOBPOOL_MAX_AUTO_WORKERS;
+	}
+
+
+	m_unNumQueues	= numWorkers + 1;
+	m_pQueues		= new JobQueue[ m_unNumQueues ];
+	m_unQueued		= 0;
+	m_bShutdown		= false;
+
+	m_vWorkers.reserve( numWorkers );
+	for( unsigned int i = 1; i <= numWorkers; i++ )
+		m_vWorkers.push_back( std::thread( &JobPool::WorkerProc, this, i ) );
+}
+
+
+//*********************************************************************//
+// Terminate
+//	- wake & join the workers, then deallocate the queues
+void JobPool::Terminate( void )
+{
+	if( m_pQueues == nullptr )
+		return;
+
+	{
+		std::lock_guard< std::mutex > lock( m_mtxWake );
+		m_bShutdown = true;
+	}
+	m_cvWake.notify_all();
+
+	for( unsigned int i = 0; i < m_vWorkers.size(); i++ )
+		m_vWorkers[ i ].join();
+
+	m_vWorkers.clear();
+
+	delete[] m_pQueues;
+	m_pQueues		= nullptr;
+	m_unNumQueues	= 0;
+}
+
+
+//*********************************************************************//
+// ParallelFor
+//	- deal the chunks round-robin so each queue starts with an equal share
+//	- the calling thread drains its own queue, then steals until
+//	  every chunk (including the ones taken by workers) has finished
+void JobPool::ParallelFor( unsigned int count, unsigned int grain, RangeFunction pFunction, void* pData )
+{
+	// Validate the parameters
+	SGD_ASSERT( pFunction != nullptr,
+				"JobPool::ParallelFor - function cannot be null" );
+
+	if( count == 0 )
+		return;
+
+	if( grain == 0 )
+		grain = 1;
+
+
+	// Not worth splitting?
+	if( m_unNumQueues <= 1 || count <= grain )
+	{
+		pFunction( pData, 0, count );
+		return;
+	}
+
+
+	unsigned int numChunks = (count + grain - 1) / grain;
+	std::atomic< unsigned int > remaining( numChunks );
+
+	// Count the jobs before queuing them, so the count never drops below
+	// zero (a worker woken early just polls until the jobs show up)
+	{
+		std::lock_guard< std::mutex > lock( m_mtxWake );
+		m_unQueued += numChunks;
+	}
+
+	for( unsigned int c = 0; c < numChunks; c++ )
+	{
+		Job job;
+		job.pFunction	= pFunction;
+		job.pData		= pData;
+		job.unFirst		= c * grain;
+		job.unLast		= (c == numChunks - 1) ? count : job.unFirst + grain;
+		job.pRemaining	= &remaining;
+
+		JobQueue& queue = m_pQueues[ c % m_unNumQueues ];
+		std::lock_guard< std::mutex > lock( queue.mutex );
+		queue.jobs.push_back( job );
+	}
+	m_cvWake.notify_all();
+
+
+	// Help until the loop is done
+	Job job;
+	while( remaining.load() > 0 )
+	{
+		if( FindJob( 0, job ) == true )
+			RunJob( job );
+		else
+			std::this_thread::yield();		// the last chunks are running elsewhere
+	}
+}
+
+
+//*********************************************************************//
+// FindJob
+//	- pop the newest job of the thread's own queue (still in cache),
+//	  otherwise steal the oldest job of another queue
+bool JobPool::FindJob( unsigned int queue, Job& job )
+{
+	for( unsigned int i = 0; i < m_unNumQueues; i++ )
+	{
+		JobQueue& q = m_pQueues[ (queue + i) % m_unNumQueues ];
+
+		std::lock_guard< std::mutex > lock( q.mutex );
+		if( q.jobs.empty() == true )
+			continue;
+
+		if( i == 0 )
+		{
+			job = q.jobs.back();
+			q.jobs.pop_back();
+		}
+		else
+		{
+			job = q.jobs.front();
+			q.jobs.pop_front();
+		}
+
+		--m_unQueued;
+		return true;
+	}
+
+	return false;
+}
+
+
+//*********************************************************************//
+// RunJob
+//	- process the chunk & count it off
+void JobPool::RunJob( const Job& job )
+{
+	job.pFunction( job.pData, job.unFirst, job.unLast );
+	--(*job.pRemaining);
+}
+
+
+//*********************************************************************//
+// WorkerProc
+//	- sleep while every queue is empty
+void JobPool::WorkerProc( unsigned int queue )
+{
+	Job job;
+	for( ;; )
+	{
+		if( FindJob( queue, job ) == true )
+		{
+			RunJob( job );
+			continue;
+		}
+
+		std::unique_lock< std::mutex > lock( m_mtxWake );
+		while( m_bShutdown == false && m_unQueued.load() == 0 )
+			m_cvWake.wait( lock );
+
+		if( m_bShutdown == true )
+			return;
+	}
+}
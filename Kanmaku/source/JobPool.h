@@ -0,0 +1,116 @@
+//*********************************************************************//
+//	File:		JobPool.h
+//	Author:		
+//	Course:		
+//	Purpose:	JobPool class runs data-parallel loops on a small set
+//				of work-stealing worker threads
+//*********************************************************************//
+
+#pragma once
+
+#include <atomic>					// uses std::atomic
+#include <condition_variable>		// uses std::condition_variable
+#include <deque>					// uses std::deque
+#include <mutex>					// uses std::mutex
+#include <thread>					// uses std::thread
+#include <vector>					// uses std::vector
+
+
+//*********************************************************************//
+// JobPool class
+//	- ParallelFor splits an index range into chunks, deals them out to
+//	  one queue per thread, and the calling thread works too
+//	- an idle thread steals chunks from the front of another queue
+//	- ParallelFor returns once every chunk has run
+//	- only the thread that called Initialize may call ParallelFor
+//	  (no nested loops from inside a job)
+class JobPool
+{
+public:
+	//*****************************************************************//
+	// Range function: process the indices [first, last)
+	typedef void (*RangeFunction)( void* pData, unsigned int first, unsigned int last );
+
+
+	//*****************************************************************//
+	// Constructor & destructor
+	JobPool( void )		= default;
+	~JobPool( void );
+
+
+	//*****************************************************************//
+	// Setup & Cleanup
+	//	- 0 workers runs every loop on the calling thread
+	//	- AUTO_WORKERS starts one worker per extra hardware thread
+	enum { AUTO_WORKERS = 0xFFFFFFFF };
+
+	void			Initialize		( unsigned int numWorkers = AUTO_WORKERS );
+	void			Terminate		( void );
+
+	unsigned int	GetWorkerCount	( void ) const		{	return (unsigned int)m_vWorkers.size();	}
+	unsigned int	GetThreadCount	( void ) const		{	return GetWorkerCount() + 1;			}
+
+
+	//*****************************************************************//
+	// ParallelFor
+	//	- call pFunction on chunks of at most 'grain' indices
+	//	- the template version takes any functor / lambda with
+	//	  an operator()( unsigned int first, unsigned int last )
+	void			ParallelFor		( unsigned int count, unsigned int grain, RangeFunction pFunction, void* pData );
+
+	template< typename TFunction >
+	void			ParallelFor		( unsigned int count, unsigned int grain, TFunction& function )
+	{
+		ParallelFor( count, grain, &JobPool::InvokeRange< TFunction >, &function );
+	}
+
+private:
+	//*****************************************************************//
+	// Not a singleton, but still don't want the Trilogy-of-Evil
+	JobPool( const JobPool& )				= delete;
+	JobPool& operator= ( const JobPool& )	= delete;
+
+
+	//*****************************************************************//
+	// Job: one chunk of a ParallelFor
+	struct Job
+	{
+		RangeFunction				pFunction;
+		void*						pData;
+		unsigned int				unFirst;
+		unsigned int				unLast;
+		std::atomic< unsigned int >*	pRemaining;		// chunks left in the loop
+	};
+
+	// Per-thread queue: the owner pops the back, thieves take the front
+	struct JobQueue
+	{
+		std::mutex			mutex;
+		std::deque< Job >	jobs;
+	};
+
+
+	//*****************************************************************//
+	// Helper methods
+	template< typename TFunction >
+	static void		InvokeRange		( void* pData, unsigned int first, unsigned int last )
+	{
+		(*reinterpret_cast< TFunction* >( pData ))( first, last );
+	}
+
+	bool			FindJob			( unsigned int queue, Job& job );
+	void			RunJob			( const Job& job );
+	void			WorkerProc		( unsigned int queue );
+
+
+	//*****************************************************************//
+	// members:
+	std::vector< std::thread >		m_vWorkers;
+	JobQueue*						m_pQueues		= nullptr;	// [0] is the calling thread's
+	unsigned int					m_unNumQueues	= 0;
+
+	std::mutex						m_mtxWake;
+	std::condition_variable			m_cvWake;
+	std::atomic< unsigned int >		m_unQueued;					// jobs waiting in any queue
+	bool							m_bShutdown		= false;	// guarded by m_mtxWake
+};
@@ -17,9 +17,20 @@
 #include "GameplayState.h"
 #include "OptionMenuState.h"
 
+#include "AssetResidency.h"
+
 //debug
 #include <iostream>
 
+
+//*********************************************************************//
+// Asset files (loaded by Enter, listed by GetAssets)
+#define MAINMENU_BACKGROUND_IMG		L"resource/graphics/kc_BackgroundImg.png"
+#define MAINMENU_START_IMG			L"resource/graphics/kc_MenuStart.png"
+#define MAINMENU_OPTION_IMG			L"resource/graphics/kc_optionButton.png"
+#define MAINMENU_BACKGROUND_MUS		L"resource/audio/bgm/kc_menu_bgm.xwm"
+#define MAINMENU_SELECT_SE			L"resource/audio/se/kc_menu_select.wav"
+
 //*********************************************************************//
 // GetInstance
 //	- create & return THE singleton object
@@ -41,17 +52,22 @@
 	// (commented out to keep the last cursor position)
 	//m_nCursor = 0;
 
-	SGD::GraphicsManager*	pGraphics = SGD::GraphicsManager::GetInstance();
-	SGD::AudioManager*		pAudio = SGD::AudioManager::GetInstance();
+	// Load the assets asynchronously
+	//	- Render shows the loading screen until they complete
+	m_Loading.Clear();
 
-	m_hBackgroundImg = pGraphics->LoadTexture(L"resource/graphics/kc_BackgroundImg.png");
-	m_hStartImg = pGraphics->LoadTexture(L"resource/graphics/kc_MenuStart.png");
-	m_hOptionImg = pGraphics->LoadTexture(L"resource/graphics/kc_optionButton.png");
+	m_hBackgroundImg = m_Loading.LoadTexture(MAINMENU_BACKGROUND_IMG);
+	m_hStartImg = m_Loading.LoadTexture(MAINMENU_START_IMG);
+	m_hOptionImg = m_Loading.LoadTexture(MAINMENU_OPTION_IMG);
 	
 
-	m_hBackgroundMus = pAudio->LoadAudio(L"resource/audio/bgm/kc_menu_bgm.xwm");
+	m_hBackgroundMus = m_Loading.LoadAudio(MAINMENU_BACKGROUND_MUS);
+
+	m_hIntroMenuSe = m_Loading.LoadAudio(MAINMENU_SELECT_SE);
 
-	m_hIntroMenuSe = pAudio->LoadAudio(L"resource/audio/se/kc_menu_select.wav");
+	// Preload the game while the menu runs
+	// (START then finds its assets loaded)
+	Game::GetInstance()->GetResidency()->Prefetch(GameplayState::GetInstance());
 
 	// volumes setting
 		// In option menu
@@ -59,7 +75,7 @@
 	//pAudio->SetAudioVolume(m_hIntroMenuSe, 70);			// Laser shot sfx is at 70% volume
 
 	// play music
-	pAudio->PlayAudio(m_hBackgroundMus, true);
+	//	- Update starts it once the loads complete
 
 
 }
@@ -70,7 +86,9 @@
 //	- unload resources
 /*virtual*/ void MainMenuState::Exit( void )		/*override*/
 {
-	// Unload the resources
+	// Unload the resources (even those still loading)
+	m_Loading.Clear();
+
 	SGD::GraphicsManager*	pGraphics = SGD::GraphicsManager::GetInstance();
 	SGD::AudioManager*		pAudio = SGD::AudioManager::GetInstance();
 
@@ -89,12 +107,37 @@
 }
 
 
+//*********************************************************************//
+// GetAssets
+//	- list the files Enter loads
+/*virtual*/ void MainMenuState::GetAssets( AssetManifest& assets ) const	/*override*/
+{
+	assets.vTextures.push_back(MAINMENU_BACKGROUND_IMG);
+	assets.vTextures.push_back(MAINMENU_START_IMG);
+	assets.vTextures.push_back(MAINMENU_OPTION_IMG);
+
+	assets.vAudio.push_back(MAINMENU_BACKGROUND_MUS);
+	assets.vAudio.push_back(MAINMENU_SELECT_SE);
+}
+
+
 //*********************************************************************//
 // Update
 //	- called EVERY FRAME
 //	- handle input & update
 /*virtual*/ bool MainMenuState::Update( float elapsedTime )	/*override*/
 {
+	// Wait in the loading screen until the assets are loaded,
+	// then start the music (unless it kept playing from the last menu)
+	if( m_Loading.IsComplete() == false )
+	{
+		if( m_Loading.Update() == false )
+			return true;	// keep playing
+
+		if( SGD::AudioManager::GetInstance()->IsAudioPlaying(m_hBackgroundMus) == false )
+			SGD::AudioManager::GetInstance()->PlayAudio(m_hBackgroundMus, true);
+	}
+
 	SGD::InputManager* pInput = SGD::InputManager::GetInstance();
 
 	SGD::Vector vAcceleration = { 0, -1 };	// up
@@ -205,6 +248,13 @@
 //	- draw menus / entities
 /*virtual*/ void MainMenuState::Render( float elapsedTime )		/*override*/
 {
+	// Show the progress while the assets are loading
+	if( m_Loading.IsComplete() == false )
+	{
+		Game::GetInstance()->RenderLoading( m_Loading.GetProgress() );
+		return;
+	}
+
 	SGD::InputManager* pInput = SGD::InputManager::GetInstance();
 
 
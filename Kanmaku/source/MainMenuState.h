@@ -9,6 +9,7 @@
 
 #include "IGameState.h"
 #include "../SGD Wrappers/SGD_Handle.h"
+#include "../SGD Wrappers/SGD_LoadBatch.h"
 
 
 //*********************************************************************//
@@ -31,6 +32,8 @@ public:
 	virtual bool Update	( float elapsedTime )	override;	// handle input / update entities
 	virtual void Render	( float elapsedTime )	override;	// draw entities / menu
 
+	virtual void GetAssets	( AssetManifest& assets ) const	override;	// files loaded by Enter
+
 private:
 	//*****************************************************************//
 	// SINGLETON (not-dynamically allocated)
@@ -54,6 +57,10 @@ private:
 	// introducing se
 	SGD::HAudio		m_hIntroMenuSe = SGD::INVALID_HANDLE;
 
+	// Asynchronous loads of the assets above (the music starts
+	// once they complete)
+	SGD::LoadBatch	m_Loading;
+
 	//*****************************************************************//
 	// cursor index / position
 	int m_nCursor = 0;
@@ -13,10 +13,20 @@
 #include "BitmapFont.h"
 #include "GameplayState.h"
 #include "MainMenuState.h"
+#include "AssetResidency.h"
+#include "TextBuilder.h"
 
 #include <string>
 
 
+//*********************************************************************//
+// Asset files (loaded by Enter, listed by GetAssets)
+#define OPTION_BACKGROUND_IMG		L"resource/graphics/kc_OptionBGImg.png"
+#define OPTION_ARROW_IMG			L"resource/graphics/kc_optionArrow.png"
+#define OPTION_BACKGROUND_MUS		L"resource/audio/bgm/kc_menu_bgm.xwm"
+#define OPTION_SELECT_SE			L"resource/audio/se/kc_menu_select.wav"
+
+
 //*********************************************************************//
 // GetInstance
 //	- create & return THE singleton object
@@ -37,16 +47,17 @@
 	// (commented out to keep the last cursor position)
 	//m_nCursor = 0;
 
-	SGD::GraphicsManager*	pGraphics = SGD::GraphicsManager::GetInstance();
-	SGD::AudioManager*		pAudio = SGD::AudioManager::GetInstance();
+	// Load the assets asynchronously
+	//	- Render shows the loading screen until they complete
+	m_Loading.Clear();
 
-	m_hBackgroundImg = pGraphics->LoadTexture(L"resource/graphics/kc_OptionBGImg.png");
-	m_hArrowImg = pGraphics->LoadTexture(L"resource/graphics/kc_optionArrow.png");
+	m_hBackgroundImg = m_Loading.LoadTexture(OPTION_BACKGROUND_IMG);
+	m_hArrowImg = m_Loading.LoadTexture(OPTION_ARROW_IMG);
 
 
-	m_hBackgroundMus = pAudio->LoadAudio(L"resource/audio/bgm/kc_menu_bgm.xwm");
+	m_hBackgroundMus = m_Loading.LoadAudio(OPTION_BACKGROUND_MUS);
 
-	m_hIntroMenuSe = pAudio->LoadAudio(L"resource/audio/se/kc_menu_select.wav");
+	m_hIntroMenuSe = m_Loading.LoadAudio(OPTION_SELECT_SE);
 
 	// volumes setting
 
@@ -54,7 +65,7 @@
 	//pAudio->SetAudioVolume(m_hIntroMenuSe, 70);			// Laser shot sfx is at 70% volume
 
 	// play music
-	pAudio->PlayAudio(m_hBackgroundMus, true);
+	//	- Update starts it once the loads complete
 
 
 }
@@ -65,7 +76,9 @@
 //	- unload resources
 /*virtual*/ void OptionMenuState::Exit(void)		/*override*/
 {
-	// Unload the resources
+	// Unload the resources (even those still loading)
+	m_Loading.Clear();
+
 	SGD::GraphicsManager*	pGraphics = SGD::GraphicsManager::GetInstance();
 	SGD::AudioManager*		pAudio = SGD::AudioManager::GetInstance();
 
@@ -83,12 +96,36 @@
 }
 
 
+//*********************************************************************//
+// GetAssets
+//	- list the files Enter loads
+/*virtual*/ void OptionMenuState::GetAssets(AssetManifest& assets) const	/*override*/
+{
+	assets.vTextures.push_back(OPTION_BACKGROUND_IMG);
+	assets.vTextures.push_back(OPTION_ARROW_IMG);
+
+	assets.vAudio.push_back(OPTION_BACKGROUND_MUS);
+	assets.vAudio.push_back(OPTION_SELECT_SE);
+}
+
+
 //*********************************************************************//
 // Update
 //	- called EVERY FRAME
 //	- handle input & update
 /*virtual*/ bool OptionMenuState::Update(float elapsedTime)	/*override*/
 {
+	// Wait in the loading screen until the assets are loaded,
+	// then start the music (unless it kept playing from the last menu)
+	if( m_Loading.IsComplete() == false )
+	{
+		if( m_Loading.Update() == false )
+			return true;	// keep playing
+
+		if( SGD::AudioManager::GetInstance()->IsAudioPlaying(m_hBackgroundMus) == false )
+			SGD::AudioManager::GetInstance()->PlayAudio(m_hBackgroundMus, true);
+	}
+
 	SGD::InputManager* pInput = SGD::InputManager::GetInstance();
 	SGD::AudioManager* pAudio = SGD::AudioManager::GetInstance();
 
@@ -140,6 +177,13 @@
 //	- draw menus / entities
 /*virtual*/ void OptionMenuState::Render(float elapsedTime)		/*override*/
 {
+	// Show the progress while the assets are loading
+	if( m_Loading.IsComplete() == false )
+	{
+		Game::GetInstance()->RenderLoading( m_Loading.GetProgress() );
+		return;
+	}
+
 	SGD::InputManager* pInput = SGD::InputManager::GetInstance();
 
 
@@ -171,12 +215,14 @@
 	//pFont->Draw("Kantai Danmaku", { (width - (14 * 32 * 2.0f)) / 2, 80 },
 	//	2.0f, { 255, 255, 255 });
 	
-	std::string bgm_lv = std::to_string((int)((m_fVolumeBGM) / MAX_VOLUME * 100.0f));
-	std::string se_lv = std::to_string((int)((m_fVolumeSE) / MAX_VOLUME * 100.0f));
+	TextBuilder bgm_lv;
+	bgm_lv.Append((int)((m_fVolumeBGM) / MAX_VOLUME * 100.0f));
+	TextBuilder se_lv;
+	se_lv.Append((int)((m_fVolumeSE) / MAX_VOLUME * 100.0f));
 	
 	
-	pFont->Draw(bgm_lv.c_str(), SGD::Point{ 300, 580 - SCREEN_OFFSET }, 0.8f, SGD::Color{ 255, 255, 255 });
-	pFont->Draw(se_lv.c_str(), SGD::Point{ 300, 690 - SCREEN_OFFSET }, 0.8f, SGD::Color{ 255, 255, 255 });
+	pFont->Draw(bgm_lv.GetText(), SGD::Point{ 300, 580 - SCREEN_OFFSET }, 0.8f, SGD::Color{ 255, 255, 255 });
+	pFont->Draw(se_lv.GetText(), SGD::Point{ 300, 690 - SCREEN_OFFSET }, 0.8f, SGD::Color{ 255, 255, 255 });
 
 	//// Display the menu options centered at 1x scale
 	//pFont->Draw( "PLAY", { (width - (4 * 32))/2, 300 }, 
@@ -10,6 +10,7 @@
 #include "IGameState.h"
 #include "MainMenuState.h"
 #include "../SGD Wrappers/SGD_Handle.h"
+#include "../SGD Wrappers/SGD_LoadBatch.h"
 
 #define MAX_VOLUME 300.0f
 
@@ -33,6 +34,8 @@ class OptionMenuState : public IGameState {
 		virtual bool Update(float elapsedTime)	override;	// handle input / update entities
 		virtual void Render(float elapsedTime)	override;	// draw entities / menu
 
+		virtual void GetAssets(AssetManifest& assets) const	override;	// files loaded by Enter
+
 	private:
 		//*****************************************************************//
 		// SINGLETON (not-dynamically allocated)
@@ -55,6 +58,10 @@ class OptionMenuState : public IGameState {
 		// introducing se
 		SGD::HAudio		m_hIntroMenuSe = SGD::INVALID_HANDLE;
 
+		// Asynchronous loads of the assets above (the music starts
+		// once they complete)
+		SGD::LoadBatch	m_Loading;
+
 		//*****************************************************************//
 		// cursor index / position
 		int m_nCursor = 0;
@@ -0,0 +1,323 @@
+//*********************************************************************//
+//	File:		ParallaxBackground.cpp
+//	Author:		
+//	Course:		
+//	Purpose:	ParallaxBackground class draws tiled background layers
+//				scrolling with the camera & streams their tiles from
+//				disk under a memory budget
+//*********************************************************************//
+
+#define _CRT_SECURE_NO_WARNINGS		// uses _wfopen
+
+#include "ParallaxBackground.h"
+
+#include "../SGD Wrappers/SGD_GraphicsManager.h"
+
+#include "Game.h"
+#include "FrameArena.h"
+
+#include <cstdio>
+#include <cmath>
+#include <cwchar>
+
+
+//*********************************************************************//
+// Destructor
+//	- the tiles must be unloaded while the GraphicsManager exists:
+//	  call Clear first
+ParallaxBackground::~ParallaxBackground( void )
+{
+}
+
+
+//*********************************************************************//
+// AddLayer
+//	- read the layer's tile index (no tile is loaded yet)
+bool ParallaxBackground::AddLayer( const wchar_t* indexFilename, float parallax )
+{
+	Layer layer;
+	layer.fParallax = parallax;
+
+#if defined( _WIN32 )
+	FILE* file = _wfopen( indexFilename, L"rb" );
+#else
+	// Narrow the name (the tile folders are ASCII)
+	std::string narrow( indexFilename, indexFilename + wcslen( indexFilename ) );
+	FILE* file = fopen( narrow.c_str(), "rb" );
+#endif
+	bool success = layer.index.Read( file );
+	if( file != nullptr )
+		fclose( file );
+
+	if( success == false )
+		return false;
+
+
+	// Tiles are named relative to the index's folder
+	layer.wsFolder = indexFilename;
+	size_t slash = layer.wsFolder.find_last_of( L"/\\" );
+	layer.wsFolder.resize( (slash == std::wstring::npos) ? 0 : slash + 1 );
+
+	layer.vTiles.resize( layer.index.unColumns * layer.index.unRows );
+
+	m_vLayers.push_back( layer );
+	return true;
+}
+
+
+//*********************************************************************//
+// Clear
+void ParallaxBackground::Clear( void )
+{
+	for( unsigned int l = 0; l < m_vLayers.size(); l++ )
+		for( unsigned int t = 0; t < m_vLayers[ l ].vTiles.size(); t++ )
+			EvictTile( l, t );
+
+	m_vLayers.clear();
+	m_unFrame	= 0;
+	m_Stats		= Stats();
+}
+
+
+//*********************************************************************//
+// GetLayerSize
+SGD::Size ParallaxBackground::GetLayerSize( unsigned int layer ) const
+{
+	if( layer >= m_vLayers.size() )
+		return SGD::Size{ 0, 0 };
+
+	return SGD::Size{ (float)m_vLayers[ layer ].index.unWidth, (float)m_vLayers[ layer ].index.unHeight };
+}
+
+
+//*********************************************************************//
+// Update
+//	- load the tiles around the view, then evict the least
+//	  recently wanted ones down to the budget
+void ParallaxBackground::Update( SGD::Point camera, SGD::Size view )
+{
+	++m_unFrame;
+	m_Stats.unVisible = 0;
+
+
+	// Want every tile within the margin
+	for( unsigned int l = 0; l < m_vLayers.size(); l++ )
+	{
+		Layer& layer = m_vLayers[ l ];
+
+		Range range;
+		if( ComputeRange( layer, camera, view, m_fMargin, range ) == false )
+			continue;
+
+		for( unsigned int row = range.unFirstRow; row <= range.unLastRow; row++ )
+			for( unsigned int column = range.unFirstColumn; column <= range.unLastColumn; column++ )
+				if( layer.index.HasTile( column, row ) == true )
+					LoadTile( layer, column, row );
+
+
+		// Count the tiles in view
+		if( ComputeRange( layer, camera, view, 0.0f, range ) == false )
+			continue;
+
+		for( unsigned int row = range.unFirstRow; row <= range.unLastRow; row++ )
+			for( unsigned int column = range.unFirstColumn; column <= range.unLastColumn; column++ )
+				if( layer.index.HasTile( column, row ) == true )
+					m_Stats.unVisible++;
+	}
+
+
+	// Evict down to the budget
+	while( m_Stats.unResidentBytes > m_unBudget )
+		if( EvictOldest() == false )
+			break;	// every resident tile is wanted
+}
+
+
+//*********************************************************************//
+// Render
+//	- draw the loaded tiles in view, back layer first
+//	- a tile still loading leaves a hole for a frame or two
+void ParallaxBackground::Render( SGD::Point camera, SGD::Size view )
+{
+	SGD::GraphicsManager* pGraphics = SGD::GraphicsManager::GetInstance();
+	m_Stats.unDrawn = 0;
+
+	for( unsigned int l = 0; l < m_vLayers.size(); l++ )
+	{
+		const Layer& layer = m_vLayers[ l ];
+
+		Range range;
+		if( ComputeRange( layer, camera, view, 0.0f, range ) == false )
+			continue;
+
+		SGD::Point offset = { camera.x * layer.fParallax, camera.y * layer.fParallax };
+
+		for( unsigned int row = range.unFirstRow; row <= range.unLastRow; row++ )
+			for( unsigned int column = range.unFirstColumn; column <= range.unLastColumn; column++ )
+			{
+				const Tile& tile = layer.vTiles[ row * layer.index.unColumns + column ];
+				if( tile.hTexture == SGD::INVALID_HANDLE )
+					continue;
+
+				SGD::Point position = {
+					(float)(column * layer.index.unTileWidth) - offset.x,
+					(float)(row * layer.index.unTileHeight) - offset.y };
+
+				if( pGraphics->DrawTexture( tile.hTexture, position ) == true )
+					m_Stats.unDrawn++;
+			}
+	}
+}
+
+
+//*********************************************************************//
+// IsViewLoaded
+bool ParallaxBackground::IsViewLoaded( SGD::Point camera, SGD::Size view ) const
+{
+	SGD::GraphicsManager* pGraphics = SGD::GraphicsManager::GetInstance();
+
+	for( unsigned int l = 0; l < m_vLayers.size(); l++ )
+	{
+		const Layer& layer = m_vLayers[ l ];
+
+		Range range;
+		if( ComputeRange( layer, camera, view, 0.0f, range ) == false )
+			continue;
+
+		for( unsigned int row = range.unFirstRow; row <= range.unLastRow; row++ )
+			for( unsigned int column = range.unFirstColumn; column <= range.unLastColumn; column++ )
+			{
+				if( layer.index.HasTile( column, row ) == false )
+					continue;
+
+				const Tile& tile = layer.vTiles[ row * layer.index.unColumns + column ];
+				if( tile.hTexture == SGD::INVALID_HANDLE
+					|| pGraphics->GetTextureStatus( tile.hTexture ) == SGD::LoadStatus::Pending )
+					return false;
+			}
+	}
+
+	return true;
+}
+
+
+//*********************************************************************//
+// IsTileResident
+//	- loaded or loading
+bool ParallaxBackground::IsTileResident( unsigned int layer, unsigned int column, unsigned int row ) const
+{
+	if( layer >= m_vLayers.size()
+		|| column >= m_vLayers[ layer ].index.unColumns || row >= m_vLayers[ layer ].index.unRows )
+		return false;
+
+	const Layer& data = m_vLayers[ layer ];
+	return data.vTiles[ row * data.index.unColumns + column ].hTexture != SGD::INVALID_HANDLE;
+}
+
+
+//*********************************************************************//
+// ComputeRange
+//	- the tiles of the layer overlapping the view grown by the margin
+//	- false if none do
+bool ParallaxBackground::ComputeRange( const Layer& layer, SGD::Point camera, SGD::Size view, float margin, Range& range ) const
+{
+	// View in layer pixels, clipped to the layer
+	float left		= camera.x * layer.fParallax - margin;
+	float top		= camera.y * layer.fParallax - margin;
+	float right		= left + view.width  + 2 * margin;
+	float bottom	= top  + view.height + 2 * margin;
+
+	if( left < 0 )							left	= 0;
+	if( top < 0 )							top		= 0;
+	if( right > layer.index.unWidth )		right	= (float)layer.index.unWidth;
+	if( bottom > layer.index.unHeight )		bottom	= (float)layer.index.unHeight;
+
+	if( left >= right || top >= bottom )
+		return false;
+
+
+	// Overlapped tiles (the far edges are exclusive)
+	range.unFirstColumn	= (unsigned int)left / layer.index.unTileWidth;
+	range.unFirstRow	= (unsigned int)top  / layer.index.unTileHeight;
+	range.unLastColumn	= ((unsigned int)ceilf( right )  - 1) / layer.index.unTileWidth;
+	range.unLastRow		= ((unsigned int)ceilf( bottom ) - 1) / layer.index.unTileHeight;
+	return true;
+}
+
+
+//*********************************************************************//
+// LoadTile
+//	- start loading the tile if it is not resident & mark it wanted
+void ParallaxBackground::LoadTile( Layer& layer, unsigned int column, unsigned int row )
+{
+	Tile& tile = layer.vTiles[ row * layer.index.unColumns + column ];
+	tile.unLastWanted = m_unFrame;
+
+	if( tile.hTexture != SGD::INVALID_HANDLE )
+		return;
+
+	// Build the path in the frame arena
+	wchar_t suffix[ 32 ];
+	layer.index.GetTileSuffix( column, row, suffix, 32 );
+
+	FrameWString filename( Game::GetInstance()->GetFrameArena() );
+	filename.reserve( layer.wsFolder.size() + layer.index.wsPrefix.size() + 32 );
+	filename.append( layer.wsFolder.c_str() ).append( layer.index.wsPrefix.c_str() ).append( suffix );
+
+	tile.hTexture = SGD::GraphicsManager::GetInstance()->LoadTextureAsync( filename.c_str() );
+	if( tile.hTexture == SGD::INVALID_HANDLE )
+		return;
+
+	m_Stats.unLoads++;
+	m_Stats.unResident++;
+	m_Stats.unResidentBytes += layer.index.unTileWidth * layer.index.unTileHeight * 4;
+}
+
+
+//*********************************************************************//
+// EvictTile
+//	- unload the tile (a load in progress is discarded)
+void ParallaxBackground::EvictTile( unsigned int layer, unsigned int tile )
+{
+	Layer& data = m_vLayers[ layer ];
+	Tile& evicted = data.vTiles[ tile ];
+
+	if( evicted.hTexture == SGD::INVALID_HANDLE )
+		return;
+
+	SGD::GraphicsManager::GetInstance()->UnloadTexture( evicted.hTexture );
+
+	m_Stats.unEvictions++;
+	m_Stats.unResident--;
+	m_Stats.unResidentBytes -= data.index.unTileWidth * data.index.unTileHeight * 4;
+}
+
+
+//*********************************************************************//
+// EvictOldest
+//	- evict the resident tile wanted longest ago (not this frame)
+//	- false if there is none
+bool ParallaxBackground::EvictOldest( void )
+{
+	unsigned int oldestLayer	= 0;
+	unsigned int oldestTile		= 0;
+	unsigned int oldestFrame	= m_unFrame;
+
+	for( unsigned int l = 0; l < m_vLayers.size(); l++ )
+		for( unsigned int t = 0; t < m_vLayers[ l ].vTiles.size(); t++ )
+		{
+			const Tile& tile = m_vLayers[ l ].vTiles[ t ];
+			if( tile.hTexture != SGD::INVALID_HANDLE && tile.unLastWanted < oldestFrame )
+			{
+				oldestLayer	= l;
+				oldestTile	= t;
+				oldestFrame	= tile.unLastWanted;
+			}
+		}
+
+	if( oldestFrame == m_unFrame )
+		return false;
+
+	EvictTile( oldestLayer, oldestTile );
+	return true;
+}
@@ -0,0 +1,127 @@
+//*********************************************************************//
+//	File:		ParallaxBackground.h
+//	Author:		
+//	Course:		
+//	Purpose:	ParallaxBackground class draws tiled background layers
+//				scrolling with the camera & streams their tiles from
+//				disk under a memory budget
+//*********************************************************************//
+
+#pragma once
+
+#include "../SGD Wrappers/SGD_Geometry.h"			// uses Point & Size
+#include "../SGD Wrappers/SGD_Handle.h"			// uses HTexture
+#include "../SGD Wrappers/SGD_TextureAtlas.h"		// uses TileLayerIndex
+#include <string>									// uses std::wstring
+#include <vector>									// uses std::vector
+
+
+//*********************************************************************//
+// Defaults
+#define PARALLAX_DEFAULT_BUDGET		(16 * 1024 * 1024)	// bytes of resident tiles
+#define PARALLAX_DEFAULT_MARGIN		128.0f				// pixels loaded around the view
+
+
+//*********************************************************************//
+// ParallaxBackground class
+//	- each layer is a grid of tiles cut by the TileSlicer tool, drawn
+//	  at (camera * parallax), so 0.5 scrolls at half the camera speed
+//	- layers are drawn in the order they were added (back to front)
+//	- Update loads the tiles within the margin around the view
+//	  asynchronously, then evicts the least recently wanted tiles
+//	  until the resident tiles fit the budget (tiles wanted this
+//	  frame are never evicted, even over budget)
+//	- Render draws only the tiles in view that have loaded
+class ParallaxBackground
+{
+public:
+	//*****************************************************************//
+	// Streaming counters
+	//	- visible & drawn are of the last Update / Render,
+	//	  loads & evictions since the layers were added
+	struct Stats
+	{
+		unsigned int	unResident		= 0;	// tiles loaded or loading
+		unsigned int	unResidentBytes	= 0;
+		unsigned int	unVisible		= 0;	// tiles in view (with a file)
+		unsigned int	unDrawn			= 0;
+		unsigned int	unLoads			= 0;
+		unsigned int	unEvictions		= 0;
+	};
+
+
+	//*****************************************************************//
+	// Constructor & destructor
+	ParallaxBackground( void )	= default;
+	~ParallaxBackground( void );
+
+
+	//*****************************************************************//
+	// Layers:
+	bool			AddLayer		( const wchar_t* indexFilename, float parallax );
+	void			Clear			( void );		// unload every tile & remove the layers
+
+	unsigned int	GetLayerCount	( void ) const		{	return (unsigned int)m_vLayers.size();	}
+	SGD::Size		GetLayerSize	( unsigned int layer ) const;
+
+
+	//*****************************************************************//
+	// Streaming:
+	void			SetBudget		( unsigned int bytes )		{	m_unBudget = bytes;		}
+	void			SetMargin		( float pixels )			{	m_fMargin = pixels;		}
+
+	void			Update			( SGD::Point camera, SGD::Size view );
+	void			Render			( SGD::Point camera, SGD::Size view );
+
+	bool			IsViewLoaded	( SGD::Point camera, SGD::Size view ) const;	// every tile in view has loaded
+	bool			IsTileResident	( unsigned int layer, unsigned int column, unsigned int row ) const;
+	const Stats&	GetStats		( void ) const		{	return m_Stats;		}
+
+
+private:
+	//*****************************************************************//
+	// Not a singleton, but still don't want the Trilogy-of-Evil
+	ParallaxBackground( const ParallaxBackground& )				= delete;
+	ParallaxBackground& operator= ( const ParallaxBackground& )	= delete;
+
+
+	//*****************************************************************//
+	// Tile & Layer
+	struct Tile
+	{
+		SGD::HTexture		hTexture;					// INVALID_HANDLE when not resident
+		unsigned int		unLastWanted	= 0;		// Update frame
+	};
+
+	struct Layer
+	{
+		SGD::TileLayerIndex	index;
+		std::wstring		wsFolder;					// of the index, for the tile names
+		float				fParallax;
+		std::vector< Tile >	vTiles;						// row by row
+	};
+
+	// Tile range of a layer [first, last] (empty if first > last)
+	struct Range
+	{
+		unsigned int	unFirstColumn, unLastColumn;
+		unsigned int	unFirstRow, unLastRow;
+	};
+
+
+	//*****************************************************************//
+	// Helper Methods
+	bool			ComputeRange	( const Layer& layer, SGD::Point camera, SGD::Size view, float margin, Range& range ) const;
+	void			LoadTile		( Layer& layer, unsigned int column, unsigned int row );
+	void			EvictTile		( unsigned int layer, unsigned int tile );
+	bool			EvictOldest		( void );
+
+
+	//*****************************************************************//
+	// Data
+	std::vector< Layer >	m_vLayers;
+	unsigned int			m_unBudget		= PARALLAX_DEFAULT_BUDGET;
+	float					m_fMargin		= PARALLAX_DEFAULT_MARGIN;
+	unsigned int			m_unFrame		= 0;		// Update count
+	Stats					m_Stats;
+};
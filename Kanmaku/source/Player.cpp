@@ -8,6 +8,7 @@
 #include "Player.h"
 #include "Puff.h"
 #include "GameplayState.h"
+#include "Game.h"
 #include "../SGD Wrappers/SGD_InputManager.h"
 #include "../SGD Wrappers/SGD_AudioManager.h"
 #include "../SGD Wrappers/SGD_IListener.h"
@@ -16,16 +17,13 @@
 
 #include "CreateBulletMessage.h"
 
-#include "AnchorPointAnimation.h"
+#include "AnimationLibrary.h"
 
 #if _DEBUG
 #include <iostream>
 #endif
 
 
-#define FRAME 1.0f / 60.0f
-
-
 Player::Player(void) : 
 	m_fSpeed(0.0f),
 	m_fAccelerationRate(512.0f),
@@ -34,25 +32,25 @@ Player::Player(void) :
 	m_fWallOffset(192.0f) {
 
 
-	m_pCharaterAnim = new AnchorPointAnimation();
-	m_pCharaterAnim->InitialPlayer();
-	m_pCharaterAnim->Restart(true, 1.0f);
+	// The frames & image are shared through the animation library,
+	// the cursor is advanced with every other one by the animation system
+	AnimationSystem* pAnimations = GameplayState::GetInstance()->GetAnimations();
+	m_unCharaterAnim = pAnimations->Create(Game::GetInstance()->GetAnimations()->FindClip("player_run"));
+	pAnimations->Restart(m_unCharaterAnim, true, 1.0f);
 
 }
 
 Player::~Player(void) {
 
-	if (m_pCharaterAnim != nullptr) {
-		m_pCharaterAnim->Terminate();
-		delete m_pCharaterAnim;
-		m_pCharaterAnim = nullptr;
-	}
+	GameplayState::GetInstance()->GetAnimations()->Destroy(m_unCharaterAnim);
 }
 
 
-// to-do change the struture;
-
-void Player::Update(float elapsedTime) {
+// Input
+//	- read the input once per rendered frame
+//	- presses are latched until a simulation step consumes them,
+//	  so none are lost or repeated whatever the step count
+void Player::Input(void) {
 
 	SGD::InputManager *ptInput = SGD::InputManager::GetInstance();
 
@@ -60,9 +58,24 @@ void Player::Update(float elapsedTime) {
 		m_bPendingJump = true;
 	}
 
+	if (ptInput->IsKeyPressed(SGD::Key::MouseLeft)) {
+		m_bPendingShot = true;
+	}
+
+	m_bMoveLeft = ptInput->IsKeyDown(SGD::Key::A);
+	m_bMoveRight = ptInput->IsKeyDown(SGD::Key::D);
+}
+
+
+// Update
+//	- one fixed simulation step (Game runs the steps)
+void Player::Update(float elapsedTime) {
+
 	Puff* ptPuff = dynamic_cast<Puff*>(GameplayState::GetInstance()->GetPuff());
 
-	if (ptInput->IsKeyPressed(SGD::Key::MouseLeft)) {
+	if (m_bPendingShot) {
+		m_bPendingShot = false;
+
 		// Allocate a CreateLaserMessage
 
 		CreateBulletMessage* pMsg = new CreateBulletMessage(
@@ -79,23 +92,7 @@ void Player::Update(float elapsedTime) {
 		pMsg = nullptr;
 	}
 
-	//=============================================================
-	// independent phycis timer/buffer
-	//////////////////////////////////////////////////////////////
-	m_fAccumulatedTime += elapsedTime;
-
-	if (m_fAccumulatedTime < FRAME) return;
-
-	elapsedTime = FRAME;
-
-	while (m_fAccumulatedTime >= FRAME) {
-		m_fAccumulatedTime -= FRAME;
-	}
-	//=============================================================
-	// independent phycis timer/buffer
-	//////////////////////////////////////////////////////////////
-
-	if (ptInput->IsKeyDown(SGD::Key::A)) {
+	if (m_bMoveLeft) {
 		m_bIsFlipped = true;
 
 		if (m_fSpeed < m_fMaxSpeed) {
@@ -104,7 +101,7 @@ void Player::Update(float elapsedTime) {
 		
 	} 
 
-	if (ptInput->IsKeyDown(SGD::Key::D)) {
+	if (m_bMoveRight) {
 		m_bIsFlipped = false;
 
 		if (m_fSpeed > -m_fMaxSpeed) {
@@ -113,7 +110,7 @@ void Player::Update(float elapsedTime) {
 		
 	} 
 	//	left and right control
-	if (!(ptInput->IsKeyDown(SGD::Key::D) || ptInput->IsKeyDown(SGD::Key::A))) {
+	if (!(m_bMoveRight || m_bMoveLeft)) {
 
 		if (m_ptPosition.y + m_szSize.height / 2 == GameplayState::GetInstance()->GetWorldSize().height - m_fGroundOffset) {
 			if (m_fSpeed > 0) {
@@ -142,44 +139,44 @@ void Player::Update(float elapsedTime) {
 	m_vtVelocity.x = vtNewVelocity.x;
  	m_vtVelocity += m_vtGravity;
 
+	AnimationSystem* pAnimations = GameplayState::GetInstance()->GetAnimations();
+
 	if (m_fSpeed > 0) {
-		m_pCharaterAnim->Pause(false);
+		pAnimations->Pause(m_unCharaterAnim, false);
 	} else if (m_fSpeed < 0) {
-		m_pCharaterAnim->Pause(false);
+		pAnimations->Pause(m_unCharaterAnim, false);
 	} else {
-		m_pCharaterAnim->Pause(true);
-		m_pCharaterAnim->Restart(true, 1.0f);
+		pAnimations->Pause(m_unCharaterAnim, true);
+		pAnimations->Restart(m_unCharaterAnim, true, 1.0f);
 	}
 
-	if (m_pCharaterAnim != nullptr) {
-		m_pCharaterAnim->Update(elapsedTime, m_bIsFlipped);
-		Entity::Update(elapsedTime);
-	}
+	// Facing left plays the frames reversed (advanced after the entities update)
+	pAnimations->SetReversed(m_unCharaterAnim, m_bIsFlipped);
+	Entity::Update(elapsedTime);
+
 	StayInWorld();
 }
 
 void Player::Render(void) {
 
-	if (m_pCharaterAnim != nullptr) {
+	// Validate the image
+	SGD_ASSERT(m_hImage != SGD::INVALID_HANDLE, "Entity::Render - image was not set!");
 
+	// Draw between the last two simulation steps
+	SGD::Point ptRender = GetRenderPosition();
 
-		// Validate the image
-		SGD_ASSERT(m_hImage != SGD::INVALID_HANDLE, "Entity::Render - image was not set!");
+	SGD::Point ptOffset = SGD::Point{ 
+		(ptRender /*- m_szSize / 2*/).x - GameplayState::GetInstance()->GetWorldCamPosition().x,
+		(ptRender /*- m_szSize / 2*/).y - GameplayState::GetInstance()->GetWorldCamPosition().y 
+	};
+	SGD::Rectangle rectOffset = SGD::Rectangle{ ptRender - m_szSize / 2, m_szSize };
+	rectOffset.Offset(-GameplayState::GetInstance()->GetWorldCamPosition().x, -GameplayState::GetInstance()->GetWorldCamPosition().y);
 
-		SGD::Point ptOffset = SGD::Point{ 
-			(m_ptPosition /*- m_szSize / 2*/).x - GameplayState::GetInstance()->GetWorldCamPosition().x,
-			(m_ptPosition /*- m_szSize / 2*/).y - GameplayState::GetInstance()->GetWorldCamPosition().y 
-		};
-		SGD::Rectangle rectOffset = GetRect();
-		rectOffset.Offset(-GameplayState::GetInstance()->GetWorldCamPosition().x, -GameplayState::GetInstance()->GetWorldCamPosition().y);
-
-		// Draw the image
-		SGD::GraphicsManager::GetInstance()->DrawRectangle(rectOffset, SGD::Color(255, 255, 0));
-		//SGD::GraphicsManager::GetInstance()->DrawTexture(m_hImage, ptOffset, m_fRotation, m_szSize / 2, SGD::Color{ 255, 255, 255 });
-		//SGD::GraphicsManager::GetInstance()->DrawTextureSection(m_hImage, ptOffset, {0.0f, 0.0f, 64.0f, 64.0f}, m_fRotation, m_szSize / 2, SGD::Color{ 255, 255, 255 });
-		m_pCharaterAnim->Render(ptOffset, m_bIsFlipped);
-
-	}
+	// Draw the image
+	SGD::GraphicsManager::GetInstance()->DrawRectangle(rectOffset, SGD::Color(255, 255, 0));
+	//SGD::GraphicsManager::GetInstance()->DrawTexture(m_hImage, ptOffset, m_fRotation, m_szSize / 2, SGD::Color{ 255, 255, 255 });
+	//SGD::GraphicsManager::GetInstance()->DrawTextureSection(m_hImage, ptOffset, {0.0f, 0.0f, 64.0f, 64.0f}, m_fRotation, m_szSize / 2, SGD::Color{ 255, 255, 255 });
+	GameplayState::GetInstance()->GetAnimations()->Render(m_unCharaterAnim, ptOffset, m_bIsFlipped);
 
 }
 
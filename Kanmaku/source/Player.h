@@ -9,8 +9,7 @@
 
 #include "Entity.h"
 #include "../SGD Wrappers/SGD_IListener.h"
-
-class AnchorPointAnimation;
+#include "AnimationSystem.h"
 
 //***********************************************************************
 // Player class
@@ -28,6 +27,9 @@ class Player : public Entity, public SGD::IListener {
 		virtual void	Update(float elapsedTime) override;
 		virtual void	Render(void) override;
 
+		// Per-frame input (latched for the next simulation step)
+		void			Input(void);
+
 		virtual int		GetType(void)	const override { return ENT_PLAYER; }
 		virtual void	HandleCollision(const IEntity* pOther)	override;
 
@@ -65,10 +67,12 @@ class Player : public Entity, public SGD::IListener {
 		int m_nLives = 3;
 		int m_nSenka = 0;
 
-		float m_fAccumulatedTime = 0.0f;
 		bool m_bPendingJump = false;
+		bool m_bPendingShot = false;
+		bool m_bMoveLeft = false;
+		bool m_bMoveRight = false;
 
-		AnchorPointAnimation*	m_pCharaterAnim = nullptr;
+		unsigned int	m_unCharaterAnim = ANIMATION_INVALID_CURSOR;	// cursor of the GameplayState's AnimationSystem
 
 
 		// properties
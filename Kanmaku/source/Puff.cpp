@@ -27,6 +27,8 @@ Puff::~Puff(void) {
 
 
 void Puff::Update(float elapsedTime) {
+	StorePreviousPosition();
+
 	m_unPlusTime += elapsedTime * 2;
 	SGD::Point newPosition;
 
@@ -49,11 +51,14 @@ void Puff::Render(void) {
 	// Validate the image
 	SGD_ASSERT(m_hImage != SGD::INVALID_HANDLE, "Entity::Render - image was not set!");
 
+	// Draw between the last two simulation steps
+	SGD::Point ptRender = GetRenderPosition();
+
 	SGD::Point ptOffset = SGD::Point{
-		(m_ptPosition - m_szSize / 2).x - GameplayState::GetInstance()->GetWorldCamPosition().x,
-		(m_ptPosition - m_szSize / 2).y - GameplayState::GetInstance()->GetWorldCamPosition().y
+		(ptRender - m_szSize / 2).x - GameplayState::GetInstance()->GetWorldCamPosition().x,
+		(ptRender - m_szSize / 2).y - GameplayState::GetInstance()->GetWorldCamPosition().y
 	};
-	SGD::Rectangle rectOffset = GetRect();
+	SGD::Rectangle rectOffset = SGD::Rectangle{ ptRender - m_szSize / 2, m_szSize };
 	rectOffset.Offset(-GameplayState::GetInstance()->GetWorldCamPosition().x, -GameplayState::GetInstance()->GetWorldCamPosition().y);
 
 	// Draw the image
@@ -0,0 +1,289 @@
+//*********************************************************************//
+//	File:		SpatialHash.cpp
+//	Author:		
+//	Course:		
+//	Purpose:	SpatialHash class buckets rectangles into a uniform grid
+//				to find overlapping pairs without testing every pair
+//*********************************************************************//
+
+#include "SpatialHash.h"
+
+#include "../SGD Wrappers/SGD_Utilities.h"
+#include <algorithm>
+#include <cmath>
+
+
+//*********************************************************************//
+// Cell coordinates are clamped so huge / infinite rectangles cannot
+// overflow the integer math (they simply pile into the border cells)
+#define SPATIALHASH_MAX_CELL	32767
+#define SPATIALHASH_MIN_BUCKETS	64
+
+// Most cells one rectangle is stored in (or one query visits),
+// beyond that it is oversized
+#define SPATIALHASH_MAX_CELLS	64
+
+
+//*********************************************************************//
+// Constructor
+SpatialHash::SpatialHash( float cellSize )
+{
+	SetCellSize( cellSize );
+}
+
+
+//*********************************************************************//
+// SetCellSize
+//	- takes effect on the next Build
+void SpatialHash::SetCellSize( float cellSize )
+{
+	// Validate the parameter
+	SGD_ASSERT( cellSize > 0.0f,
+				"SpatialHash::SetCellSize - cell size must be positive" );
+	if( cellSize <= 0.0f )
+		return;
+
+	m_fCellSize		= cellSize;
+	m_fInvCellSize	= 1.0f / cellSize;
+}
+
+
+//*********************************************************************//
+// Clear
+//	- empty the grid but keep the allocated storage
+void SpatialHash::Clear( void )
+{
+	m_vRects.clear();
+	m_vEntries.clear();
+	m_EntryRects.Clear();
+	m_vOversized.clear();
+	m_OversizedRects.Clear();
+	m_vBucketStart.clear();
+	m_unBucketMask = 0;
+}
+
+
+//*********************************************************************//
+// Build
+//	- counting sort of every (rectangle, cell) entry by hash bucket
+//	- empty rectangles are kept in the snapshot but never inserted,
+//	  since they cannot intersect anything
+//	- oversized rectangles skip the cells for the oversized list
+void SpatialHash::Build( const SGD::Rectangle* pRects, unsigned int count )
+{
+	// Validate the parameter
+	SGD_ASSERT( pRects != nullptr || count == 0,
+				"SpatialHash::Build - rectangles cannot be null" );
+
+	Clear();
+	if( count == 0 )
+		return;
+
+	m_vRects.assign( pRects, pRects + count );
+
+
+	// Size the bucket table to the next power of two above 2 buckets per rectangle
+	unsigned int numBuckets = SPATIALHASH_MIN_BUCKETS;
+	while( numBuckets < count * 2 )
+		numBuckets <<= 1;
+
+	m_unBucketMask = numBuckets - 1;
+	m_vBucketStart.assign( numBuckets + 1, 0 );
+
+
+	// Pass 1: count the entries per bucket
+	for( unsigned int i = 0; i < count; i++ )
+	{
+		const SGD::Rectangle& rect = m_vRects[ i ];
+		if( rect.IsEmpty() == true )
+			continue;
+
+		int x0 = ComputeCell( rect.left ),	x1 = ComputeCell( rect.right );
+		int y0 = ComputeCell( rect.top ),	y1 = ComputeCell( rect.bottom );
+
+		if( IsOversized( x0, y0, x1, y1 ) == true )
+		{
+			m_vOversized.push_back( i );
+			continue;
+		}
+
+		for( int y = y0; y <= y1; y++ )
+			for( int x = x0; x <= x1; x++ )
+				m_vBucketStart[ ComputeHash( x, y ) + 1 ]++;
+	}
+
+
+	// Prefix sum: bucket b owns the entries [start[b], start[b+1])
+	for( unsigned int b = 0; b < numBuckets; b++ )
+		m_vBucketStart[ b + 1 ] += m_vBucketStart[ b ];
+
+	m_vEntries.resize( m_vBucketStart[ numBuckets ] );
+	m_EntryRects.Resize( m_vBucketStart[ numBuckets ] );
+
+	m_OversizedRects.Resize( (unsigned int)m_vOversized.size() );
+	for( unsigned int o = 0; o < m_vOversized.size(); o++ )
+		m_OversizedRects.Set( o, m_vRects[ m_vOversized[ o ] ] );
+
+
+	// Pass 2: scatter the entries (one write cursor per bucket)
+	m_vCursor.assign( m_vBucketStart.begin(), m_vBucketStart.end() - 1 );
+
+	for( unsigned int i = 0; i < count; i++ )
+	{
+		const SGD::Rectangle& rect = m_vRects[ i ];
+		if( rect.IsEmpty() == true )
+			continue;
+
+		int x0 = ComputeCell( rect.left ),	x1 = ComputeCell( rect.right );
+		int y0 = ComputeCell( rect.top ),	y1 = ComputeCell( rect.bottom );
+
+		if( IsOversized( x0, y0, x1, y1 ) == true )
+			continue;
+
+		for( int y = y0; y <= y1; y++ )
+			for( int x = x0; x <= x1; x++ )
+			{
+				unsigned int e	= m_vCursor[ ComputeHash( x, y ) ]++;
+
+				Entry& entry	= m_vEntries[ e ];
+				entry.nCellX	= x;
+				entry.nCellY	= y;
+				entry.unIndex	= i;
+
+				m_EntryRects.Set( e, rect );
+			}
+	}
+}
+
+
+//*********************************************************************//
+// Query
+//	- each visited bucket is narrow-phase tested in one batch
+//	  (the hits vector doubles as scratch space for the batch)
+//	- a pair overlapping several shared cells is only reported from the
+//	  cell holding the top-left corner of the overlap, so no duplicate
+//	  tracking is needed (and the method stays const / thread-safe)
+//	- the oversized rectangles are tested as one more batch; an
+//	  oversized query tests every rectangle instead of the cells
+unsigned int SpatialHash::Query( const SGD::Rectangle& rect, std::vector< unsigned int >& hits ) const
+{
+	hits.clear();
+
+	// Nothing can intersect an empty rectangle
+	if( m_vRects.empty() == true || rect.IsEmpty() == true )
+		return 0;
+
+	int x0 = ComputeCell( rect.left ),	x1 = ComputeCell( rect.right );
+	int y0 = ComputeCell( rect.top ),	y1 = ComputeCell( rect.bottom );
+
+	// Too many cells to visit: test every rectangle (already in index order)
+	if( IsOversized( x0, y0, x1, y1 ) == true )
+	{
+		for( unsigned int i = 0; i < m_vRects.size(); i++ )
+			if( rect.IsIntersecting( m_vRects[ i ] ) == true )
+				hits.push_back( i );
+
+		return (unsigned int)m_vRects.size();
+	}
+
+
+	// The oversized rectangles (batch positions map to their indices)
+	unsigned int tests = (unsigned int)m_vOversized.size();
+
+	if( tests > 0 )
+	{
+		hits.resize( tests );
+		unsigned int found = m_OversizedRects.FindIntersections( rect, &hits[ 0 ] );
+
+		for( unsigned int h = 0; h < found; h++ )
+			hits[ h ] = m_vOversized[ hits[ h ] ];
+
+		hits.resize( found );
+	}
+
+
+	// The cells the rectangle covers
+	if( m_vEntries.empty() == true )
+		return tests;
+
+	for( int y = y0; y <= y1; y++ )
+		for( int x = x0; x <= x1; x++ )
+		{
+			unsigned int bucket	= ComputeHash( x, y );
+			unsigned int first	= m_vBucketStart[ bucket ];
+			unsigned int count	= m_vBucketStart[ bucket + 1 ] - first;
+
+			if( count == 0 )
+				continue;
+
+			// Narrow phase: entry positions of the hits go past the kept results
+			unsigned int kept = (unsigned int)hits.size();
+			hits.resize( kept + count );
+
+			tests += count;
+			unsigned int found = m_EntryRects.FindIntersections( rect, first, count, &hits[ kept ] );
+
+			unsigned int end = kept + found;
+			for( unsigned int h = kept; h < end; h++ )
+			{
+				const Entry& entry = m_vEntries[ hits[ h ] ];
+
+				// Another cell that hashed into the same bucket?
+				if( entry.nCellX != x || entry.nCellY != y )
+					continue;
+
+				// Report the pair only from the cell owning the overlap's top-left
+				const SGD::Rectangle& other = m_vRects[ entry.unIndex ];
+				float refX = (rect.left > other.left) ? rect.left : other.left;
+				float refY = (rect.top  > other.top)  ? rect.top  : other.top;
+
+				if( ComputeCell( refX ) == x && ComputeCell( refY ) == y )
+					hits[ kept++ ] = entry.unIndex;
+			}
+
+			hits.resize( kept );
+		}
+
+	// Match the index order of a brute-force loop
+	std::sort( hits.begin(), hits.end() );
+
+	return tests;
+}
+
+
+//*********************************************************************//
+// ComputeCell
+//	- convert a world coordinate into a clamped cell coordinate
+int SpatialHash::ComputeCell( float coord ) const
+{
+	float cell = std::floor( coord * m_fInvCellSize );
+
+	if( !(cell > -SPATIALHASH_MAX_CELL) )		// also catches NaN
+		return -SPATIALHASH_MAX_CELL;
+	if( cell > SPATIALHASH_MAX_CELL )
+		return SPATIALHASH_MAX_CELL;
+
+	return (int)cell;
+}
+
+
+//*********************************************************************//
+// IsOversized
+//	- does the cell range cover more than SPATIALHASH_MAX_CELLS cells?
+/*static*/ bool SpatialHash::IsOversized( int x0, int y0, int x1, int y1 )
+{
+	int width	= x1 - x0 + 1;
+	int height	= y1 - y0 + 1;
+
+	return width > SPATIALHASH_MAX_CELLS || height > SPATIALHASH_MAX_CELLS
+		|| width * height > SPATIALHASH_MAX_CELLS;
+}
+
+
+//*********************************************************************//
+// ComputeHash
+//	- spread the cell coordinates across the bucket table
+unsigned int SpatialHash::ComputeHash( int cellX, int cellY ) const
+{
+	return ( ((unsigned int)cellX * 73856093u) ^ ((unsigned int)cellY * 19349663u) ) & m_unBucketMask;
+}
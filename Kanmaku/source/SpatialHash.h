@@ -0,0 +1,93 @@
+//*********************************************************************//
+//	File:		SpatialHash.h
+//	Author:		
+//	Course:		
+//	Purpose:	SpatialHash class buckets rectangles into a uniform grid
+//				to find overlapping pairs without testing every pair
+//*********************************************************************//
+
+#pragma once
+
+#include "../SGD Wrappers/SGD_Geometry.h"			// uses Rectangle
+#include "../SGD Wrappers/SGD_RectangleBatch.h"	// uses RectangleBatch
+#include <vector>									// uses std::vector
+
+
+//*********************************************************************//
+// SpatialHash class
+//	- uniform grid of square cells, hashed into a fixed bucket table
+//	- rebuilt from a snapshot of rectangles (no incremental updates)
+//	- each rectangle is stored once per cell it covers, with a
+//	  SoA copy of its rect so a bucket is tested in one SIMD batch
+//	- a rectangle covering too many cells goes into an oversized list
+//	  instead, tested by every query (and an oversized query tests
+//	  every rectangle), so the cell loops stay bounded
+//	- queries report each overlapping rectangle exactly once,
+//	  in ascending index order
+class SpatialHash
+{
+public:
+	//*****************************************************************//
+	// Constructor & destructor
+	explicit SpatialHash( float cellSize = 64.0f );
+	~SpatialHash( void )	= default;
+
+
+	//*****************************************************************//
+	// Grid Setup:
+	void	SetCellSize	( float cellSize );
+	float	GetCellSize	( void ) const		{	return m_fCellSize;	}
+
+	void	Build		( const SGD::Rectangle* pRects, unsigned int count );
+	void	Clear		( void );
+
+	unsigned int	GetCount( void ) const	{	return (unsigned int)m_vRects.size();	}
+	const SGD::Rectangle& GetRect( unsigned int index ) const	{	return m_vRects[ index ];	}
+
+
+	//*****************************************************************//
+	// Query:
+	//	- fills the vector with the indices of the stored rectangles
+	//	  that intersect the given rectangle
+	//	- returns the number of narrow-phase tests performed
+	//	- const, so several threads may query the same grid
+	unsigned int	Query( const SGD::Rectangle& rect, std::vector< unsigned int >& hits ) const;
+
+private:
+	//*****************************************************************//
+	// Not a singleton, but still don't want the Trilogy-of-Evil
+	SpatialHash( const SpatialHash& )				= delete;
+	SpatialHash& operator= ( const SpatialHash& )	= delete;
+
+
+	//*****************************************************************//
+	// Cell entry: one per (rectangle, covered cell)
+	struct Entry
+	{
+		int				nCellX;		// cell coordinates stored to reject
+		int				nCellY;		// other cells sharing the hash bucket
+		unsigned int	unIndex;	// index into m_vRects
+	};
+
+
+	//*****************************************************************//
+	// Helper methods
+	int				ComputeCell	( float coord ) const;
+	unsigned int	ComputeHash	( int cellX, int cellY ) const;
+	static bool		IsOversized	( int x0, int y0, int x1, int y1 );
+
+
+	//*****************************************************************//
+	// members:
+	float							m_fCellSize		= 64.0f;
+	float							m_fInvCellSize	= 1.0f / 64.0f;
+	unsigned int					m_unBucketMask	= 0;
+
+	std::vector< SGD::Rectangle >	m_vRects;			// snapshot of the built rectangles
+	std::vector< unsigned int >		m_vBucketStart;		// prefix sums into m_vEntries (bucket count + 1)
+	std::vector< Entry >			m_vEntries;			// entries sorted by bucket
+	SGD::RectangleBatch				m_EntryRects;		// rect of each entry, same order
+	std::vector< unsigned int >		m_vOversized;		// indices of the rects kept out of the cells
+	SGD::RectangleBatch				m_OversizedRects;	// rect of each oversized index, same order
+	std::vector< unsigned int >		m_vCursor;			// scatter cursors (kept to reuse storage)
+};
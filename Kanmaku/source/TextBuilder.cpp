@@ -0,0 +1,88 @@
+//*********************************************************************//
+//	File:		TextBuilder.cpp
+//	Author:		
+//	Course:		
+//	Purpose:	TextBuilder class formats short text (HUD counters)
+//				into a fixed buffer without allocating
+//*********************************************************************//
+
+#include "TextBuilder.h"
+
+
+//*********************************************************************//
+// Clear
+TextBuilder& TextBuilder::Clear( void )
+{
+	m_unLength		= 0;
+	m_szText[ 0 ]	= '\0';
+	return *this;
+}
+
+
+//*********************************************************************//
+// Append
+//	- copy the string (null appends nothing)
+TextBuilder& TextBuilder::Append( const char* text )
+{
+	if( text == nullptr )
+		return *this;
+
+	while( *text != '\0' && m_unLength < TEXTBUILDER_CAPACITY - 1 )
+		m_szText[ m_unLength++ ] = *text++;
+
+	m_szText[ m_unLength ] = '\0';
+	return *this;
+}
+
+
+//*********************************************************************//
+// Append
+//	- decimal, with a '-' when negative
+TextBuilder& TextBuilder::Append( int value )
+{
+	if( value < 0 )
+	{
+		Append( "-" );
+
+		// Negate as unsigned (-INT_MIN does not fit in an int)
+		AppendDigits( 0u - (unsigned int)value );
+	}
+	else
+		AppendDigits( (unsigned int)value );
+
+	return *this;
+}
+
+
+//*********************************************************************//
+// Append
+//	- decimal
+TextBuilder& TextBuilder::Append( unsigned int value )
+{
+	AppendDigits( value );
+	return *this;
+}
+
+
+//*********************************************************************//
+// AppendDigits
+//	- write the digits backwards into a scratch array,
+//	  then copy them in order
+void TextBuilder::AppendDigits( unsigned int value )
+{
+	char digits[ 12 ];				// 4294967295 is 10 digits
+	unsigned int count = 0;
+
+	do
+	{
+		digits[ count++ ] = (char)( '0' + value % 10 );
+		value /= 10;
+	}
+	while( value != 0 );
+
+
+	while( count > 0 && m_unLength < TEXTBUILDER_CAPACITY - 1 )
+		m_szText[ m_unLength++ ] = digits[ --count ];
+
+	m_szText[ m_unLength ] = '\0';
+}
@@ -0,0 +1,52 @@
+//*********************************************************************//
+//	File:		TextBuilder.h
+//	Author:		
+//	Course:		
+//	Purpose:	TextBuilder class formats short text (HUD counters)
+//				into a fixed buffer without allocating
+//*********************************************************************//
+
+#pragma once
+
+
+//*********************************************************************//
+// Characters a TextBuilder holds (including the null terminator)
+#define TEXTBUILDER_CAPACITY		128
+
+
+//*********************************************************************//
+// TextBuilder class
+//	- appends strings & integers into its own array, so a HUD can be
+//	  rebuilt every frame without std::to_string or a string stream
+//	- text past the capacity is dropped (the text stays terminated)
+//	- Append returns the builder, so calls can be chained:
+//		text.Clear().Append( "Lives:" ).Append( lives );
+class TextBuilder
+{
+public:
+	//*****************************************************************//
+	// Constructor
+	TextBuilder( void )		{	Clear();	}
+
+
+	//*****************************************************************//
+	// Formatting
+	TextBuilder&	Clear	( void );
+	TextBuilder&	Append	( const char* text );
+	TextBuilder&	Append	( int value );
+	TextBuilder&	Append	( unsigned int value );
+
+	const char*		GetText		( void ) const	{	return m_szText;	}
+	unsigned int	GetLength	( void ) const	{	return m_unLength;	}
+
+private:
+	//*****************************************************************//
+	// Helper Methods
+	void			AppendDigits	( unsigned int value );
+
+
+	//*****************************************************************//
+	// Data
+	char			m_szText[ TEXTBUILDER_CAPACITY ];
+	unsigned int	m_unLength;
+};
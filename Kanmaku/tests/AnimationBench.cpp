@@ -0,0 +1,150 @@
+//*********************************************************************//
+//	File:		AnimationBench.cpp
+//	Author:		
+//	Course:		
+//	Purpose:	AnimationSystem::Update against per-object
+//				AnchorPointAnimation::Update, 100k cursors
+//*********************************************************************//
+
+#include "BenchSupport.h"
+#include "HeadlessGame.h"
+
+#include "../source/AnchorPointAnimation.h"
+#include "../source/AnimationLibrary.h"
+#include "../source/AnimationSystem.h"
+
+#include <vector>
+
+
+//*********************************************************************//
+// 100k cursors, 10 s of fixed steps
+#define BENCH_CURSORS		100000
+#define BENCH_TICKS			600
+#define BENCH_STEP			(1.0f / 60.0f)
+
+
+//*********************************************************************//
+// Case
+//	- the clip & speed of cursor i
+struct Case
+{
+	const char*		szName;
+	bool			bInterleaved;	// alternate the two clips (else only clip)
+	unsigned int	unClip;
+	bool			bStaggered;		// speeds 0.5 to 2 (else 1: every cursor steps together)
+};
+
+static unsigned int CursorClip( const Case& test, unsigned int i, const unsigned int* clips )
+{
+	return (test.bInterleaved == true) ? clips[ i % 2 ] : clips[ test.unClip ];
+}
+
+static float CursorSpeed( const Case& test, unsigned int i )
+{
+	return (test.bStaggered == true) ? 0.5f + (i % 7) * 0.25f : 1.0f;
+}
+
+
+//*********************************************************************//
+// RunCase
+//	- both paths play the same cursors; false if their frames differ
+static bool RunCase( const AnimationLibrary& library, const unsigned int* clips, const Case& test )
+{
+	std::vector< AnchorPointAnimation > objects( BENCH_CURSORS );
+
+	double oldMs = BenchMeasure(
+		[&]()
+		{
+			for( unsigned int i = 0; i < BENCH_CURSORS; i++ )
+			{
+				objects[ i ].Initialize( &library, CursorClip( test, i, clips ) );
+				objects[ i ].Restart( true, CursorSpeed( test, i ) );
+			}
+		},
+		[&]()
+		{
+			for( int tick = 0; tick < BENCH_TICKS; tick++ )
+				for( unsigned int i = 0; i < BENCH_CURSORS; i++ )
+					objects[ i ].Update( BENCH_STEP );
+		} );
+
+
+	AnimationSystem system;
+	std::vector< unsigned int > cursors( BENCH_CURSORS );
+
+	double newMs = BenchMeasure(
+		[&]()
+		{
+			system.Terminate();
+			system.Initialize( &library );
+
+			for( unsigned int i = 0; i < BENCH_CURSORS; i++ )
+			{
+				cursors[ i ] = system.Create( CursorClip( test, i, clips ) );
+				system.Restart( cursors[ i ], true, CursorSpeed( test, i ) );
+			}
+		},
+		[&]()
+		{
+			for( int tick = 0; tick < BENCH_TICKS; tick++ )
+				system.Update( BENCH_STEP );
+		} );
+
+	BenchReport( test.szName, oldMs, newMs );
+
+
+	// Same frame under every cursor
+	unsigned int wrong = 0;
+	for( unsigned int i = 0; i < BENCH_CURSORS; i++ )
+	{
+		SGD::Rectangle a = objects[ i ].GetRect( SGD::Point{ 0, 0 } );
+		SGD::Rectangle b = system.GetRect( cursors[ i ], SGD::Point{ 0, 0 } );
+
+		if( a.left != b.left || a.top != b.top || a.right != b.right || a.bottom != b.bottom )
+			wrong++;
+	}
+
+	if( wrong != 0 )
+		fprintf( stderr, "%s: %u cursors on another frame than AnchorPointAnimation\n", test.szName, wrong );
+
+	system.Terminate();
+	return wrong == 0;
+}
+
+
+//*********************************************************************//
+// main
+int main( void )
+{
+	Game* pGame = Game::GetInstance();
+	if( pGame->Initialize() == false )
+		return 1;
+
+	// The game's clips: player_run (mixed durations) & explosion (uniform)
+	AnimationLibrary library;
+	library.Load( "resource/animations.xml" );
+
+	unsigned int clips[ 2 ] = { library.FindClip( "player_run" ), library.FindClip( "explosion" ) };
+	if( clips[ 0 ] == ANIMATION_INVALID_CLIP || clips[ 1 ] == ANIMATION_INVALID_CLIP )
+		return 1;
+
+	const Case cases[] =
+	{
+		{ "uniform clip, lockstep",				false, 1, false },
+		{ "mixed clip, lockstep",				false, 0, false },
+		{ "both clips interleaved, lockstep",	true,  0, false },
+		{ "both clips interleaved, staggered",	true,  0, true  },
+	};
+
+	BenchHeader( "AnimationBench: 100k cursors, 600 ticks (AnchorPointAnimation / AnimationSystem)" );
+
+	bool same = true;
+	for( unsigned int c = 0; c < sizeof( cases ) / sizeof( cases[ 0 ] ); c++ )
+		same = RunCase( library, clips, cases[ c ] ) && same;
+
+	library.Unload();
+	pGame->Terminate();
+	Game::DeleteInstance();
+
+	return (same == true) ? 0 : 1;
+}
@@ -0,0 +1,181 @@
+//*********************************************************************//
+//	File:		AnimationSystemTest.cpp
+//	Author:		
+//	Course:		
+//	Purpose:	AnimationSystem plays like AnchorPointAnimation while
+//				cursors of both clips are created & destroyed
+//*********************************************************************//
+
+#include "TestSupport.h"
+#include "HeadlessGame.h"
+
+#include "../source/AnchorPointAnimation.h"
+#include "../source/AnimationLibrary.h"
+#include "../source/AnimationSystem.h"
+
+#include <cstdlib>
+#include <vector>
+
+
+//*********************************************************************//
+#define TEST_TICKS			1200
+#define TEST_STEP			(1.0f / 60.0f)
+#define TEST_MAX_CURSORS	300
+
+
+//*********************************************************************//
+// Pair
+//	- a cursor & the object playing the same clip
+struct Pair
+{
+	unsigned int			unCursor;
+	AnchorPointAnimation	Object;
+	bool					bReversed;
+};
+
+
+//*********************************************************************//
+// IsSameRect
+static bool IsSameRect( const SGD::Rectangle& a, const SGD::Rectangle& b )
+{
+	return a.left == b.left && a.top == b.top && a.right == b.right && a.bottom == b.bottom;
+}
+
+
+//*********************************************************************//
+// main
+int main( void )
+{
+	Game* pGame = Game::GetInstance();
+	CHECK( pGame->Initialize() == true );
+
+	AnimationLibrary library;
+	CHECK( library.Load( "resource/animations.xml" ) == true );
+	CHECK( library.GetClipCount() >= 2 );
+	if( library.GetClipCount() < 2 )
+		return TEST_RESULT();
+
+	AnimationSystem system;
+	system.Initialize( &library );
+
+	static const float speeds[] = { 1.0f, 2.5f, 0.5f };
+
+	std::vector< Pair > pairs;
+	pairs.reserve( TEST_MAX_CURSORS );
+
+	unsigned int	wrongFrames		= 0;
+	unsigned int	wrongStates		= 0;
+	unsigned int	wrongEvents		= 0;
+	unsigned int	finished		= 0;
+
+	srand( 2015 );
+
+	for( int tick = 0; tick < TEST_TICKS; tick++ )
+	{
+		// Create a few cursors, on either clip
+		int creates = rand() % 4;
+		for( int n = 0; n < creates && pairs.size() < TEST_MAX_CURSORS; n++ )
+		{
+			Pair pair;
+			unsigned int clip	= rand() % library.GetClipCount();
+			bool looping		= rand() % 3 == 0;
+			float speed			= speeds[ rand() % 3 ];
+			pair.bReversed		= rand() % 2 == 0;
+
+			pair.unCursor = system.Create( clip );
+			system.SetReversed( pair.unCursor, pair.bReversed );
+			system.Restart( pair.unCursor, looping, speed );
+
+			pair.Object.Initialize( &library, clip );
+			pair.Object.Restart( looping, speed );
+
+			pairs.push_back( pair );
+		}
+
+		// Destroy a few, anywhere in the arrays
+		int destroys = rand() % 3;
+		for( int n = 0; n < destroys && pairs.empty() == false; n++ )
+		{
+			unsigned int p = rand() % pairs.size();
+
+			system.Destroy( pairs[ p ].unCursor );
+			CHECK( pairs[ p ].unCursor == ANIMATION_INVALID_CURSOR );
+
+			pairs[ p ] = pairs.back();
+			pairs.pop_back();
+		}
+
+		CHECK( system.GetCount() == pairs.size() );
+
+
+		// Play both
+		std::vector< bool > wasFinished( pairs.size() );
+		for( unsigned int p = 0; p < pairs.size(); p++ )
+		{
+			wasFinished[ p ] = pairs[ p ].Object.IsFinished();
+			pairs[ p ].Object.Update( TEST_STEP, pairs[ p ].bReversed );
+		}
+
+		system.Update( TEST_STEP );
+
+
+		// Same frame & state; a finished event for each object that just finished
+		unsigned int expectedFinished = 0;
+		for( unsigned int p = 0; p < pairs.size(); p++ )
+		{
+			const Pair& pair = pairs[ p ];
+
+			if( IsSameRect( pair.Object.GetRect( SGD::Point{ 0, 0 }, pair.bReversed ),
+				system.GetRect( pair.unCursor, SGD::Point{ 0, 0 }, pair.bReversed ) ) == false )
+				wrongFrames++;
+
+			if( pair.Object.IsPlaying() != system.IsPlaying( pair.unCursor )
+				|| pair.Object.IsFinished() != system.IsFinished( pair.unCursor ) )
+				wrongStates++;
+
+			if( wasFinished[ p ] == false && pair.Object.IsFinished() == true )
+				expectedFinished++;
+		}
+
+		const std::vector< AnimationSystem::Event >& events = system.GetEvents();
+		unsigned int finishedEvents = 0;
+		for( unsigned int e = 0; e < events.size(); e++ )
+		{
+			if( events[ e ].eType == AnimationSystem::EVENT_FINISHED )
+			{
+				finishedEvents++;
+				if( system.IsFinished( events[ e ].unCursor ) == false )
+					wrongEvents++;
+			}
+			else if( system.IsPlaying( events[ e ].unCursor ) == false )
+				wrongEvents++;
+		}
+
+		if( finishedEvents != expectedFinished )
+			wrongEvents++;
+
+		finished += finishedEvents;
+	}
+
+	CHECK( wrongFrames == 0 );
+	CHECK( wrongStates == 0 );
+	CHECK( wrongEvents == 0 );
+
+	// The run really finished animations
+	CHECK( finished > 0 );
+
+
+	// Destroy the rest: nothing left
+	for( unsigned int p = 0; p < pairs.size(); p++ )
+		system.Destroy( pairs[ p ].unCursor );
+
+	CHECK( system.GetCount() == 0 );
+
+	system.Terminate();
+	library.Unload();
+
+	pGame->Terminate();
+	Game::DeleteInstance();
+
+	return TEST_RESULT();
+}
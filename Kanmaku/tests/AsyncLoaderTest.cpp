@@ -0,0 +1,352 @@
+//*********************************************************************//
+//	File:		AsyncLoaderTest.cpp
+//	Author:		
+//	Course:		
+//	Purpose:	AsyncLoader jobs & the headless asynchronous texture
+//				loads: LoadBatch progress, failed & unloaded loads,
+//				synchronous loads of pending files, Terminate
+//*********************************************************************//
+
+#include "TestSupport.h"
+#include "HeadlessGame.h"
+
+#include "../SGD Wrappers/SGD_AsyncLoader.h"
+#include "../SGD Wrappers/SGD_GraphicsManager.h"
+#include "../SGD Wrappers/SGD_LoadBatch.h"
+
+#include <atomic>
+#include <condition_variable>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+
+//*********************************************************************//
+// Frames a batch may take before the test calls it hung
+#define TEST_MAX_FRAMES		100000
+
+static const wchar_t* s_Files[] =
+{
+	L"resource/graphics/kc_BulletTypeA.png",
+	L"resource/graphics/DEBUG_Puff.png",
+	L"resource/graphics/DEBUG_PlayerEntity.png",
+	L"resource/graphics/kc_explosion.png",
+	L"resource/graphics/kc_MenuStart.png",
+	L"resource/graphics/kc_optionArrow.png",
+	L"resource/graphics/kc_optionButton.png",
+	L"resource/graphics/SGD_Anim_Explosion.png",
+};
+
+#define TEST_FILES		(sizeof( s_Files ) / sizeof( s_Files[ 0 ] ))
+
+
+//*********************************************************************//
+// Gate
+//	- holds a loader worker inside a decode until Open
+class Gate
+{
+public:
+	void Wait( void )
+	{
+		std::unique_lock< std::mutex > lock( m_Mutex );
+		m_bEntered = true;
+		m_cvEntered.notify_all();
+		m_cvOpen.wait( lock, [this]{ return m_bOpen == true; } );
+	}
+
+	void WaitEntered( void )
+	{
+		std::unique_lock< std::mutex > lock( m_Mutex );
+		m_cvEntered.wait( lock, [this]{ return m_bEntered == true; } );
+	}
+
+	void Open( void )
+	{
+		std::lock_guard< std::mutex > lock( m_Mutex );
+		m_bOpen = true;
+		m_cvOpen.notify_all();
+	}
+
+private:
+	std::mutex				m_Mutex;
+	std::condition_variable	m_cvEntered;
+	std::condition_variable	m_cvOpen;
+	bool					m_bEntered	= false;
+	bool					m_bOpen		= false;
+};
+
+
+//*********************************************************************//
+// TestLoader
+//	- the AsyncLoader on its own: a worker held by a Gate keeps
+//	  the later jobs queued
+static void TestLoader( void )
+{
+	using SGD::SGD_IMPLEMENTATION::AsyncLoader;
+
+	std::thread::id mainThread = std::this_thread::get_id();
+
+
+	// Complete of a queued job decodes it on the calling thread
+	{
+		AsyncLoader loader;
+		loader.Initialize( 1 );
+
+		Gate gate;
+		bool heldFinished = false;
+		unsigned int held = loader.Submit( [&]{ gate.Wait(); }, [&]{ heldFinished = true; } );
+		gate.WaitEntered();
+
+		std::thread::id decodedOn;
+		bool queuedFinished = false;
+		unsigned int queued = loader.Submit( [&]{ decodedOn = std::this_thread::get_id(); }, [&]{ queuedFinished = true; } );
+
+		CHECK( held != 0 );
+		CHECK( queued != 0 && queued != held );
+		CHECK( queuedFinished == false );				// never inside Submit
+		CHECK( loader.GetPendingCount() == 2 );
+
+		loader.Complete( queued );
+		CHECK( queuedFinished == true );
+		CHECK( decodedOn == mainThread );
+		CHECK( heldFinished == false );
+		CHECK( loader.GetPendingCount() == 1 );
+
+		// Completing it again does nothing
+		loader.Complete( queued );
+
+		gate.Open();
+		loader.CompleteAll();
+		CHECK( heldFinished == true );
+		CHECK( loader.GetPendingCount() == 0 );
+
+		loader.Terminate();
+	}
+
+
+	// Terminate with jobs still queued: none of them finishes
+	{
+		AsyncLoader loader;
+		loader.Initialize( 1 );
+
+		Gate gate;
+		std::atomic< unsigned int > decoded( 0 );
+		unsigned int finished = 0;
+
+		loader.Submit( [&]{ gate.Wait(); ++decoded; }, [&]{ ++finished; } );
+		gate.WaitEntered();
+
+		for( int i = 0; i < 10; i++ )
+			loader.Submit( [&]{ ++decoded; }, [&]{ ++finished; } );
+
+		CHECK( loader.GetPendingCount() == 11 );
+
+		// The worker leaves the held job once Terminate has cleared the queue
+		std::thread opener( [&]{ while( loader.GetPendingCount() > 1 ) std::this_thread::yield(); gate.Open(); } );
+		loader.Terminate();
+		opener.join();
+
+		CHECK( decoded == 1 );
+		CHECK( finished == 0 );
+		CHECK( loader.GetPendingCount() == 0 );
+
+		// The loader starts over
+		loader.Initialize( 1 );
+		loader.Submit( [&]{ ++decoded; }, [&]{ ++finished; } );
+		loader.CompleteAll();
+		CHECK( finished == 1 );
+		loader.Terminate();
+	}
+
+
+	// Without workers, Update decodes on the calling thread
+	{
+		AsyncLoader loader;
+		loader.Initialize( 0 );
+
+		std::thread::id decodedOn;
+		unsigned int finished = 0;
+		for( int i = 0; i < 3; i++ )
+			loader.Submit( [&]{ decodedOn = std::this_thread::get_id(); }, [&]{ ++finished; } );
+
+		CHECK( loader.Update( 2 ) == 2 );
+		CHECK( loader.Update( 2 ) == 1 );
+		CHECK( finished == 3 );
+		CHECK( decodedOn == mainThread );
+	}
+}
+
+
+//*********************************************************************//
+// TestBatch
+//	- a LoadBatch of every file goes from 0 to 1, a frame at a time
+static void TestBatch( void )
+{
+	SGD::GraphicsManager* pGraphics = SGD::GraphicsManager::GetInstance();
+
+	SGD::LoadBatch batch( pGraphics );
+	CHECK( batch.GetProgress() == 1.0f );		// empty
+
+	for( unsigned int f = 0; f < TEST_FILES; f++ )
+		CHECK( batch.LoadTexture( s_Files[ f ] ) != SGD::INVALID_HANDLE );
+
+	CHECK( batch.GetCount() == TEST_FILES );
+	CHECK( batch.GetProgress() == 0.0f );
+	CHECK( batch.IsComplete() == false );
+
+	float progress		= 0.0f;
+	bool  backwards		= false;
+	int   frames		= 0;
+
+	while( batch.Update() == false && frames < TEST_MAX_FRAMES )
+	{
+		if( batch.GetProgress() < progress )
+			backwards = true;
+		progress = batch.GetProgress();
+
+		pGraphics->Update();
+		std::this_thread::yield();
+		frames++;
+	}
+
+	CHECK( frames < TEST_MAX_FRAMES );
+	CHECK( backwards == false );
+	CHECK( batch.GetProgress() == 1.0f );
+	CHECK( batch.GetCompleted() == TEST_FILES );
+	CHECK( batch.GetFailed() == 0 );
+
+	batch.Unload();
+	CHECK( batch.GetCount() == 0 );
+}
+
+
+//*********************************************************************//
+// TestMissing
+//	- a missing file completes as failed instead of staying pending
+static void TestMissing( void )
+{
+	SGD::GraphicsManager* pGraphics = SGD::GraphicsManager::GetInstance();
+
+	SGD::LoadBatch batch( pGraphics );
+	SGD::HTexture good		= batch.LoadTexture( s_Files[ 0 ] );
+	SGD::HTexture missing	= batch.LoadTexture( L"resource/graphics/missing.png" );
+
+	CHECK( missing != SGD::INVALID_HANDLE );
+	CHECK( pGraphics->GetTextureStatus( missing ) == SGD::LoadStatus::Pending );
+
+	batch.Wait();
+	CHECK( batch.IsComplete() == true );
+	CHECK( batch.GetProgress() == 1.0f );
+	CHECK( batch.GetFailed() == 1 );
+	CHECK( pGraphics->GetTextureStatus( good ) == SGD::LoadStatus::Loaded );
+	CHECK( pGraphics->GetTextureStatus( missing ) == SGD::LoadStatus::Failed );
+
+	// Drawing the failed texture quietly fails
+	CHECK( pGraphics->DrawTexture( missing, SGD::Point{ 0, 0 } ) == false );
+
+	batch.Unload();
+	CHECK( pGraphics->FinishLoads( true ) == 0 );
+}
+
+
+//*********************************************************************//
+// TestUnloadPending
+//	- a texture unloaded before its load finished is discarded, and
+//	  a new load of the file starts over
+static void TestUnloadPending( void )
+{
+	SGD::GraphicsManager* pGraphics = SGD::GraphicsManager::GetInstance();
+
+	for( unsigned int f = 0; f < TEST_FILES; f++ )
+	{
+		// Only the main thread finishes loads: still pending
+		SGD::HTexture handle = pGraphics->LoadTextureAsync( s_Files[ f ] );
+		SGD::HTexture copy = handle;
+		CHECK( pGraphics->GetTextureStatus( handle ) == SGD::LoadStatus::Pending );
+
+		CHECK( pGraphics->UnloadTexture( handle ) == true );
+		CHECK( handle == SGD::INVALID_HANDLE );
+		CHECK( pGraphics->GetTextureStatus( copy ) == SGD::LoadStatus::Failed );
+	}
+
+	// The discarded loads finish without touching anything
+	CHECK( pGraphics->FinishLoads( true ) == 0 );
+
+	SGD::HTexture again = pGraphics->LoadTextureAsync( s_Files[ 0 ] );
+	CHECK( pGraphics->FinishLoads( true ) == 0 );
+	CHECK( pGraphics->GetTextureStatus( again ) == SGD::LoadStatus::Loaded );
+	pGraphics->UnloadTexture( again );
+
+
+	// The same through a batch
+	SGD::LoadBatch batch( pGraphics );
+	for( unsigned int f = 0; f < TEST_FILES; f++ )
+		batch.LoadTexture( s_Files[ f ] );
+
+	batch.Unload();
+	CHECK( pGraphics->FinishLoads( true ) == 0 );
+}
+
+
+//*********************************************************************//
+// TestLoadPending
+//	- LoadTexture of a file still loading finishes it right away
+//	  (the queue is deep, so the last loads are still queued & are
+//	  decoded on this thread)
+static void TestLoadPending( void )
+{
+	SGD::GraphicsManager* pGraphics = SGD::GraphicsManager::GetInstance();
+
+	std::vector< SGD::HTexture > pending;
+	for( unsigned int f = 0; f < TEST_FILES; f++ )
+		pending.push_back( pGraphics->LoadTextureAsync( s_Files[ f ] ) );
+
+	for( int f = TEST_FILES - 1; f >= 0; f-- )
+	{
+		SGD::HTexture loaded = pGraphics->LoadTexture( s_Files[ f ] );
+		CHECK( loaded == pending[ f ] );
+		CHECK( pGraphics->GetTextureStatus( loaded ) == SGD::LoadStatus::Loaded );
+		CHECK( pGraphics->DrawTexture( loaded, SGD::Point{ 0, 0 } ) == true );
+
+		pGraphics->UnloadTexture( loaded );
+	}
+
+	// A pending missing file fails at once
+	SGD::HTexture missing = pGraphics->LoadTextureAsync( L"resource/graphics/missing.png" );
+	CHECK( missing != SGD::INVALID_HANDLE );
+	CHECK( pGraphics->LoadTexture( L"resource/graphics/missing.png" ) == SGD::INVALID_HANDLE );
+	CHECK( pGraphics->GetTextureStatus( missing ) == SGD::LoadStatus::Failed );
+
+	pGraphics->UnloadTexture( missing );
+	for( unsigned int f = 0; f < TEST_FILES; f++ )
+		pGraphics->UnloadTexture( pending[ f ] );
+
+	CHECK( pGraphics->FinishLoads( true ) == 0 );
+}
+
+
+//*********************************************************************//
+// main
+int main( void )
+{
+	TestLoader();
+
+	Game* pGame = Game::GetInstance();
+	CHECK( pGame->Initialize() == true );
+
+	TestBatch();
+	TestMissing();
+	TestUnloadPending();
+	TestLoadPending();
+
+	// Terminate with loads still queued: they are discarded
+	SGD::GraphicsManager* pGraphics = SGD::GraphicsManager::GetInstance();
+	for( int r = 0; r < 4; r++ )
+		for( unsigned int f = 0; f < TEST_FILES; f++ )
+			pGraphics->LoadTextureAsync( s_Files[ f ] );
+
+	pGame->Terminate();
+	Game::DeleteInstance();
+
+	return TEST_RESULT();
+}
@@ -0,0 +1,210 @@
+//*********************************************************************//
+//	File:		AtlasPackerTest.cpp
+//	Author:		
+//	Course:		
+//	Purpose:	the MaxRects packer never overlaps or overflows, and
+//				the AtlasPacker tool rebuilds the game's sprite atlas
+//				with every sprite's pixels in place
+//
+//	Usage:		AtlasPackerTest <AtlasPacker executable> <output index.atlas>
+//*********************************************************************//
+
+#include "TestSupport.h"
+
+#include "../SGD Wrappers/SGD_TextureAtlas.h"
+
+#include "../tools/AtlasPacker/MaxRectsPacker.h"
+#include "../tools/AtlasPacker/PngImage.h"
+
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <string>
+#include <vector>
+
+
+//*********************************************************************//
+// The game's atlas (run from the Kanmaku folder)
+#define TEST_ATLAS			"resource/graphics/sprites.atlas"
+#define TEST_FOLDER			"resource/graphics/"
+
+// Random rectangles packed into one bin
+#define TEST_BIN_SIZE		256
+#define TEST_RECTS			400
+
+
+//*********************************************************************//
+// Narrow
+//	- the atlas names are ASCII
+static std::string Narrow( const std::wstring& text )
+{
+	std::string narrow;
+	for( unsigned int i = 0; i < text.size(); i++ )
+		narrow += (char)text[ i ];
+	return narrow;
+}
+
+//*********************************************************************//
+// ReadIndex
+static bool ReadIndex( const char* filename, SGD::AtlasIndex& index )
+{
+	FILE* file = fopen( filename, "rb" );
+	bool success = file != nullptr && index.Read( file ) == true;
+	if( file != nullptr )
+		fclose( file );
+
+	return success;
+}
+
+//*********************************************************************//
+// IsOverlapping
+static bool IsOverlapping( const MaxRectsPacker::Rect& a, const MaxRectsPacker::Rect& b )
+{
+	return a.x < b.x + b.width && b.x < a.x + a.width
+		&& a.y < b.y + b.height && b.y < a.y + a.height;
+}
+
+
+//*********************************************************************//
+// TestPacker
+//	- random sizes until the bin is full: every placed rectangle is
+//	  inside the bin & overlaps no other, and the used bounds hold them
+static void TestPacker( void )
+{
+	srand( 12345 );
+
+	MaxRectsPacker packer;
+	packer.Initialize( TEST_BIN_SIZE, TEST_BIN_SIZE );
+
+	std::vector< MaxRectsPacker::Rect > placed;
+	unsigned long area = 0;
+	unsigned int outside = 0, overlaps = 0;
+
+	for( int i = 0; i < TEST_RECTS; i++ )
+	{
+		MaxRectsPacker::Rect rect;
+		if( packer.Insert( 1 + rand() % 48, 1 + rand() % 48, rect ) == false )
+			continue;
+
+		if( rect.x + rect.width > TEST_BIN_SIZE || rect.y + rect.height > TEST_BIN_SIZE )
+			outside++;
+
+		for( unsigned int p = 0; p < placed.size(); p++ )
+			if( IsOverlapping( rect, placed[ p ] ) == true )
+				overlaps++;
+
+		placed.push_back( rect );
+		area += (unsigned long)rect.width * rect.height;
+	}
+
+	CHECK( outside == 0 );
+	CHECK( overlaps == 0 );
+	CHECK( packer.GetUsedArea() == area );
+
+	// The bin filled up well before the rectangles ran out
+	CHECK( placed.size() < TEST_RECTS );
+	CHECK( area > TEST_BIN_SIZE * TEST_BIN_SIZE / 2 );
+
+	for( unsigned int p = 0; p < placed.size(); p++ )
+		CHECK( placed[ p ].x + placed[ p ].width <= packer.GetUsedWidth()
+			&& placed[ p ].y + placed[ p ].height <= packer.GetUsedHeight() );
+
+	// Nothing fits a full bin, a zero size never does
+	MaxRectsPacker::Rect rect;
+	CHECK( packer.Insert( TEST_BIN_SIZE, 1, rect ) == false );
+
+	packer.Initialize( TEST_BIN_SIZE, TEST_BIN_SIZE );
+	CHECK( packer.Insert( 0, 4, rect ) == false );
+	CHECK( packer.Insert( TEST_BIN_SIZE, TEST_BIN_SIZE, rect ) == true );
+}
+
+
+//*********************************************************************//
+// TestTool
+//	- pack the game atlas' sprites again: the new index places them
+//	  like the committed one, and the new page holds their pixels
+static void TestTool( const char* packerPath, const char* outputPath )
+{
+	SGD::AtlasIndex expected;
+	CHECK( ReadIndex( TEST_ATLAS, expected ) == true );
+	CHECK( expected.vSprites.empty() == false );
+
+	std::string command = std::string( "\"" ) + packerPath + "\" -o \"" + outputPath + "\"";
+	for( unsigned int s = 0; s < expected.vSprites.size(); s++ )
+		command += " " TEST_FOLDER + Narrow( expected.vSprites[ s ].wsFilename );
+
+	CHECK( system( command.c_str() ) == 0 );
+
+	SGD::AtlasIndex packed;
+	CHECK( ReadIndex( outputPath, packed ) == true );
+	if( packed.vSprites.size() != expected.vSprites.size() || packed.vPages.size() != expected.vPages.size() )
+	{
+		CHECK( false );
+		return;
+	}
+
+
+	// Same pages (a power of 2, D3DX would round them anyway)
+	for( unsigned int p = 0; p < packed.vPages.size(); p++ )
+	{
+		CHECK( packed.vPages[ p ].unWidth == expected.vPages[ p ].unWidth );
+		CHECK( packed.vPages[ p ].unHeight == expected.vPages[ p ].unHeight );
+		CHECK( (packed.vPages[ p ].unWidth & (packed.vPages[ p ].unWidth - 1)) == 0 );
+		CHECK( (packed.vPages[ p ].unHeight & (packed.vPages[ p ].unHeight - 1)) == 0 );
+	}
+
+
+	// Same places, & every pixel copied
+	std::string folder = outputPath;
+	folder.resize( folder.find_last_of( "/\\" ) + 1 );
+
+	std::vector< PngImage > pages( packed.vPages.size() );
+	for( unsigned int p = 0; p < pages.size(); p++ )
+		CHECK( pages[ p ].Load( (folder + Narrow( packed.vPages[ p ].wsFilename )).c_str() ) == true );
+
+	for( unsigned int s = 0; s < packed.vSprites.size(); s++ )
+	{
+		const SGD::AtlasIndex::Sprite& sprite = packed.vSprites[ s ];
+		const SGD::AtlasIndex::Sprite& other = expected.vSprites[ s ];
+
+		CHECK( sprite.wsFilename == other.wsFilename );
+		CHECK( sprite.unPage == other.unPage && sprite.unX == other.unX && sprite.unY == other.unY );
+		CHECK( sprite.unWidth == other.unWidth && sprite.unHeight == other.unHeight );
+
+		PngImage source;
+		CHECK( source.Load( (TEST_FOLDER + Narrow( sprite.wsFilename )).c_str() ) == true );
+
+		const PngImage& page = pages[ sprite.unPage ];
+		if( page.GetPixels() == nullptr || source.GetPixels() == nullptr
+			|| sprite.unX + sprite.unWidth > page.GetWidth() || sprite.unY + sprite.unHeight > page.GetHeight() )
+		{
+			CHECK( false );
+			continue;
+		}
+
+		unsigned int wrongRows = 0;
+		for( unsigned int y = 0; y < sprite.unHeight; y++ )
+			if( memcmp( page.GetPixels() + ((sprite.unY + y) * page.GetWidth() + sprite.unX) * 4,
+				source.GetPixels() + y * source.GetWidth() * 4, sprite.unWidth * 4 ) != 0 )
+				wrongRows++;
+
+		CHECK( wrongRows == 0 );
+	}
+}
+
+
+//*********************************************************************//
+// main
+int main( int argc, char* argv[] )
+{
+	if( argc != 3 )
+	{
+		fprintf( stderr, "Usage: AtlasPackerTest <AtlasPacker executable> <output index.atlas>\n" );
+		return 1;
+	}
+
+	TestPacker();
+	TestTool( argv[ 1 ], argv[ 2 ] );
+
+	return TEST_RESULT();
+}
@@ -0,0 +1,56 @@
+//*********************************************************************//
+//	File:		BenchSupport.h
+//	Author:		
+//	Course:		
+//	Purpose:	timer & report for the headless benchmarks
+//*********************************************************************//
+
+#pragma once
+
+#include <chrono>							// uses steady_clock
+#include <cstdio>							// uses printf
+
+
+//*********************************************************************//
+// Runs of each measurement (the fastest one is reported)
+#define BENCH_RUNS		5
+
+
+//*********************************************************************//
+// BenchMeasure
+//	- the fastest of BENCH_RUNS calls of run(), in milliseconds
+//	- setup() runs before each call, untimed
+template< typename Setup, typename Run >
+double BenchMeasure( Setup setup, Run run )
+{
+	double best = 0.0;
+
+	for( int r = 0; r < BENCH_RUNS; r++ )
+	{
+		setup();
+
+		std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+		run();
+		std::chrono::steady_clock::time_point end = std::chrono::steady_clock::now();
+
+		double ms = std::chrono::duration< double, std::milli >( end - start ).count();
+		if( r == 0 || ms < best )
+			best = ms;
+	}
+
+	return best;
+}
+
+
+//*********************************************************************//
+// BenchReport
+//	- one line: the old & new times of a case, and the speedup
+inline void BenchReport( const char* name, double oldMs, double newMs )
+{
+	printf( "%-40s %10.3f ms %10.3f ms %7.2fx\n", name, oldMs, newMs, (newMs > 0.0) ? oldMs / newMs : 0.0 );
+}
+
+inline void BenchHeader( const char* title )
+{
+	printf( "\n%s\n%-40s %13s %13s %8s\n", title, "case", "old", "new", "speedup" );
+}
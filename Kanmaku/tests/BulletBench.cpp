@@ -0,0 +1,253 @@
+//*********************************************************************//
+//	File:		BulletBench.cpp
+//	Author:		
+//	Course:		
+//	Purpose:	BulletSystem spawn & update throughput against the
+//				heap Bullet entity it replaced
+//*********************************************************************//
+
+#include "BenchSupport.h"
+#include "HeadlessGame.h"
+
+#include "../source/BulletSystem.h"
+#include "../source/Entity.h"
+#include "../source/EntityManager.h"
+
+#include <cmath>
+#include <vector>
+
+
+//*********************************************************************//
+#define BENCH_STEP				(1.0f / 60.0f)
+#define BENCH_UPDATE_FRAMES		60			// bullets stay on the screen
+#define BENCH_STREAM_FRAMES		600
+#define BENCH_STREAM_SPAWNS		500			// per frame, leaving at 300 px/s
+
+
+//*********************************************************************//
+// HeapBullet
+//	- the old Bullet: one heap entity per shot, moved by its virtual
+//	  Update, removed once off the screen (the old one queued a
+//	  DestroyEntityMessage, this one queues the remove directly)
+class HeapBullet : public Entity
+{
+public:
+	HeapBullet( EntityManager* pManager ) : m_pManager( pManager )	{	++s_unLive;	}
+
+	virtual void Update( float elapsedTime ) override
+	{
+		Entity::Update( elapsedTime );
+
+		SGD::Size offsetScreen = Game::GetInstance()->GetScreenSize();
+		offsetScreen.height -= 65.0f;
+		SGD::Rectangle rScreen = { SGD::Point{ 0, 65.0f }, offsetScreen };
+
+		if( GetRect().IsIntersecting( rScreen ) == false )
+			m_pManager->QueueRemove( this );
+	}
+
+	virtual int GetType( void ) const override	{	return ENT_BULLET_A;	}
+
+	virtual SGD::Rectangle GetRect( void ) const override
+	{
+		return SGD::Rectangle{ m_ptPosition - m_szSize / 2, m_szSize };
+	}
+
+	static unsigned int	s_unLive;		// not yet released
+
+protected:
+	virtual ~HeapBullet( void )		{	--s_unLive;	}
+
+private:
+	EntityManager*	m_pManager;
+};
+
+/*static*/ unsigned int HeapBullet::s_unLive = 0;
+
+
+//*********************************************************************//
+// Shot
+//	- position & velocity of shot i (fast: leaves the screen)
+static SGD::Point ShotPosition( unsigned int i )
+{
+	return SGD::Point{ 100.0f + (i * 37 % 824), 165.0f + (i * 53 % 503) };
+}
+
+static SGD::Vector ShotVelocity( unsigned int i, float speed )
+{
+	float angle = i * 0.61f;
+	return SGD::Vector{ speed * cosf( angle ), speed * sinf( angle ) };
+}
+
+
+//*********************************************************************//
+// OldSpawn & NewSpawn
+static void OldSpawn( EntityManager& manager, unsigned int i, float speed )
+{
+	HeapBullet* pBullet = new HeapBullet( &manager );
+	pBullet->SetPosition( ShotPosition( i ) );
+	pBullet->SetVelocity( ShotVelocity( i, speed ) );
+	pBullet->SetSize( SGD::Size{ 16, 16 } );
+
+	manager.AddEntity( pBullet, 0 );
+	pBullet->Release();
+}
+
+static void NewSpawn( BulletSystem* pBullets, unsigned int i, float speed )
+{
+	pBullets->Spawn( Entity::ENT_BULLET_A, ShotPosition( i ), ShotVelocity( i, speed ), 0.0f );
+}
+
+
+//*********************************************************************//
+// RunCase
+//	- spawning count bullets, then moving them (slow enough to stay
+//	  on the screen); false if the two paths end with different
+//	  live bullets
+static bool RunCase( unsigned int count )
+{
+	EntityManager oldManager, newManager;
+
+	BulletSystem* pBullets = new BulletSystem;
+	pBullets->SetBulletImage( Entity::ENT_BULLET_A, SGD::INVALID_HANDLE, SGD::Size{ 16, 16 } );
+	newManager.AddEntity( pBullets, 0 );
+
+	char name[ 64 ];
+
+
+	// Spawn
+	double oldMs = BenchMeasure(
+		[&]()	{	oldManager.RemoveAll();		},
+		[&]()
+		{
+			for( unsigned int i = 0; i < count; i++ )
+				OldSpawn( oldManager, i, 10.0f );
+		} );
+
+	double newMs = BenchMeasure(
+		[&]()	{	pBullets->DespawnAll();		},
+		[&]()
+		{
+			for( unsigned int i = 0; i < count; i++ )
+				NewSpawn( pBullets, i, 10.0f );
+		} );
+
+	snprintf( name, sizeof( name ), "spawn %u", count );
+	BenchReport( name, oldMs, newMs );
+
+
+	// Update
+	oldMs = BenchMeasure(
+		[&]()	{	},
+		[&]()
+		{
+			for( int frame = 0; frame < BENCH_UPDATE_FRAMES; frame++ )
+			{
+				oldManager.UpdateAll( BENCH_STEP );
+				oldManager.ProcessQueues();
+			}
+		} );
+
+	newMs = BenchMeasure(
+		[&]()	{	},
+		[&]()
+		{
+			for( int frame = 0; frame < BENCH_UPDATE_FRAMES; frame++ )
+			{
+				newManager.UpdateAll( BENCH_STEP );
+				newManager.ProcessQueues();
+			}
+		} );
+
+	snprintf( name, sizeof( name ), "update %u x %d frames", count, BENCH_UPDATE_FRAMES );
+	BenchReport( name, oldMs, newMs );
+
+
+	bool same = HeapBullet::s_unLive == count && pBullets->GetLiveCount() == count;
+	if( same == false )
+		fprintf( stderr, "%s: %u heap bullets, %u in the system\n", name, HeapBullet::s_unLive, pBullets->GetLiveCount() );
+
+	oldManager.RemoveAll();
+	newManager.RemoveAll();
+	pBullets->Release();
+
+	return same;
+}
+
+
+//*********************************************************************//
+// RunStream
+//	- a stream of fast shots, each leaving the screen: spawn, update
+//	  & despawn every frame
+static bool RunStream( void )
+{
+	EntityManager oldManager, newManager;
+
+	BulletSystem* pBullets = new BulletSystem;
+	pBullets->SetBulletImage( Entity::ENT_BULLET_A, SGD::INVALID_HANDLE, SGD::Size{ 16, 16 } );
+	newManager.AddEntity( pBullets, 0 );
+
+	double oldMs = BenchMeasure(
+		[&]()	{	oldManager.RemoveAll();		},
+		[&]()
+		{
+			for( int frame = 0; frame < BENCH_STREAM_FRAMES; frame++ )
+			{
+				for( unsigned int i = 0; i < BENCH_STREAM_SPAWNS; i++ )
+					OldSpawn( oldManager, frame * BENCH_STREAM_SPAWNS + i, 300.0f );
+
+				oldManager.UpdateAll( BENCH_STEP );
+				oldManager.ProcessQueues();
+			}
+		} );
+
+	double newMs = BenchMeasure(
+		[&]()	{	pBullets->DespawnAll();		},
+		[&]()
+		{
+			for( int frame = 0; frame < BENCH_STREAM_FRAMES; frame++ )
+			{
+				for( unsigned int i = 0; i < BENCH_STREAM_SPAWNS; i++ )
+					NewSpawn( pBullets, frame * BENCH_STREAM_SPAWNS + i, 300.0f );
+
+				newManager.UpdateAll( BENCH_STEP );
+				newManager.ProcessQueues();
+			}
+		} );
+
+	char name[ 64 ];
+	snprintf( name, sizeof( name ), "stream %d a frame x %d frames", BENCH_STREAM_SPAWNS, BENCH_STREAM_FRAMES );
+	BenchReport( name, oldMs, newMs );
+
+
+	bool same = HeapBullet::s_unLive == pBullets->GetLiveCount() && HeapBullet::s_unLive > 0;
+	if( same == false )
+		fprintf( stderr, "%s: %u heap bullets, %u in the system\n", name, HeapBullet::s_unLive, pBullets->GetLiveCount() );
+
+	oldManager.RemoveAll();
+	newManager.RemoveAll();
+	pBullets->Release();
+
+	return same;
+}
+
+
+//*********************************************************************//
+// main
+int main( void )
+{
+	Game* pGame = Game::GetInstance();
+	if( pGame->Initialize() == false )
+		return 1;
+
+	BenchHeader( "BulletBench: (heap Bullet entities / BulletSystem)" );
+
+	bool same = RunCase( 10000 );
+	same = RunCase( 50000 ) && same;
+	same = RunStream() && same;
+
+	pGame->Terminate();
+	Game::DeleteInstance();
+
+	return (same == true) ? 0 : 1;
+}
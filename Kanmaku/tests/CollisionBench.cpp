@@ -0,0 +1,185 @@
+//*********************************************************************//
+//	File:		CollisionBench.cpp
+//	Author:		
+//	Course:		
+//	Purpose:	EntityManager::CheckCollisions (spatial hash) against
+//				the brute-force loop it replaced, 100 to 50k bullets
+//*********************************************************************//
+
+#include "BenchSupport.h"
+#include "HeadlessGame.h"
+
+#include "../source/Entity.h"
+#include "../source/EntityManager.h"
+#include "../source/FrameArena.h"
+
+#include <vector>
+
+
+//*********************************************************************//
+// Bullets against the player & enemies, in a 2048x1536 level
+#define BENCH_TARGETS		100
+#define BENCH_CHECKS		10
+#define BENCH_LEVEL_WIDTH	2048.0f
+#define BENCH_LEVEL_HEIGHT	1536.0f
+
+
+//*********************************************************************//
+// Random
+static unsigned int s_unSeed = 11;
+
+static float Random( float range )
+{
+	s_unSeed = s_unSeed * 1664525u + 1013904223u;
+	return range * (s_unSeed >> 8) / 16777216.0f;
+}
+
+
+//*********************************************************************//
+// CountingEntity
+//	- counts its collisions
+class CountingEntity : public Entity
+{
+public:
+	virtual void HandleCollision( const IEntity* pOther ) override
+	{
+		(void)pOther;			// unused parameter
+		++m_unHits;
+	}
+
+	unsigned int	m_unHits	= 0;
+};
+
+
+//*********************************************************************//
+// BruteForce
+//	- the old CheckCollisions of two buckets: the smaller one outside,
+//	  both rects read for every pair
+static void BruteForce( const std::vector< IEntity* >& bucket1, const std::vector< IEntity* >& bucket2 )
+{
+	const std::vector< IEntity* >& vec1 = (bucket2.size() < bucket1.size()) ? bucket2 : bucket1;
+	const std::vector< IEntity* >& vec2 = (bucket2.size() < bucket1.size()) ? bucket1 : bucket2;
+
+	for( unsigned int i = 0; i < vec1.size(); i++ )
+	{
+		if( vec1[ i ]->GetRect().IsEmpty() == true )
+			continue;
+
+		for( unsigned int j = 0; j < vec2.size(); j++ )
+		{
+			if( vec1[ i ] == vec2[ j ] )
+				continue;
+
+			SGD::Rectangle rEntity1 = vec1[ i ]->GetRect();
+			SGD::Rectangle rEntity2 = vec2[ j ]->GetRect();
+
+			if( rEntity1.IsIntersecting( rEntity2 ) == true )
+			{
+				vec1[ i ]->HandleCollision( vec2[ j ] );
+				vec2[ j ]->HandleCollision( vec1[ i ] );
+			}
+		}
+	}
+}
+
+
+//*********************************************************************//
+// CountHits
+static unsigned int CountHits( const std::vector< CountingEntity* >& entities )
+{
+	unsigned int hits = 0;
+	for( unsigned int i = 0; i < entities.size(); i++ )
+		hits += entities[ i ]->m_unHits;
+	return hits;
+}
+
+static void ClearHits( const std::vector< CountingEntity* >& entities )
+{
+	for( unsigned int i = 0; i < entities.size(); i++ )
+		entities[ i ]->m_unHits = 0;
+}
+
+
+//*********************************************************************//
+// RunCase
+//	- BENCH_CHECKS checks of the bullets against the targets;
+//	  false if the two paths found different collisions
+static bool RunCase( unsigned int bullets )
+{
+	FrameArena* pArena = Game::GetInstance()->GetFrameArena();
+
+	EntityManager manager;
+	std::vector< CountingEntity* >	entities;
+	std::vector< IEntity* >			bucket1, bucket2;
+
+	for( unsigned int i = 0; i < bullets + BENCH_TARGETS; i++ )
+	{
+		bool bullet = i < bullets;
+
+		CountingEntity* pEntity = new CountingEntity;
+		pEntity->SetPosition( SGD::Point{ Random( BENCH_LEVEL_WIDTH ), Random( BENCH_LEVEL_HEIGHT ) } );
+		pEntity->SetSize( (bullet == true) ? SGD::Size{ 8, 8 } : SGD::Size{ 48, 48 } );
+
+		manager.AddEntity( pEntity, (bullet == true) ? 0 : 1 );
+		((bullet == true) ? bucket1 : bucket2).push_back( pEntity );
+		entities.push_back( pEntity );
+		pEntity->Release();
+	}
+
+
+	unsigned int oldHits = 0, newHits = 0;
+
+	double oldMs = BenchMeasure(
+		[&]()	{	ClearHits( entities );	},
+		[&]()
+		{
+			for( int c = 0; c < BENCH_CHECKS; c++ )
+				BruteForce( bucket1, bucket2 );
+		} );
+	oldHits = CountHits( entities );
+
+	double newMs = BenchMeasure(
+		[&]()	{	ClearHits( entities );	},
+		[&]()
+		{
+			for( int c = 0; c < BENCH_CHECKS; c++ )
+			{
+				pArena->Reset();		// a frame per check
+				manager.CheckCollisions( 0u, 1u );
+			}
+		} );
+	newHits = CountHits( entities );
+
+	char name[ 64 ];
+	snprintf( name, sizeof( name ), "%u bullets x %u targets", bullets, BENCH_TARGETS );
+	BenchReport( name, oldMs, newMs );
+
+	if( oldHits != newHits )
+		fprintf( stderr, "%s: %u collisions, brute force found %u\n", name, newHits, oldHits );
+
+	manager.RemoveAll();
+	return oldHits == newHits;
+}
+
+
+//*********************************************************************//
+// main
+int main( void )
+{
+	Game* pGame = Game::GetInstance();
+	if( pGame->Initialize() == false )
+		return 1;
+
+	BenchHeader( "CollisionBench: 10 checks (brute force / spatial hash)" );
+
+	static const unsigned int counts[] = { 100, 1000, 10000, 50000 };
+
+	bool same = true;
+	for( unsigned int c = 0; c < sizeof( counts ) / sizeof( counts[ 0 ] ); c++ )
+		same = RunCase( counts[ c ] ) && same;
+
+	pGame->Terminate();
+	Game::DeleteInstance();
+
+	return (same == true) ? 0 : 1;
+}
@@ -0,0 +1,145 @@
+//*********************************************************************//
+//	File:		ContactOrderTest.cpp
+//	Author:		
+//	Course:		
+//	Purpose:	the parallel narrow phase finds & handles the same
+//				contacts, in the same order, on 1 & 8 threads
+//*********************************************************************//
+
+#include "TestSupport.h"
+#include "HeadlessGame.h"
+
+#include "../source/Entity.h"
+#include "../source/EntityManager.h"
+#include "../source/JobPool.h"
+
+#include <utility>
+#include <vector>
+
+
+//*********************************************************************//
+// Buckets & their sizes
+#define BUCKET_A		0
+#define BUCKET_B		1
+#define ENTITIES_A		3000
+#define ENTITIES_B		700
+
+
+//*********************************************************************//
+// Every HandleCollision call, in order: (entity id, other id)
+static std::vector< std::pair< int, int > >		s_vHandled;
+
+
+//*********************************************************************//
+// LoggingEntity
+//	- a fixed rect that logs its collisions
+class LoggingEntity : public Entity
+{
+public:
+	explicit LoggingEntity( int id )	: m_nID( id )	{	}
+
+	virtual void HandleCollision( const IEntity* pOther ) override
+	{
+		s_vHandled.push_back( std::make_pair( m_nID, static_cast< const LoggingEntity* >( pOther )->m_nID ) );
+	}
+
+private:
+	int		m_nID;
+};
+
+
+//*********************************************************************//
+// Random
+//	- a fixed sequence, so both runs build the same scene
+static unsigned int s_unSeed = 1;
+
+static float Random( float range )
+{
+	s_unSeed = s_unSeed * 1664525u + 1013904223u;
+	return range * (s_unSeed >> 8) / 16777216.0f;
+}
+
+
+//*********************************************************************//
+// Run
+//	- the same scene on a pool of threads (1 = the caller only)
+//	- the found contacts of each check, then every handled collision
+struct RunResult
+{
+	std::vector< unsigned int >				vContacts;		// (first, second) flattened
+	std::vector< std::pair< int, int > >	vHandled;
+};
+
+static RunResult Run( unsigned int threads )
+{
+	JobPool jobs;
+	jobs.Initialize( threads - 1 );
+	CHECK( jobs.GetThreadCount() == threads );
+
+	EntityManager entities;
+	entities.SetJobPool( &jobs );
+	entities.SetParallelCollisions( true );
+	entities.SetCollisionCellSize( 32.0f );
+
+	s_unSeed = 1;
+	int id = 0;
+
+	for( int i = 0; i < ENTITIES_A + ENTITIES_B; i++ )
+	{
+		LoggingEntity* pEntity = new LoggingEntity( id++ );
+		pEntity->SetPosition( SGD::Point{ Random( 2048.0f ), Random( 2048.0f ) } );
+		pEntity->SetSize( SGD::Size{ 4.0f + Random( 60.0f ), 4.0f + Random( 60.0f ) } );
+
+		entities.AddEntity( pEntity, i < ENTITIES_A ? BUCKET_A : BUCKET_B );
+		pEntity->Release();
+	}
+
+
+	RunResult result;
+	unsigned int pairs[][ 2 ] = { { BUCKET_A, BUCKET_B }, { BUCKET_B, BUCKET_A }, { BUCKET_A, BUCKET_A } };
+
+	for( unsigned int p = 0; p < 3; p++ )
+	{
+		const EntityManager::ContactVector& contacts = entities.FindContacts( pairs[ p ][ 0 ], pairs[ p ][ 1 ] );
+
+		for( unsigned int c = 0; c < contacts.size(); c++ )
+		{
+			result.vContacts.push_back( contacts[ c ].unFirst );
+			result.vContacts.push_back( contacts[ c ].unSecond );
+		}
+	}
+
+	s_vHandled.clear();
+	for( unsigned int p = 0; p < 3; p++ )
+		entities.CheckCollisions( pairs[ p ][ 0 ], pairs[ p ][ 1 ] );
+
+	result.vHandled.swap( s_vHandled );
+
+	entities.RemoveAll();
+	jobs.Terminate();
+	return result;
+}
+
+
+//*********************************************************************//
+int main( void )
+{
+	// The collision snapshots come from the game's frame arena
+	Game* pGame = Game::GetInstance();
+	CHECK( pGame->Initialize() == true );
+
+	RunResult serial	= Run( 1 );
+	RunResult parallel	= Run( 8 );
+
+	pGame->Terminate();
+	Game::DeleteInstance();
+
+	CHECK( serial.vContacts.empty() == false );
+	CHECK( serial.vContacts == parallel.vContacts );
+	CHECK( serial.vHandled == parallel.vHandled );
+
+	// Both entities of each contact handled it
+	CHECK( serial.vHandled.size() == serial.vContacts.size() );
+
+	return TEST_RESULT();
+}
@@ -0,0 +1,166 @@
+//*********************************************************************//
+//	File:		EntityStressTest.cpp
+//	Author:		
+//	Course:		
+//	Purpose:	100k entities spawned & removed through handles, the
+//				deferred queues & RemoveAll: stale handles never
+//				find an entity, every entity is released
+//*********************************************************************//
+
+#include "TestSupport.h"
+
+#include "../source/Entity.h"
+#include "../source/EntityManager.h"
+
+#include <vector>
+
+
+//*********************************************************************//
+// Entities per round & buckets
+#define STRESS_ENTITIES		100000
+#define STRESS_BUCKETS		4
+
+
+//*********************************************************************//
+// CountedEntity
+//	- counts the live instances, so the test sees every release
+static int s_nLiveEntities = 0;
+
+class CountedEntity : public Entity
+{
+public:
+	CountedEntity( void )					{	++s_nLiveEntities;	}
+
+protected:
+	virtual ~CountedEntity( void )			{	--s_nLiveEntities;	}
+};
+
+
+//*********************************************************************//
+// Spawn
+//	- add count entities round-robin across the buckets
+static void Spawn( EntityManager& entities, unsigned int count, std::vector< IEntity* >& stored, std::vector< EntityHandle >& handles )
+{
+	for( unsigned int i = 0; i < count; i++ )
+	{
+		IEntity* pEntity = new CountedEntity;
+		entities.AddEntity( pEntity, i % STRESS_BUCKETS );
+
+		stored.push_back( pEntity );
+		handles.push_back( pEntity->GetEntityHandle() );
+
+		pEntity->Release();
+	}
+}
+
+
+//*********************************************************************//
+// CountStale
+//	- handles that still find an entity (should be none)
+static unsigned int CountStale( const EntityManager& entities, const std::vector< EntityHandle >& handles )
+{
+	unsigned int found = 0;
+	for( unsigned int i = 0; i < handles.size(); i++ )
+		if( entities.GetEntity( handles[ i ] ) != nullptr )
+			found++;
+
+	return found;
+}
+
+
+//*********************************************************************//
+int main( void )
+{
+	EntityManager				entities;
+	std::vector< IEntity* >		stored;
+	std::vector< EntityHandle >	handles;
+	std::vector< EntityHandle >	removed;
+
+	stored.reserve( STRESS_ENTITIES );
+	handles.reserve( STRESS_ENTITIES );
+
+	Spawn( entities, STRESS_ENTITIES, stored, handles );
+	CHECK( s_nLiveEntities == STRESS_ENTITIES );
+
+
+	// Remove every other entity by handle, then every fourth again (stale)
+	for( unsigned int i = 0; i < handles.size(); i += 2 )
+	{
+		entities.RemoveEntity( handles[ i ] );
+		removed.push_back( handles[ i ] );
+	}
+
+	for( unsigned int i = 0; i < handles.size(); i += 4 )
+		entities.RemoveEntity( handles[ i ] );
+
+	CHECK( s_nLiveEntities == STRESS_ENTITIES / 2 );
+	CHECK( CountStale( entities, removed ) == 0 );
+
+	unsigned int wrong = 0;
+	for( unsigned int i = 1; i < handles.size(); i += 2 )
+		if( entities.GetEntity( handles[ i ] ) != stored[ i ] )
+			wrong++;
+
+	CHECK( wrong == 0 );
+
+
+	// Refill the freed slots: the old handles must not find the new entities
+	std::vector< IEntity* >		refill;
+	std::vector< EntityHandle >	refillHandles;
+	Spawn( entities, STRESS_ENTITIES / 2, refill, refillHandles );
+
+	CHECK( s_nLiveEntities == STRESS_ENTITIES );
+	CHECK( CountStale( entities, removed ) == 0 );
+
+
+	// Queue removes of the odd entities (twice) & adds of new ones
+	std::vector< IEntity* > queued;
+	for( unsigned int i = 0; i < STRESS_ENTITIES / 10; i++ )
+	{
+		IEntity* pEntity = new CountedEntity;
+		entities.QueueAdd( pEntity, i % STRESS_BUCKETS );
+		queued.push_back( pEntity );
+		pEntity->Release();
+	}
+
+	for( unsigned int i = 1; i < stored.size(); i += 2 )
+	{
+		entities.QueueRemove( stored[ i ] );
+		entities.QueueRemove( stored[ i ], i % STRESS_BUCKETS );
+		removed.push_back( handles[ i ] );
+	}
+
+	entities.ProcessQueues();
+
+	CHECK( s_nLiveEntities == STRESS_ENTITIES / 2 + STRESS_ENTITIES / 10 );
+	CHECK( CountStale( entities, removed ) == 0 );
+
+	wrong = 0;
+	for( unsigned int i = 0; i < queued.size(); i++ )
+		if( entities.GetEntity( queued[ i ]->GetEntityHandle() ) != queued[ i ] )
+			wrong++;
+
+	CHECK( wrong == 0 );
+
+
+	// RemoveAll keeps the generations: no handle from before it
+	// finds one of the entities added after
+	for( unsigned int i = 0; i < refillHandles.size(); i++ )
+		removed.push_back( refillHandles[ i ] );
+	for( unsigned int i = 0; i < queued.size(); i++ )
+		removed.push_back( queued[ i ]->GetEntityHandle() );
+
+	entities.RemoveAll();
+	CHECK( s_nLiveEntities == 0 );
+
+	std::vector< IEntity* >		again;
+	std::vector< EntityHandle >	againHandles;
+	Spawn( entities, STRESS_ENTITIES, again, againHandles );
+
+	CHECK( CountStale( entities, removed ) == 0 );
+
+	entities.RemoveAll();
+	CHECK( s_nLiveEntities == 0 );
+
+	return TEST_RESULT();
+}
@@ -0,0 +1,240 @@
+//*********************************************************************//
+//	File:		EventBench.cpp
+//	Author:		
+//	Course:		
+//	Purpose:	SGD::EventManager's interned dispatch against the
+//				multimap of string IDs it replaced: 10k events a
+//				frame across 1k listeners
+//*********************************************************************//
+
+#include "BenchSupport.h"
+
+#include "../SGD Wrappers/SGD_Event.h"
+#include "../SGD Wrappers/SGD_EventManager.h"
+#include "../SGD Wrappers/SGD_IListener.h"
+
+#include <algorithm>
+#include <cstring>
+#include <map>
+#include <queue>
+#include <vector>
+
+
+//*********************************************************************//
+// 1k listeners, 10 on each of 100 IDs; 1 event in 4 is targeted
+#define BENCH_LISTENERS		1000
+#define BENCH_IDS			100
+#define BENCH_EVENTS		10000
+#define BENCH_FRAMES		60
+
+
+//*********************************************************************//
+// CountingListener
+class CountingListener : public SGD::IListener
+{
+public:
+	virtual void HandleEvent( const SGD::Event* pEvent ) override
+	{
+		(void)pEvent;			// unused parameter
+		++s_unDeliveries;
+	}
+
+	static unsigned long	s_unDeliveries;
+};
+
+/*static*/ unsigned long CountingListener::s_unDeliveries = 0;
+
+
+//*********************************************************************//
+// OldEventManager
+//	- the old EventManager's queue & Update: a multimap keyed on the
+//	  32 characters (strcmp), a temporary vector per event, the
+//	  unlisteners searched per delivery, dynamic_cast per target
+class OldEventManager
+{
+public:
+	struct OldEventID
+	{
+		char	id[ 32 ];
+
+		OldEventID( const SGD::EventID& eventID )
+		{
+			memset( id, 0, sizeof( id ) );
+			for( unsigned int i = 0; i < sizeof( id ) && eventID[ i ] != '\0'; i++ )
+				id[ i ] = eventID[ i ];
+		}
+
+		OldEventID( const char* str )
+		{
+			memset( id, 0, sizeof( id ) );
+			strncpy( id, str, sizeof( id ) - 1 );
+		}
+
+		bool operator < ( const OldEventID& other ) const	{	return strcmp( id, other.id ) < 0;				}
+		bool operator == ( const OldEventID& other ) const	{	return memcmp( id, other.id, sizeof( id ) ) == 0;	}
+	};
+
+	typedef std::multimap< OldEventID, SGD::IListener* >	ListenerMap;
+	typedef ListenerMap::const_iterator						LMapIter;
+	typedef ListenerMap::value_type							LMapValue;
+	typedef std::pair< LMapIter, LMapIter >					LMapRange;
+	typedef std::vector< SGD::IListener* >					ListenerVector;
+
+	void RegisterForEvent( SGD::IListener* listener, const char* eventID )
+	{
+		OldEventID id = eventID;
+
+		LMapRange range = m_mListeners.equal_range( id );
+		for( LMapIter iter = range.first; iter != range.second; ++iter )
+			if( iter->second == listener )
+				return;
+
+		m_mListeners.insert( LMapValue( id, listener ) );
+	}
+
+	void QueueEvent( const SGD::Event* pEvent, const void* destination )
+	{
+		m_qEvents.push( std::make_pair( pEvent, destination ) );
+	}
+
+	void Update( void )
+	{
+		while( m_qEvents.empty() == false )
+		{
+			std::pair< const SGD::Event*, const void* > eventPair = m_qEvents.front();
+			m_qEvents.pop();
+
+			OldEventID id = eventPair.first->GetEventID();
+
+			LMapRange range = m_mListeners.equal_range( id );
+			if( range.first != range.second )
+			{
+				ListenerVector vec;
+
+				if( eventPair.second == nullptr )
+				{
+					for( LMapIter iter = range.first; iter != range.second; ++iter )
+						vec.push_back( iter->second );
+				}
+				else
+				{
+					for( LMapIter iter = range.first; iter != range.second; ++iter )
+					{
+						if( dynamic_cast< const void* >( iter->second ) == eventPair.second )
+						{
+							vec.push_back( iter->second );
+							break;
+						}
+					}
+				}
+
+				for( unsigned int i = 0; i < vec.size(); i++ )
+				{
+					if( m_mUnlisteners.empty() == false )
+					{
+						LMapRange removed = m_mUnlisteners.equal_range( id );
+						if( removed.first != removed.second )
+						{
+							LMapIter iter = std::find( removed.first, removed.second, LMapValue( id, vec[ i ] ) );
+							if( iter != removed.second )
+							{
+								m_mUnlisteners.erase( iter );
+								continue;
+							}
+						}
+					}
+
+					vec[ i ]->HandleEvent( eventPair.first );
+				}
+			}
+
+			delete eventPair.first;
+		}
+
+		m_mUnlisteners.clear();
+	}
+
+private:
+	std::queue< std::pair< const SGD::Event*, const void* > >	m_qEvents;
+	ListenerMap		m_mListeners;
+	ListenerMap		m_mUnlisteners;
+};
+
+
+//*********************************************************************//
+// main
+int main( void )
+{
+	SGD::EventManager* pEvents = SGD::EventManager::GetInstance();
+	if( pEvents->Initialize() == false )
+		return 1;
+
+	// The IDs
+	std::vector< std::vector< char > > names( BENCH_IDS, std::vector< char >( 32 ) );
+	for( unsigned int n = 0; n < BENCH_IDS; n++ )
+		snprintf( names[ n ].data(), 32, "BENCH_EVENT_%u", n );
+
+	// Listener i hears ID i % 100, on both managers
+	OldEventManager oldEvents;
+	std::vector< CountingListener > listeners( BENCH_LISTENERS );
+
+	for( unsigned int i = 0; i < BENCH_LISTENERS; i++ )
+	{
+		listeners[ i ].RegisterForEvent( names[ i % BENCH_IDS ].data() );
+		oldEvents.RegisterForEvent( &listeners[ i ], names[ i % BENCH_IDS ].data() );
+	}
+
+	// Event e: ID e * 7 % 100, every 4th targeted at one of its listeners
+	auto target = []( unsigned int e ) -> unsigned int
+	{
+		return (e * 7 % BENCH_IDS) + BENCH_IDS * (e / 4 % (BENCH_LISTENERS / BENCH_IDS));
+	};
+
+
+	unsigned long oldDeliveries = 0, newDeliveries = 0;
+
+	double oldMs = BenchMeasure(
+		[&]()	{	CountingListener::s_unDeliveries = 0;	},
+		[&]()
+		{
+			for( int frame = 0; frame < BENCH_FRAMES; frame++ )
+			{
+				for( unsigned int e = 0; e < BENCH_EVENTS; e++ )
+					oldEvents.QueueEvent( new SGD::Event( names[ e * 7 % BENCH_IDS ].data() ),
+						(e % 4 == 0) ? &listeners[ target( e ) ] : nullptr );
+
+				oldEvents.Update();
+			}
+		} );
+	oldDeliveries = CountingListener::s_unDeliveries;
+
+	double newMs = BenchMeasure(
+		[&]()	{	CountingListener::s_unDeliveries = 0;	},
+		[&]()
+		{
+			for( int frame = 0; frame < BENCH_FRAMES; frame++ )
+			{
+				for( unsigned int e = 0; e < BENCH_EVENTS; e++ )
+					(new SGD::Event( names[ e * 7 % BENCH_IDS ].data() ))->QueueEvent(
+						(e % 4 == 0) ? &listeners[ target( e ) ] : nullptr );
+
+				pEvents->Update();
+			}
+		} );
+	newDeliveries = CountingListener::s_unDeliveries;
+
+
+	BenchHeader( "EventBench: 10k events a frame, 1k listeners on 100 IDs, 60 frames (multimap / interned)" );
+	BenchReport( "queue & dispatch", oldMs, newMs );
+	printf( "(%lu deliveries a frame)\n", newDeliveries / BENCH_FRAMES );
+
+	bool same = oldDeliveries == newDeliveries;
+	if( same == false )
+		fprintf( stderr, "%lu deliveries, the multimap made %lu\n", newDeliveries, oldDeliveries );
+
+	listeners.clear();
+	pEvents->Terminate();
+	SGD::EventManager::DeleteInstance();
+
+	return (same == true) ? 0 : 1;
+}
@@ -0,0 +1,277 @@
+//*********************************************************************//
+//	File:		FixedStepTest.cpp
+//	Author:		
+//	Course:		
+//	Purpose:	the headless game loop at 30, 60 & 144 frames per
+//				second simulates exactly the same steps, through
+//				the gameplay step loop (RunFixedSteps)
+//*********************************************************************//
+
+#include "TestSupport.h"
+#include "HeadlessGame.h"
+
+#include "../SGD Wrappers/SGD_EventManager.h"
+#include "../SGD Wrappers/SGD_GraphicsManager.h"
+#include "../SGD Wrappers/SGD_Message.h"
+#include "../SGD Wrappers/SGD_MessageManager.h"
+
+#include "../source/Entity.h"
+#include "../source/EntityManager.h"
+#include "../source/FixedStepClock.h"
+#include "../source/FixedStepLoop.h"
+#include "../source/IGameState.h"
+#include "../source/MessageID.h"
+
+#include <vector>
+
+
+//*********************************************************************//
+// Simulated time & falling entities
+#define TEST_SECONDS		2
+#define TEST_ENTITIES		16
+
+
+//*********************************************************************//
+// Every position after every step, & the messages delivered
+static std::vector< SGD::Point >	s_vSteps;
+static unsigned int					s_unDelivered	= 0;
+
+
+//*********************************************************************//
+// FallingEntity
+//	- gravity makes the position depend on every earlier step
+//	- records its position after each step
+//	- the first one sends a message each step, and checks the last
+//	  step's message was delivered (within that step)
+class FallingEntity : public Entity
+{
+public:
+	explicit FallingEntity( bool sender )	: m_bSender( sender )	{	}
+
+	virtual void Update( float elapsedTime ) override
+	{
+		StorePreviousPosition();
+
+		m_vtVelocity += m_vtGravity * elapsedTime;
+		m_ptPosition += m_vtVelocity * elapsedTime;
+
+		s_vSteps.push_back( m_ptPosition );
+
+		if( m_bSender == true )
+		{
+			if( s_unDelivered != m_unSent )
+				m_bLate = true;
+
+			(new SGD::Message( MessageID::MSG_UNKNOWN ))->QueueMessage();
+			m_unSent++;
+		}
+	}
+
+	SGD::Point GetPreviousPosition( void ) const	{	return m_ptPrevPosition;	}
+
+	bool			m_bSender;
+	unsigned int	m_unSent	= 0;
+	bool			m_bLate		= false;
+};
+
+
+//*********************************************************************//
+// StepState
+//	- runs the frame's fixed steps with RunFixedSteps, like GameplayState
+//	- checks each rendered position lies between the last two steps
+class StepState : public IGameState
+{
+public:
+	virtual void Enter( void ) override
+	{
+		s_vSteps.clear();
+		s_unDelivered = 0;
+
+		SGD::EventManager::GetInstance()->Initialize();
+		SGD::MessageManager::GetInstance()->Initialize( &MessageProc );
+
+		m_hImage = SGD::GraphicsManager::GetInstance()->LoadTexture( L"resource/graphics/kc_BulletTypeA.png" );
+
+		for( int i = 0; i < TEST_ENTITIES; i++ )
+		{
+			FallingEntity* pEntity = new FallingEntity( i == 0 );
+			pEntity->SetImage( m_hImage );
+			pEntity->SetSize( SGD::Size{ 16, 16 } );
+			pEntity->SetPosition( SGD::Point{ 10.0f * i, 0.0f } );
+			pEntity->SetVelocity( SGD::Vector{ 7.0f * i, -30.0f - i } );
+
+			m_Entities.AddEntity( pEntity, 0 );
+			m_vEntities.push_back( pEntity );
+			pEntity->Release();
+		}
+	}
+
+	virtual void Exit( void ) override
+	{
+		m_bLate = m_vEntities[ 0 ]->m_bLate;
+
+		m_Entities.RemoveAll();
+		m_vEntities.clear();
+
+		SGD::GraphicsManager::GetInstance()->UnloadTexture( m_hImage );
+
+		SGD::MessageManager::GetInstance()->Terminate();
+		SGD::MessageManager::DeleteInstance();
+		SGD::EventManager::GetInstance()->Terminate();
+		SGD::EventManager::DeleteInstance();
+	}
+
+	virtual bool Update( float elapsedTime ) override
+	{
+		(void)elapsedTime;		// the steps use the fixed step
+
+		FixedStepSystems systems;
+		systems.pEntities = &m_Entities;
+
+		unsigned int steps = RunFixedSteps( Game::GetInstance()->GetClock(), systems );
+		if( steps != Game::GetInstance()->GetSimulationSteps() )
+			m_bWrongSteps = true;
+
+		m_unSteps += steps;
+		return true;
+	}
+
+	virtual void Render( float elapsedTime ) override
+	{
+		(void)elapsedTime;		// unused parameter
+
+		float alpha = Game::GetInstance()->GetInterpolation();
+		if( alpha < 0.0f || alpha >= 1.0f )
+			m_bInterpolated = false;
+
+		for( unsigned int i = 0; i < m_vEntities.size(); i++ )
+		{
+			SGD::Point ptPrev	= m_vEntities[ i ]->GetPreviousPosition();
+			SGD::Point ptCurr	= m_vEntities[ i ]->GetPosition();
+			SGD::Point ptRender	= m_vEntities[ i ]->GetRenderPosition();
+
+			if( (ptRender.y - ptPrev.y) * (ptRender.y - ptCurr.y) > 0.0001f )
+				m_bInterpolated = false;
+		}
+
+		m_Entities.RenderAll();
+	}
+
+	bool							m_bInterpolated	= true;
+	bool							m_bWrongSteps	= false;
+	bool							m_bLate			= false;	// a message waited past its step
+	unsigned int					m_unSteps		= 0;
+
+private:
+	static void MessageProc( const SGD::Message* pMsg )
+	{
+		(void)pMsg;				// unused parameter
+		s_unDelivered++;
+	}
+
+	EntityManager					m_Entities;
+	std::vector< FallingEntity* >	m_vEntities;
+	SGD::HTexture					m_hImage;
+};
+
+
+//*********************************************************************//
+// RunAtFrameRate
+//	- TEST_SECONDS of frames at fps, each frame's ticks rounded down
+//	  from the ideal frame boundary (as a real counter would be)
+static std::vector< SGD::Point > RunAtFrameRate( unsigned int fps )
+{
+	Game* pGame = Game::GetInstance();
+	CHECK( pGame->Initialize() == true );
+
+	StepState state;
+	pGame->ChangeState( &state );
+
+	long long		ticks		= 0;
+	unsigned int	frames		= fps * TEST_SECONDS;
+	unsigned int	wrongDraws	= 0;
+
+	for( unsigned int frame = 1; frame <= frames; frame++ )
+	{
+		long long boundary = HEADLESS_CLOCK_FREQUENCY * frame / fps;
+		SetHeadlessFrameTicks( boundary - ticks );
+		ticks = boundary;
+
+		CHECK( pGame->Update() == 0 );
+
+		// The last completed frame drew every entity
+		if( frame > 1 && SGD::GraphicsManager::GetInstance()->GetFrameStats().unSprites != TEST_ENTITIES )
+			wrongDraws++;
+	}
+
+	std::vector< SGD::Point > steps = s_vSteps;
+
+	pGame->Terminate();
+	Game::DeleteInstance();
+
+	CHECK( wrongDraws == 0 );
+	CHECK( state.m_bInterpolated == true );
+	CHECK( state.m_bWrongSteps == false );
+	CHECK( state.m_bLate == false );
+
+	// One message each step, every one delivered
+	CHECK( steps.size() == state.m_unSteps * TEST_ENTITIES );
+	CHECK( s_unDelivered == state.m_unSteps );
+
+	return steps;
+}
+
+
+//*********************************************************************//
+// SameSteps
+//	- bit-identical positions
+static bool SameSteps( const std::vector< SGD::Point >& a, const std::vector< SGD::Point >& b )
+{
+	if( a.size() != b.size() )
+		return false;
+
+	for( unsigned int i = 0; i < a.size(); i++ )
+		if( a[ i ].x != b[ i ].x || a[ i ].y != b[ i ].y )
+			return false;
+
+	return true;
+}
+
+
+//*********************************************************************//
+// TestClamp
+//	- a long frame runs the maximum steps and drops the rest
+static void TestClamp( void )
+{
+	FixedStepClock clock( 1.0f / 60.0f, 5 );
+	clock.Start( HEADLESS_CLOCK_FREQUENCY );
+
+	clock.Advance( HEADLESS_CLOCK_FREQUENCY );		// a one second hitch
+	CHECK( clock.GetSimulationSteps() == 5 );
+	CHECK( clock.GetInterpolation() == 0.0f );
+
+	clock.Advance( clock.GetStepTicks() / 2 );
+	CHECK( clock.GetSimulationSteps() == 0 );
+	CHECK( clock.GetInterpolation() > 0.49f && clock.GetInterpolation() < 0.51f );
+}
+
+
+//*********************************************************************//
+int main( void )
+{
+	std::vector< SGD::Point > steps30	= RunAtFrameRate( 30 );
+	std::vector< SGD::Point > steps60	= RunAtFrameRate( 60 );
+	std::vector< SGD::Point > steps144	= RunAtFrameRate( 144 );
+
+	// Every rate simulated the same whole steps of the same time
+	unsigned int expected = (unsigned int)( HEADLESS_CLOCK_FREQUENCY * TEST_SECONDS
+		/ (long long)( HEADLESS_CLOCK_FREQUENCY / 60.0 + 0.5 ) );
+
+	CHECK( steps60.size() == expected * TEST_ENTITIES );
+	CHECK( SameSteps( steps30, steps60 ) == true );
+	CHECK( SameSteps( steps144, steps60 ) == true );
+
+	TestClamp();
+
+	return TEST_RESULT();
+}
@@ -0,0 +1,293 @@
+//*********************************************************************//
+//	File:		FrameMemoryTest.cpp
+//	Author:		
+//	Course:		
+//	Purpose:	a steady gameplay-like frame makes no heap allocation:
+//				a counting operator new runs the headless game loop
+//*********************************************************************//
+
+#include "TestSupport.h"
+#include "HeadlessGame.h"
+
+#include "../SGD Wrappers/SGD_GraphicsManager.h"
+#include "../SGD Wrappers/SGD_Message.h"
+#include "../SGD Wrappers/SGD_MessageManager.h"
+
+#include "../source/BulletSystem.h"
+#include "../source/Entity.h"
+#include "../source/EntityManager.h"
+#include "../source/FrameArena.h"
+#include "../source/IGameState.h"
+#include "../source/MessageID.h"
+#include "../source/ParallaxBackground.h"
+
+#include <atomic>
+#include <cmath>
+#include <cstdlib>
+#include <new>
+#include <vector>
+
+
+//*********************************************************************//
+// The scene restarts every period, so the measured frames replay the
+// warm-up (every tile loaded, every vector & pool at its peak)
+#define TEST_PERIOD_FRAMES		240
+#define TEST_WARMUP_FRAMES		TEST_PERIOD_FRAMES
+#define TEST_STEADY_FRAMES		(3 * TEST_PERIOD_FRAMES)
+
+#define TEST_ENTITIES			96
+#define TEST_WALLS				32
+
+
+//*********************************************************************//
+// Counting operator new
+//	- counts every thread, like the debug CRT hook of Game.cpp
+static std::atomic< bool >			s_bCounting( false );
+static std::atomic< unsigned int >	s_unAllocations( 0 );
+
+void* operator new( std::size_t size )
+{
+	if( s_bCounting.load( std::memory_order_relaxed ) == true )
+		s_unAllocations.fetch_add( 1, std::memory_order_relaxed );
+
+	void* memory = malloc( (size != 0) ? size : 1 );
+	if( memory == nullptr )
+		throw std::bad_alloc();
+
+	return memory;
+}
+
+// (GCC sees free() on memory from a new expression once both inline)
+#if defined( __GNUC__ ) && !defined( __clang__ )
+#pragma GCC diagnostic ignored "-Wmismatched-new-delete"
+#endif
+
+void operator delete( void* memory ) noexcept
+{
+	free( memory );
+}
+
+
+//*********************************************************************//
+// BouncingEntity
+//	- moves around the screen, turning at the edges
+class BouncingEntity : public Entity
+{
+public:
+	virtual void Update( float elapsedTime ) override
+	{
+		StorePreviousPosition();
+		Entity::Update( elapsedTime );
+
+		if( (m_ptPosition.x < 0 && m_vtVelocity.x < 0) || (m_ptPosition.x > 1000 && m_vtVelocity.x > 0) )
+			m_vtVelocity.x = -m_vtVelocity.x;
+		if( (m_ptPosition.y < 64 && m_vtVelocity.y < 0) || (m_ptPosition.y > 740 && m_vtVelocity.y > 0) )
+			m_vtVelocity.y = -m_vtVelocity.y;
+	}
+
+	virtual void HandleCollision( const IEntity* pOther ) override
+	{
+		(void)pOther;			// unused parameter
+		SetDepth( GetDepth() + 1.0f );
+	}
+};
+
+
+//*********************************************************************//
+// SpawnMessage
+//	- asks the state to fire a bullet (like CreateBulletMessage)
+class SpawnMessage : public SGD::Message
+{
+public:
+	SpawnMessage( float x, float angle )
+		: Message( MessageID::MSG_CREATE_BULLET ), m_fX( x ), m_fAngle( angle )	{	}
+
+	float	m_fX;
+	float	m_fAngle;
+};
+
+
+//*********************************************************************//
+// FrameState
+//	- the gameplay frame without input or audio: streamed background,
+//	  bouncing entities colliding with each other, the walls & the
+//	  bullets, a bullet message per frame, the sorted render list
+class FrameState : public IGameState
+{
+public:
+	virtual void Enter( void ) override
+	{
+		s_pState = this;
+
+		Game* pGame = Game::GetInstance();
+		SGD::GraphicsManager* pGraphics = SGD::GraphicsManager::GetInstance();
+
+		SGD::MessageManager::GetInstance()->Initialize( &MessageProc );
+
+		m_hImage = pGraphics->LoadTexture( L"resource/graphics/kc_BulletTypeA.png" );
+
+		m_Background.AddLayer( L"resource/graphics/tiles/bg_back.tiles", 0.5f );
+		m_Background.AddLayer( L"resource/graphics/tiles/bg_middle.tiles", 0.8f );
+		m_Background.AddLayer( L"resource/graphics/tiles/bg_front.tiles", 1.0f );
+
+		m_Entities.SetJobPool( pGame->GetJobPool() );
+		m_Entities.SetParallelCollisions( true );
+
+		m_pBullets = new BulletSystem;
+		m_pBullets->SetBulletImage( Entity::ENT_BULLET_A, m_hImage, SGD::Size{ 16, 16 } );
+		m_Entities.AddEntity( m_pBullets, 2 );
+
+		for( int i = 0; i < TEST_ENTITIES + TEST_WALLS; i++ )
+		{
+			BouncingEntity* pEntity = new BouncingEntity;
+			pEntity->SetImage( m_hImage );
+			pEntity->SetSize( SGD::Size{ 24, 24 } );
+
+			m_Entities.AddEntity( pEntity, (i < TEST_ENTITIES) ? 0 : 1 );
+			m_vEntities.push_back( pEntity );
+			pEntity->Release();
+		}
+	}
+
+	virtual void Exit( void ) override
+	{
+		m_Entities.RemoveAll();
+		m_vEntities.clear();
+		m_pBullets->Release();
+		m_pBullets = nullptr;
+
+		m_Background.Clear();
+		SGD::GraphicsManager::GetInstance()->UnloadTexture( m_hImage );
+
+		SGD::MessageManager::GetInstance()->Terminate();
+		SGD::MessageManager::DeleteInstance();
+
+		s_pState = nullptr;
+	}
+
+	virtual bool Update( float elapsedTime ) override
+	{
+		(void)elapsedTime;		// the steps use the fixed step
+
+		Game* pGame = Game::GetInstance();
+
+		if( m_unFrame % TEST_PERIOD_FRAMES == 0 )
+			Restart();
+
+		// Pan the camera back & forth
+		unsigned int frame = m_unFrame++ % TEST_PERIOD_FRAMES;
+		m_ptCamera.x = 256.0f + 256.0f * sinf( frame * 0.05f );
+		m_ptCamera.y = 64.0f + 64.0f * cosf( frame * 0.03f );
+
+		m_Background.Update( m_ptCamera, pGame->GetScreenSize() );
+		SGD::GraphicsManager::GetInstance()->FinishLoads( true );
+
+		// One bullet a frame, from the pool
+		(new SpawnMessage( (float)(frame * 97 % 1000), frame * 0.7f ))->QueueMessage();
+
+		for( unsigned int step = 0; step < pGame->GetSimulationSteps(); step++ )
+		{
+			m_Entities.UpdateAll( pGame->GetFixedTimeStep() );
+
+			m_Entities.CheckCollisions( 0u, 0u );
+			m_Entities.CheckCollisions( 0u, 1u );
+			m_Entities.CheckCollisions( 0u, m_pBullets );
+
+			SGD::MessageManager::GetInstance()->Update();
+			m_Entities.ProcessQueues();
+		}
+
+		return true;
+	}
+
+	virtual void Render( float elapsedTime ) override
+	{
+		(void)elapsedTime;		// unused parameter
+
+		m_Background.Render( m_ptCamera, Game::GetInstance()->GetScreenSize() );
+		m_Entities.RenderAll();
+	}
+
+	BulletSystem*		m_pBullets		= nullptr;
+
+private:
+	// Restart
+	//	- put every entity back & clear the bullets
+	void Restart( void )
+	{
+		for( unsigned int i = 0; i < m_vEntities.size(); i++ )
+		{
+			BouncingEntity* pEntity = m_vEntities[ i ];
+			pEntity->SetPosition( SGD::Point{ (float)(i * 37 % 1000), 64.0f + (float)(i * 53 % 670) } );
+			pEntity->SetDepth( (float)(i % 7) );
+
+			if( i < TEST_ENTITIES )
+				pEntity->SetVelocity( SGD::Vector{ 40.0f + i % 13 * 9.0f, 30.0f - i % 11 * 7.0f } );
+		}
+
+		m_pBullets->DespawnAll();
+	}
+
+	static void MessageProc( const SGD::Message* pMsg )
+	{
+		const SpawnMessage* pSpawn = static_cast< const SpawnMessage* >( pMsg );
+
+		s_pState->m_pBullets->Spawn( Entity::ENT_BULLET_A, SGD::Point{ pSpawn->m_fX, 400.0f },
+			SGD::Vector{ 300.0f * cosf( pSpawn->m_fAngle ), 300.0f * sinf( pSpawn->m_fAngle ) }, pSpawn->m_fAngle );
+	}
+
+	static FrameState*	s_pState;
+
+	EntityManager		m_Entities;
+	std::vector< BouncingEntity* >	m_vEntities;		// held by m_Entities
+	ParallaxBackground	m_Background;
+	SGD::HTexture		m_hImage;
+	SGD::Point			m_ptCamera		= { 0, 0 };
+	unsigned int		m_unFrame		= 0;
+};
+
+/*static*/ FrameState* FrameState::s_pState = nullptr;
+
+
+//*********************************************************************//
+// main
+int main( void )
+{
+	Game* pGame = Game::GetInstance();
+	CHECK( pGame->Initialize() == true );
+
+	FrameState state;
+	pGame->ChangeState( &state );
+
+	for( int frame = 0; frame < TEST_WARMUP_FRAMES; frame++ )
+		CHECK( pGame->Update() == 0 );
+
+	FrameArena* pArena = pGame->GetFrameArena();
+	unsigned int overflows = pArena->GetOverflows();
+
+	s_bCounting = true;
+
+	for( int frame = 0; frame < TEST_STEADY_FRAMES; frame++ )
+		pGame->Update();
+
+	s_bCounting = false;
+
+	// Nothing from the heap: the snapshots came from the arena,
+	// within its block
+	CHECK( s_unAllocations == 0 );
+	CHECK( pArena->GetHighWater() > 0 );
+	CHECK( pArena->GetHighWater() <= pArena->GetCapacity() );
+	CHECK( pArena->GetOverflows() == overflows );
+
+	// The frame really ran
+	CHECK( state.m_pBullets->GetLiveCount() > 0 );
+
+	if( s_unAllocations != 0 )
+		fprintf( stderr, "%u heap allocations in %d steady frames\n", s_unAllocations.load(), TEST_STEADY_FRAMES );
+
+	pGame->ChangeState( nullptr );
+	pGame->Terminate();
+	Game::DeleteInstance();
+
+	return TEST_RESULT();
+}
@@ -0,0 +1,281 @@
+//*********************************************************************//
+//	File:		HandleBench.cpp
+//	Author:		
+//	Course:		
+//	Purpose:	the slot-array HandleManager against the vector of
+//				pairs & std::list free list it replaced: store /
+//				remove / lookup churn & iteration
+//*********************************************************************//
+
+#include "BenchSupport.h"
+
+#include "../SGD Wrappers/SGD_Handle.h"
+#include "../SGD Wrappers/SGD_HandleManager.h"
+
+#include <list>
+#include <utility>
+#include <vector>
+
+
+//*********************************************************************//
+#define BENCH_LIVE			1000		// voices playing at once
+#define BENCH_ROUNDS		1000000		// remove one & store one
+#define BENCH_LOOKUPS		8			// lookups per round
+#define BENCH_SLOTS			10000		// high-water mark of the sparse case
+#define BENCH_SPARSE_LIVE	1000
+#define BENCH_ITERATIONS	2000
+
+
+using SGD::SGD_IMPLEMENTATION::Handle;
+using SGD::SGD_IMPLEMENTATION::HandleDecoder;
+
+
+//*********************************************************************//
+// VoiceInfo
+//	- the size of the audio manager's voice data
+struct VoiceInfo
+{
+	void*			pVoice;
+	unsigned int	unSound;
+	unsigned int	unFlags;
+};
+
+
+//*********************************************************************//
+// OldHandleManager
+//	- the old HandleManager: std::pair< Handle, DataType > in a vector,
+//	  freed handles in a std::list, an 8-bit reuse counter & 24-bit
+//	  index, ForEach over every slot
+template< typename DataType >
+class OldHandleManager
+{
+public:
+	Handle StoreData( DataType data )
+	{
+		if( m_lFreeIndices.empty() == false )
+		{
+			unsigned long value = HandleDecoder::HandleToValue( m_lFreeIndices.back() );
+			m_lFreeIndices.pop_back();
+
+			unsigned long reuse = value >> 24;
+			reuse = (reuse == 255) ? 1 : reuse + 1;
+
+			Handle handle = HandleDecoder::ValueToHandle( (reuse << 24) | (value & 0xFFFFFF) );
+			unsigned int index = value & 0xFFFFFF;
+			m_vData[ index ].first	= handle;
+			m_vData[ index ].second	= data;
+			return handle;
+		}
+
+		Handle handle = HandleDecoder::ValueToHandle( (1ul << 24) | (unsigned long)m_vData.size() );
+		m_vData.push_back( std::make_pair( handle, data ) );
+		return handle;
+	}
+
+	DataType* GetData( Handle handle )
+	{
+		if( handle == SGD::INVALID_HANDLE )
+			return nullptr;
+
+		unsigned int index = HandleDecoder::HandleToValue( handle ) & 0xFFFFFF;
+		if( index >= m_vData.size() || m_vData[ index ].first != handle )
+			return nullptr;
+
+		return &m_vData[ index ].second;
+	}
+
+	bool RemoveData( Handle handle )
+	{
+		DataType* data = GetData( handle );
+		if( data == nullptr )
+			return false;
+
+		unsigned int index = HandleDecoder::HandleToValue( handle ) & 0xFFFFFF;
+		m_vData[ index ].first	= SGD::INVALID_HANDLE;
+		m_vData[ index ].second	= DataType();
+		m_lFreeIndices.push_back( handle );
+		return true;
+	}
+
+	template< typename TFunction >
+	void ForEach( TFunction function )
+	{
+		for( unsigned int i = 0; i < m_vData.size(); i++ )
+			if( m_vData[ i ].first != SGD::INVALID_HANDLE )
+				function( m_vData[ i ].second );
+	}
+
+	void Clear( void )
+	{
+		m_vData.clear();
+		m_lFreeIndices.clear();
+	}
+
+private:
+	std::vector< std::pair< Handle, DataType > >	m_vData;
+	std::list< Handle >								m_lFreeIndices;
+};
+
+
+//*********************************************************************//
+// NewHandleManager
+//	- the same calls on the current HandleManager
+template< typename DataType >
+class NewHandleManager
+{
+public:
+	Handle		StoreData	( DataType data )	{	return m_Manager.StoreData( data );				}
+	DataType*	GetData		( Handle handle )	{	return m_Manager.GetData( handle );				}
+	bool		RemoveData	( Handle handle )	{	return m_Manager.RemoveData( handle, nullptr );	}
+	void		Clear		( void )			{	m_Manager.Clear();								}
+
+	template< typename TFunction >
+	void ForEach( TFunction function )
+	{
+		m_Manager.ForEach( &NewHandleManager::Visit< TFunction >, &function );
+	}
+
+private:
+	template< typename TFunction >
+	static bool Visit( Handle handle, DataType& data, TFunction* function )
+	{
+		(void)handle;			// unused parameter
+		(*function)( data );
+		return true;
+	}
+
+	SGD::SGD_IMPLEMENTATION::HandleManager< DataType >	m_Manager;
+};
+
+
+//*********************************************************************//
+// Random
+static unsigned int s_unSeed = 17;
+
+static unsigned int RandomInt( unsigned int range )
+{
+	s_unSeed = s_unSeed * 1664525u + 1013904223u;
+	return (s_unSeed >> 8) % range;
+}
+
+
+//*********************************************************************//
+// Churn
+//	- remove a live handle & store a new one in its place, then look
+//	  up live handles (the picks are drawn beforehand)
+//	- returns a checksum of the data found
+template< typename Manager >
+static void Fill( Manager& manager, std::vector< Handle >& live )
+{
+	manager.Clear();
+	live.clear();
+
+	for( unsigned int i = 0; i < BENCH_LIVE; i++ )
+		live.push_back( manager.StoreData( VoiceInfo{ nullptr, i, 0 } ) );
+}
+
+template< typename Manager >
+static void Churn( Manager& manager, std::vector< Handle >& live, const std::vector< unsigned int >& picks )
+{
+	for( unsigned int round = 0; round < BENCH_ROUNDS; round++ )
+	{
+		unsigned int victim = picks[ round ];
+		manager.RemoveData( live[ victim ] );
+		live[ victim ] = manager.StoreData( VoiceInfo{ nullptr, round, 0 } );
+	}
+}
+
+template< typename Manager >
+static unsigned long Lookup( Manager& manager, const std::vector< Handle >& live, const std::vector< unsigned int >& picks )
+{
+	unsigned long sum = 0;
+
+	for( unsigned int l = 0; l < BENCH_LOOKUPS; l++ )
+		for( unsigned int round = 0; round < BENCH_ROUNDS; round++ )
+		{
+			VoiceInfo* info = manager.GetData( live[ picks[ round ] ] );
+			if( info != nullptr )
+				sum += info->unSound;
+		}
+
+	return sum;
+}
+
+
+//*********************************************************************//
+// Iterate
+//	- a sparse manager (10% live after a burst): ForEach over it
+template< typename Manager >
+static unsigned long Iterate( Manager& manager, bool fill )
+{
+	if( fill == true )
+	{
+		manager.Clear();
+
+		std::vector< Handle > handles;
+		for( unsigned int i = 0; i < BENCH_SLOTS; i++ )
+			handles.push_back( manager.StoreData( VoiceInfo{ nullptr, i, 0 } ) );
+
+		for( unsigned int i = 0; i < BENCH_SLOTS; i++ )
+			if( i % (BENCH_SLOTS / BENCH_SPARSE_LIVE) != 0 )
+				manager.RemoveData( handles[ i ] );
+
+		return 0;
+	}
+
+	unsigned long sum = 0;
+	for( int n = 0; n < BENCH_ITERATIONS; n++ )
+		manager.ForEach( [&sum]( VoiceInfo& info ) { sum += info.unSound; } );
+
+	return sum;
+}
+
+
+//*********************************************************************//
+// main
+int main( void )
+{
+	OldHandleManager< VoiceInfo >	oldManager;
+	NewHandleManager< VoiceInfo >	newManager;
+
+	bool same = true;
+	unsigned long oldSum = 0, newSum = 0;
+
+	BenchHeader( "HandleBench: (vector of pairs & std::list / slot array & dense data)" );
+
+
+	// Churn & lookups
+	std::vector< unsigned int > picks( BENCH_ROUNDS );
+	for( unsigned int round = 0; round < BENCH_ROUNDS; round++ )
+		picks[ round ] = RandomInt( BENCH_LIVE );
+
+	std::vector< Handle > oldLive, newLive;
+
+	double oldMs = BenchMeasure( [&]() { Fill( oldManager, oldLive ); }, [&]() { Churn( oldManager, oldLive, picks ); } );
+	double newMs = BenchMeasure( [&]() { Fill( newManager, newLive ); }, [&]() { Churn( newManager, newLive, picks ); } );
+	BenchReport( "1M remove & store, 1k live", oldMs, newMs );
+
+	oldMs = BenchMeasure( [&]() { }, [&]() { oldSum = Lookup( oldManager, oldLive, picks ); } );
+	newMs = BenchMeasure( [&]() { }, [&]() { newSum = Lookup( newManager, newLive, picks ); } );
+	BenchReport( "8M lookups, 1k live", oldMs, newMs );
+
+	if( oldSum != newSum )
+	{
+		fprintf( stderr, "lookups: other data found\n" );
+		same = false;
+	}
+
+
+	// Iteration
+	oldMs = BenchMeasure( [&]() { Iterate( oldManager, true ); }, [&]() { oldSum = Iterate( oldManager, false ); } );
+	newMs = BenchMeasure( [&]() { Iterate( newManager, true ); }, [&]() { newSum = Iterate( newManager, false ); } );
+	BenchReport( "ForEach x2000: 1k live of 10k slots", oldMs, newMs );
+
+	if( oldSum != newSum )
+	{
+		fprintf( stderr, "ForEach: other data visited\n" );
+		same = false;
+	}
+
+	return (same == true) ? 0 : 1;
+}
@@ -0,0 +1,136 @@
+//*********************************************************************//
+//	File:		HeadlessGame.cpp
+//	Author:		
+//	Course:		
+//	Purpose:	Game for the headless tests: HeadlessGame.cpp defines
+//				the Game methods in place of Game.cpp
+//*********************************************************************//
+
+#include "HeadlessGame.h"
+
+#include "../SGD Wrappers/SGD_AudioManager.h"
+#include "../SGD Wrappers/SGD_GraphicsManager.h"
+
+#include "../source/FrameArena.h"
+#include "../source/IGameState.h"
+#include "../source/JobPool.h"
+
+
+//*********************************************************************//
+// Ticks of the next frame (1/60 s until a test sets it)
+static long long	s_llFrameTicks	= HEADLESS_CLOCK_FREQUENCY / 60;
+
+void SetHeadlessFrameTicks( long long ticks )
+{
+	s_llFrameTicks = ticks;
+}
+
+
+//*********************************************************************//
+// AudioManager
+//	- the XAudio2 backend does not build headless: there is no audio
+//	  manager, so a LoadBatch can only load textures
+/*static*/ SGD::AudioManager* SGD::AudioManager::GetInstance( void )
+{
+	return nullptr;
+}
+
+
+//*********************************************************************//
+// SINGLETON
+/*static*/ Game* Game::s_pInstance = nullptr;
+
+/*static*/ Game* Game::GetInstance( void )
+{
+	if( s_pInstance == nullptr )
+		s_pInstance = new Game;
+
+	return s_pInstance;
+}
+
+/*static*/ void Game::DeleteInstance( void )
+{
+	delete s_pInstance;
+	s_pInstance = nullptr;
+}
+
+
+//*********************************************************************//
+// Initialize
+//	- the wrappers & systems the tests need
+bool Game::Initialize( void )
+{
+	if( SGD::GraphicsManager::GetInstance()->Initialize( L"Kanmaku - Headless", m_szScreenSize, false ) == false )
+		return false;
+
+	m_pFrameArena = new FrameArena;
+
+	m_pJobs = new JobPool;
+	m_pJobs->Initialize();
+
+	m_Clock.Start( HEADLESS_CLOCK_FREQUENCY );
+	return true;
+}
+
+
+//*********************************************************************//
+// Update
+//	- the frame of Game::Update, timed by SetHeadlessFrameTicks
+int Game::Update( void )
+{
+	m_pFrameArena->Reset();
+
+	if( SGD::GraphicsManager::GetInstance()->Update() == false )
+		return +1;
+
+	float elapsedTime = (float)( (double)s_llFrameTicks / m_Clock.GetFrequency() );
+	if( elapsedTime > 0.125f )
+		elapsedTime = 0.125f;
+
+	m_Clock.Advance( s_llFrameTicks );
+
+	if( m_pCurrState != nullptr )
+	{
+		if( m_pCurrState->Update( elapsedTime ) == false )
+			return +1;
+
+		m_pCurrState->Render( elapsedTime );
+	}
+
+	return 0;
+}
+
+
+//*********************************************************************//
+// Terminate
+void Game::Terminate( void )
+{
+	ChangeState( nullptr );
+
+	if( m_pJobs != nullptr )
+	{
+		m_pJobs->Terminate();
+		delete m_pJobs;
+		m_pJobs = nullptr;
+	}
+
+	delete m_pFrameArena;
+	m_pFrameArena = nullptr;
+
+	SGD::GraphicsManager::GetInstance()->Terminate();
+	SGD::GraphicsManager::DeleteInstance();
+}
+
+
+//*********************************************************************//
+// ChangeState
+void Game::ChangeState( IGameState* pNextState )
+{
+	if( m_pCurrState != nullptr )
+		m_pCurrState->Exit();
+
+	m_pCurrState = pNextState;
+
+	if( m_pCurrState != nullptr )
+		m_pCurrState->Enter();
+}
@@ -0,0 +1,25 @@
+//*********************************************************************//
+//	File:		HeadlessGame.h
+//	Author:		
+//	Course:		
+//	Purpose:	Game for the headless tests: HeadlessGame.cpp defines
+//				the Game methods in place of Game.cpp
+//*********************************************************************//
+
+#pragma once
+
+#include "../source/Game.h"
+
+
+//*********************************************************************//
+// Headless Game
+//	- Initialize starts the headless GraphicsManager, the frame arena
+//	  & the job pool (no Input, Audio, font, animations or residency:
+//	  AudioManager::GetInstance is null),
+//	  and no state: the test calls ChangeState with its own
+//	- Update runs one frame like Game::Update, but the frame's time
+//	  comes from SetHeadlessFrameTicks instead of the performance
+//	  counter (HEADLESS_CLOCK_FREQUENCY ticks per second)
+#define HEADLESS_CLOCK_FREQUENCY	10000000LL		// a typical QueryPerformanceFrequency
+
+void	SetHeadlessFrameTicks	( long long ticks );		// time of the next Game::Update
@@ -0,0 +1,210 @@
+//*********************************************************************//
+//	File:		MPSCQueueTest.cpp
+//	Author:		
+//	Course:		
+//	Purpose:	8 producer threads queue messages & events while the
+//				main thread updates: nothing lost, each thread's
+//				order kept
+//*********************************************************************//
+
+#include "TestSupport.h"
+
+#include "../SGD Wrappers/SGD_MPSCQueue.h"
+#include "../SGD Wrappers/SGD_MessageManager.h"
+#include "../SGD Wrappers/SGD_Message.h"
+#include "../SGD Wrappers/SGD_EventManager.h"
+#include "../SGD Wrappers/SGD_Event.h"
+#include "../SGD Wrappers/SGD_IListener.h"
+
+#include "../source/MessageID.h"
+
+#include <atomic>
+#include <thread>
+#include <vector>
+
+
+//*********************************************************************//
+// Producer threads & items per thread
+#define PRODUCERS		8
+#define ITEMS			200000
+#define EVENT_EVERY		4			// one event per 4 messages
+
+
+//*********************************************************************//
+// StressMessage
+//	- which thread queued it & its place in that thread's order
+class StressMessage : public SGD::Message
+{
+public:
+	StressMessage( int producer, int sequence )
+		: Message( MessageID::MSG_UNKNOWN ), m_nProducer( producer ), m_nSequence( sequence )	{	}
+
+	int		m_nProducer;
+	int		m_nSequence;
+};
+
+struct StressData
+{
+	int		nProducer;
+	int		nSequence;
+};
+
+
+//*********************************************************************//
+// Consumer side (main thread)
+static int			s_nNextMessage[ PRODUCERS ]	= { };
+static int			s_nNextEvent[ PRODUCERS ]	= { };
+static long long	s_nMessages					= 0;
+static long long	s_nEvents					= 0;
+static bool			s_bOrderKept				= true;
+
+static void StressMessageProc( const SGD::Message* pMsg )
+{
+	const StressMessage* pStress = static_cast< const StressMessage* >( pMsg );
+
+	if( pStress->m_nSequence != s_nNextMessage[ pStress->m_nProducer ] )
+		s_bOrderKept = false;
+
+	s_nNextMessage[ pStress->m_nProducer ] = pStress->m_nSequence + 1;
+	++s_nMessages;
+}
+
+class StressListener : public SGD::IListener
+{
+public:
+	virtual void HandleEvent( const SGD::Event* pEvent ) override
+	{
+		StressData* pData = reinterpret_cast< StressData* >( pEvent->GetData() );
+
+		if( pData->nSequence != s_nNextEvent[ pData->nProducer ] )
+			s_bOrderKept = false;
+
+		s_nNextEvent[ pData->nProducer ] = pData->nSequence + 1;
+		++s_nEvents;
+
+		delete pData;
+	}
+};
+
+
+//*********************************************************************//
+// TestRawQueue
+//	- a 4-cell ring, so most pushes take the overflow path
+static void TestRawQueue( void )
+{
+	SGD::SGD_IMPLEMENTATION::MPSCQueue< long long > queue( 4 );
+
+	std::atomic< int >			done( 0 );
+	std::vector< std::thread >	producers;
+
+	for( int p = 0; p < PRODUCERS; ++p )
+		producers.emplace_back( [ &queue, &done, p ]
+		{
+			for( int i = 0; i < ITEMS; ++i )
+				queue.Push( ((long long)p << 32) | i );
+
+			++done;
+		} );
+
+	int			next[ PRODUCERS ]	= { };
+	long long	count				= 0;
+	bool		ordered				= true;
+
+	auto consume = [ &next, &count, &ordered ]( long long item )
+	{
+		int producer	= (int)(item >> 32);
+		int sequence	= (int)(item & 0xFFFFFFFF);
+
+		if( sequence != next[ producer ] )
+			ordered = false;
+
+		next[ producer ] = sequence + 1;
+		++count;
+	};
+
+	while( done.load() < PRODUCERS )
+		queue.Drain( consume );
+
+	for( unsigned int i = 0; i < producers.size(); ++i )
+		producers[ i ].join();
+
+	queue.Drain( consume );
+
+	CHECK( ordered == true );
+	CHECK( count == (long long)PRODUCERS * ITEMS );
+	CHECK( queue.IsEmpty() == true );
+}
+
+
+//*********************************************************************//
+// TestManagers
+//	- every producer queues messages & events while the main thread
+//	  updates both managers
+static void TestManagers( void )
+{
+	SGD::MessageManager*	pMessages	= SGD::MessageManager::GetInstance();
+	SGD::EventManager*		pEvents		= SGD::EventManager::GetInstance();
+
+	CHECK( pMessages->Initialize( &StressMessageProc ) == true );
+	CHECK( pEvents->Initialize() == true );
+
+	// The listener unregisters in its destructor, before Terminate
+	StressListener* pListener = new StressListener;
+	pListener->RegisterForEvent( "STRESS" );
+
+	std::atomic< int >			done( 0 );
+	std::vector< std::thread >	producers;
+
+	for( int p = 0; p < PRODUCERS; ++p )
+		producers.emplace_back( [ &done, p ]
+		{
+			for( int i = 0; i < ITEMS; ++i )
+			{
+				(new StressMessage( p, i ))->QueueMessage();
+
+				if( i % EVENT_EVERY == 0 )
+					(new SGD::Event( "STRESS", new StressData{ p, i / EVENT_EVERY } ))->QueueEvent();
+			}
+
+			++done;
+		} );
+
+	while( done.load() < PRODUCERS )
+	{
+		pMessages->Update();
+		pEvents->Update();
+	}
+
+	for( unsigned int i = 0; i < producers.size(); ++i )
+		producers[ i ].join();
+
+	pMessages->Update();
+	pEvents->Update();
+
+	CHECK( s_bOrderKept == true );
+	CHECK( s_nMessages == (long long)PRODUCERS * ITEMS );
+	CHECK( s_nEvents == (long long)PRODUCERS * (ITEMS / EVENT_EVERY) );
+
+	// Queued but never processed: ClearMessages releases them
+	for( int i = 0; i < 100; ++i )
+		(new StressMessage( 0, 0 ))->QueueMessage();
+
+	CHECK( pMessages->ClearMessages() == true );
+
+	delete pListener;
+
+	pMessages->Terminate();
+	SGD::MessageManager::DeleteInstance();
+	pEvents->Terminate();
+	SGD::EventManager::DeleteInstance();
+}
+
+
+//*********************************************************************//
+int main( void )
+{
+	TestRawQueue();
+	TestManagers();
+
+	return TEST_RESULT();
+}
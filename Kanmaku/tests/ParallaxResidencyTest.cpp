@@ -0,0 +1,220 @@
+//*********************************************************************//
+//	File:		ParallaxResidencyTest.cpp
+//	Author:		
+//	Course:		
+//	Purpose:	the parallax tiles resident along a camera path:
+//				every tile near the view is loaded, the rest are
+//				evicted down to the budget
+//*********************************************************************//
+
+#include "TestSupport.h"
+#include "HeadlessGame.h"
+
+#include "../SGD Wrappers/SGD_GraphicsManager.h"
+#include "../SGD Wrappers/SGD_TextureAtlas.h"
+
+#include "../source/ParallaxBackground.h"
+
+#include <cstdio>
+#include <vector>
+
+
+//*********************************************************************//
+// Layers of GameplayState
+#define TEST_LAYERS			3
+
+static const char*		s_szIndices[ TEST_LAYERS ]		= { "resource/graphics/tiles/bg_back.tiles", "resource/graphics/tiles/bg_middle.tiles", "resource/graphics/tiles/bg_front.tiles" };
+static const wchar_t*	s_wszIndices[ TEST_LAYERS ]		= { L"resource/graphics/tiles/bg_back.tiles", L"resource/graphics/tiles/bg_middle.tiles", L"resource/graphics/tiles/bg_front.tiles" };
+static const float		s_fParallax[ TEST_LAYERS ]		= { 0.5f, 0.8f, 1.0f };
+
+// A small view & margin, so the path leaves tiles behind
+static const SGD::Size	s_szView						= { 512, 384 };
+#define TEST_MARGIN			64.0f
+
+
+//*********************************************************************//
+// IsWanted
+//	- the tile overlaps the view grown by the margin (in layer pixels)
+static bool IsWanted( const SGD::TileLayerIndex& index, float parallax, SGD::Point camera, unsigned int column, unsigned int row )
+{
+	if( index.HasTile( column, row ) == false )
+		return false;
+
+	float left		= camera.x * parallax - TEST_MARGIN;
+	float top		= camera.y * parallax - TEST_MARGIN;
+	float right		= left + s_szView.width  + 2 * TEST_MARGIN;
+	float bottom	= top  + s_szView.height + 2 * TEST_MARGIN;
+
+	float tileLeft	= (float)(column * index.unTileWidth);
+	float tileTop	= (float)(row * index.unTileHeight);
+
+	return tileLeft < right && tileLeft + index.unTileWidth > left
+		&& tileTop < bottom && tileTop + index.unTileHeight > top;
+}
+
+
+//*********************************************************************//
+// Path
+//	- pan right & down across the front layer, then back to the start
+static std::vector< SGD::Point > BuildPath( void )
+{
+	std::vector< SGD::Point > path;
+
+	for( int step = 0; step <= 48; step++ )
+		path.push_back( SGD::Point{ 32.0f * step, 8.0f * step } );
+
+	for( int step = 47; step >= 0; step-- )
+		path.push_back( SGD::Point{ 32.0f * step, 8.0f * step } );
+
+	return path;
+}
+
+
+//*********************************************************************//
+// RunPath
+//	- one frame per camera position: checks the resident tiles
+//	  against the tiles the test expects to be wanted
+static void RunPath( ParallaxBackground& background, const SGD::TileLayerIndex* indices, unsigned int budget )
+{
+	Game* pGame = Game::GetInstance();
+	SGD::GraphicsManager* pGraphics = SGD::GraphicsManager::GetInstance();
+
+	std::vector< SGD::Point > path = BuildPath();
+
+	unsigned int	missing		= 0;		// wanted, not resident
+	unsigned int	stray		= 0;		// resident without a file
+	unsigned int	overBudget	= 0;		// over budget with an unwanted tile
+	unsigned int	unloaded	= 0;		// view not loaded after the wait
+	unsigned int	holes		= 0;		// visible, not drawn
+
+	for( unsigned int p = 0; p < path.size(); p++ )
+	{
+		CHECK( pGame->Update() == 0 );
+
+		background.Update( path[ p ], s_szView );
+		pGraphics->FinishLoads( true );
+
+		unsigned int wanted = 0;
+
+		for( unsigned int l = 0; l < TEST_LAYERS; l++ )
+			for( unsigned int row = 0; row < indices[ l ].unRows; row++ )
+				for( unsigned int column = 0; column < indices[ l ].unColumns; column++ )
+				{
+					bool resident = background.IsTileResident( l, column, row );
+
+					if( IsWanted( indices[ l ], s_fParallax[ l ], path[ p ], column, row ) == true )
+					{
+						wanted++;
+						if( resident == false )
+							missing++;
+					}
+					else if( resident == true && indices[ l ].HasTile( column, row ) == false )
+						stray++;
+				}
+
+		const ParallaxBackground::Stats& stats = background.GetStats();
+		if( stats.unResidentBytes > budget && stats.unResident != wanted )
+			overBudget++;
+
+		if( background.IsViewLoaded( path[ p ], s_szView ) == false )
+			unloaded++;
+
+		background.Render( path[ p ], s_szView );
+		if( background.GetStats().unDrawn != background.GetStats().unVisible )
+			holes++;
+	}
+
+	CHECK( missing == 0 );
+	CHECK( stray == 0 );
+	CHECK( overBudget == 0 );
+	CHECK( unloaded == 0 );
+	CHECK( holes == 0 );
+}
+
+
+//*********************************************************************//
+// CountTiles
+//	- tiles with a file, in every layer
+static unsigned int CountTiles( const SGD::TileLayerIndex* indices )
+{
+	unsigned int count = 0;
+
+	for( unsigned int l = 0; l < TEST_LAYERS; l++ )
+		for( unsigned int t = 0; t < indices[ l ].vHasTile.size(); t++ )
+			if( indices[ l ].vHasTile[ t ] != 0 )
+				count++;
+
+	return count;
+}
+
+
+//*********************************************************************//
+// TestPath
+//	- under a budget of tileBudget tiles
+static void TestPath( const SGD::TileLayerIndex* indices, unsigned int tileBudget )
+{
+	unsigned int tileBytes	= indices[ 0 ].unTileWidth * indices[ 0 ].unTileHeight * 4;
+	unsigned int budget		= tileBudget * tileBytes;
+
+	ParallaxBackground background;
+	background.SetBudget( budget );
+	background.SetMargin( TEST_MARGIN );
+
+	for( unsigned int l = 0; l < TEST_LAYERS; l++ )
+		CHECK( background.AddLayer( s_wszIndices[ l ], s_fParallax[ l ] ) == true );
+
+	RunPath( background, indices, budget );
+
+	const ParallaxBackground::Stats& stats = background.GetStats();
+	unsigned int tiles = CountTiles( indices );
+
+	if( tileBudget >= tiles )
+	{
+		// Everything fits: each tile loads once, none is evicted
+		CHECK( stats.unEvictions == 0 );
+		CHECK( stats.unLoads == stats.unResident );
+		CHECK( stats.unLoads <= tiles );
+	}
+	else
+	{
+		// The path left tiles behind: they were evicted & reloaded
+		CHECK( stats.unEvictions > 0 );
+		CHECK( stats.unLoads == stats.unResident + stats.unEvictions );
+	}
+
+	background.Clear();
+}
+
+
+//*********************************************************************//
+// main
+int main( void )
+{
+	// The expected tiles come from the indices themselves
+	SGD::TileLayerIndex indices[ TEST_LAYERS ];
+
+	for( unsigned int l = 0; l < TEST_LAYERS; l++ )
+	{
+		FILE* file = fopen( s_szIndices[ l ], "rb" );
+		CHECK( file != nullptr );
+		CHECK( indices[ l ].Read( file ) == true );
+		if( file != nullptr )
+			fclose( file );
+	}
+
+	if( s_nTestFailures != 0 )
+		return TEST_RESULT();
+
+
+	Game* pGame = Game::GetInstance();
+	CHECK( pGame->Initialize() == true );
+
+	TestPath( indices, 1000 );		// everything fits
+	TestPath( indices, 24 );		// the path must evict
+	TestPath( indices, 1 );			// only the wanted tiles stay
+
+	pGame->Terminate();
+	Game::DeleteInstance();
+
+	return TEST_RESULT();
+}
@@ -0,0 +1,145 @@
+//*********************************************************************//
+//	File:		ParallelUpdateBench.cpp
+//	Author:		
+//	Course:		
+//	Purpose:	EntityManager::UpdateAll split across 1 to N threads,
+//				against the serial UpdateAll
+//*********************************************************************//
+
+#include "BenchSupport.h"
+#include "HeadlessGame.h"
+
+#include "../source/Entity.h"
+#include "../source/EntityManager.h"
+#include "../source/JobPool.h"
+
+#include <cmath>
+#include <thread>
+#include <vector>
+
+
+//*********************************************************************//
+// A large parallel-safe bucket & a small serial one
+#define BENCH_ENTITIES		100000
+#define BENCH_SERIAL		16
+#define BENCH_FRAMES		60
+#define BENCH_STEP			(1.0f / 60.0f)
+
+
+//*********************************************************************//
+// HomingEntity
+//	- turns toward a fixed target: a few dozen flops per Update,
+//	  writing only to itself (parallel-safe)
+class HomingEntity : public Entity
+{
+public:
+	virtual void Update( float elapsedTime ) override
+	{
+		SGD::Vector toTarget = SGD::Point{ 512, 384 } - m_ptPosition;
+		float distance = sqrtf( toTarget.x * toTarget.x + toTarget.y * toTarget.y ) + 1.0f;
+
+		m_vtVelocity.x += (toTarget.x / distance * 200.0f - m_vtVelocity.x) * elapsedTime;
+		m_vtVelocity.y += (toTarget.y / distance * 200.0f - m_vtVelocity.y) * elapsedTime;
+		m_fRotation = atan2f( m_vtVelocity.y, m_vtVelocity.x );
+
+		Entity::Update( elapsedTime );
+	}
+};
+
+
+//*********************************************************************//
+// Checksum
+//	- of every position, to see that each thread count moved the
+//	  entities alike
+static double Checksum( const std::vector< HomingEntity* >& entities )
+{
+	double sum = 0.0;
+	for( unsigned int i = 0; i < entities.size(); i++ )
+		sum += entities[ i ]->GetPosition().x + 3.0 * entities[ i ]->GetPosition().y;
+	return sum;
+}
+
+
+//*********************************************************************//
+// main
+int main( void )
+{
+	Game* pGame = Game::GetInstance();
+	if( pGame->Initialize() == false )
+		return 1;
+
+	EntityManager manager;
+	manager.SetBucketParallel( 0, true );
+
+	std::vector< HomingEntity* > entities;
+	for( unsigned int i = 0; i < BENCH_ENTITIES + BENCH_SERIAL; i++ )
+	{
+		HomingEntity* pEntity = new HomingEntity;
+		manager.AddEntity( pEntity, (i < BENCH_ENTITIES) ? 0 : 1 );
+		entities.push_back( pEntity );
+		pEntity->Release();
+	}
+
+	auto reset = [&]()
+	{
+		for( unsigned int i = 0; i < entities.size(); i++ )
+		{
+			entities[ i ]->SetPosition( SGD::Point{ (float)(i * 37 % 1024), (float)(i * 53 % 768) } );
+			entities[ i ]->SetVelocity( SGD::Vector{ 0, 0 } );
+		}
+	};
+
+	auto run = [&]()
+	{
+		for( int frame = 0; frame < BENCH_FRAMES; frame++ )
+			manager.UpdateAll( BENCH_STEP );
+	};
+
+
+	// Serial UpdateAll
+	manager.SetParallelUpdate( false );
+	double serialMs = BenchMeasure( reset, run );
+	double serialSum = Checksum( entities );
+
+	char title[ 128 ];
+	snprintf( title, sizeof( title ), "ParallelUpdateBench: 100k entities, 60 frames, %u hardware threads (serial UpdateAll / parallel)",
+		std::thread::hardware_concurrency() );
+	BenchHeader( title );
+
+
+	// 1 to N threads (the caller & N - 1 workers)
+	unsigned int maxThreads = std::thread::hardware_concurrency();
+	if( maxThreads < 4 )
+		maxThreads = 4;
+
+	bool same = true;
+	manager.SetParallelUpdate( true );
+
+	for( unsigned int threads = 1; threads <= maxThreads; threads *= 2 )
+	{
+		JobPool pool;
+		pool.Initialize( threads - 1 );
+		manager.SetJobPool( &pool );
+
+		double parallelMs = BenchMeasure( reset, run );
+
+		char name[ 64 ];
+		snprintf( name, sizeof( name ), "%u threads", threads );
+		BenchReport( name, serialMs, parallelMs );
+
+		if( Checksum( entities ) != serialSum )
+		{
+			fprintf( stderr, "%s: the entities moved differently\n", name );
+			same = false;
+		}
+
+		manager.SetJobPool( nullptr );
+		pool.Terminate();
+	}
+
+	manager.RemoveAll();
+	pGame->Terminate();
+	Game::DeleteInstance();
+
+	return (same == true) ? 0 : 1;
+}
@@ -0,0 +1,168 @@
+//*********************************************************************//
+//	File:		ParallelUpdateTest.cpp
+//	Author:		
+//	Course:		
+//	Purpose:	UpdateAll across the job pool moves the entities of a
+//				parallel bucket like the serial UpdateAll, and keeps
+//				every other bucket on the calling thread
+//*********************************************************************//
+
+#include "TestSupport.h"
+
+#include "../source/Entity.h"
+#include "../source/EntityManager.h"
+#include "../source/JobPool.h"
+
+#include <cmath>
+#include <thread>
+#include <vector>
+
+
+//*********************************************************************//
+// A large parallel-safe bucket, a small one marked parallel (below
+// the split size) & a serial one
+#define TEST_PARALLEL		5000
+#define TEST_SMALL			16
+#define TEST_SERIAL			16
+#define TEST_FRAMES			30
+#define TEST_STEP			(1.0f / 60.0f)
+
+
+//*********************************************************************//
+// HomingEntity
+//	- turns toward a fixed target, writing only to itself
+//	- counts its updates & the ones off the main thread
+class HomingEntity : public Entity
+{
+public:
+	virtual void Update( float elapsedTime ) override
+	{
+		SGD::Vector toTarget = SGD::Point{ 512, 384 } - m_ptPosition;
+		float distance = sqrtf( toTarget.x * toTarget.x + toTarget.y * toTarget.y ) + 1.0f;
+
+		m_vtVelocity.x += (toTarget.x / distance * 200.0f - m_vtVelocity.x) * elapsedTime;
+		m_vtVelocity.y += (toTarget.y / distance * 200.0f - m_vtVelocity.y) * elapsedTime;
+
+		Entity::Update( elapsedTime );
+
+		m_unUpdates++;
+		if( std::this_thread::get_id() != s_MainThread )
+			m_unOffMain++;
+	}
+
+	static std::thread::id	s_MainThread;
+
+	unsigned int	m_unUpdates		= 0;
+	unsigned int	m_unOffMain		= 0;
+};
+
+/*static*/ std::thread::id HomingEntity::s_MainThread;
+
+
+//*********************************************************************//
+// Fill
+//	- the three buckets, with the same start for every manager
+static void Fill( EntityManager& manager, std::vector< HomingEntity* >& entities )
+{
+	static const unsigned int counts[ 3 ] = { TEST_PARALLEL, TEST_SMALL, TEST_SERIAL };
+
+	for( unsigned int bucket = 0; bucket < 3; bucket++ )
+	{
+		for( unsigned int i = 0; i < counts[ bucket ]; i++ )
+		{
+			HomingEntity* pEntity = new HomingEntity;
+			pEntity->SetPosition( SGD::Point{ (float)(i * 37 % 1024), (float)(i * 53 % 768) } );
+			pEntity->SetVelocity( SGD::Vector{ (float)(i % 13) * 5.0f, (float)(i % 11) * -4.0f } );
+
+			manager.AddEntity( pEntity, bucket );
+			entities.push_back( pEntity );
+			pEntity->Release();
+		}
+	}
+}
+
+
+//*********************************************************************//
+// main
+int main( void )
+{
+	HomingEntity::s_MainThread = std::this_thread::get_id();
+
+	JobPool jobs;
+	jobs.Initialize( 3 );
+
+
+	EntityManager				serial;
+	std::vector< HomingEntity* >	serialEntities;
+	Fill( serial, serialEntities );
+
+	EntityManager				parallel;
+	std::vector< HomingEntity* >	parallelEntities;
+	Fill( parallel, parallelEntities );
+
+	parallel.SetJobPool( &jobs );
+	parallel.SetParallelUpdate( true );
+	parallel.SetBucketParallel( 0, true );
+	parallel.SetBucketParallel( 1, true );
+
+	CHECK( parallel.IsBucketParallel( 0 ) == true );
+	CHECK( parallel.IsBucketParallel( 2 ) == false );
+	CHECK( parallel.IsBucketParallel( 7 ) == false );
+
+	for( int frame = 0; frame < TEST_FRAMES; frame++ )
+	{
+		serial.UpdateAll( TEST_STEP );
+		parallel.UpdateAll( TEST_STEP );
+	}
+
+
+	// Every entity updated once a frame, to the same position
+	unsigned int wrongCount		= 0;
+	unsigned int wrongPosition	= 0;
+	for( unsigned int i = 0; i < parallelEntities.size(); i++ )
+	{
+		if( parallelEntities[ i ]->m_unUpdates != TEST_FRAMES || serialEntities[ i ]->m_unUpdates != TEST_FRAMES )
+			wrongCount++;
+
+		if( parallelEntities[ i ]->GetPosition() != serialEntities[ i ]->GetPosition() )
+			wrongPosition++;
+	}
+
+	CHECK( wrongCount == 0 );
+	CHECK( wrongPosition == 0 );
+
+
+	// Only the large parallel bucket left the main thread
+	unsigned int offMain = 0;
+	for( unsigned int i = 0; i < serialEntities.size(); i++ )
+		offMain += serialEntities[ i ]->m_unOffMain;
+
+	for( unsigned int i = TEST_PARALLEL; i < parallelEntities.size(); i++ )
+		offMain += parallelEntities[ i ]->m_unOffMain;
+
+	CHECK( offMain == 0 );
+
+
+	// Turned off, the large bucket stays on the main thread too
+	parallel.SetParallelUpdate( false );
+
+	std::vector< unsigned int > before( TEST_PARALLEL );
+	for( unsigned int i = 0; i < TEST_PARALLEL; i++ )
+		before[ i ] = parallelEntities[ i ]->m_unOffMain;
+
+	parallel.UpdateAll( TEST_STEP );
+
+	unsigned int moved = 0;
+	for( unsigned int i = 0; i < TEST_PARALLEL; i++ )
+		if( parallelEntities[ i ]->m_unOffMain != before[ i ] )
+			moved++;
+
+	CHECK( moved == 0 );
+
+
+	serial.RemoveAll();
+	parallel.RemoveAll();
+	jobs.Terminate();
+
+	return TEST_RESULT();
+}
@@ -0,0 +1,138 @@
+//*********************************************************************//
+//	File:		RectangleBatchTest.cpp
+//	Author:		
+//	Course:		
+//	Purpose:	RectangleBatch::FindIntersections finds the pairs of
+//				Rectangle::IsIntersecting at every SIMD level
+//*********************************************************************//
+
+#include "TestSupport.h"
+
+#include "../SGD Wrappers/SGD_RectangleBatch.h"
+
+#include <limits>
+#include <vector>
+
+
+//*********************************************************************//
+// Random
+static unsigned int s_unSeed = 5;
+
+static unsigned int RandomInt( unsigned int range )
+{
+	s_unSeed = s_unSeed * 1664525u + 1013904223u;
+	return (s_unSeed >> 8) % range;
+}
+
+//*********************************************************************//
+// RandomRect
+//	- on a coarse grid, so many rectangles only touch; some are empty,
+//	  inverted, infinite or NaN
+static SGD::Rectangle RandomRect( void )
+{
+	const float inf = std::numeric_limits< float >::infinity();
+	const float nan = std::numeric_limits< float >::quiet_NaN();
+
+	float x = 8.0f * RandomInt( 16 ), y = 8.0f * RandomInt( 16 );
+	SGD::Rectangle rect = { x, y, x + 8.0f * RandomInt( 5 ), y + 8.0f * RandomInt( 5 ) };
+
+	switch( RandomInt( 16 ) )
+	{
+	case 0:		rect.right = rect.left - 8.0f;		break;		// inverted
+	case 1:		rect.left = -inf;					break;
+	case 2:		rect.bottom = inf;					break;
+	case 3:		rect.top = nan;						break;
+	default:										break;
+	}
+
+	return rect;
+}
+
+
+//*********************************************************************//
+// IsSame
+//	- equal, or both NaN
+static bool IsSame( float a, float b )
+{
+	return a == b || (a != a && b != b);
+}
+
+
+//*********************************************************************//
+// TestLevel
+//	- random batches & ranges (counts around the 4 & 8 wide steps)
+static void TestLevel( SGD::SimdLevel level )
+{
+	CHECK( SGD::SetSimdLevel( level ) == true );
+	CHECK( SGD::GetSimdLevel() == level );
+
+	unsigned int wrong = 0;
+
+	for( int round = 0; round < 200; round++ )
+	{
+		unsigned int count = RandomInt( 40 );
+
+		std::vector< SGD::Rectangle > rects( count );
+		for( unsigned int i = 0; i < count; i++ )
+			rects[ i ] = RandomRect();
+
+		SGD::RectangleBatch batch;
+		batch.Assign( rects.data(), count );
+
+		for( unsigned int i = 0; i < count; i++ )
+		{
+			SGD::Rectangle copy = batch.Get( i );
+			if( IsSame( copy.left, rects[ i ].left ) == false || IsSame( copy.top, rects[ i ].top ) == false
+				|| IsSame( copy.right, rects[ i ].right ) == false || IsSame( copy.bottom, rects[ i ].bottom ) == false )
+				wrong++;
+		}
+
+		std::vector< unsigned int > hits( count + 1 );
+
+		for( int q = 0; q < 20; q++ )
+		{
+			SGD::Rectangle query = RandomRect();
+			unsigned int first = (count > 0) ? RandomInt( count ) : 0;
+			unsigned int range = (count > first) ? RandomInt( count - first + 1 ) : 0;
+
+			std::vector< unsigned int > expected;
+			for( unsigned int i = first; i < first + range; i++ )
+				if( query.IsIntersecting( rects[ i ] ) == true )
+					expected.push_back( i );
+
+			unsigned int found = batch.FindIntersections( query, first, range, hits.data() );
+			if( std::vector< unsigned int >( hits.begin(), hits.begin() + found ) != expected )
+				wrong++;
+
+			// The whole batch
+			expected.clear();
+			for( unsigned int i = 0; i < count; i++ )
+				if( query.IsIntersecting( rects[ i ] ) == true )
+					expected.push_back( i );
+
+			found = batch.FindIntersections( query, hits.data() );
+			if( std::vector< unsigned int >( hits.begin(), hits.begin() + found ) != expected )
+				wrong++;
+		}
+	}
+
+	CHECK( wrong == 0 );
+}
+
+
+//*********************************************************************//
+// main
+int main( void )
+{
+	SGD::SimdLevel maxLevel = SGD::GetMaxSimdLevel();
+
+	for( int l = (int)SGD::SimdLevel::SCALAR; l <= (int)maxLevel; l++ )
+		TestLevel( (SGD::SimdLevel)l );
+
+	// A level above the CPU's is refused
+	if( maxLevel != SGD::SimdLevel::AVX )
+		CHECK( SGD::SetSimdLevel( SGD::SimdLevel::AVX ) == false );
+
+	SGD::SetSimdLevel( maxLevel );
+	return TEST_RESULT();
+}
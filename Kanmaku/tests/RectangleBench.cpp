@@ -0,0 +1,133 @@
+//*********************************************************************//
+//	File:		RectangleBench.cpp
+//	Author:		
+//	Course:		
+//	Purpose:	RectangleBatch::FindIntersections at each SIMD level
+//				against a loop of Rectangle::IsIntersecting
+//*********************************************************************//
+
+#include "BenchSupport.h"
+
+#include "../SGD Wrappers/SGD_RectangleBatch.h"
+
+#include <vector>
+
+
+//*********************************************************************//
+// Queries of bullet-sized rectangles into a 2048x2048 level
+#define BENCH_QUERIES		1000
+#define BENCH_LEVEL_SIZE	2048.0f
+
+
+//*********************************************************************//
+// Random
+static unsigned int s_unSeed = 3;
+
+static float Random( float range )
+{
+	s_unSeed = s_unSeed * 1664525u + 1013904223u;
+	return range * (s_unSeed >> 8) / 16777216.0f;
+}
+
+static SGD::Rectangle RandomRect( float maxSize )
+{
+	float x = Random( BENCH_LEVEL_SIZE ), y = Random( BENCH_LEVEL_SIZE );
+	return SGD::Rectangle{ x, y, x + 1.0f + Random( maxSize ), y + 1.0f + Random( maxSize ) };
+}
+
+
+//*********************************************************************//
+// LevelName
+static const char* LevelName( SGD::SimdLevel level )
+{
+	switch( level )
+	{
+	case SGD::SimdLevel::SSE2:	return "SSE2";
+	case SGD::SimdLevel::AVX:	return "AVX";
+	default:					return "scalar";
+	}
+}
+
+
+//*********************************************************************//
+// RunCase
+//	- every query against count rectangles; false if a level finds
+//	  other hits than IsIntersecting
+static bool RunCase( unsigned int count )
+{
+	std::vector< SGD::Rectangle > rects( count ), queries( BENCH_QUERIES );
+	for( unsigned int i = 0; i < count; i++ )
+		rects[ i ] = RandomRect( 64.0f );
+	for( unsigned int q = 0; q < BENCH_QUERIES; q++ )
+		queries[ q ] = RandomRect( 128.0f );
+
+	SGD::RectangleBatch batch;
+	batch.Assign( rects.data(), count );
+
+	std::vector< unsigned int > hits( count );
+	unsigned long oldHits = 0;
+
+	double oldMs = BenchMeasure(
+		[&]()	{	oldHits = 0;	},
+		[&]()
+		{
+			for( unsigned int q = 0; q < BENCH_QUERIES; q++ )
+			{
+				unsigned int found = 0;
+				for( unsigned int i = 0; i < count; i++ )
+					if( queries[ q ].IsIntersecting( rects[ i ] ) == true )
+						hits[ found++ ] = i;
+				oldHits += found;
+			}
+		} );
+
+
+	// Each level the CPU supports
+	bool same = true;
+	SGD::SimdLevel maxLevel = SGD::GetMaxSimdLevel();
+
+	for( int l = (int)SGD::SimdLevel::SCALAR; l <= (int)maxLevel; l++ )
+	{
+		SGD::SimdLevel level = (SGD::SimdLevel)l;
+		SGD::SetSimdLevel( level );
+
+		unsigned long newHits = 0;
+
+		double newMs = BenchMeasure(
+			[&]()	{	newHits = 0;	},
+			[&]()
+			{
+				for( unsigned int q = 0; q < BENCH_QUERIES; q++ )
+					newHits += batch.FindIntersections( queries[ q ], hits.data() );
+			} );
+
+		char name[ 64 ];
+		snprintf( name, sizeof( name ), "%u rects, %s", count, LevelName( level ) );
+		BenchReport( name, oldMs, newMs );
+
+		if( newHits != oldHits )
+		{
+			fprintf( stderr, "%s: %lu hits, IsIntersecting found %lu\n", name, newHits, oldHits );
+			same = false;
+		}
+	}
+
+	SGD::SetSimdLevel( maxLevel );
+	return same;
+}
+
+
+//*********************************************************************//
+// main
+int main( void )
+{
+	BenchHeader( "RectangleBench: 1000 queries (IsIntersecting loop / FindIntersections)" );
+
+	static const unsigned int counts[] = { 64, 1000, 10000, 100000 };
+
+	bool same = true;
+	for( unsigned int c = 0; c < sizeof( counts ) / sizeof( counts[ 0 ] ); c++ )
+		same = RunCase( counts[ c ] ) && same;
+
+	return (same == true) ? 0 : 1;
+}
@@ -0,0 +1,187 @@
+//*********************************************************************//
+//	File:		RenderListBench.cpp
+//	Author:		
+//	Course:		
+//	Purpose:	EntityManager's persistent render list against the
+//				per-frame gather & std::sort it replaced, 10k entities
+//*********************************************************************//
+
+#include "BenchSupport.h"
+#include "HeadlessGame.h"
+
+#include "../source/Entity.h"
+#include "../source/EntityManager.h"
+
+#include <algorithm>
+#include <vector>
+
+
+//*********************************************************************//
+#define BENCH_ENTITIES		10000
+#define BENCH_BUCKETS		4
+#define BENCH_FRAMES		600
+
+
+//*********************************************************************//
+// DepthEntity
+//	- draws nothing: Render checks the depth order (so the times are
+//	  the render list's)
+class DepthEntity : public Entity
+{
+public:
+	virtual void Render( void ) override
+	{
+		if( GetDepth() < s_fLastDepth )
+			++s_unOutOfOrder;
+
+		s_fLastDepth = GetDepth();
+		++s_unRendered;
+	}
+
+	static float			s_fLastDepth;
+	static unsigned int		s_unOutOfOrder;
+	static unsigned int		s_unRendered;
+};
+
+/*static*/ float		DepthEntity::s_fLastDepth		= 0.0f;
+/*static*/ unsigned int	DepthEntity::s_unOutOfOrder		= 0;
+/*static*/ unsigned int	DepthEntity::s_unRendered		= 0;
+
+
+//*********************************************************************//
+// OldRenderAll
+//	- the old EntityManager::RenderAll: gather every bucket into a new
+//	  vector, sort it by depth, render
+static bool DepthLess( IEntity* a, IEntity* b )
+{
+	return a->GetDepth() < b->GetDepth();
+}
+
+static void OldRenderAll( const std::vector< std::vector< IEntity* > >& table )
+{
+	std::vector< IEntity* > priorityQueue;
+
+	for( unsigned int bucket = 0; bucket < table.size(); bucket++ )
+		for( unsigned int i = 0; i < table[ bucket ].size(); i++ )
+			priorityQueue.push_back( table[ bucket ][ i ] );
+
+	std::sort( priorityQueue.begin(), priorityQueue.end(), DepthLess );
+
+	for( unsigned int i = 0; i < priorityQueue.size(); i++ )
+		priorityQueue[ i ]->Render();
+}
+
+
+//*********************************************************************//
+// Case
+//	- entities whose depth changes each frame
+struct Case
+{
+	const char*		szName;
+	unsigned int	unMoving;		// every n-th entity
+	float			fStep;			// depth change (toggled each frame)
+};
+
+
+//*********************************************************************//
+// RunCase
+static bool RunCase( const Case& test )
+{
+	EntityManager manager;
+	std::vector< std::vector< IEntity* > > table( BENCH_BUCKETS );
+	std::vector< DepthEntity* > entities;
+
+	for( unsigned int i = 0; i < BENCH_ENTITIES; i++ )
+	{
+		DepthEntity* pEntity = new DepthEntity;
+		pEntity->SetDepth( (float)(i * 7919 % 100) );
+
+		manager.AddEntity( pEntity, i % BENCH_BUCKETS );
+		table[ i % BENCH_BUCKETS ].push_back( pEntity );
+		entities.push_back( pEntity );
+		pEntity->Release();
+	}
+
+	// Move the chosen entities back & forth
+	auto changeDepths = [&]( int frame )
+	{
+		if( test.unMoving == 0 )
+			return;
+
+		float step = (frame % 2 == 0) ? test.fStep : -test.fStep;
+		for( unsigned int i = 0; i < entities.size(); i += test.unMoving )
+			entities[ i ]->SetDepth( entities[ i ]->GetDepth() + step );
+	};
+
+	auto startFrame = [&]()
+	{
+		DepthEntity::s_fLastDepth = -1.0e9f;
+	};
+
+
+	double oldMs = BenchMeasure(
+		[&]()	{	},
+		[&]()
+		{
+			for( int frame = 0; frame < BENCH_FRAMES; frame++ )
+			{
+				changeDepths( frame );
+				startFrame();
+				OldRenderAll( table );
+			}
+		} );
+
+	DepthEntity::s_unOutOfOrder = 0;
+	DepthEntity::s_unRendered = 0;
+
+	double newMs = BenchMeasure(
+		[&]()	{	},
+		[&]()
+		{
+			for( int frame = 0; frame < BENCH_FRAMES; frame++ )
+			{
+				changeDepths( frame );
+				startFrame();
+				manager.RenderAll();
+			}
+		} );
+
+	BenchReport( test.szName, oldMs, newMs );
+
+	bool sorted = DepthEntity::s_unOutOfOrder == 0
+		&& DepthEntity::s_unRendered == (unsigned int)BENCH_RUNS * BENCH_FRAMES * BENCH_ENTITIES;
+	if( sorted == false )
+		fprintf( stderr, "%s: %u entities drawn out of depth order\n", test.szName, DepthEntity::s_unOutOfOrder );
+
+	manager.RemoveAll();
+	return sorted;
+}
+
+
+//*********************************************************************//
+// main
+int main( void )
+{
+	Game* pGame = Game::GetInstance();
+	if( pGame->Initialize() == false )
+		return 1;
+
+	const Case cases[] =
+	{
+		{ "no depth changes",				0,		0.0f	},
+		{ "10 toggle +-0.2 (like Puff)",	1000,	0.2f	},
+		{ "1% move +-1.5",					100,	1.5f	},
+		{ "10% move +-1.5",					10,		1.5f	},
+	};
+
+	BenchHeader( "RenderListBench: 10k entities, 600 frames (gather & sort / render list)" );
+
+	bool sorted = true;
+	for( unsigned int c = 0; c < sizeof( cases ) / sizeof( cases[ 0 ] ); c++ )
+		sorted = RunCase( cases[ c ] ) && sorted;
+
+	pGame->Terminate();
+	Game::DeleteInstance();
+
+	return (sorted == true) ? 0 : 1;
+}
@@ -0,0 +1,109 @@
+//*********************************************************************//
+//	File:		RenderOrderTest.cpp
+//	Author:		
+//	Course:		
+//	Purpose:	RenderAll draws in depth order (stable for equal
+//				depths) after adds, removes & SetDepth calls
+//*********************************************************************//
+
+#include "TestSupport.h"
+
+#include "../source/Entity.h"
+#include "../source/EntityManager.h"
+
+#include <vector>
+
+
+//*********************************************************************//
+// Every Render call of the last RenderAll: entity id
+static std::vector< int >	s_vDrawn;
+
+
+//*********************************************************************//
+// DrawnEntity
+//	- logs its Render call instead of drawing
+class DrawnEntity : public Entity
+{
+public:
+	explicit DrawnEntity( int id )	: m_nID( id )	{	}
+
+	virtual void Render( void ) override	{	s_vDrawn.push_back( m_nID );	}
+
+private:
+	int		m_nID;
+};
+
+
+//*********************************************************************//
+// Draw
+//	- the ids in the order RenderAll drew them
+static std::vector< int > Draw( EntityManager& entities )
+{
+	s_vDrawn.clear();
+	entities.RenderAll();
+	return s_vDrawn;
+}
+
+
+//*********************************************************************//
+int main( void )
+{
+	EntityManager				entities;
+	std::vector< DrawnEntity* >	stored;
+
+	// Depths 2, 1, 0, 2, 1, 0, ... added out of order
+	for( int i = 0; i < 9; i++ )
+	{
+		DrawnEntity* pEntity = new DrawnEntity( i );
+		pEntity->SetDepth( (float)(2 - i % 3) );
+
+		entities.AddEntity( pEntity, (unsigned int)i % 2 );
+		stored.push_back( pEntity );
+		pEntity->Release();
+	}
+
+	// Depth order, ties in the order they were added
+	std::vector< int > expected = { 2, 5, 8, 1, 4, 7, 0, 3, 6 };
+	CHECK( Draw( entities ) == expected );
+	CHECK( Draw( entities ) == expected );
+
+
+	// A new depth re-sorts the list (stable: the entity keeps its
+	// place relative to the others of that depth)
+	stored[ 8 ]->SetDepth( 1.0f );
+	expected = { 2, 5, 8, 1, 4, 7, 0, 3, 6 };
+	CHECK( Draw( entities ) == expected );
+
+	// The same depth changes nothing
+	stored[ 2 ]->SetDepth( 0.0f );
+	CHECK( Draw( entities ) == expected );
+
+
+	// Removed entities are skipped, added ones are inserted in place
+	entities.RemoveEntity( stored[ 4 ] );
+	entities.RemoveEntity( stored[ 0 ] );
+
+	DrawnEntity* pAdded = new DrawnEntity( 9 );
+	pAdded->SetDepth( 1.0f );
+	entities.AddEntity( pAdded, 0 );
+	pAdded->Release();
+
+	expected = { 2, 5, 8, 1, 7, 9, 3, 6 };
+	CHECK( Draw( entities ) == expected );
+
+
+	// Removed entities no longer mark the list
+	DrawnEntity* pKept = stored[ 3 ];
+	pKept->AddRef();
+	entities.RemoveEntity( pKept );
+	pKept->SetDepth( -5.0f );
+
+	expected = { 2, 5, 8, 1, 7, 9, 6 };
+	CHECK( Draw( entities ) == expected );
+	pKept->Release();
+
+	entities.RemoveAll();
+	CHECK( Draw( entities ).empty() == true );
+
+	return TEST_RESULT();
+}
@@ -0,0 +1,175 @@
+//*********************************************************************//
+//	File:		SpatialHashTest.cpp
+//	Author:		
+//	Course:		
+//	Purpose:	the spatial hash finds the brute-force pairs, also for
+//				huge rectangles, and the entity grid follows the
+//				entities moved by HandleCollision
+//*********************************************************************//
+
+#include "TestSupport.h"
+#include "HeadlessGame.h"
+
+#include "../source/Entity.h"
+#include "../source/EntityManager.h"
+#include "../source/SpatialHash.h"
+
+#include <limits>
+#include <vector>
+
+
+//*********************************************************************//
+// Random
+static unsigned int s_unSeed = 7;
+
+static float Random( float range )
+{
+	s_unSeed = s_unSeed * 1664525u + 1013904223u;
+	return range * (s_unSeed >> 8) / 16777216.0f;
+}
+
+
+//*********************************************************************//
+// Most narrow-phase tests a small query may make: its few cells
+// (the test's random rects cover at most 16) plus the oversized list,
+// far below the 2005 of a brute-force query
+#define TEST_MAX_SMALL_TESTS	256
+
+
+//*********************************************************************//
+// TestAgainstBruteForce
+//	- small, large, huge & infinite rectangles, queried with each other
+//	- the query counts show the cells bounded the work (timing is
+//	  for CollisionBench)
+static void TestAgainstBruteForce( void )
+{
+	const float huge = 1.0e9f;
+	const float inf  = std::numeric_limits< float >::infinity();
+
+	std::vector< SGD::Rectangle > rects;
+	for( int i = 0; i < 2000; i++ )
+	{
+		float x = Random( 4096.0f ), y = Random( 4096.0f );
+		rects.push_back( SGD::Rectangle{ x, y, x + 1.0f + Random( 80.0f ), y + 1.0f + Random( 80.0f ) } );
+	}
+
+	rects.push_back( SGD::Rectangle{ 100.0f, 100.0f, 3000.0f, 200.0f } );		// long & thin
+	rects.push_back( SGD::Rectangle{ -huge, -huge, huge, huge } );				// billions of cells
+	rects.push_back( SGD::Rectangle{ -inf, 500.0f, inf, 520.0f } );				// infinite
+	rects.push_back( SGD::Rectangle{ 10.0f, 10.0f, 10.0f, 50.0f } );			// empty
+	rects.push_back( SGD::Rectangle{ 0.0f, 0.0f, 4096.0f, 4096.0f } );			// the whole level
+
+	const unsigned int small	= 2000;
+	const unsigned int count	= (unsigned int)rects.size();
+
+	SpatialHash grid( 32.0f );
+	grid.Build( rects.data(), count );
+
+	std::vector< unsigned int >	hits;
+	unsigned int				wrong		= 0;
+	unsigned int				wrongTests	= 0;
+	unsigned long long			smallTests	= 0;
+
+	for( unsigned int q = 0; q < count; q++ )
+	{
+		unsigned int tests = grid.Query( rects[ q ], hits );
+
+		// Small queries only visit their cells, the large ones test
+		// every rectangle once, the empty one tests nothing
+		if( q < small )
+		{
+			smallTests += tests;
+			if( tests > TEST_MAX_SMALL_TESTS )
+				wrongTests++;
+		}
+		else if( tests != (rects[ q ].IsEmpty() ? 0 : count) )
+			wrongTests++;
+
+		std::vector< unsigned int > expected;
+		for( unsigned int i = 0; i < rects.size(); i++ )
+			if( rects[ q ].IsIntersecting( rects[ i ] ) == true )
+				expected.push_back( i );
+
+		if( hits != expected )
+			wrong++;
+	}
+
+	CHECK( wrong == 0 );
+	CHECK( wrongTests == 0 );
+
+	// Together, a small fraction of the brute-force pairs
+	CHECK( smallTests < (unsigned long long)small * count / 20 );
+}
+
+
+//*********************************************************************//
+// PushingEntity
+//	- pushes itself away from whatever it touches
+class PushingEntity : public Entity
+{
+public:
+	virtual void HandleCollision( const IEntity* pOther ) override
+	{
+		(void)pOther;			// unused parameter
+		m_ptPosition.x += 1000.0f;
+		++m_nHits;
+	}
+
+	int		m_nHits	= 0;
+};
+
+
+//*********************************************************************//
+// TestMovedEntities
+//	- the second check of the step must see where the first one
+//	  moved the entities
+static void TestMovedEntities( void )
+{
+	EntityManager entities;
+
+	PushingEntity* pA = new PushingEntity;
+	pA->SetPosition( SGD::Point{ 0, 0 } );
+	pA->SetSize( SGD::Size{ 32, 32 } );
+
+	PushingEntity* pB = new PushingEntity;
+	pB->SetPosition( SGD::Point{ 16, 16 } );
+	pB->SetSize( SGD::Size{ 32, 32 } );
+
+	PushingEntity* pC = new PushingEntity;
+	pC->SetPosition( SGD::Point{ 1016, 16 } );
+	pC->SetSize( SGD::Size{ 32, 32 } );
+
+	entities.AddEntity( pA, 0 );
+	entities.AddEntity( pB, 1 );
+	entities.AddEntity( pC, 1 );
+
+	// A touches B: both move 1000 to the right, B now sits on C
+	entities.CheckCollisions( 0, 1 );
+	CHECK( pA->m_nHits == 1 && pB->m_nHits == 1 && pC->m_nHits == 0 );
+
+	// A (at 1000) now touches B (at 1016) & C (at 1016)
+	entities.CheckCollisions( 0, 1 );
+	CHECK( pA->m_nHits == 3 && pB->m_nHits == 2 && pC->m_nHits == 1 );
+
+	pA->Release();
+	pB->Release();
+	pC->Release();
+	entities.RemoveAll();
+}
+
+
+//*********************************************************************//
+int main( void )
+{
+	// The collision snapshots come from the game's frame arena
+	Game* pGame = Game::GetInstance();
+	CHECK( pGame->Initialize() == true );
+
+	TestAgainstBruteForce();
+	TestMovedEntities();
+
+	pGame->Terminate();
+	Game::DeleteInstance();
+
+	return TEST_RESULT();
+}
@@ -0,0 +1,270 @@
+//*********************************************************************//
+//	File:		SpriteBatchTest.cpp
+//	Author:		
+//	Course:		
+//	Purpose:	SpriteBatch draws its quads by depth then texture,
+//				one DrawTextureBatch per texture run, and counts them
+//*********************************************************************//
+
+#include "TestSupport.h"
+#include "HeadlessGame.h"
+
+#include "../SGD Wrappers/SGD_GraphicsManager.h"
+#include "../SGD Wrappers/SGD_SpriteBatch.h"
+
+#include <algorithm>
+#include <cstdlib>
+#include <vector>
+
+
+//*********************************************************************//
+#define TEST_FRAMES			20
+#define TEST_MAX_SPRITES	400
+
+
+//*********************************************************************//
+// Submitted
+//	- a Draw call: its position.x holds its Draw index
+struct Submitted
+{
+	float				fDepth;
+	SGD::HTexture		hTexture;
+	unsigned int		unIndex;
+};
+
+static bool SubmittedLess( const Submitted& a, const Submitted& b )
+{
+	if( a.fDepth != b.fDepth )
+		return a.fDepth < b.fDepth;
+
+	if( a.hTexture != b.hTexture )
+		return a.hTexture < b.hTexture;
+
+	return a.unIndex < b.unIndex;
+}
+
+
+//*********************************************************************//
+// RecordingGraphics
+//	- passes every call to the headless GraphicsManager, and logs
+//	  the DrawTextureBatch calls: their texture & quads
+class RecordingGraphics : public SGD::GraphicsManager
+{
+public:
+	struct Batch
+	{
+		SGD::HTexture		hTexture;
+		unsigned int		unFirst;		// into m_vQuads
+		unsigned int		unCount;
+	};
+
+	explicit RecordingGraphics( SGD::GraphicsManager* pGraphics )	: m_pGraphics( pGraphics )	{	}
+	virtual ~RecordingGraphics( void )	= default;
+
+	void	Clear	( void )	{	m_vBatches.clear();	m_vQuads.clear();	}
+
+	std::vector< Batch >			m_vBatches;
+	std::vector< SGD::SpriteQuad >	m_vQuads;
+
+
+	virtual bool		DrawTextureBatch	( SGD::HTexture handle, const SGD::SpriteQuad* quads, unsigned int count ) override
+	{
+		Batch batch = { handle, (unsigned int)m_vQuads.size(), count };
+		m_vBatches.push_back( batch );
+		m_vQuads.insert( m_vQuads.end(), quads, quads + count );
+
+		return m_pGraphics->DrawTextureBatch( handle, quads, count );
+	}
+
+
+	virtual	bool		Initialize			( bool vsync ) override											{	return m_pGraphics->Initialize( vsync );	}
+	virtual	bool		Initialize			( const wchar_t* title, SGD::Size size, bool vsync ) override	{	return m_pGraphics->Initialize( title, size, vsync );	}
+	virtual	bool		Update				( void ) override												{	return m_pGraphics->Update();	}
+	virtual	bool		Terminate			( void ) override												{	return m_pGraphics->Terminate();	}
+
+	virtual bool		SetClearColor		( SGD::Color color ) override					{	return m_pGraphics->SetClearColor( color );	}
+	virtual bool		SetPixelatedMode	( bool pixelated ) override						{	return m_pGraphics->SetPixelatedMode( pixelated );	}
+	virtual bool		ShowCursor			( bool show ) override							{	return m_pGraphics->ShowCursor( show );	}
+	virtual bool		ShowConsoleWindow	( bool show ) override							{	return m_pGraphics->ShowConsoleWindow( show );	}
+	virtual bool		Resize				( SGD::Size size, bool windowed ) override		{	return m_pGraphics->Resize( size, windowed );	}
+	virtual bool		IsForegroundWindow	( void ) override								{	return m_pGraphics->IsForegroundWindow();	}
+
+	virtual bool		DrawString			( const wchar_t* text, SGD::Point position, SGD::Color color ) override		{	return m_pGraphics->DrawString( text, position, color );	}
+	virtual bool		DrawString			( const char* text, SGD::Point position, SGD::Color color ) override		{	return m_pGraphics->DrawString( text, position, color );	}
+	virtual bool		DrawLine			( SGD::Point position1, SGD::Point position2, SGD::Color color, unsigned int lineWidth ) override		{	return m_pGraphics->DrawLine( position1, position2, color, lineWidth );	}
+	virtual bool		DrawRectangle		( SGD::Rectangle rect, SGD::Color fillColor, SGD::Color lineColor, unsigned int lineWidth ) override	{	return m_pGraphics->DrawRectangle( rect, fillColor, lineColor, lineWidth );	}
+
+	virtual	SGD::HTexture	LoadTexture			( const wchar_t* filename, SGD::Color colorKey ) override		{	return m_pGraphics->LoadTexture( filename, colorKey );	}
+	virtual	SGD::HTexture	LoadTexture			( const char* filename, SGD::Color colorKey ) override			{	return m_pGraphics->LoadTexture( filename, colorKey );	}
+	virtual	bool		DrawTexture			( SGD::HTexture handle, SGD::Point position, float rotation, SGD::Vector rotationOffset, SGD::Color color, SGD::Size scale ) override
+	{
+		return m_pGraphics->DrawTexture( handle, position, rotation, rotationOffset, color, scale );
+	}
+	virtual	bool		DrawTextureSection	( SGD::HTexture handle, SGD::Point position, SGD::Rectangle section, float rotation, SGD::Vector rotationOffset, SGD::Color color, SGD::Size scale ) override
+	{
+		return m_pGraphics->DrawTextureSection( handle, position, section, rotation, rotationOffset, color, scale );
+	}
+	virtual	bool		UnloadTexture		( SGD::HTexture& handle ) override				{	return m_pGraphics->UnloadTexture( handle );	}
+
+	virtual	bool		LoadAtlas			( const wchar_t* filename ) override			{	return m_pGraphics->LoadAtlas( filename );	}
+	virtual	bool		LoadAtlas			( const char* filename ) override				{	return m_pGraphics->LoadAtlas( filename );	}
+
+	virtual	SGD::HTexture	LoadTextureAsync	( const wchar_t* filename, SGD::Color colorKey ) override	{	return m_pGraphics->LoadTextureAsync( filename, colorKey );	}
+	virtual	SGD::HTexture	LoadTextureAsync	( const char* filename, SGD::Color colorKey ) override		{	return m_pGraphics->LoadTextureAsync( filename, colorKey );	}
+	virtual	SGD::LoadStatus	GetTextureStatus	( SGD::HTexture handle ) override							{	return m_pGraphics->GetTextureStatus( handle );	}
+	virtual	unsigned int	FinishLoads			( bool wait ) override										{	return m_pGraphics->FinishLoads( wait );	}
+
+	virtual	const SGD::GraphicsStats&	GetFrameStats	( void ) const override		{	return m_pGraphics->GetFrameStats();	}
+	virtual	const SGD::CacheStats&		GetCacheStats	( void ) const override		{	return m_pGraphics->GetCacheStats();	}
+
+private:
+	SGD::GraphicsManager*	m_pGraphics;
+};
+
+
+//*********************************************************************//
+// CheckFrame
+//	- draws the sprites through the batch & checks what came out
+static void CheckFrame( SGD::SpriteBatch& batch, RecordingGraphics& recorder, const std::vector< Submitted >& sprites )
+{
+	SGD::GraphicsManager* pGraphics = SGD::GraphicsManager::GetInstance();
+
+	recorder.Clear();
+	batch.Begin();
+
+	for( unsigned int i = 0; i < sprites.size(); i++ )
+		batch.Draw( sprites[ i ].hTexture, SGD::Point{ (float)sprites[ i ].unIndex, 0.0f }, SGD::Rectangle{},
+			0.0f, SGD::Vector{}, SGD::Color{}, SGD::Size{ 1.0f, 1.0f }, sprites[ i ].fDepth );
+
+	CHECK( batch.GetCount() == sprites.size() );
+	CHECK( batch.End( &recorder ) == true );
+
+
+	// The quads by depth, then texture, then Draw order
+	std::vector< Submitted > expected = sprites;
+	std::sort( expected.begin(), expected.end(), &SubmittedLess );
+
+	CHECK( recorder.m_vQuads.size() == expected.size() );
+	if( recorder.m_vQuads.size() != expected.size() )
+		return;
+
+	unsigned int wrongOrder = 0;
+	for( unsigned int q = 0; q < expected.size(); q++ )
+		if( recorder.m_vQuads[ q ].position.x != (float)expected[ q ].unIndex )
+			wrongOrder++;
+
+	CHECK( wrongOrder == 0 );
+
+
+	// One call per run of one texture, with every quad of the run
+	unsigned int runs		= 0;
+	unsigned int wrongRuns	= 0;
+	for( unsigned int q = 0; q < expected.size(); q++ )
+	{
+		if( q > 0 && expected[ q ].hTexture == expected[ q - 1 ].hTexture )
+			continue;
+
+		if( runs >= recorder.m_vBatches.size() )
+		{
+			wrongRuns++;
+			break;
+		}
+
+		const RecordingGraphics::Batch& call = recorder.m_vBatches[ runs++ ];
+		if( call.hTexture != expected[ q ].hTexture || call.unFirst != q )
+			wrongRuns++;
+	}
+
+	CHECK( wrongRuns == 0 );
+	CHECK( recorder.m_vBatches.size() == runs );
+
+
+	// The batch's counters & the frame's
+	const SGD::SpriteBatchStats& stats = batch.GetStats();
+	CHECK( stats.unSprites == sprites.size() );
+	CHECK( stats.unRuns == runs );
+	CHECK( stats.unDrawCallsSaved == sprites.size() - runs );
+
+	CHECK( pGraphics->Update() == true );
+	CHECK( pGraphics->GetFrameStats().unBatches == runs );
+	CHECK( pGraphics->GetFrameStats().unSprites == sprites.size() );
+}
+
+
+//*********************************************************************//
+// main
+int main( void )
+{
+	Game* pGame = Game::GetInstance();
+	CHECK( pGame->Initialize() == true );
+
+	SGD::GraphicsManager* pGraphics = SGD::GraphicsManager::GetInstance();
+
+	SGD::HTexture textures[ 3 ] =
+	{
+		pGraphics->LoadTexture( L"resource/graphics/kc_BulletTypeA.png" ),
+		pGraphics->LoadTexture( L"resource/graphics/DEBUG_Puff.png" ),
+		pGraphics->LoadTexture( L"resource/graphics/DEBUG_PlayerEntity.png" ),
+	};
+
+	for( int t = 0; t < 3; t++ )
+		CHECK( textures[ t ] != SGD::INVALID_HANDLE );
+
+	RecordingGraphics	recorder( pGraphics );
+	SGD::SpriteBatch	batch;
+	std::vector< Submitted > sprites;
+
+
+	// Nothing drawn: no call
+	sprites.clear();
+	CheckFrame( batch, recorder, sprites );
+	CHECK( batch.GetStats().unRuns == 0 );
+
+
+	// One texture at every depth: one call
+	for( unsigned int i = 0; i < 50; i++ )
+	{
+		Submitted sprite = { (float)(i % 5), textures[ 1 ], i };
+		sprites.push_back( sprite );
+	}
+	CheckFrame( batch, recorder, sprites );
+	CHECK( batch.GetStats().unRuns == 1 );
+
+
+	// Two textures alternating on one depth: a call each
+	sprites.clear();
+	for( unsigned int i = 0; i < 50; i++ )
+	{
+		Submitted sprite = { 1.0f, textures[ i % 2 ], i };
+		sprites.push_back( sprite );
+	}
+	CheckFrame( batch, recorder, sprites );
+	CHECK( batch.GetStats().unRuns == 2 );
+
+
+	// Random frames: few depths & textures, so runs span depths
+	srand( 2015 );
+
+	for( int frame = 0; frame < TEST_FRAMES; frame++ )
+	{
+		sprites.clear();
+
+		unsigned int count = 1 + rand() % TEST_MAX_SPRITES;
+		for( unsigned int i = 0; i < count; i++ )
+		{
+			Submitted sprite = { (float)(rand() % 4) * 0.5f, textures[ rand() % 3 ], i };
+			sprites.push_back( sprite );
+		}
+
+		CheckFrame( batch, recorder, sprites );
+	}
+
+
+	for( int t = 0; t < 3; t++ )
+		pGraphics->UnloadTexture( textures[ t ] );
+
+	pGame->Terminate();
+	Game::DeleteInstance();
+
+	return TEST_RESULT();
+}
@@ -0,0 +1,34 @@
+//*********************************************************************//
+//	File:		TestSupport.h
+//	Author:		
+//	Course:		
+//	Purpose:	CHECK macro & result for the headless tests
+//*********************************************************************//
+
+#pragma once
+
+#include <cstdio>							// uses fprintf
+
+
+//*********************************************************************//
+// Failed checks in this test (main returns it)
+static int s_nTestFailures = 0;
+
+//*********************************************************************//
+// CHECK
+//	- report the failed expression, keep running the test
+#define CHECK( expression )													\
+	do																		\
+	{																		\
+		if( !(expression) )													\
+		{																	\
+			fprintf( stderr, "%s(%d): CHECK failed: %s\n",					\
+				__FILE__, __LINE__, #expression );							\
+			++s_nTestFailures;												\
+		}																	\
+	} while( false )
+
+//*********************************************************************//
+// TEST_RESULT
+//	- return value of main
+#define TEST_RESULT()		( s_nTestFailures == 0 ? 0 : 1 )
@@ -0,0 +1,312 @@
+//*********************************************************************//
+//	File:		AtlasPacker.cpp
+//	Author:		
+//	Course:		
+//	Purpose:	Command-line tool packing sprite images into texture
+//				atlas pages & writing their sub-rectangle index
+//	Build:		g++ -std=c++11 -O2 -o AtlasPacker AtlasPacker.cpp MaxRectsPacker.cpp PngImage.cpp "../../SGD Wrappers/SGD_TextureAtlas.cpp" "../../SGD Wrappers/SGD_PngDecoder.cpp"
+//				cl /EHsc /O2 AtlasPacker.cpp MaxRectsPacker.cpp PngImage.cpp "..\..\SGD Wrappers\SGD_TextureAtlas.cpp" "..\..\SGD Wrappers\SGD_PngDecoder.cpp"
+//	Usage:		AtlasPacker [-size <max page size>] [-padding <pixels>] -o <index.atlas> <image.png>...
+//				(run from Kanmaku: tools/AtlasPacker/AtlasPacker -o resource/graphics/sprites.atlas resource/graphics/a.png ...)
+//*********************************************************************//
+
+#define _CRT_SECURE_NO_WARNINGS		// uses fopen
+
+#include "MaxRectsPacker.h"
+#include "PngImage.h"
+
+#include "../../SGD Wrappers/SGD_TextureAtlas.h"
+
+#include <algorithm>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <string>
+#include <vector>
+
+
+//*********************************************************************//
+// Defaults
+#define ATLASPACKER_DEFAULT_SIZE		1024	// max page width & height
+#define ATLASPACKER_DEFAULT_PADDING		1		// transparent pixels between sprites
+
+
+//*********************************************************************//
+// Sprite being packed
+struct InputSprite
+{
+	std::string		strPath;		// as given on the command line
+	std::string		strName;		// file name, stored in the index
+	PngImage		image;
+	unsigned int	unPage;
+	unsigned int	unX;
+	unsigned int	unY;
+};
+
+
+//*********************************************************************//
+// GetFileName
+//	- the part after the last slash
+static std::string GetFileName( const std::string& path )
+{
+	size_t slash = path.find_last_of( "/\\" );
+	return (slash == std::string::npos) ? path : path.substr( slash + 1 );
+}
+
+
+//*********************************************************************//
+// Widen
+//	- UTF-8 to UTF-16 / UTF-32 (invalid bytes pass through as Latin-1)
+static std::wstring Widen( const std::string& text )
+{
+	std::wstring wide;
+	for( size_t i = 0; i < text.size(); )
+	{
+		unsigned int lead = (unsigned char)text[ i ];
+		unsigned int extra = (lead >= 0xF0) ? 3 : (lead >= 0xE0) ? 2 : (lead >= 0xC0) ? 1 : 0;
+
+		if( extra == 0 || i + extra >= text.size() )
+		{
+			wide += (wchar_t)lead;
+			i++;
+			continue;
+		}
+
+		unsigned int code = lead & (0x3F >> extra);
+		for( unsigned int e = 1; e <= extra; e++ )
+			code = (code << 6) | ((unsigned char)text[ i + e ] & 0x3F);
+
+		wide += (wchar_t)code;
+		i += 1 + extra;
+	}
+	return wide;
+}
+
+
+//*********************************************************************//
+// GetPageName
+//	- "<index name without extension>_<page>.png"
+static std::string GetPageName( const std::string& indexPath, unsigned int page )
+{
+	std::string stem = GetFileName( indexPath );
+	size_t dot = stem.find_last_of( '.' );
+	if( dot != std::string::npos )
+		stem.resize( dot );
+
+	char suffix[ 32 ];
+	sprintf( suffix, "_%u.png", page );
+	return stem + suffix;
+}
+
+
+//*********************************************************************//
+// NextPowerOf2
+//	- the game's textures are rounded up like this by D3DX anyway
+//	  (& a page of any other size would be stretched to it)
+static unsigned int NextPowerOf2( unsigned int value )
+{
+	unsigned int result = 1;
+	while( result < value )
+		result <<= 1;
+	return result;
+}
+
+
+//*********************************************************************//
+// SpriteOrder
+//	- tallest first, then widest: sprites of one height end up
+//	  side by side, so the rows leave little space under them
+static bool SpriteOrder( const InputSprite* a, const InputSprite* b )
+{
+	if( a->image.GetHeight() != b->image.GetHeight() )
+		return a->image.GetHeight() > b->image.GetHeight();
+	return a->image.GetWidth() > b->image.GetWidth();
+}
+
+
+//*********************************************************************//
+// PrintUsage
+static int PrintUsage( void )
+{
+	fprintf( stderr,
+		"Usage: AtlasPacker [-size <max page size>] [-padding <pixels>] -o <index.atlas> <image.png>...\n"
+		"  Packs the images into <index>_0.png, <index>_1.png, ... next to the index.\n"
+		"  The images should live in the index's folder: the game finds\n"
+		"  them by that folder + their file name.\n" );
+	return 1;
+}
+
+
+//*********************************************************************//
+// main
+int main( int argc, char* argv[] )
+{
+	unsigned int maxSize = ATLASPACKER_DEFAULT_SIZE;
+	unsigned int padding = ATLASPACKER_DEFAULT_PADDING;
+	std::string indexPath;
+	std::vector< InputSprite > sprites;
+
+
+	// Parse the arguments
+	for( int a = 1; a < argc; a++ )
+	{
+		if( strcmp( argv[ a ], "-size" ) == 0 && a + 1 < argc )
+			maxSize = (unsigned int)atoi( argv[ ++a ] );
+		else if( strcmp( argv[ a ], "-padding" ) == 0 && a + 1 < argc )
+			padding = (unsigned int)atoi( argv[ ++a ] );
+		else if( strcmp( argv[ a ], "-o" ) == 0 && a + 1 < argc )
+			indexPath = argv[ ++a ];
+		else if( argv[ a ][ 0 ] == '-' )
+			return PrintUsage();
+		else
+		{
+			InputSprite sprite;
+			sprite.strPath = argv[ a ];
+			sprite.strName = GetFileName( sprite.strPath );
+			sprites.push_back( sprite );
+		}
+	}
+
+	if( indexPath.empty() == true || sprites.empty() == true || maxSize == 0 )
+		return PrintUsage();
+
+
+	// Load the images
+	for( unsigned int s = 0; s < sprites.size(); s++ )
+	{
+		InputSprite& sprite = sprites[ s ];
+		if( sprite.image.Load( sprite.strPath.c_str() ) == false )
+		{
+			fprintf( stderr, "AtlasPacker: %s: %s\n", sprite.strPath.c_str(), sprite.image.GetError().c_str() );
+			return 1;
+		}
+
+		if( sprite.image.GetWidth() > maxSize || sprite.image.GetHeight() > maxSize )
+		{
+			fprintf( stderr, "AtlasPacker: %s: %ux%u does not fit a %u page\n", sprite.strPath.c_str(),
+				sprite.image.GetWidth(), sprite.image.GetHeight(), maxSize );
+			return 1;
+		}
+
+		for( unsigned int t = 0; t < s; t++ )
+			if( sprites[ t ].strName == sprite.strName )
+			{
+				fprintf( stderr, "AtlasPacker: %s: file name given twice\n", sprite.strPath.c_str() );
+				return 1;
+			}
+	}
+
+
+	// Pack the tallest sprites first, opening pages as needed
+	//	- every sprite reserves 'padding' extra pixels on its right &
+	//	  bottom, and the bin is that much larger so the page edges
+	//	  need no padding
+	std::vector< InputSprite* > remaining;
+	for( unsigned int s = 0; s < sprites.size(); s++ )
+		remaining.push_back( &sprites[ s ] );
+	std::stable_sort( remaining.begin(), remaining.end(), &SpriteOrder );
+
+	SGD::AtlasIndex index;
+	MaxRectsPacker packer;
+	unsigned long spriteArea = 0;		// the sprites' own pixels
+	unsigned long separateArea = 0;		// as individual power-of-2 textures
+	unsigned long pageArea = 0;
+
+	while( remaining.empty() == false )
+	{
+		unsigned int page = (unsigned int)index.vPages.size();
+		packer.Initialize( maxSize + padding, maxSize + padding );
+
+		std::vector< InputSprite* > next;
+		for( unsigned int r = 0; r < remaining.size(); r++ )
+		{
+			InputSprite* sprite = remaining[ r ];
+
+			MaxRectsPacker::Rect placed;
+			if( packer.Insert( sprite->image.GetWidth() + padding, sprite->image.GetHeight() + padding, placed ) == false )
+			{
+				next.push_back( sprite );
+				continue;
+			}
+
+			sprite->unPage	= page;
+			sprite->unX		= placed.x;
+			sprite->unY		= placed.y;
+		}
+
+		// Shrink the page to the used bounds, rounded to a power of 2
+		unsigned int usedWidth	= packer.GetUsedWidth()  - padding;
+		unsigned int usedHeight	= packer.GetUsedHeight() - padding;
+
+		SGD::AtlasIndex::Page info;
+		info.unWidth	= NextPowerOf2( usedWidth );
+		info.unHeight	= NextPowerOf2( usedHeight );
+		info.wsFilename	= Widen( GetPageName( indexPath, page ) );
+
+		index.vPages.push_back( info );
+		pageArea += (unsigned long)info.unWidth * info.unHeight;
+
+		remaining.swap( next );
+	}
+
+
+	// Compose & save the pages
+	std::string folder = indexPath.substr( 0, indexPath.size() - GetFileName( indexPath ).size() );
+
+	for( unsigned int p = 0; p < index.vPages.size(); p++ )
+	{
+		PngImage page;
+		page.Create( index.vPages[ p ].unWidth, index.vPages[ p ].unHeight );
+
+		for( unsigned int s = 0; s < sprites.size(); s++ )
+			if( sprites[ s ].unPage == p )
+				page.Blit( sprites[ s ].image, sprites[ s ].unX, sprites[ s ].unY );
+		std::string pagePath = folder + GetPageName( indexPath, p );
+
+		if( page.Save( pagePath.c_str() ) == false )
+		{
+			fprintf( stderr, "AtlasPacker: %s: %s\n", pagePath.c_str(), page.GetError().c_str() );
+			return 1;
+		}
+
+		printf( "%s: %ux%u\n", pagePath.c_str(), index.vPages[ p ].unWidth, index.vPages[ p ].unHeight );
+	}
+
+
+	// Write the index (in command line order)
+	for( unsigned int s = 0; s < sprites.size(); s++ )
+	{
+		const InputSprite& sprite = sprites[ s ];
+
+		SGD::AtlasIndex::Sprite entry;
+		entry.wsFilename	= Widen( sprite.strName );
+		entry.unPage		= sprite.unPage;
+		entry.unX			= sprite.unX;
+		entry.unY			= sprite.unY;
+		entry.unWidth		= sprite.image.GetWidth();
+		entry.unHeight		= sprite.image.GetHeight();
+		index.vSprites.push_back( entry );
+
+		spriteArea += (unsigned long)entry.unWidth * entry.unHeight;
+		separateArea += (unsigned long)NextPowerOf2( entry.unWidth ) * NextPowerOf2( entry.unHeight );
+	}
+
+	FILE* file = fopen( indexPath.c_str(), "wb" );
+	bool success = file != nullptr && index.Write( file ) == true;
+	if( file != nullptr )
+		success = (fclose( file ) == 0) && success;
+
+	if( success == false )
+	{
+		fprintf( stderr, "AtlasPacker: %s: cannot write the index\n", indexPath.c_str() );
+		return 1;
+	}
+
+
+	// The atlas saves texture switches, not always texels: sprites
+	// already sized to a power of 2 take more room packed, once the
+	// padding & the page's own rounding are added
+	printf( "%s: %u sprites on %u page(s), %lu page texels for %lu sprite texels (%lu as separate textures)\n",
+		indexPath.c_str(), (unsigned int)sprites.size(), (unsigned int)index.vPages.size(), pageArea, spriteArea, separateArea );
+	return 0;
+}
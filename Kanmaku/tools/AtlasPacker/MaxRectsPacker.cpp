@@ -0,0 +1,163 @@
+//*********************************************************************//
+//	File:		MaxRectsPacker.cpp
+//	Author:		
+//	Course:		
+//	Purpose:	MaxRectsPacker class places rectangles into one bin with
+//				the MaxRects algorithm (best short side fit)
+//*********************************************************************//
+
+#include "MaxRectsPacker.h"
+
+
+//*********************************************************************//
+// Initialize
+//	- the whole bin starts as one free rectangle
+void MaxRectsPacker::Initialize( unsigned int width, unsigned int height )
+{
+	Rect bin = { 0, 0, width, height };
+
+	m_vFree.clear();
+	m_vFree.push_back( bin );
+
+	m_unUsedWidth	= 0;
+	m_unUsedHeight	= 0;
+	m_ulUsedArea	= 0;
+}
+
+
+//*********************************************************************//
+// Insert
+//	- best short side fit, ties broken by the long side
+bool MaxRectsPacker::Insert( unsigned int width, unsigned int height, Rect& placed )
+{
+	if( width == 0 || height == 0 )
+		return false;
+
+	unsigned int bestShort = 0xFFFFFFFF, bestLong = 0xFFFFFFFF;
+	int best = -1;
+
+	for( unsigned int i = 0; i < m_vFree.size(); i++ )
+	{
+		const Rect& free = m_vFree[ i ];
+		if( free.width < width || free.height < height )
+			continue;
+
+		unsigned int leftoverX = free.width - width;
+		unsigned int leftoverY = free.height - height;
+		unsigned int shortSide = (leftoverX < leftoverY) ? leftoverX : leftoverY;
+		unsigned int longSide  = (leftoverX < leftoverY) ? leftoverY : leftoverX;
+
+		if( shortSide < bestShort || (shortSide == bestShort && longSide < bestLong) )
+		{
+			bestShort	= shortSide;
+			bestLong	= longSide;
+			best		= (int)i;
+		}
+	}
+
+	if( best < 0 )
+		return false;
+
+
+	placed.x		= m_vFree[ best ].x;
+	placed.y		= m_vFree[ best ].y;
+	placed.width	= width;
+	placed.height	= height;
+
+	SplitFreeRects( placed );
+	PruneFreeRects();
+
+
+	if( placed.x + width > m_unUsedWidth )
+		m_unUsedWidth = placed.x + width;
+	if( placed.y + height > m_unUsedHeight )
+		m_unUsedHeight = placed.y + height;
+
+	m_ulUsedArea += (unsigned long)width * height;
+	return true;
+}
+
+
+//*********************************************************************//
+// SplitFreeRects
+//	- replace each free rectangle overlapping the used one with the
+//	  (up to 4) maximal rectangles around it
+void MaxRectsPacker::SplitFreeRects( const Rect& used )
+{
+	unsigned int count = (unsigned int)m_vFree.size();
+
+	for( unsigned int i = 0; i < count; )
+	{
+		Rect free = m_vFree[ i ];
+
+		if( used.x >= free.x + free.width || used.x + used.width <= free.x
+			|| used.y >= free.y + free.height || used.y + used.height <= free.y )
+		{
+			i++;
+			continue;
+		}
+
+		// Left, right, top & bottom remainders
+		if( used.x > free.x )
+		{
+			Rect r = { free.x, free.y, used.x - free.x, free.height };
+			m_vFree.push_back( r );
+		}
+		if( used.x + used.width < free.x + free.width )
+		{
+			Rect r = { used.x + used.width, free.y, free.x + free.width - (used.x + used.width), free.height };
+			m_vFree.push_back( r );
+		}
+		if( used.y > free.y )
+		{
+			Rect r = { free.x, free.y, free.width, used.y - free.y };
+			m_vFree.push_back( r );
+		}
+		if( used.y + used.height < free.y + free.height )
+		{
+			Rect r = { free.x, used.y + used.height, free.width, free.y + free.height - (used.y + used.height) };
+			m_vFree.push_back( r );
+		}
+
+		// Remove the split rectangle (the last unchecked one takes its place)
+		m_vFree[ i ] = m_vFree[ count - 1 ];
+		m_vFree[ count - 1 ] = m_vFree.back();
+		m_vFree.pop_back();
+		count--;
+	}
+}
+
+
+//*********************************************************************//
+// PruneFreeRects
+//	- drop every free rectangle contained in another one
+void MaxRectsPacker::PruneFreeRects( void )
+{
+	for( unsigned int i = 0; i < m_vFree.size(); i++ )
+	{
+		for( unsigned int j = i + 1; j < m_vFree.size(); )
+		{
+			const Rect& a = m_vFree[ i ];
+			const Rect& b = m_vFree[ j ];
+
+			if( a.x >= b.x && a.y >= b.y && a.x + a.width <= b.x + b.width && a.y + a.height <= b.y + b.height )
+			{
+				// a inside b
+				m_vFree[ i ] = m_vFree.back();
+				m_vFree.pop_back();
+				j = i + 1;
+				continue;
+			}
+
+			if( b.x >= a.x && b.y >= a.y && b.x + b.width <= a.x + a.width && b.y + b.height <= a.y + a.height )
+			{
+				// b inside a
+				m_vFree[ j ] = m_vFree.back();
+				m_vFree.pop_back();
+				continue;
+			}
+
+			j++;
+		}
+	}
+}
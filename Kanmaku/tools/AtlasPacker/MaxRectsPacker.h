@@ -0,0 +1,60 @@
+//*********************************************************************//
+//	File:		MaxRectsPacker.h
+//	Author:		
+//	Course:		
+//	Purpose:	MaxRectsPacker class places rectangles into one bin with
+//				the MaxRects algorithm (best short side fit)
+//*********************************************************************//
+
+#pragma once
+
+#include <vector>					// uses std::vector
+
+
+//*********************************************************************//
+// MaxRectsPacker class
+//	- keeps every maximal free rectangle of the bin, which may overlap
+//	- each insert picks the free rectangle leaving the shortest
+//	  leftover side, then splits every free rectangle it overlaps
+//	- rectangles are never rotated (sprites are drawn unrotated)
+class MaxRectsPacker
+{
+public:
+	//*****************************************************************//
+	// Rect: integer rectangle, right & bottom exclusive
+	struct Rect
+	{
+		unsigned int	x, y;
+		unsigned int	width, height;
+	};
+
+
+	//*****************************************************************//
+	// Constructor & destructor
+	MaxRectsPacker( void )		= default;
+	~MaxRectsPacker( void )		= default;
+
+
+	//*****************************************************************//
+	// Bin:
+	void			Initialize	( unsigned int width, unsigned int height );
+	bool			Insert		( unsigned int width, unsigned int height, Rect& placed );	// false if it does not fit
+
+	unsigned int	GetUsedWidth	( void ) const		{	return m_unUsedWidth;	}
+	unsigned int	GetUsedHeight	( void ) const		{	return m_unUsedHeight;	}
+	unsigned long	GetUsedArea		( void ) const		{	return m_ulUsedArea;	}
+
+private:
+	//*****************************************************************//
+	// Helper methods
+	void			SplitFreeRects	( const Rect& used );
+	void			PruneFreeRects	( void );
+
+
+	//*****************************************************************//
+	// members:
+	std::vector< Rect >		m_vFree;
+	unsigned int			m_unUsedWidth	= 0;	// bounds of the placed rectangles
+	unsigned int			m_unUsedHeight	= 0;
+	unsigned long			m_ulUsedArea	= 0;
+};
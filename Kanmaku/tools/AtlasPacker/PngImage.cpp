@@ -0,0 +1,495 @@
+//*********************************************************************//
+//	File:		PngImage.cpp
+//	Author:		
+//	Course:		
+//	Purpose:	PngImage class decodes & encodes PNG files as 8-bit RGBA
+//				pixels, with its own deflate (no zlib); decoding goes
+//				through the game's SGD_PngDecoder
+//*********************************************************************//
+
+#define _CRT_SECURE_NO_WARNINGS		// uses fopen
+
+#include "PngImage.h"
+
+#include "../../SGD Wrappers/SGD_PngDecoder.h"
+
+#include <algorithm>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+
+
+//*********************************************************************//
+// Deflate limits (RFC 1951)
+#define PNG_WINDOW_SIZE		32768
+#define PNG_MIN_MATCH		3
+#define PNG_MAX_MATCH		258
+
+// Encoder match search
+#define PNG_HASH_BITS		15
+#define PNG_MAX_CHAIN		64
+
+
+namespace
+{
+	//*****************************************************************//
+	// Deflate tables: base value & extra bits of each length / distance code
+	const unsigned short s_LengthBase[ 29 ]	= { 3, 4, 5, 6, 7, 8, 9, 10, 11, 13, 15, 17, 19, 23, 27, 31,
+												35, 43, 51, 59, 67, 83, 99, 115, 131, 163, 195, 227, 258 };
+	const unsigned char s_LengthExtra[ 29 ]	= { 0, 0, 0, 0, 0, 0, 0, 0, 1, 1, 1, 1, 2, 2, 2, 2,
+												3, 3, 3, 3, 4, 4, 4, 4, 5, 5, 5, 5, 0 };
+	const unsigned short s_DistBase[ 30 ]	= { 1, 2, 3, 4, 5, 7, 9, 13, 17, 25, 33, 49, 65, 97, 129, 193,
+												257, 385, 513, 769, 1025, 1537, 2049, 3073, 4097, 6145, 8193, 12289, 16385, 24577 };
+	const unsigned char s_DistExtra[ 30 ]	= { 0, 0, 0, 0, 1, 1, 2, 2, 3, 3, 4, 4, 5, 5, 6, 6,
+												7, 7, 8, 8, 9, 9, 10, 10, 11, 11, 12, 12, 13, 13 };
+
+
+	//*****************************************************************//
+	// Crc32
+	//	- CRC of a chunk's type & data
+	unsigned long Crc32( const unsigned char* data, size_t size, unsigned long crc = 0 )
+	{
+		static unsigned long table[ 256 ];
+		static bool initialized = false;
+
+		if( initialized == false )
+		{
+			for( unsigned long n = 0; n < 256; n++ )
+			{
+				unsigned long c = n;
+				for( int k = 0; k < 8; k++ )
+					c = (c & 1) ? (0xEDB88320UL ^ (c >> 1)) : (c >> 1);
+				table[ n ] = c;
+			}
+			initialized = true;
+		}
+
+		crc = crc ^ 0xFFFFFFFFUL;
+		for( size_t i = 0; i < size; i++ )
+			crc = table[ (crc ^ data[ i ]) & 0xFF ] ^ (crc >> 8);
+
+		return crc ^ 0xFFFFFFFFUL;
+	}
+
+
+	//*****************************************************************//
+	// Adler32
+	//	- checksum at the end of a zlib stream
+	unsigned long Adler32( const unsigned char* data, size_t size )
+	{
+		unsigned long a = 1, b = 0;
+		for( size_t i = 0; i < size; i++ )
+		{
+			a = (a + data[ i ]) % 65521;
+			b = (b + a) % 65521;
+		}
+		return (b << 16) | a;
+	}
+
+
+	//*****************************************************************//
+	// Big-endian helper
+	void WriteBE32( std::vector< unsigned char >& out, unsigned long value )
+	{
+		out.push_back( (unsigned char)(value >> 24) );
+		out.push_back( (unsigned char)(value >> 16) );
+		out.push_back( (unsigned char)(value >> 8) );
+		out.push_back( (unsigned char)value );
+	}
+
+
+	//*****************************************************************//
+	// BitWriter
+	//	- packs bits starting at the least significant bit
+	struct BitWriter
+	{
+		std::vector< unsigned char >&	out;
+		unsigned long					ulBuffer;
+		int								nCount;
+
+		void Bits( unsigned long value, int count )
+		{
+			ulBuffer |= value << nCount;
+			nCount += count;
+
+			while( nCount >= 8 )
+			{
+				out.push_back( (unsigned char)ulBuffer );
+				ulBuffer >>= 8;
+				nCount -= 8;
+			}
+		}
+
+		// Huffman codes are stored starting at their most significant bit
+		void Code( unsigned long code, int length )
+		{
+			unsigned long reversed = 0;
+			for( int i = 0; i < length; i++ )
+				reversed |= ((code >> i) & 1) << (length - 1 - i);
+
+			Bits( reversed, length );
+		}
+
+		void Flush( void )
+		{
+			if( nCount > 0 )
+				out.push_back( (unsigned char)ulBuffer );
+
+			ulBuffer = 0;
+			nCount = 0;
+		}
+	};
+
+
+	//*****************************************************************//
+	// WriteFixedLiteral
+	//	- literal / length symbol with the fixed code of RFC 1951 3.2.6
+	void WriteFixedLiteral( BitWriter& out, unsigned int symbol )
+	{
+		if( symbol < 144 )
+			out.Code( 0x30 + symbol, 8 );
+		else if( symbol < 256 )
+			out.Code( 0x190 + (symbol - 144), 9 );
+		else if( symbol < 280 )
+			out.Code( symbol - 256, 7 );
+		else
+			out.Code( 0xC0 + (symbol - 280), 8 );
+	}
+
+
+	//*****************************************************************//
+	// Deflate
+	//	- zlib stream of one fixed-code block, with greedy LZ77 matches
+	//	  found through hash chains
+	void Deflate( const unsigned char* data, size_t size, std::vector< unsigned char >& out )
+	{
+		out.clear();
+		out.push_back( 0x78 );		// deflate, 32K window
+		out.push_back( 0x01 );		// no dictionary, check bits
+
+		BitWriter bits = { out, 0, 0 };
+		bits.Bits( 1, 1 );			// final block
+		bits.Bits( 1, 2 );			// fixed codes
+
+
+		const size_t hashSize = (size_t)1 << PNG_HASH_BITS;
+		std::vector< long > head( hashSize, -1 );
+		std::vector< long > previous( size > 0 ? size : 1, -1 );
+
+		size_t pos = 0;
+		while( pos < size )
+		{
+			size_t bestLength = 0, bestDistance = 0;
+
+			if( pos + PNG_MIN_MATCH <= size )
+			{
+				unsigned int hash = ((data[ pos ] << 10) ^ (data[ pos + 1 ] << 5) ^ data[ pos + 2 ]) & (hashSize - 1);
+
+				// Walk the chain of earlier positions with the same hash
+				size_t maxLength = (size - pos < PNG_MAX_MATCH) ? size - pos : PNG_MAX_MATCH;
+				long candidate = head[ hash ];
+				for( int chain = 0; candidate >= 0 && chain < PNG_MAX_CHAIN; chain++ )
+				{
+					size_t distance = pos - (size_t)candidate;
+					if( distance > PNG_WINDOW_SIZE )
+						break;
+
+					size_t length = 0;
+					while( length < maxLength && data[ candidate + length ] == data[ pos + length ] )
+						length++;
+
+					if( length > bestLength )
+					{
+						bestLength = length;
+						bestDistance = distance;
+						if( length == maxLength )
+							break;
+					}
+
+					candidate = previous[ candidate ];
+				}
+
+				previous[ pos ] = head[ hash ];
+				head[ hash ] = (long)pos;
+			}
+
+
+			if( bestLength >= PNG_MIN_MATCH )
+			{
+				// Length code
+				int code = 28;
+				while( s_LengthBase[ code ] > bestLength )
+					code--;
+				WriteFixedLiteral( bits, 257 + code );
+				bits.Bits( (unsigned long)(bestLength - s_LengthBase[ code ]), s_LengthExtra[ code ] );
+
+				// Distance code (5-bit fixed)
+				code = 29;
+				while( s_DistBase[ code ] > bestDistance )
+					code--;
+				bits.Code( (unsigned long)code, 5 );
+				bits.Bits( (unsigned long)(bestDistance - s_DistBase[ code ]), s_DistExtra[ code ] );
+
+				// Hash the skipped positions so later matches can find them
+				for( size_t i = 1; i < bestLength; i++ )
+				{
+					size_t p = pos + i;
+					if( p + PNG_MIN_MATCH > size )
+						break;
+
+					unsigned int hash = ((data[ p ] << 10) ^ (data[ p + 1 ] << 5) ^ data[ p + 2 ]) & (hashSize - 1);
+					previous[ p ] = head[ hash ];
+					head[ hash ] = (long)p;
+				}
+
+				pos += bestLength;
+			}
+			else
+			{
+				WriteFixedLiteral( bits, data[ pos ] );
+				pos++;
+			}
+		}
+
+		WriteFixedLiteral( bits, 256 );		// end of block
+		bits.Flush();
+
+		WriteBE32( out, Adler32( data, size ) );
+	}
+
+
+	//*****************************************************************//
+	// Paeth
+	//	- PNG filter type 4 predictor
+	unsigned char Paeth( int a, int b, int c )
+	{
+		int p = a + b - c;
+		int pa = abs( p - a ), pb = abs( p - b ), pc = abs( p - c );
+
+		if( pa <= pb && pa <= pc )
+			return (unsigned char)a;
+		if( pb <= pc )
+			return (unsigned char)b;
+		return (unsigned char)c;
+	}
+
+
+	//*****************************************************************//
+	// AppendChunk
+	void AppendChunk( std::vector< unsigned char >& file, const char* type, const std::vector< unsigned char >& data )
+	{
+		WriteBE32( file, (unsigned long)data.size() );
+
+		size_t start = file.size();
+		file.insert( file.end(), type, type + 4 );
+		file.insert( file.end(), data.begin(), data.end() );
+
+		WriteBE32( file, Crc32( &file[ start ], file.size() - start ) );
+	}
+
+}	// namespace
+
+
+
+//*********************************************************************//
+// Create
+void PngImage::Create( unsigned int width, unsigned int height )
+{
+	m_unWidth	= width;
+	m_unHeight	= height;
+	m_vPixels.assign( (size_t)width * height * 4, 0 );
+}
+
+
+//*********************************************************************//
+// Load
+//	- read the whole file & decode it
+bool PngImage::Load( const char* filename )
+{
+	FILE* file = fopen( filename, "rb" );
+	if( file == nullptr )
+		return Fail( "cannot open the file" );
+
+	std::vector< unsigned char > bytes;
+	unsigned char buffer[ 4096 ];
+	size_t read;
+	while( (read = fread( buffer, 1, sizeof( buffer ), file )) > 0 )
+		bytes.insert( bytes.end(), buffer, buffer + read );
+
+	fclose( file );
+
+	return Decode( bytes );
+}
+
+
+//*********************************************************************//
+// Save
+//	- 8-bit RGBA, each row filtered with the filter giving the smallest
+//	  sum of absolute differences (the usual heuristic)
+bool PngImage::Save( const char* filename ) const
+{
+	if( m_unWidth == 0 || m_unHeight == 0 )
+		return Fail( "the image is empty" );
+
+
+	// Filter the rows
+	size_t stride = (size_t)m_unWidth * 4;
+	std::vector< unsigned char > filtered;
+	filtered.reserve( (stride + 1) * m_unHeight );
+
+	std::vector< unsigned char > candidate( stride );
+	std::vector< unsigned char > best( stride );
+
+	for( unsigned int y = 0; y < m_unHeight; y++ )
+	{
+		const unsigned char* row	= &m_vPixels[ y * stride ];
+		const unsigned char* above	= (y > 0) ? row - stride : nullptr;
+
+		unsigned long bestSum = 0xFFFFFFFFUL;
+		unsigned char bestType = 0;
+
+		for( unsigned char type = 0; type <= 4; type++ )
+		{
+			unsigned long sum = 0;
+			for( size_t i = 0; i < stride; i++ )
+			{
+				int a = (i >= 4) ? row[ i - 4 ] : 0;
+				int b = (above != nullptr) ? above[ i ] : 0;
+				int c = (i >= 4 && above != nullptr) ? above[ i - 4 ] : 0;
+
+				unsigned char predicted = 0;
+				switch( type )
+				{
+				case 1:	predicted = (unsigned char)a;				break;
+				case 2:	predicted = (unsigned char)b;				break;
+				case 3:	predicted = (unsigned char)((a + b) / 2);	break;
+				case 4:	predicted = Paeth( a, b, c );				break;
+				}
+
+				candidate[ i ] = (unsigned char)(row[ i ] - predicted);
+				sum += (candidate[ i ] < 128) ? candidate[ i ] : 256 - candidate[ i ];
+			}
+
+			if( sum < bestSum )
+			{
+				bestSum = sum;
+				bestType = type;
+				best.swap( candidate );
+			}
+		}
+
+		filtered.push_back( bestType );
+		filtered.insert( filtered.end(), best.begin(), best.end() );
+	}
+
+
+	// Assemble the file
+	std::vector< unsigned char > bytes;
+	const unsigned char signature[ 8 ] = { 0x89, 'P', 'N', 'G', '\r', '\n', 0x1A, '\n' };
+	bytes.insert( bytes.end(), signature, signature + 8 );
+
+	std::vector< unsigned char > header;
+	WriteBE32( header, m_unWidth );
+	WriteBE32( header, m_unHeight );
+	header.push_back( 8 );		// bit depth
+	header.push_back( 6 );		// RGBA
+	header.push_back( 0 );		// deflate
+	header.push_back( 0 );		// adaptive filtering
+	header.push_back( 0 );		// not interlaced
+	AppendChunk( bytes, "IHDR", header );
+
+	std::vector< unsigned char > compressed;
+	Deflate( &filtered[ 0 ], filtered.size(), compressed );
+	AppendChunk( bytes, "IDAT", compressed );
+
+	AppendChunk( bytes, "IEND", std::vector< unsigned char >() );
+
+
+	FILE* file = fopen( filename, "wb" );
+	if( file == nullptr )
+		return Fail( "cannot create the file" );
+
+	bool success = fwrite( &bytes[ 0 ], 1, bytes.size(), file ) == bytes.size();
+	success = (fclose( file ) == 0) && success;
+
+	if( success == false )
+		return Fail( "cannot write the file" );
+
+	return true;
+}
+
+
+//*********************************************************************//
+// Blit
+void PngImage::Blit( const PngImage& source, unsigned int x, unsigned int y )
+{
+	if( x >= m_unWidth || y >= m_unHeight )
+		return;
+
+	unsigned int width	= (source.m_unWidth  < m_unWidth  - x) ? source.m_unWidth  : m_unWidth  - x;
+	unsigned int height	= (source.m_unHeight < m_unHeight - y) ? source.m_unHeight : m_unHeight - y;
+
+	for( unsigned int row = 0; row < height; row++ )
+		memcpy( &m_vPixels[ ((size_t)(y + row) * m_unWidth + x) * 4 ],
+				&source.m_vPixels[ (size_t)row * source.m_unWidth * 4 ],
+				(size_t)width * 4 );
+}
+
+
+//*********************************************************************//
+// Copy
+void PngImage::Copy( const PngImage& source, unsigned int x, unsigned int y )
+{
+	std::fill( m_vPixels.begin(), m_vPixels.end(), (unsigned char)0 );
+
+	if( x >= source.m_unWidth || y >= source.m_unHeight )
+		return;
+
+	unsigned int width	= (m_unWidth  < source.m_unWidth  - x) ? m_unWidth  : source.m_unWidth  - x;
+	unsigned int height	= (m_unHeight < source.m_unHeight - y) ? m_unHeight : source.m_unHeight - y;
+
+	for( unsigned int row = 0; row < height; row++ )
+		memcpy( &m_vPixels[ (size_t)row * m_unWidth * 4 ],
+				&source.m_vPixels[ ((size_t)(y + row) * source.m_unWidth + x) * 4 ],
+				(size_t)width * 4 );
+}
+
+
+//*********************************************************************//
+// IsTransparent
+bool PngImage::IsTransparent( void ) const
+{
+	for( size_t i = 3; i < m_vPixels.size(); i += 4 )
+		if( m_vPixels[ i ] != 0 )
+			return false;
+
+	return true;
+}
+
+
+//*********************************************************************//
+// Decode
+//	- the decoder is shared with the game (SGD_PngDecoder)
+bool PngImage::Decode( const std::vector< unsigned char >& file )
+{
+	const char* error = nullptr;
+	if( SGD::DecodePng( file.empty() ? nullptr : &file[ 0 ], (unsigned int)file.size(),
+						m_unWidth, m_unHeight, m_vPixels, &error ) == false )
+	{
+		Create( 0, 0 );
+		return Fail( error );
+	}
+
+	m_strError.clear();
+	return true;
+}
+
+
+//*********************************************************************//
+// Fail
+//	- store the reason & return false
+bool PngImage::Fail( const char* message ) const
+{
+	m_strError = message;
+	return false;
+}
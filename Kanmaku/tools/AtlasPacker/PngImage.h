@@ -0,0 +1,67 @@
+//*********************************************************************//
+//	File:		PngImage.h
+//	Author:		
+//	Course:		
+//	Purpose:	PngImage class decodes & encodes PNG files as 8-bit RGBA
+//				pixels, with its own deflate (no zlib); decoding goes
+//				through the game's SGD_PngDecoder
+//*********************************************************************//
+
+#pragma once
+
+#include <string>					// uses std::string
+#include <vector>					// uses std::vector
+
+
+//*********************************************************************//
+// PngImage class
+//	- Load accepts every non-interlaced PNG color type & bit depth
+//	  (16-bit samples are reduced to 8 bits)
+//	- Save always writes 8-bit RGBA, compressed with fixed Huffman codes
+//	- pixels are stored top-down, 4 bytes per pixel
+class PngImage
+{
+public:
+	//*****************************************************************//
+	// Constructor & destructor
+	PngImage( void )	= default;
+	~PngImage( void )	= default;
+
+
+	//*****************************************************************//
+	// Setup:
+	//	- Create fills the image with transparent black
+	void			Create		( unsigned int width, unsigned int height );
+	bool			Load		( const char* filename );
+	bool			Save		( const char* filename ) const;
+
+	const std::string&	GetError	( void ) const		{	return m_strError;	}
+
+
+	//*****************************************************************//
+	// Pixels:
+	//	- Blit copies the whole source image, clipped to this image
+	//	- Copy fills this image with the source's pixels starting at
+	//	  (x, y), transparent where it runs past the source
+	void			Blit		( const PngImage& source, unsigned int x, unsigned int y );
+	void			Copy		( const PngImage& source, unsigned int x, unsigned int y );
+	bool			IsTransparent	( void ) const;		// every alpha is 0
+
+	unsigned int	GetWidth	( void ) const		{	return m_unWidth;	}
+	unsigned int	GetHeight	( void ) const		{	return m_unHeight;	}
+	const unsigned char*	GetPixels	( void ) const		{	return m_vPixels.empty() ? nullptr : &m_vPixels[ 0 ];	}
+
+private:
+	//*****************************************************************//
+	// Helper methods
+	bool			Decode		( const std::vector< unsigned char >& file );
+	bool			Fail		( const char* message ) const;
+
+
+	//*****************************************************************//
+	// members:
+	unsigned int					m_unWidth	= 0;
+	unsigned int					m_unHeight	= 0;
+	std::vector< unsigned char >	m_vPixels;				// RGBA, top-down
+	mutable std::string				m_strError;				// reason of the last failure
+};
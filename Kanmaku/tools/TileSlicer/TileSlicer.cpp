@@ -0,0 +1,155 @@
+//*********************************************************************//
+//	File:		TileSlicer.cpp
+//	Author:		
+//	Course:		
+//	Purpose:	Command-line tool cutting a background image into a grid
+//				of equal tiles & writing the layer's tile index
+//	Build:		g++ -std=c++11 -O2 -o TileSlicer TileSlicer.cpp ../AtlasPacker/PngImage.cpp "../../SGD Wrappers/SGD_TextureAtlas.cpp" "../../SGD Wrappers/SGD_PngDecoder.cpp"
+//				cl /EHsc /O2 TileSlicer.cpp ..\AtlasPacker\PngImage.cpp "..\..\SGD Wrappers\SGD_TextureAtlas.cpp" "..\..\SGD Wrappers\SGD_PngDecoder.cpp"
+//	Usage:		TileSlicer [-tile <size>] -o <layer.tiles> <image.png>
+//				(run from Kanmaku: tools/TileSlicer/TileSlicer -o resource/graphics/tiles/bg_back.tiles resource/graphics/DEBUG_GameStateBG_Back.png)
+//*********************************************************************//
+
+#define _CRT_SECURE_NO_WARNINGS		// uses fopen
+
+#include "../AtlasPacker/PngImage.h"
+
+#include "../../SGD Wrappers/SGD_TextureAtlas.h"
+
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <string>
+
+
+//*********************************************************************//
+// Defaults
+#define TILESLICER_DEFAULT_TILE		256		// tile width & height (a power of 2)
+
+
+//*********************************************************************//
+// GetStem
+//	- file name without its folder & extension
+static std::string GetStem( const std::string& path )
+{
+	size_t slash = path.find_last_of( "/\\" );
+	std::string stem = (slash == std::string::npos) ? path : path.substr( slash + 1 );
+
+	size_t dot = stem.find_last_of( '.' );
+	if( dot != std::string::npos )
+		stem.resize( dot );
+	return stem;
+}
+
+
+//*********************************************************************//
+// PrintUsage
+static int PrintUsage( void )
+{
+	fprintf( stderr,
+		"Usage: TileSlicer [-tile <size>] -o <layer.tiles> <image.png>\n"
+		"  Cuts the image into <layer>_<column>_<row>.png next to the index.\n"
+		"  Fully transparent tiles are not written.\n" );
+	return 1;
+}
+
+
+//*********************************************************************//
+// main
+int main( int argc, char* argv[] )
+{
+	unsigned int tileSize = TILESLICER_DEFAULT_TILE;
+	std::string indexPath;
+	std::string imagePath;
+
+
+	// Parse the arguments
+	for( int a = 1; a < argc; a++ )
+	{
+		if( strcmp( argv[ a ], "-tile" ) == 0 && a + 1 < argc )
+			tileSize = (unsigned int)atoi( argv[ ++a ] );
+		else if( strcmp( argv[ a ], "-o" ) == 0 && a + 1 < argc )
+			indexPath = argv[ ++a ];
+		else if( argv[ a ][ 0 ] == '-' || imagePath.empty() == false )
+			return PrintUsage();
+		else
+			imagePath = argv[ a ];
+	}
+
+	// Tiles become textures as they are: keep them a power of 2
+	if( indexPath.empty() == true || imagePath.empty() == true
+		|| tileSize == 0 || (tileSize & (tileSize - 1)) != 0 )
+		return PrintUsage();
+
+
+	// Load the image
+	PngImage image;
+	if( image.Load( imagePath.c_str() ) == false )
+	{
+		fprintf( stderr, "TileSlicer: %s: %s\n", imagePath.c_str(), image.GetError().c_str() );
+		return 1;
+	}
+
+
+	// Describe the grid
+	std::string stem = GetStem( indexPath );
+
+	SGD::TileLayerIndex index;
+	index.unWidth		= image.GetWidth();
+	index.unHeight		= image.GetHeight();
+	index.unTileWidth	= tileSize;
+	index.unTileHeight	= tileSize;
+	index.unColumns		= (index.unWidth  + tileSize - 1) / tileSize;
+	index.unRows		= (index.unHeight + tileSize - 1) / tileSize;
+	index.wsPrefix		= std::wstring( stem.begin(), stem.end() );
+	index.vHasTile.assign( index.unColumns * index.unRows, 0 );
+
+
+	// Cut & save the tiles
+	size_t slash = indexPath.find_last_of( "/\\" );
+	std::string folder = (slash == std::string::npos) ? std::string() : indexPath.substr( 0, slash + 1 );
+
+	PngImage tile;
+	tile.Create( tileSize, tileSize );
+	unsigned int written = 0;
+
+	for( unsigned int row = 0; row < index.unRows; row++ )
+		for( unsigned int column = 0; column < index.unColumns; column++ )
+		{
+			tile.Copy( image, column * tileSize, row * tileSize );
+			if( tile.IsTransparent() == true )
+				continue;
+
+			char suffix[ 32 ];
+			sprintf( suffix, "_%u_%u.png", column, row );
+			std::string tilePath = folder + stem + suffix;
+
+			if( tile.Save( tilePath.c_str() ) == false )
+			{
+				fprintf( stderr, "TileSlicer: %s: %s\n", tilePath.c_str(), tile.GetError().c_str() );
+				return 1;
+			}
+
+			index.vHasTile[ row * index.unColumns + column ] = 1;
+			written++;
+		}
+
+
+	// Write the index
+	FILE* file = fopen( indexPath.c_str(), "wb" );
+	bool success = file != nullptr && index.Write( file ) == true;
+	if( file != nullptr )
+		success = (fclose( file ) == 0) && success;
+
+	if( success == false )
+	{
+		fprintf( stderr, "TileSlicer: %s: cannot write the index\n", indexPath.c_str() );
+		return 1;
+	}
+
+
+	printf( "%s: %ux%u in %ux%u tiles of %u, %u written (%u transparent)\n",
+		indexPath.c_str(), index.unWidth, index.unHeight, index.unColumns, index.unRows, tileSize,
+		written, index.unColumns * index.unRows - written );
+	return 0;
+}